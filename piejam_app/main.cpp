@@ -22,6 +22,7 @@
 #include <piejam/redux/subscriber.h>
 #include <piejam/redux/subscriptions_manager.h>
 #include <piejam/runtime/actions/audio_engine_sync.h>
+#include <piejam/runtime/actions/autosave_session.h>
 #include <piejam/runtime/actions/load_app_config.h>
 #include <piejam/runtime/actions/load_session.h>
 #include <piejam/runtime/actions/recording.h>
@@ -31,6 +32,7 @@
 #include <piejam/runtime/actions/save_session.h>
 #include <piejam/runtime/actions/scan_ladspa_fx_plugins.h>
 #include <piejam/runtime/audio_engine_middleware.h>
+#include <piejam/runtime/audio_thread_topology.h>
 #include <piejam/runtime/ladspa_fx_middleware.h>
 #include <piejam/runtime/locations.h>
 #include <piejam/runtime/midi_control_middleware.h>
@@ -44,6 +46,7 @@
 #include <piejam/runtime/ui/thunk_action.h>
 #include <piejam/system/avg_cpu_load_tracker.h>
 #include <piejam/system/cpu_temp.h>
+#include <piejam/system/cpu_topology.h>
 #include <piejam/system/disk_usage.h>
 #include <piejam/thread/affinity.h>
 
@@ -81,6 +84,9 @@ config_file_path(piejam::runtime::locations const& locs)
 
 constexpr int realtime_priority = 96;
 
+// first cpu is for the system
+constexpr int ui_cpu = 1;
+
 struct QtThreadDelegator
 {
     template <std::invocable F>
@@ -112,11 +118,9 @@ main(int argc, char* argv[]) -> int
 
     qputenv("QT_IM_MODULE", QByteArray("qtvirtualkeyboard"));
 
-    // run app on the second cpu, first one is for the system
-    this_thread::set_affinity(1);
+    this_thread::set_affinity(ui_cpu);
 
     piejam::gui::init();
-    piejam::fx_modules::init();
 
     gui::qt_log::install_handler();
     spdlog::set_level(spdlog::level::level_enum::debug);
@@ -140,6 +144,8 @@ main(int argc, char* argv[]) -> int
                             .toStdString();
     locs.rec_dir = locs.home_dir / "recordings";
 
+    piejam::fx_modules::init(locs.home_dir / "impulse_responses");
+
     QGuiApplication app(argc, argv);
 
     QQuickStyle::setStyle("Material");
@@ -172,7 +178,8 @@ main(int argc, char* argv[]) -> int
             runtime::make_initial_state());
 
     store.apply_middleware(
-            middleware_factory::make<runtime::persistence_middleware>());
+            middleware_factory::make<runtime::persistence_middleware>(
+                    locs.home_dir / "autosave"));
 
     store.apply_middleware(
             middleware_factory::make<runtime::recorder_middleware>(
@@ -180,26 +187,15 @@ main(int argc, char* argv[]) -> int
 
     store.apply_middleware(
             middleware_factory::make<runtime::audio_engine_middleware>(
-                    thread::configuration{
-                            .affinity = 2,
-                            .realtime_priority = realtime_priority,
-                            .name = "audio_main"},
-                    std::array{
-                            thread::configuration{
-                                    .affinity = 3,
-                                    .realtime_priority = realtime_priority,
-                                    .name = "audio_worker_0"},
-                            thread::configuration{
-                                    .affinity = 0,
-                                    .realtime_priority = realtime_priority,
-                                    .name = "audio_worker_1"},
-                            thread::configuration{
-                                    .affinity = 1,
-                                    .realtime_priority = realtime_priority,
-                                    .name = "audio_worker_2"}},
+                    runtime::auto_audio_thread_topology(
+                            system::online_cpus(),
+                            system::isolated_cpus(),
+                            ui_cpu,
+                            realtime_priority),
                     *audio_device_manager,
                     ladspa_manager,
-                    runtime::make_midi_input_controller(*midi_device_manager)));
+                    runtime::make_midi_input_controller(*midi_device_manager),
+                    locs.home_dir / "xruns"));
 
     store.apply_middleware(
             middleware_factory::make<runtime::midi_control_middleware>(
@@ -229,7 +225,9 @@ main(int argc, char* argv[]) -> int
         state_change_subscriber.notify(state);
     });
 
-    store.dispatch(runtime::actions::scan_ladspa_fx_plugins("/usr/lib/ladspa"));
+    store.dispatch(runtime::actions::scan_ladspa_fx_plugins(
+            "/usr/lib/ladspa",
+            locs.config_dir / "ladspa_scan.cache"));
 
     gui::ModelManager modelManager(store, state_change_subscriber);
 
@@ -248,12 +246,17 @@ main(int argc, char* argv[]) -> int
             &QQmlApplicationEngine::quit,
             &QGuiApplication::quit);
 
-    auto session_file = locs.home_dir / "last.pjs";
+    auto const session_file = locs.home_dir / "last.pjsb";
+
+    // sessions saved before the binary format was introduced
+    auto const legacy_session_file = locs.home_dir / "last.pjs";
 
     store.dispatch(runtime::actions::refresh_sound_cards{});
     store.dispatch(runtime::actions::refresh_midi_devices{});
     store.dispatch(runtime::actions::load_app_config(config_file_path(locs)));
-    store.dispatch(runtime::actions::load_session(session_file));
+    store.dispatch(runtime::actions::load_session(
+            std::filesystem::exists(session_file) ? session_file
+                                                  : legacy_session_file));
 
     system::avg_cpu_load_tracker avg_cpu_load(4);
 
@@ -262,6 +265,7 @@ main(int argc, char* argv[]) -> int
         auto timer = new QTimer(&app);
         QObject::connect(timer, &QTimer::timeout, [&]() {
             store.dispatch(runtime::actions::refresh_midi_devices{});
+            store.dispatch(runtime::actions::autosave_session{});
 
             modelManager.info()->setCpuTemp(system::cpu_temp());
 
@@ -0,0 +1,75 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/dynamics.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <span>
+
+constexpr auto min_period_size = 64;
+constexpr auto max_period_size = 1024;
+
+static void
+BM_compute_gain(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    mipp::vector<float> level(state.range(0));
+    for (float& l : level)
+    {
+        l = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    }
+    mipp::vector<float> gain(level.size());
+    float const log_threshold = std::log(0.25f);
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < level.size(); ++i)
+        {
+            gain[i] = piejam::audio::dsp::compute_gain(
+                    level[i],
+                    log_threshold,
+                    0.75f);
+        }
+        benchmark::DoNotOptimize(gain.data());
+    }
+}
+
+BENCHMARK(BM_compute_gain)
+        ->RangeMultiplier(2)
+        ->Range(min_period_size, max_period_size);
+
+static void
+BM_simd_compute_gain(benchmark::State& state)
+{
+    std::srand(std::time(nullptr));
+
+    mipp::vector<float> level(state.range(0));
+    for (float& l : level)
+    {
+        l = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    }
+    mipp::vector<float> gain(level.size());
+    float const log_threshold = std::log(0.25f);
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        piejam::audio::dsp::simd::compute_gain<float>(
+                level,
+                log_threshold,
+                0.75f,
+                gain);
+        benchmark::DoNotOptimize(gain.data());
+    }
+}
+
+BENCHMARK(BM_simd_compute_gain)
+        ->RangeMultiplier(2)
+        ->Range(min_period_size, max_period_size);
@@ -0,0 +1,126 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/event_buffer.h>
+#include <piejam/audio/engine/event_buffer_memory.h>
+
+#include <piejam/midi/event.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace piejam;
+
+constexpr std::size_t period_size = 1024;
+constexpr std::size_t event_memory_size = 1 << 20;
+
+// dense CC stream, e.g. a controller sweep, num_events per period
+static auto
+cc_event(std::size_t const n) -> midi::external_event
+{
+    return {.device_id = {},
+            .event = midi::channel_cc_event{
+                    .channel = 0,
+                    .data = {.cc = 7, .value = n % 128}}};
+}
+
+static void
+BM_event_buffer_insert_in_order(benchmark::State& state)
+{
+    auto const num_events = static_cast<std::size_t>(state.range(0));
+
+    audio::engine::event_buffer_memory event_memory(event_memory_size);
+    std::pmr::memory_resource* event_memory_resource =
+            &event_memory.memory_resource();
+    audio::engine::event_buffer<midi::external_event> sut(
+            event_memory_resource);
+
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0; n < num_events; ++n)
+        {
+            sut.insert(n * period_size / num_events, cc_event(n));
+        }
+
+        benchmark::DoNotOptimize(sut.size());
+
+        sut.clear();
+        event_memory.release();
+    }
+
+    state.SetItemsProcessed(
+            state.iterations() * static_cast<std::int64_t>(num_events));
+}
+
+BENCHMARK(BM_event_buffer_insert_in_order)->RangeMultiplier(4)->Range(16, 4096);
+
+// two interleaved streams, the second one is merged into the first one
+static void
+BM_event_buffer_insert_merge(benchmark::State& state)
+{
+    auto const num_events = static_cast<std::size_t>(state.range(0));
+
+    audio::engine::event_buffer_memory event_memory(event_memory_size);
+    std::pmr::memory_resource* event_memory_resource =
+            &event_memory.memory_resource();
+    audio::engine::event_buffer<midi::external_event> sut(
+            event_memory_resource);
+
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0; n < num_events; n += 2)
+        {
+            sut.insert(n * period_size / num_events, cc_event(n));
+        }
+
+        for (std::size_t n = 1; n < num_events; n += 2)
+        {
+            sut.insert(n * period_size / num_events, cc_event(n));
+        }
+
+        benchmark::DoNotOptimize(sut.size());
+
+        sut.clear();
+        event_memory.release();
+    }
+
+    state.SetItemsProcessed(
+            state.iterations() * static_cast<std::int64_t>(num_events));
+}
+
+BENCHMARK(BM_event_buffer_insert_merge)->RangeMultiplier(4)->Range(16, 4096);
+
+static void
+BM_event_buffer_iterate(benchmark::State& state)
+{
+    auto const num_events = static_cast<std::size_t>(state.range(0));
+
+    audio::engine::event_buffer_memory event_memory(event_memory_size);
+    std::pmr::memory_resource* event_memory_resource =
+            &event_memory.memory_resource();
+    audio::engine::event_buffer<midi::external_event> sut(
+            event_memory_resource);
+
+    for (std::size_t n = 0; n < num_events; ++n)
+    {
+        sut.insert(n * period_size / num_events, cc_event(n));
+    }
+
+    for (auto _ : state)
+    {
+        std::size_t sum{};
+        for (audio::engine::event<midi::external_event> const& ev : sut)
+        {
+            sum += ev.offset() +
+                   std::get<midi::channel_cc_event>(ev.value().event)
+                           .data.value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(
+            state.iterations() * static_cast<std::int64_t>(num_events));
+}
+
+BENCHMARK(BM_event_buffer_iterate)->RangeMultiplier(4)->Range(16, 4096);
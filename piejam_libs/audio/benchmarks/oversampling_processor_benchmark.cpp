@@ -0,0 +1,101 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/oversampling_processor.h>
+
+#include <piejam/audio/engine/clip_processor.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+static void
+run(benchmark::State& state, processor& sut)
+{
+    std::srand(std::time(nullptr));
+
+    std::size_t const buffer_size = state.range(0);
+
+    processor_test_environment env(sut, buffer_size);
+
+    mipp::vector<float> in_buf(buffer_size);
+    for (float& x : in_buf)
+    {
+        x = 2.f * static_cast<float>(rand()) / static_cast<float>(RAND_MAX) -
+            1.f;
+    }
+    env.audio_inputs[0] = std::span<float const>{in_buf};
+
+    for (auto _ : state)
+    {
+        sut.process(env.ctx);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void
+BM_oversampling_processor(
+        benchmark::State& state,
+        oversampling_factor const factor,
+        oversampling_phase const phase)
+{
+    std::vector<std::unique_ptr<processor>> chain;
+    chain.push_back(make_clip_processor(-0.5f, 0.5f));
+
+    auto sut = make_oversampling_processor(1, std::move(chain), factor, phase);
+
+    run(state, *sut);
+}
+
+// baseline, the clip processor without oversampling
+static void
+BM_clip_processor(benchmark::State& state)
+{
+    auto sut = make_clip_processor(-0.5f, 0.5f);
+
+    run(state, *sut);
+}
+
+BENCHMARK(BM_clip_processor)->RangeMultiplier(2)->Range(64, 1024);
+BENCHMARK_CAPTURE(
+        BM_oversampling_processor,
+        x2_linear,
+        oversampling_factor::x2,
+        oversampling_phase::linear)
+        ->RangeMultiplier(2)
+        ->Range(64, 1024);
+BENCHMARK_CAPTURE(
+        BM_oversampling_processor,
+        x2_minimum,
+        oversampling_factor::x2,
+        oversampling_phase::minimum)
+        ->RangeMultiplier(2)
+        ->Range(64, 1024);
+BENCHMARK_CAPTURE(
+        BM_oversampling_processor,
+        x4_linear,
+        oversampling_factor::x4,
+        oversampling_phase::linear)
+        ->RangeMultiplier(2)
+        ->Range(64, 1024);
+BENCHMARK_CAPTURE(
+        BM_oversampling_processor,
+        x4_minimum,
+        oversampling_factor::x4,
+        oversampling_phase::minimum)
+        ->RangeMultiplier(2)
+        ->Range(64, 1024);
+
+} // namespace piejam::audio::engine
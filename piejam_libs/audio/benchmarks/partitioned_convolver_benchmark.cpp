@@ -0,0 +1,77 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/partitioned_convolver.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Worst-case period, the one which has to meet the deadline. An iteration
+// runs one block worth of periods and its time is the slowest of them. The
+// transform cost per block is independent of the impulse response length,
+// only the spectral multiply-add grows with the number of partitions.
+//
+// args: period size, block size, impulse response length in frames
+static void
+BM_partitioned_convolver(benchmark::State& state)
+{
+    auto const period_size = static_cast<std::size_t>(state.range(0));
+    auto const block_size = static_cast<std::size_t>(state.range(1));
+    auto const ir_length = static_cast<std::size_t>(state.range(2));
+    std::size_t const periods_per_block =
+            std::max<std::size_t>(block_size / period_size, 1);
+
+    std::minstd_rand gen(1);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    std::vector<float> ir(ir_length);
+    std::ranges::generate(ir, [&]() { return dist(gen); });
+
+    piejam::numeric::dft dft(2 * block_size);
+    piejam::audio::dsp::convolution_kernel const kernel(ir, dft);
+
+    piejam::audio::dsp::partitioned_convolver conv(
+            block_size,
+            kernel.num_partitions());
+    conv.set_kernel(&kernel);
+
+    std::vector<float> in(period_size);
+    std::ranges::generate(in, [&]() { return dist(gen); });
+    std::vector<float> out(period_size);
+    benchmark::ClobberMemory();
+
+    std::chrono::duration<double> worst_period{};
+    for (auto _ : state)
+    {
+        std::chrono::duration<double> slowest{};
+        for (std::size_t i = 0; i < periods_per_block; ++i)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            conv.process(in, out);
+            benchmark::DoNotOptimize(out.data());
+            slowest = std::max<std::chrono::duration<double>>(
+                    slowest,
+                    std::chrono::steady_clock::now() - start);
+        }
+
+        state.SetIterationTime(slowest.count());
+        worst_period = std::max(worst_period, slowest);
+    }
+
+    state.counters["partitions"] =
+            static_cast<double>(kernel.num_partitions());
+    state.counters["worst_period_us"] = worst_period.count() * 1e6;
+}
+
+BENCHMARK(BM_partitioned_convolver)
+        ->ArgsProduct(
+                {{64, 256},
+                 {128, 256, 512},
+                 {4'800, 24'000, 48'000, 96'000, 192'000}})
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
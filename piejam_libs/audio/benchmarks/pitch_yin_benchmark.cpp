@@ -5,6 +5,7 @@
 #include <piejam/audio/dsp/pitch_yin.h>
 
 #include <piejam/audio/dsp/generate_sine.h>
+#include <piejam/audio/dsp/pitch_yin_fft.h>
 
 #include <mipp.h>
 
@@ -37,3 +38,50 @@ BM_pitch_yin(benchmark::State& state)
 }
 
 BENCHMARK(BM_pitch_yin)->DenseRange(0, freqs.size() - 1);
+
+// args: window size, frequency index
+static void
+BM_pitch_yin_window(benchmark::State& state)
+{
+    constexpr piejam::audio::sample_rate sr{48000};
+
+    mipp::vector<float> in_buf(state.range(0));
+    piejam::audio::dsp::generate_sine(
+            std::span{in_buf},
+            sr.as_float(),
+            freqs[state.range(1)]);
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+                piejam::audio::dsp::pitch_yin<float>(in_buf, sr));
+    }
+}
+
+BENCHMARK(BM_pitch_yin_window)->ArgsProduct({{2048, 4096}, {1, 3, 5}});
+
+// args: window size, frequency index, pre-pass decimation
+static void
+BM_pitch_yin_fft(benchmark::State& state)
+{
+    constexpr piejam::audio::sample_rate sr{48000};
+
+    mipp::vector<float> in_buf(state.range(0));
+    piejam::audio::dsp::generate_sine(
+            std::span{in_buf},
+            sr.as_float(),
+            freqs[state.range(1)]);
+
+    piejam::audio::dsp::pitch_yin_fft pitch_yin(
+            state.range(0),
+            state.range(2));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pitch_yin(in_buf, sr));
+    }
+}
+
+BENCHMARK(BM_pitch_yin_fft)->ArgsProduct({{2048, 4096}, {1, 3, 5}, {1, 4}});
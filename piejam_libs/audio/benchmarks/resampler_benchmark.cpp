@@ -0,0 +1,132 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/resampler.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+// Throughput, one period of input per iteration.
+//
+// args: period size, input rate, output rate
+static void
+BM_resampler(benchmark::State& state)
+{
+    auto const period_size = static_cast<std::size_t>(state.range(0));
+    double const ratio = static_cast<double>(state.range(2)) /
+                         static_cast<double>(state.range(1));
+
+    std::minstd_rand gen(1);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    piejam::audio::dsp::resampler sut(ratio);
+
+    std::vector<float> in(period_size);
+    std::ranges::generate(in, [&]() { return dist(gen); });
+    std::vector<float> out(sut.max_output_size(period_size));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sut.process(in, out));
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(
+            state.iterations() * static_cast<std::int64_t>(period_size));
+}
+
+BENCHMARK(BM_resampler)
+        ->ArgsProduct({{64, 256, 1024}, {44100}, {48000}})
+        ->ArgsProduct({{64, 256, 1024}, {48000}, {44100}})
+        ->ArgsProduct({{64, 256, 1024}, {96000}, {48000}});
+
+// Drift compensation, the ratio is adjusted every period.
+static void
+BM_resampler_adaptive(benchmark::State& state)
+{
+    auto const period_size = static_cast<std::size_t>(state.range(0));
+
+    std::minstd_rand gen(1);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    piejam::audio::dsp::resampler sut(1.);
+
+    std::vector<float> in(period_size);
+    std::ranges::generate(in, [&]() { return dist(gen); });
+    std::vector<float> out(2 * period_size);
+    benchmark::ClobberMemory();
+
+    double drift{};
+    for (auto _ : state)
+    {
+        drift = drift > 0. ? -1e-4 : 1e-4;
+        sut.set_ratio(1. + drift);
+        benchmark::DoNotOptimize(sut.process(in, out));
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(
+            state.iterations() * static_cast<std::int64_t>(period_size));
+}
+
+BENCHMARK(BM_resampler_adaptive)->RangeMultiplier(4)->Range(64, 1024);
+
+// Quality, a sine from 44.1 kHz to 48 kHz is compared to the ideal one.
+// The signal to noise ratio is reported as counter, in dB.
+//
+// args: sine frequency in Hz, zero crossings
+static void
+BM_resampler_quality(benchmark::State& state)
+{
+    using std::numbers::pi;
+
+    double const freq = static_cast<double>(state.range(0));
+    auto const zero_crossings = static_cast<std::size_t>(state.range(1));
+
+    constexpr std::size_t in_rate = 44100;
+    constexpr std::size_t out_rate = 48000;
+
+    std::vector<float> in(in_rate);
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<float>(
+                std::sin(2. * pi * freq * static_cast<double>(i) / in_rate));
+    }
+
+    double signal{};
+    double noise{};
+    for (auto _ : state)
+    {
+        piejam::audio::dsp::resampler sut(
+                static_cast<double>(out_rate) / in_rate,
+                zero_crossings);
+
+        std::vector<float> out(sut.max_output_size(in.size()));
+        out.resize(sut.process(in, out));
+
+        // skip the ringing of the abrupt start
+        signal = 0.;
+        noise = 0.;
+        for (std::size_t i = out_rate / 10; i < out.size(); ++i)
+        {
+            double const expected = std::sin(
+                    2. * pi * freq * static_cast<double>(i) / out_rate);
+            signal += expected * expected;
+            noise += (out[i] - expected) * (out[i] - expected);
+        }
+    }
+
+    state.counters["snr_db"] = 10. * std::log10(signal / noise);
+}
+
+BENCHMARK(BM_resampler_quality)
+        ->ArgsProduct({{100, 1000, 10000, 18000}, {16, 32, 64}})
+        ->Iterations(1)
+        ->Unit(benchmark::kMillisecond);
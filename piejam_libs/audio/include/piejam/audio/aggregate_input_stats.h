@@ -0,0 +1,40 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+namespace piejam::audio
+{
+
+//! Health of an additional capture device, which runs on its own clock.
+struct aggregate_input_stats
+{
+    //! The device couldn't be opened, its channels are silent.
+    bool failed{};
+
+    //! Added to the latency of the master device, in its frames.
+    std::size_t latency{};
+
+    //! Mean fill level of the buffer, relative to the targeted one.
+    float buffer_fill{};
+
+    //! Deviation of the device clock from the master clock, in ppm.
+    float drift_ppm{};
+
+    //! The buffer ran empty, the audio thread got silence.
+    std::size_t underruns{};
+
+    //! The buffer was full, captured frames were dropped.
+    std::size_t overruns{};
+
+    //! Overruns of the device itself.
+    std::size_t xruns{};
+
+    auto operator==(aggregate_input_stats const&) const noexcept
+            -> bool = default;
+};
+
+} // namespace piejam::audio
@@ -4,9 +4,23 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace piejam::audio
 {
 
+//! Marks the calling thread as real-time thread. Dynamic memory allocations
+//! on it are counted and a backtrace sample is recorded. In debug builds,
+//! they additionally fail with std::bad_alloc. Marking a marked thread
+//! again is cheap.
 void prohibit_dynamic_memory_allocation();
 
+//! Number of dynamic memory allocations on real-time threads so far.
+[[nodiscard]]
+auto rt_allocation_count() noexcept -> std::size_t;
+
+//! Logs the recorded backtrace samples and frees their slots. Not to be
+//! called from a real-time thread.
+void log_rt_allocation_samples();
+
 } // namespace piejam::audio
@@ -0,0 +1,118 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/aggregate_input_stats.h>
+#include <piejam/audio/dsp/resampler.h>
+#include <piejam/audio/io_process_config.h>
+#include <piejam/system/monotonic_raw_clock.h>
+#include <piejam/thread/spsc_queue.h>
+#include <piejam/thread/spsc_slot.h>
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <span>
+#include <vector>
+
+namespace piejam::audio
+{
+
+//! Hands the frames of a capture device, which runs on its own clock, over
+//! to the audio thread of the master device.
+//!
+//! The capture thread resamples its periods to the master sample rate into
+//! a ring buffer, the audio thread takes its periods out of it. The mean
+//! fill level of the ring buffer is kept at a target, by a PI controller
+//! adjusting the resampling ratio. In the steady state, the correction of
+//! the ratio is the drift between the two clocks.
+class async_input_buffer
+{
+public:
+    using time_point = system::monotonic_raw_clock::time_point;
+
+    async_input_buffer(
+            std::size_t num_channels,
+            sound_card_buffer_config const& device,
+            sound_card_buffer_config const& master);
+    ~async_input_buffer();
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_num_channels;
+    }
+
+    //! Called by the capture thread, with a period of the device per
+    //! channel, which was completed at the given time.
+    void write(
+            std::span<std::span<float const> const> channels,
+            time_point now) noexcept;
+
+    //! Called by the audio thread, the frames are accessible through
+    //! channel() afterwards. Silence, until the buffer is filled up to the
+    //! target, and after it ran empty.
+    void read(std::size_t frames, time_point now) noexcept;
+
+    [[nodiscard]]
+    auto channel(std::size_t const ch) const noexcept -> std::span<float const>
+    {
+        BOOST_ASSERT(ch < m_num_channels);
+        return std::span{m_output}.subspan(ch * m_frames, m_frames);
+    }
+
+    //! Safe to call from any thread. The xruns of the device are not known
+    //! here, and left at zero.
+    [[nodiscard]]
+    auto stats() const noexcept -> aggregate_input_stats;
+
+private:
+    struct delivery
+    {
+        time_point time{};
+        std::size_t frames{};
+    };
+
+    void resync(std::size_t fill) noexcept;
+    [[nodiscard]]
+    auto estimate_fill(time_point now) noexcept -> double;
+    void control(double fill) noexcept;
+
+    std::size_t m_num_channels;
+    std::size_t m_max_frames;
+    double m_nominal_ratio;
+    double m_sample_rate;
+    double m_device_period;
+    double m_target_fill;
+    double m_resampler_latency;
+
+    // capture thread
+    std::vector<dsp::resampler> m_resamplers;
+    std::vector<float> m_resampled;
+    std::vector<float> m_write_buffer;
+    std::size_t m_frames_written{};
+
+    thread::spsc_queue<float> m_ring;
+    thread::spsc_slot<delivery> m_deliveries;
+    std::atomic<double> m_ratio_correction{1.};
+
+    // audio thread
+    std::vector<float> m_read_buffer;
+    std::vector<float> m_output;
+    std::size_t m_frames{};
+    std::size_t m_frames_read{};
+    delivery m_last_delivery;
+    bool m_running{};
+    double m_fill_mean{};
+    double m_drift{};
+
+    std::atomic<float> m_stats_fill{};
+    std::atomic<float> m_stats_drift{};
+    std::atomic<float> m_stats_latency{};
+    std::atomic_size_t m_underruns{};
+    std::atomic_size_t m_overruns{};
+};
+
+} // namespace piejam::audio
@@ -0,0 +1,200 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+//! 4-point, 3rd-order hermite interpolation between y1 and y2, frac being
+//! the position in between, [0, 1).
+[[nodiscard]]
+constexpr auto
+interpolate_hermite(
+        float const y0,
+        float const y1,
+        float const y2,
+        float const y3,
+        float const frac) noexcept -> float
+{
+    float const c1 = 0.5f * (y2 - y0);
+    float const c2 = y0 - 2.5f * y1 + 2.f * y2 - 0.5f * y3;
+    float const c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+    return ((c3 * frac + c2) * frac + c1) * frac + y1;
+}
+
+namespace simd
+{
+
+//! Element-wise dsp::interpolate_hermite, the taps are expected in
+//! separate arrays. Input and output don't need to be aligned.
+inline void
+interpolate_hermite(
+        std::span<float const> const y0,
+        std::span<float const> const y1,
+        std::span<float const> const y2,
+        std::span<float const> const y3,
+        std::span<float const> const frac,
+        std::span<float> const out) noexcept
+{
+    BOOST_ASSERT(y0.size() == out.size());
+    BOOST_ASSERT(y1.size() == out.size());
+    BOOST_ASSERT(y2.size() == out.size());
+    BOOST_ASSERT(y3.size() == out.size());
+    BOOST_ASSERT(frac.size() == out.size());
+
+    constexpr std::size_t N = mipp::N<float>();
+
+    std::size_t const main_size = (out.size() / N) * N;
+    mipp::Reg<float> const half(0.5f);
+    mipp::Reg<float> const one_and_half(1.5f);
+    mipp::Reg<float> const two(2.f);
+    mipp::Reg<float> const two_and_half(2.5f);
+
+    std::size_t i = 0;
+    for (; i < main_size; i += N)
+    {
+        mipp::Reg<float> r0, r1, r2, r3, f;
+        r0.loadu(y0.data() + i);
+        r1.loadu(y1.data() + i);
+        r2.loadu(y2.data() + i);
+        r3.loadu(y3.data() + i);
+        f.loadu(frac.data() + i);
+
+        auto const c1 = half * (r2 - r0);
+        auto const c2 = r0 - two_and_half * r1 + two * r2 - half * r3;
+        auto const c3 = half * (r3 - r0) + one_and_half * (r1 - r2);
+        mipp::fmadd(mipp::fmadd(mipp::fmadd(c3, f, c2), f, c1), f, r1)
+                .storeu(out.data() + i);
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = dsp::interpolate_hermite(y0[i], y1[i], y2[i], y3[i], frac[i]);
+    }
+}
+
+} // namespace simd
+
+//! Ring buffer on borrowed memory, with a power of two size. Reads refer
+//! to the sample which is written next, a delay of 1 is the sample
+//! written last.
+class delay_line
+{
+public:
+    //! Delays are read in chunks of this size.
+    static constexpr std::size_t chunk_size = 32;
+
+    delay_line() noexcept = default;
+
+    explicit delay_line(std::span<float> const memory) noexcept
+        : m_memory(memory)
+        , m_mask(memory.size() - 1)
+    {
+        BOOST_ASSERT(std::has_single_bit(memory.size()));
+    }
+
+    [[nodiscard]]
+    auto capacity() const noexcept -> std::size_t
+    {
+        return m_memory.size();
+    }
+
+    //! The largest fractional delay which can be read, leaving room for
+    //! the interpolation taps.
+    [[nodiscard]]
+    auto max_delay() const noexcept -> float
+    {
+        return static_cast<float>(capacity()) - 3.f;
+    }
+
+    [[nodiscard]]
+    auto operator[](std::size_t const delay) const noexcept -> float
+    {
+        BOOST_ASSERT(delay > 0 && delay <= capacity());
+        return m_memory[(m_write_pos - delay) & m_mask];
+    }
+
+    void push(float const x) noexcept
+    {
+        m_memory[m_write_pos & m_mask] = x;
+        ++m_write_pos;
+    }
+
+    //! out[i] is the sample delays[i] before sample i of the block that is
+    //! written next, so delays must exceed the block size by 2 at least.
+    //! Fractional delays are interpolated.
+    void read(
+            std::span<float const> const delays,
+            std::span<float> const out) const noexcept
+    {
+        BOOST_ASSERT(delays.size() == out.size());
+
+        for (std::size_t pos = 0; pos < out.size(); pos += chunk_size)
+        {
+            std::size_t const n = std::min(chunk_size, out.size() - pos);
+            read_chunk(
+                    pos,
+                    delays.subspan(pos, n),
+                    out.subspan(pos, n));
+        }
+    }
+
+    void clear() noexcept
+    {
+        std::ranges::fill(m_memory, 0.f);
+    }
+
+private:
+    // Gathering the taps is the only part that isn't vectorized.
+    void read_chunk(
+            std::size_t const offset,
+            std::span<float const> const delays,
+            std::span<float> const out) const noexcept
+    {
+        std::array<float, chunk_size> y0, y1, y2, y3, frac;
+
+        for (std::size_t i = 0; i < delays.size(); ++i)
+        {
+            BOOST_ASSERT(delays[i] >= static_cast<float>(offset + i + 2));
+            BOOST_ASSERT(delays[i] <= max_delay());
+
+            float const delay_int = std::floor(delays[i]);
+            std::size_t const pos =
+                    m_write_pos + offset + i -
+                    static_cast<std::size_t>(delay_int);
+
+            y0[i] = m_memory[(pos + 1) & m_mask];
+            y1[i] = m_memory[pos & m_mask];
+            y2[i] = m_memory[(pos - 1) & m_mask];
+            y3[i] = m_memory[(pos - 2) & m_mask];
+            frac[i] = delays[i] - delay_int;
+        }
+
+        std::size_t const n = delays.size();
+        simd::interpolate_hermite(
+                std::span{y0}.first(n),
+                std::span{y1}.first(n),
+                std::span{y2}.first(n),
+                std::span{y3}.first(n),
+                std::span{frac}.first(n),
+                out);
+    }
+
+    std::span<float> m_memory;
+    std::size_t m_mask{};
+    std::size_t m_write_pos{};
+};
+
+} // namespace piejam::audio::dsp
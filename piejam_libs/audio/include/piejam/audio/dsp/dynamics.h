@@ -0,0 +1,131 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+namespace detail
+{
+
+// Keeps the log of a silent level finite, a slope of zero would turn
+// it into nan otherwise. -180 dB, below anything we could compress.
+template <std::floating_point T>
+inline constexpr T min_detector_level = T{1e-9};
+
+} // namespace detail
+
+//! Hard knee gain computer. Works in the log domain, but with natural
+//! logarithms instead of dB, they cancel each other out:
+//!
+//!   gain = exp(min(0, slope * (log(threshold) - log(level))))
+//!
+//! with slope = 1 - 1 / ratio, 1 for a limiter. level and threshold are
+//! linear, the result is the linear gain to apply.
+template <std::floating_point T>
+[[nodiscard]]
+auto
+compute_gain(T const level, T const log_threshold, T const slope) noexcept
+        -> T
+{
+    return std::exp(std::min(
+            T{},
+            slope * (log_threshold -
+                     std::log(std::max(level,
+                                       detail::min_detector_level<T>)))));
+}
+
+namespace simd
+{
+
+//! Vectorized dsp::compute_gain, log and exp are the approximations from
+//! mipp. Input and output don't need to be aligned.
+template <std::floating_point T>
+void
+compute_gain(
+        std::span<T const> const level,
+        T const log_threshold,
+        T const slope,
+        std::span<T> const gain) noexcept
+{
+    BOOST_ASSERT(level.size() == gain.size());
+
+    constexpr std::size_t N = mipp::N<T>();
+
+    std::size_t const main_size = (level.size() / N) * N;
+    mipp::Reg<T> const reg_min_level(detail::min_detector_level<T>);
+    mipp::Reg<T> const reg_log_threshold(log_threshold);
+    mipp::Reg<T> const reg_slope(slope);
+    mipp::Reg<T> const reg_zero(T{});
+
+    std::size_t i = 0;
+    for (; i < main_size; i += N)
+    {
+        mipp::Reg<T> reg;
+        reg.loadu(level.data() + i);
+        reg = mipp::log(mipp::max(reg, reg_min_level));
+        reg = mipp::min(reg_zero, (reg_log_threshold - reg) * reg_slope);
+        mipp::exp(reg).storeu(gain.data() + i);
+    }
+
+    for (; i < level.size(); ++i)
+    {
+        gain[i] = dsp::compute_gain(level[i], log_threshold, slope);
+    }
+}
+
+} // namespace simd
+
+//! Coefficient of a one-pole smoother, reaching 1 - 1/e of a step after
+//! the given number of samples. Zero samples make it follow immediately.
+template <std::floating_point T>
+[[nodiscard]]
+auto
+one_pole_coefficient(T const samples) noexcept -> T
+{
+    return samples > T{} ? std::exp(-T{1} / samples) : T{};
+}
+
+//! Smooths the computed gain, with separate time constants for gain
+//! reduction (attack) and recovery (release).
+template <std::floating_point T>
+class gain_ballistics
+{
+public:
+    void set_coefficients(T const attack, T const release) noexcept
+    {
+        m_attack = attack;
+        m_release = release;
+    }
+
+    auto operator()(T const target) noexcept -> T
+    {
+        T const coeff = target < m_gain ? m_attack : m_release;
+        m_gain = target + coeff * (m_gain - target);
+        return m_gain;
+    }
+
+    void process(std::span<T> const gain) noexcept
+    {
+        std::ranges::transform(gain, gain.begin(), std::ref(*this));
+    }
+
+private:
+    T m_attack{};
+    T m_release{};
+    T m_gain{1};
+};
+
+} // namespace piejam::audio::dsp
@@ -0,0 +1,238 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/functional/edge_detect.h>
+#include <piejam/npos.h>
+
+#include <mipp.h>
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <span>
+
+namespace piejam::audio::dsp
+{
+
+// Edge search for scope triggering. An edge at index i means, the signal
+// crosses the level between in[i] and in[i + 1].
+//
+// With a hysteresis > 0, the trigger is armed only after the signal was
+// beyond the level by at least the hysteresis, in opposite direction of the
+// edge. Noise around the level won't trigger then.
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+find_rising_edge(
+        std::span<T const> const in,
+        T const level,
+        T const hysteresis = T{}) -> std::size_t
+{
+    auto first = in.begin();
+    if (hysteresis > T{})
+    {
+        first = std::ranges::find_if(
+                in,
+                [arm_level = level - hysteresis](T x) {
+                    return x <= arm_level;
+                });
+    }
+
+    auto it = std::adjacent_find(
+            first,
+            in.end(),
+            std::bind_front(rising_edge, level));
+    return it == in.end() ? npos
+                          : static_cast<std::size_t>(it - in.begin());
+}
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+find_falling_edge(
+        std::span<T const> const in,
+        T const level,
+        T const hysteresis = T{}) -> std::size_t
+{
+    auto first = in.begin();
+    if (hysteresis > T{})
+    {
+        first = std::ranges::find_if(
+                in,
+                [arm_level = level + hysteresis](T x) {
+                    return x >= arm_level;
+                });
+    }
+
+    auto it = std::adjacent_find(
+            first,
+            in.end(),
+            std::bind_front(falling_edge, level));
+    return it == in.end() ? npos
+                          : static_cast<std::size_t>(it - in.begin());
+}
+
+namespace simd
+{
+
+namespace detail
+{
+
+// Compares N sample pairs at once, the exact position within a block with a
+// match is resolved by a scalar scan over that block.
+template <std::floating_point T, class RegPred, class Pred>
+[[nodiscard]]
+auto
+find_adjacent(
+        std::span<T const> const in,
+        std::size_t const first,
+        RegPred&& reg_pred,
+        Pred&& pred) -> std::size_t
+{
+    constexpr std::size_t N = mipp::N<T>();
+
+    if (in.size() < 2)
+    {
+        return npos;
+    }
+
+    std::size_t const num_pairs = in.size() - 1;
+    std::size_t i = first;
+
+    for (; i + N <= num_pairs; i += N)
+    {
+        mipp::Reg<T> reg_l;
+        mipp::Reg<T> reg_r;
+        reg_l.loadu(in.data() + i);
+        reg_r.loadu(in.data() + i + 1);
+
+        if (!mipp::testz(reg_pred(reg_l, reg_r)))
+        {
+            break;
+        }
+    }
+
+    for (; i < num_pairs; ++i)
+    {
+        if (pred(in[i], in[i + 1]))
+        {
+            return i;
+        }
+    }
+
+    return npos;
+}
+
+template <std::floating_point T, class RegPred, class Pred>
+[[nodiscard]]
+auto
+find_single(std::span<T const> const in, RegPred&& reg_pred, Pred&& pred)
+        -> std::size_t
+{
+    constexpr std::size_t N = mipp::N<T>();
+
+    std::size_t i = 0;
+
+    for (; i + N <= in.size(); i += N)
+    {
+        mipp::Reg<T> reg;
+        reg.loadu(in.data() + i);
+
+        if (!mipp::testz(reg_pred(reg)))
+        {
+            break;
+        }
+    }
+
+    for (; i < in.size(); ++i)
+    {
+        if (pred(in[i]))
+        {
+            return i;
+        }
+    }
+
+    return npos;
+}
+
+} // namespace detail
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+find_rising_edge(
+        std::span<T const> const in,
+        T const level,
+        T const hysteresis = T{}) -> std::size_t
+{
+    mipp::Reg<T> const reg_level(level);
+
+    std::size_t first = 0;
+    if (hysteresis > T{})
+    {
+        T const arm_level = level - hysteresis;
+        mipp::Reg<T> const reg_arm_level(arm_level);
+
+        first = detail::find_single(
+                in,
+                [&](mipp::Reg<T> x) { return x <= reg_arm_level; },
+                [=](T x) { return x <= arm_level; });
+
+        if (first == npos)
+        {
+            return npos;
+        }
+    }
+
+    return detail::find_adjacent(
+            in,
+            first,
+            [&](mipp::Reg<T> l, mipp::Reg<T> r) {
+                return (l <= reg_level) & (r > reg_level);
+            },
+            std::bind_front(rising_edge, level));
+}
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+find_falling_edge(
+        std::span<T const> const in,
+        T const level,
+        T const hysteresis = T{}) -> std::size_t
+{
+    mipp::Reg<T> const reg_level(level);
+
+    std::size_t first = 0;
+    if (hysteresis > T{})
+    {
+        T const arm_level = level + hysteresis;
+        mipp::Reg<T> const reg_arm_level(arm_level);
+
+        first = detail::find_single(
+                in,
+                [&](mipp::Reg<T> x) { return x >= reg_arm_level; },
+                [=](T x) { return x >= arm_level; });
+
+        if (first == npos)
+        {
+            return npos;
+        }
+    }
+
+    return detail::find_adjacent(
+            in,
+            first,
+            [&](mipp::Reg<T> l, mipp::Reg<T> r) {
+                return (l >= reg_level) & (r < reg_level);
+            },
+            std::bind_front(falling_edge, level));
+}
+
+} // namespace simd
+
+} // namespace piejam::audio::dsp
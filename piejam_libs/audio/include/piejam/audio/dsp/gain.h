@@ -0,0 +1,106 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <concepts>
+#include <functional>
+#include <span>
+
+namespace piejam::audio::dsp::simd
+{
+
+namespace detail
+{
+
+template <std::floating_point T, class BinaryOp>
+void
+combine_gain(
+        std::span<T const> const l,
+        std::span<T const> const r,
+        T const gain,
+        std::span<T> const out,
+        BinaryOp&& op)
+{
+    BOOST_ASSERT(l.size() == r.size());
+    BOOST_ASSERT(l.size() == out.size());
+
+    constexpr std::size_t N = mipp::N<T>();
+
+    std::size_t const main_size = (out.size() / N) * N;
+    mipp::Reg<T> const reg_gain(gain);
+
+    std::size_t i = 0;
+    for (; i < main_size; i += N)
+    {
+        mipp::Reg<T> reg_l;
+        mipp::Reg<T> reg_r;
+        reg_l.loadu(l.data() + i);
+        reg_r.loadu(r.data() + i);
+        (op(reg_l, reg_r) * reg_gain).storeu(out.data() + i);
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = op(l[i], r[i]) * gain;
+    }
+}
+
+} // namespace detail
+
+//! out = in * gain, input and output don't need to be aligned.
+template <std::floating_point T>
+void
+apply_gain(std::span<T const> const in, T const gain, std::span<T> const out)
+{
+    BOOST_ASSERT(in.size() == out.size());
+
+    constexpr std::size_t N = mipp::N<T>();
+
+    std::size_t const main_size = (out.size() / N) * N;
+    mipp::Reg<T> const reg_gain(gain);
+
+    std::size_t i = 0;
+    for (; i < main_size; i += N)
+    {
+        mipp::Reg<T> reg;
+        reg.loadu(in.data() + i);
+        (reg * reg_gain).storeu(out.data() + i);
+    }
+
+    for (; i < out.size(); ++i)
+    {
+        out[i] = in[i] * gain;
+    }
+}
+
+//! out = (l + r) * gain
+template <std::floating_point T>
+void
+sum_gain(
+        std::span<T const> const l,
+        std::span<T const> const r,
+        T const gain,
+        std::span<T> const out)
+{
+    detail::combine_gain(l, r, gain, out, std::plus<>{});
+}
+
+//! out = (l - r) * gain
+template <std::floating_point T>
+void
+difference_gain(
+        std::span<T const> const l,
+        std::span<T const> const r,
+        T const gain,
+        std::span<T> const out)
+{
+    detail::combine_gain(l, r, gain, out, std::minus<>{});
+}
+
+} // namespace piejam::audio::dsp::simd
@@ -0,0 +1,415 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/dsp/kaiser_window.h>
+#include <piejam/audio/dsp/mirrored_history.h>
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// Polyphase half-band lowpass filters, for changing the sample rate by two.
+//
+// The fir_ variants are linear phase, the prototype is a kaiser windowed
+// sinc. Every other tap of a half-band filter is zero, so one polyphase
+// branch is a pure delay and only the other one needs to be convolved.
+//
+// The iir_ variants are made of two parallel chains of first order allpass
+// sections, each running at the low rate. They need a fraction of the
+// operations and have a much lower latency, but the phase isn't linear.
+// The coefficients are designed as in HIIR by Laurent de Soras.
+
+namespace piejam::audio::dsp
+{
+
+namespace detail
+{
+
+[[nodiscard]]
+inline auto
+dot(std::span<float const> const a, std::span<float const> const b) noexcept
+        -> float
+{
+    BOOST_ASSERT(a.size() == b.size());
+
+    constexpr std::size_t N = mipp::N<float>();
+
+    std::size_t const main_size = (a.size() / N) * N;
+
+    mipp::Reg<float> acc(0.f);
+    std::size_t i = 0;
+    for (; i < main_size; i += N)
+    {
+        mipp::Reg<float> ra, rb;
+        ra.loadu(a.data() + i);
+        rb.loadu(b.data() + i);
+        acc = mipp::fmadd(ra, rb, acc);
+    }
+
+    float sum = mipp::sum(acc);
+    for (; i < a.size(); ++i)
+    {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+//! Group delay at DC of a first order allpass in z^-2, in samples.
+[[nodiscard]]
+constexpr auto
+allpass_group_delay(float const c) noexcept -> float
+{
+    return 2.f * (1.f - c) / (1.f + c);
+}
+
+//! Runs one sample through each of the two allpass chains. The even
+//! coefficients belong to the first chain, the odd ones to the second.
+inline void
+process_allpass_chains(
+        std::span<float const> const coefficients,
+        std::span<float> const x1,
+        std::span<float> const y1,
+        float& path0,
+        float& path1) noexcept
+{
+    for (std::size_t k = 0; k < coefficients.size(); ++k)
+    {
+        float& s = k % 2 == 0 ? path0 : path1;
+        float const y = (s - y1[k]) * coefficients[k] + x1[k];
+        x1[k] = s;
+        y1[k] = y;
+        s = y;
+    }
+}
+
+} // namespace detail
+
+//! Taps of the polyphase branch of a linear phase half-band lowpass, which
+//! isn't a pure delay. The prototype has 2 * num_taps - 1 taps, num_taps
+//! must be even. The taps sum up to 0.5, the other branch is a single tap
+//! of 0.5.
+[[nodiscard]]
+inline auto
+make_fir_halfband_taps(std::size_t const num_taps, double const kaiser_beta)
+        -> std::vector<float>
+{
+    BOOST_ASSERT(num_taps > 0 && num_taps % 2 == 0);
+
+    double const center = static_cast<double>(num_taps - 1);
+
+    std::vector<double> taps(num_taps);
+    for (std::size_t j = 0; j < num_taps; ++j)
+    {
+        double const d = static_cast<double>(2 * j) - center;
+        taps[j] = std::sin(std::numbers::pi * d / 2.) /
+                  (std::numbers::pi * d) *
+                  kaiser_window(d / center, kaiser_beta);
+    }
+
+    double const sum = std::accumulate(taps.begin(), taps.end(), 0.);
+
+    std::vector<float> result(num_taps);
+    std::ranges::transform(taps, result.begin(), [sum](double const t) {
+        return static_cast<float>(0.5 * t / sum);
+    });
+    return result;
+}
+
+//! Allpass coefficients of an elliptic polyphase IIR half-band lowpass.
+//! transition is the width of the transition band, relative to the high
+//! sample rate, (0, 0.5). More coefficients yield a higher stopband
+//! attenuation for the same transition.
+[[nodiscard]]
+inline auto
+make_iir_halfband_coefficients(
+        std::size_t const num_coefficients,
+        double const transition) -> std::vector<float>
+{
+    BOOST_ASSERT(num_coefficients > 0);
+    BOOST_ASSERT(transition > 0. && transition < 0.5);
+
+    using std::numbers::pi;
+
+    double k = std::tan((1. - transition * 2.) * pi / 4.);
+    k *= k;
+    double const kksqrt = std::pow(1. - k * k, 0.25);
+    double const e = 0.5 * (1. - kksqrt) / (1. + kksqrt);
+    double const e2 = e * e;
+    double const e4 = e2 * e2;
+    double const q = e * (1. + e4 * (2. + e4 * (15. + 150. * e4)));
+
+    double const order = static_cast<double>(num_coefficients * 2 + 1);
+
+    std::vector<float> result(num_coefficients);
+    for (std::size_t index = 0; index < num_coefficients; ++index)
+    {
+        double const c = static_cast<double>(index + 1);
+
+        double num{};
+        for (int i = 0, sign = 1;; ++i, sign = -sign)
+        {
+            double const t = std::pow(q, i * (i + 1)) *
+                             std::sin((i * 2 + 1) * c * pi / order) * sign;
+            num += t;
+            if (std::abs(t) <= 1e-100)
+            {
+                break;
+            }
+        }
+        num *= std::pow(q, 0.25);
+
+        double den{};
+        for (int i = 1, sign = -1;; ++i, sign = -sign)
+        {
+            double const t = std::pow(q, i * i) *
+                             std::cos(i * 2 * c * pi / order) * sign;
+            den += t;
+            if (std::abs(t) <= 1e-100)
+            {
+                break;
+            }
+        }
+        den += 0.5;
+
+        double const ww = num / den;
+        double const wwsq = ww * ww;
+        double const x =
+                std::sqrt((1. - wwsq * k) * (1. - wwsq / k)) / (1. + wwsq);
+        result[index] = static_cast<float>((1. - x) / (1. + x));
+    }
+
+    return result;
+}
+
+//! Doubles the sample rate, the taps are from make_fir_halfband_taps.
+class fir_halfband_upsampler
+{
+public:
+    explicit fir_halfband_upsampler(std::span<float const> const taps)
+        : m_taps(taps.size())
+        , m_history(taps.size())
+    {
+        // the gain of two makes up for the zeros stuffed in between
+        std::ranges::transform(taps, m_taps.begin(), [](float const t) {
+            return 2.f * t;
+        });
+    }
+
+    //! In samples of the high rate.
+    [[nodiscard]]
+    auto latency() const noexcept -> float
+    {
+        return static_cast<float>(m_taps.size() - 1);
+    }
+
+    void process(
+            std::span<float const> const in,
+            std::span<float> const out) noexcept
+    {
+        BOOST_ASSERT(out.size() == 2 * in.size());
+
+        // the taps are symmetric, no need to reverse them
+        std::size_t const center = m_taps.size() / 2;
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            m_history.push(in[i]);
+            auto const window = m_history.window();
+            out[2 * i] = detail::dot(m_taps, window);
+            out[2 * i + 1] = window[center];
+        }
+    }
+
+    void clear() noexcept
+    {
+        m_history.clear();
+    }
+
+private:
+    std::vector<float> m_taps;
+    mirrored_history m_history;
+};
+
+//! Halves the sample rate, the taps are from make_fir_halfband_taps.
+class fir_halfband_downsampler
+{
+public:
+    explicit fir_halfband_downsampler(std::span<float const> const taps)
+        : m_taps(taps.begin(), taps.end())
+        , m_even(taps.size())
+        , m_odd(taps.size())
+    {
+    }
+
+    //! In samples of the high rate.
+    [[nodiscard]]
+    auto latency() const noexcept -> float
+    {
+        return static_cast<float>(m_taps.size() - 1);
+    }
+
+    void process(
+            std::span<float const> const in,
+            std::span<float> const out) noexcept
+    {
+        BOOST_ASSERT(in.size() == 2 * out.size());
+
+        // the even samples are kept, the odd ones only pass the center tap
+        std::size_t const center = m_taps.size() / 2 - 1;
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            m_even.push(in[2 * i]);
+            m_odd.push(in[2 * i + 1]);
+            out[i] = detail::dot(m_taps, m_even.window()) +
+                     0.5f * m_odd.window()[center];
+        }
+    }
+
+    void clear() noexcept
+    {
+        m_even.clear();
+        m_odd.clear();
+    }
+
+private:
+    std::vector<float> m_taps;
+    mirrored_history m_even;
+    mirrored_history m_odd;
+};
+
+//! Doubles the sample rate, the coefficients are from
+//! make_iir_halfband_coefficients.
+class iir_halfband_upsampler
+{
+public:
+    explicit iir_halfband_upsampler(std::span<float const> const coefficients)
+        : m_coefficients(coefficients.begin(), coefficients.end())
+        , m_x1(coefficients.size())
+        , m_y1(coefficients.size())
+    {
+    }
+
+    //! Group delay at DC, in samples of the high rate.
+    [[nodiscard]]
+    auto latency() const noexcept -> float
+    {
+        // the second chain lags by one sample, and both are averaged
+        return (std::transform_reduce(
+                        m_coefficients.begin(),
+                        m_coefficients.end(),
+                        0.f,
+                        std::plus<>{},
+                        &detail::allpass_group_delay) +
+                1.f) /
+               2.f;
+    }
+
+    void process(
+            std::span<float const> const in,
+            std::span<float> const out) noexcept
+    {
+        BOOST_ASSERT(out.size() == 2 * in.size());
+
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+            float path0 = in[i];
+            float path1 = in[i];
+            detail::process_allpass_chains(
+                    m_coefficients,
+                    m_x1,
+                    m_y1,
+                    path0,
+                    path1);
+            out[2 * i] = path0;
+            out[2 * i + 1] = path1;
+        }
+    }
+
+    void clear() noexcept
+    {
+        std::ranges::fill(m_x1, 0.f);
+        std::ranges::fill(m_y1, 0.f);
+    }
+
+private:
+    std::vector<float> m_coefficients;
+    std::vector<float> m_x1;
+    std::vector<float> m_y1;
+};
+
+//! Halves the sample rate, the coefficients are from
+//! make_iir_halfband_coefficients.
+class iir_halfband_downsampler
+{
+public:
+    explicit iir_halfband_downsampler(
+            std::span<float const> const coefficients)
+        : m_coefficients(coefficients.begin(), coefficients.end())
+        , m_x1(coefficients.size())
+        , m_y1(coefficients.size())
+    {
+    }
+
+    //! Group delay at DC, in samples of the high rate.
+    [[nodiscard]]
+    auto latency() const noexcept -> float
+    {
+        return (std::transform_reduce(
+                        m_coefficients.begin(),
+                        m_coefficients.end(),
+                        0.f,
+                        std::plus<>{},
+                        &detail::allpass_group_delay) +
+                1.f) /
+               2.f;
+    }
+
+    void process(
+            std::span<float const> const in,
+            std::span<float> const out) noexcept
+    {
+        BOOST_ASSERT(in.size() == 2 * out.size());
+
+        for (std::size_t i = 0; i < out.size(); ++i)
+        {
+            // the even samples are kept, the odd one before goes through
+            // the second chain
+            float path0 = in[2 * i];
+            float path1 = m_odd;
+            m_odd = in[2 * i + 1];
+            detail::process_allpass_chains(
+                    m_coefficients,
+                    m_x1,
+                    m_y1,
+                    path0,
+                    path1);
+            out[i] = 0.5f * (path0 + path1);
+        }
+    }
+
+    void clear() noexcept
+    {
+        std::ranges::fill(m_x1, 0.f);
+        std::ranges::fill(m_y1, 0.f);
+        m_odd = 0.f;
+    }
+
+private:
+    std::vector<float> m_coefficients;
+    std::vector<float> m_x1;
+    std::vector<float> m_y1;
+    float m_odd{};
+};
+
+} // namespace piejam::audio::dsp
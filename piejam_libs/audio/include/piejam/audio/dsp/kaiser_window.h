@@ -0,0 +1,40 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <boost/assert.hpp>
+
+#include <cmath>
+
+namespace piejam::audio::dsp
+{
+
+//! Zeroth order modified bessel function of the first kind.
+[[nodiscard]]
+inline auto
+bessel_i0(double const x) noexcept -> double
+{
+    double sum = 1.;
+    double term = 1.;
+    for (int k = 1; term > 1e-12 * sum; ++k)
+    {
+        double const f = x / (2. * k);
+        term *= f * f;
+        sum += term;
+    }
+    return sum;
+}
+
+//! Kaiser window at x, [-1, 1]. A higher beta yields a higher stopband
+//! attenuation, at the cost of a wider transition band.
+[[nodiscard]]
+inline auto
+kaiser_window(double const x, double const beta) noexcept -> double
+{
+    BOOST_ASSERT(x >= -1. && x <= 1.);
+    return bessel_i0(beta * std::sqrt(1. - x * x)) / bessel_i0(beta);
+}
+
+} // namespace piejam::audio::dsp
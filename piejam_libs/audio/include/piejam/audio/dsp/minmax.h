@@ -0,0 +1,77 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <utility>
+
+namespace piejam::audio::dsp
+{
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+minmax(std::span<T const> const in) -> std::pair<T, T>
+{
+    BOOST_ASSERT(!in.empty());
+    auto const [min, max] = std::ranges::minmax_element(in);
+    return {*min, *max};
+}
+
+namespace simd
+{
+
+// Doesn't require the input to be aligned, the streams handed to the gui are
+// usually sub-views into a bigger buffer.
+template <std::floating_point T>
+[[nodiscard]]
+auto
+minmax(std::span<T const> const in) -> std::pair<T, T>
+{
+    BOOST_ASSERT(!in.empty());
+
+    constexpr std::size_t N = mipp::N<T>();
+
+    if (in.size() < N)
+    {
+        return dsp::minmax(in);
+    }
+
+    T const* it = in.data();
+    T const* const main_end = it + (in.size() / N) * N;
+
+    mipp::Reg<T> reg_min;
+    reg_min.loadu(it);
+    mipp::Reg<T> reg_max = reg_min;
+
+    for (it += N; it != main_end; it += N)
+    {
+        mipp::Reg<T> reg;
+        reg.loadu(it);
+        reg_min = mipp::min(reg_min, reg);
+        reg_max = mipp::max(reg_max, reg);
+    }
+
+    T min = mipp::hmin(reg_min);
+    T max = mipp::hmax(reg_max);
+
+    for (; it != in.data() + in.size(); ++it)
+    {
+        min = std::min(min, *it);
+        max = std::max(max, *it);
+    }
+
+    return {min, max};
+}
+
+} // namespace simd
+
+} // namespace piejam::audio::dsp
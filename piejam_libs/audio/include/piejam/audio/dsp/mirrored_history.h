@@ -0,0 +1,57 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+//! Ring buffer of the last size() samples, which are kept contiguous in
+//! memory by writing every sample twice. Meant for FIR filters, which
+//! convolve the whole history for each sample.
+class mirrored_history
+{
+public:
+    explicit mirrored_history(std::size_t const size)
+        : m_samples(2 * size)
+        , m_size(size)
+    {
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_size;
+    }
+
+    void push(float const x) noexcept
+    {
+        m_samples[m_pos] = x;
+        m_samples[m_pos + m_size] = x;
+        m_pos = m_pos + 1 == m_size ? 0 : m_pos + 1;
+    }
+
+    //! The last size() samples, the oldest first.
+    [[nodiscard]]
+    auto window() const noexcept -> std::span<float const>
+    {
+        return std::span{m_samples}.subspan(m_pos, m_size);
+    }
+
+    void clear() noexcept
+    {
+        std::ranges::fill(m_samples, 0.f);
+    }
+
+private:
+    std::vector<float> m_samples;
+    std::size_t m_size;
+    std::size_t m_pos{};
+};
+
+} // namespace piejam::audio::dsp
@@ -0,0 +1,312 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/numeric/dft.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+namespace detail
+{
+
+// Spelled out, std::complex multiplication takes care of inf/nan, which
+// keeps the loop from being vectorized.
+inline void
+complex_multiply_add(
+        std::span<std::complex<float> const> const x,
+        std::span<std::complex<float> const> const h,
+        std::span<std::complex<float>> const acc) noexcept
+{
+    BOOST_ASSERT(x.size() == h.size());
+    BOOST_ASSERT(x.size() == acc.size());
+
+    for (std::size_t i = 0; i < acc.size(); ++i)
+    {
+        float const xr = x[i].real();
+        float const xi = x[i].imag();
+        float const hr = h[i].real();
+        float const hi = h[i].imag();
+
+        acc[i] = {
+                acc[i].real() + xr * hr - xi * hi,
+                acc[i].imag() + xr * hi + xi * hr};
+    }
+}
+
+} // namespace detail
+
+// Impulse response, split into partitions of the block size and
+// transformed into the frequency domain. Transforming a long impulse
+// response takes a while, it's meant to be done off the audio thread.
+//
+// The dft has to be twice the block size. It's passed in, since creating
+// a dft plans the transform, which must not happen concurrently.
+class convolution_kernel
+{
+public:
+    convolution_kernel(std::span<float const> const ir, numeric::dft& dft)
+        : m_block_size(dft.size() / 2)
+        , m_num_bins(dft.output_size())
+        , m_num_partitions((ir.size() + m_block_size - 1) / m_block_size)
+        , m_spectra(m_num_partitions * m_num_bins)
+    {
+        BOOST_ASSERT(dft.size() % 2 == 0);
+
+        // The inverse transform isn't normalized, the kernel is scaled
+        // instead, once.
+        float const scale = 1.f / static_cast<float>(dft.size());
+
+        auto const dft_in = dft.input_buffer();
+        for (std::size_t p = 0; p < m_num_partitions; ++p)
+        {
+            auto const partition = ir.subspan(
+                    p * m_block_size,
+                    std::min(m_block_size, ir.size() - p * m_block_size));
+
+            std::fill(
+                    std::ranges::copy(partition, dft_in.begin()).out,
+                    dft_in.end(),
+                    0.f);
+
+            std::ranges::transform(
+                    dft.process(),
+                    std::next(m_spectra.begin(), p * m_num_bins),
+                    [scale](std::complex<float> const x) {
+                        return x * scale;
+                    });
+        }
+    }
+
+    [[nodiscard]]
+    auto block_size() const noexcept -> std::size_t
+    {
+        return m_block_size;
+    }
+
+    [[nodiscard]]
+    auto num_partitions() const noexcept -> std::size_t
+    {
+        return m_num_partitions;
+    }
+
+    [[nodiscard]]
+    auto partition(std::size_t const p) const noexcept
+            -> std::span<std::complex<float> const>
+    {
+        BOOST_ASSERT(p < m_num_partitions);
+        return std::span{m_spectra}.subspan(p * m_num_bins, m_num_bins);
+    }
+
+private:
+    std::size_t m_block_size;
+    std::size_t m_num_bins;
+    std::size_t m_num_partitions;
+    std::vector<std::complex<float>> m_spectra;
+};
+
+// Uniformly partitioned overlap-save convolution, with a frequency-domain
+// delay line. The input is processed in blocks of the kernel block size,
+// which is also the latency. Each block takes one forward and one inverse
+// transform of twice the block size, independent of the kernel length, and
+// a complex multiply-add per bin and kernel partition.
+//
+// Only the first partition needs the spectrum of the current block. The
+// other partitions are applied to spectra of previous blocks, so their
+// multiply-adds are spread over the frames of the block while it's being
+// filled. With periods shorter than the block size, no single period pays
+// for the whole kernel.
+class partitioned_convolver
+{
+public:
+    partitioned_convolver(
+            std::size_t const block_size,
+            std::size_t const max_partitions)
+        : m_block_size(block_size)
+        , m_dft(2 * block_size)
+        , m_idft(2 * block_size)
+        , m_fdl(max_partitions * m_dft.output_size())
+        , m_spectrum(m_dft.output_size())
+        , m_tail(m_dft.output_size())
+        , m_input(2 * block_size)
+        , m_output(block_size)
+    {
+        BOOST_ASSERT(block_size > 0);
+        BOOST_ASSERT(max_partitions > 0);
+    }
+
+    [[nodiscard]]
+    auto block_size() const noexcept -> std::size_t
+    {
+        return m_block_size;
+    }
+
+    //! The kernel must stay alive while it is set, nullptr silences the
+    //! output. Partitions beyond max_partitions are ignored. The input
+    //! history is kept, so kernels can be switched seamlessly.
+    void set_kernel(convolution_kernel const* const kernel) noexcept
+    {
+        BOOST_ASSERT(!kernel || kernel->block_size() == m_block_size);
+        m_kernel = kernel;
+        restart_tail();
+    }
+
+    void reset() noexcept
+    {
+        std::ranges::fill(m_fdl, std::complex<float>{});
+        std::ranges::fill(m_input, 0.f);
+        std::ranges::fill(m_output, 0.f);
+        m_fdl_pos = 0;
+        m_fill = 0;
+        restart_tail();
+    }
+
+    //! Any number of frames, the output lags behind by block_size.
+    void process(std::span<float const> in, std::span<float> out) noexcept
+    {
+        BOOST_ASSERT(in.size() == out.size());
+
+        while (!in.empty())
+        {
+            std::size_t const n = std::min(in.size(), m_block_size - m_fill);
+
+            std::ranges::copy(
+                    in.first(n),
+                    std::next(m_input.begin(), m_block_size + m_fill));
+            std::copy_n(
+                    std::next(m_output.begin(), m_fill),
+                    n,
+                    out.begin());
+
+            in = in.subspan(n);
+            out = out.subspan(n);
+            m_fill += n;
+
+            // in step with the fill, the rest is done with the block
+            advance_tail(num_tail_partitions() * m_fill / m_block_size);
+
+            if (m_fill == m_block_size)
+            {
+                process_block();
+                m_fill = 0;
+            }
+        }
+    }
+
+private:
+    [[nodiscard]]
+    auto max_partitions() const noexcept -> std::size_t
+    {
+        return m_fdl.size() / m_spectrum.size();
+    }
+
+    [[nodiscard]]
+    auto num_tail_partitions() const noexcept -> std::size_t
+    {
+        if (!m_kernel)
+        {
+            return 0;
+        }
+
+        std::size_t const num_partitions =
+                std::min(m_kernel->num_partitions(), max_partitions());
+        return num_partitions > 1 ? num_partitions - 1 : 0;
+    }
+
+    void restart_tail() noexcept
+    {
+        std::ranges::fill(m_tail, std::complex<float>{});
+        m_tail_done = 0;
+    }
+
+    // Partition p is applied to the spectrum from p blocks ago. Partitions
+    // 1 and up of the next block are applied to spectra which are already
+    // in the delay line, the latest one at m_fdl_pos - 1.
+    void advance_tail(std::size_t const num_partitions) noexcept
+    {
+        std::size_t const num_bins = m_spectrum.size();
+        std::size_t const max_partitions = this->max_partitions();
+
+        for (; m_tail_done < num_partitions; ++m_tail_done)
+        {
+            std::size_t const p = m_tail_done + 1;
+            std::size_t const pos =
+                    (m_fdl_pos + max_partitions - p) % max_partitions;
+
+            detail::complex_multiply_add(
+                    std::span{m_fdl}.subspan(pos * num_bins, num_bins),
+                    m_kernel->partition(p),
+                    m_tail);
+        }
+    }
+
+    void process_block() noexcept
+    {
+        std::size_t const num_bins = m_spectrum.size();
+        std::size_t const max_partitions = this->max_partitions();
+
+        // spectrum of the previous and the current block
+        std::ranges::copy(m_input, m_dft.input_buffer().begin());
+        std::ranges::copy(
+                m_dft.process(),
+                std::next(m_fdl.begin(), m_fdl_pos * num_bins));
+
+        std::copy_n(
+                std::next(m_input.begin(), m_block_size),
+                m_block_size,
+                m_input.begin());
+
+        if (m_kernel && m_kernel->num_partitions() > 0)
+        {
+            std::ranges::copy(m_tail, m_spectrum.begin());
+            detail::complex_multiply_add(
+                    std::span{m_fdl}.subspan(m_fdl_pos * num_bins, num_bins),
+                    m_kernel->partition(0),
+                    m_spectrum);
+
+            // the first half is circular aliasing, the second half is valid
+            std::ranges::copy(m_spectrum, m_idft.input_buffer().begin());
+            std::ranges::copy(
+                    m_idft.process().subspan(m_block_size),
+                    m_output.begin());
+        }
+        else
+        {
+            std::ranges::fill(m_output, 0.f);
+        }
+
+        m_fdl_pos = (m_fdl_pos + 1) % max_partitions;
+        restart_tail();
+    }
+
+    std::size_t m_block_size;
+    numeric::dft m_dft;
+    numeric::idft m_idft;
+
+    // ring of input spectra, the latest at m_fdl_pos
+    std::vector<std::complex<float>> m_fdl;
+    std::size_t m_fdl_pos{};
+
+    std::vector<std::complex<float>> m_spectrum;
+
+    // partitions 1 and up of the next block, m_tail_done of them so far
+    std::vector<std::complex<float>> m_tail;
+    std::size_t m_tail_done{};
+
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+    std::size_t m_fill{};
+
+    convolution_kernel const* m_kernel{};
+};
+
+} // namespace piejam::audio::dsp
@@ -75,23 +75,23 @@ sqr_difference_sum(
     }
 }
 
-} // namespace detail
-
-template <std::floating_point T>
+template <std::floating_point T, class DifferenceSum>
 [[nodiscard]]
 auto
-pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
+yin_search(
+        std::size_t const e,
+        sample_rate const sr,
+        DifferenceSum&& difference_sum) -> T
 {
     constexpr T threshold{0.1f};
 
-    std::size_t const e = in.size() / 2;
     T a = T{1};
     T b = T{1};
     T c{};
     T cumulative_sum{};
     for (std::size_t tau = 1; tau < e; ++tau)
     {
-        T const sum = detail::sqr_difference_sum(in, e, tau);
+        T const sum = difference_sum(tau);
 
         cumulative_sum += sum;
         c = tau * sum / cumulative_sum;
@@ -111,4 +111,17 @@ pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
     return T{};
 }
 
+} // namespace detail
+
+template <std::floating_point T>
+[[nodiscard]]
+auto
+pitch_yin(std::span<T const> const in, sample_rate const sr) -> T
+{
+    std::size_t const e = in.size() / 2;
+    return detail::yin_search<T>(e, sr, [in, e](std::size_t const tau) {
+        return detail::sqr_difference_sum(in, e, tau);
+    });
+}
+
 } // namespace piejam::audio::dsp
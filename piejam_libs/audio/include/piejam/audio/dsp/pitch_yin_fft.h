@@ -0,0 +1,166 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/dsp/pitch_yin.h>
+#include <piejam/audio/sample_rate.h>
+
+#include <piejam/numeric/dft.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+// Same estimate as pitch_yin, but the difference function is derived from
+// the autocorrelation, which is computed in the frequency domain:
+//
+//   d(tau) = E(0) + E(tau) - 2 * r(tau)
+//
+// The energy terms E come out of a single running sum over the window,
+// so an estimate costs O(N log N) instead of O(N^2).
+//
+// With a decimation > 1, a pre-pass runs on the decimated window first. If
+// it detects a pitch below low_frequency_limit, it's taken as is. Low
+// strings still have plenty of samples per period after decimation, and
+// the full resolution pass is skipped.
+class pitch_yin_fft
+{
+public:
+    explicit pitch_yin_fft(
+            std::size_t window_size,
+            std::size_t decimation = 1,
+            float low_frequency_limit = 100.f)
+        : m_dft(window_size)
+        , m_idft(window_size)
+        , m_spectrum(m_dft.output_size())
+        , m_energy(window_size + 1)
+        , m_low_frequency_limit(low_frequency_limit)
+    {
+        BOOST_ASSERT(window_size % 2 == 0);
+        BOOST_ASSERT(decimation > 0);
+        BOOST_ASSERT(window_size % decimation == 0);
+
+        if (decimation > 1)
+        {
+            m_decimated.resize(window_size / decimation);
+            m_pre_pass = std::make_unique<pitch_yin_fft>(m_decimated.size());
+        }
+    }
+
+    [[nodiscard]]
+    auto window_size() const noexcept -> std::size_t
+    {
+        return m_dft.size();
+    }
+
+    [[nodiscard]]
+    auto operator()(std::span<float const> const in, sample_rate const sr)
+            -> float
+    {
+        BOOST_ASSERT(in.size() == window_size());
+
+        if (m_pre_pass)
+        {
+            if (float const f = pre_pass(in, sr);
+                f > 0.f && f < m_low_frequency_limit)
+            {
+                return f;
+            }
+        }
+
+        return estimate(in, sr);
+    }
+
+private:
+    auto pre_pass(std::span<float const> const in, sample_rate const sr)
+            -> float
+    {
+        std::size_t const decimation = in.size() / m_decimated.size();
+        float const scale = 1.f / static_cast<float>(decimation);
+
+        // boxcar averaging, good enough as anti-aliasing filter for the
+        // frequency range we are interested in here
+        for (std::size_t i = 0; i < m_decimated.size(); ++i)
+        {
+            auto const block = in.subspan(i * decimation, decimation);
+            m_decimated[i] =
+                    std::accumulate(block.begin(), block.end(), 0.f) * scale;
+        }
+
+        // the pre-pass estimates relative to the decimated rate
+        return (*m_pre_pass)(m_decimated, sr) * scale;
+    }
+
+    auto estimate(std::span<float const> const in, sample_rate const sr)
+            -> float
+    {
+        std::size_t const size = in.size();
+        std::size_t const e = size / 2;
+
+        // spectrum of the integration window, zero padded
+        auto const dft_in = m_dft.input_buffer();
+        std::copy_n(in.begin(), e, dft_in.begin());
+        std::fill(dft_in.begin() + e, dft_in.end(), 0.f);
+        std::ranges::copy(m_dft.process(), m_spectrum.begin());
+
+        // spectrum of the whole window
+        std::ranges::copy(in, dft_in.begin());
+        auto const window_spectrum = m_dft.process();
+
+        // r(tau) = sum_j x[j] * x[j + tau], j < e. Since j + tau < size,
+        // the circular correlation doesn't wrap around.
+        std::ranges::transform(
+                m_spectrum,
+                window_spectrum,
+                m_idft.input_buffer().begin(),
+                [](std::complex<float> const l, std::complex<float> const r) {
+                    return std::conj(l) * r;
+                });
+        auto const r = m_idft.process();
+        float const r_scale = 1.f / static_cast<float>(size);
+
+        // running sum of squares, in double to not lose the small terms
+        m_energy[0] = 0.;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_energy[i + 1] = m_energy[i] + static_cast<double>(in[i]) * in[i];
+        }
+
+        auto const energy = [this, e](std::size_t const tau) {
+            return static_cast<float>(m_energy[tau + e] - m_energy[tau]);
+        };
+
+        float const energy_0 = energy(0);
+
+        return detail::yin_search<float>(
+                e,
+                sr,
+                [&](std::size_t const tau) {
+                    return std::max(
+                            energy_0 + energy(tau) -
+                                    2.f * r[tau] * r_scale,
+                            0.f);
+                });
+    }
+
+    numeric::dft m_dft;
+    numeric::idft m_idft;
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<double> m_energy;
+
+    float m_low_frequency_limit;
+    std::vector<float> m_decimated;
+    std::unique_ptr<pitch_yin_fft> m_pre_pass;
+};
+
+} // namespace piejam::audio::dsp
@@ -0,0 +1,252 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/dsp/kaiser_window.h>
+#include <piejam/audio/dsp/mirrored_history.h>
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp
+{
+
+//! Sample rate converter for arbitrary, also changing, ratios.
+//!
+//! Each output sample is the input convolved with a kaiser windowed sinc,
+//! centered at the fractional input position of the output sample. The
+//! sinc is tabulated for num_phases positions between two input samples,
+//! positions in between are interpolated linearly from the two closest
+//! phases.
+//!
+//! The cutoff is derived from the nominal ratio, set_ratio is meant for
+//! small adjustments, e.g. to follow the drift between two clocks.
+class resampler
+{
+public:
+    static constexpr std::size_t default_zero_crossings = 32;
+    static constexpr std::size_t default_num_phases = 256;
+    static constexpr double default_kaiser_beta = 8.6;
+
+    //! ratio is the output rate divided by the input rate. The filter has
+    //! 2 * zero_crossings taps.
+    explicit resampler(
+            double const ratio,
+            std::size_t const zero_crossings = default_zero_crossings,
+            std::size_t const num_phases = default_num_phases,
+            double const kaiser_beta = default_kaiser_beta)
+        : m_num_taps(2 * zero_crossings)
+        , m_num_phases(num_phases)
+        , m_table((num_phases + 1) * m_num_taps)
+        , m_history(m_num_taps)
+        , m_ratio(ratio)
+        , m_step(1. / ratio)
+    {
+        BOOST_ASSERT(ratio > 0.);
+        BOOST_ASSERT(zero_crossings > 0);
+        BOOST_ASSERT(num_phases > 0);
+
+        // The transition band of a kaiser windowed sinc, relative to the
+        // sample rate. It is put below the nyquist frequency of the lower
+        // rate, so nothing aliases.
+        double const attenuation = kaiser_beta / 0.1102 + 8.7;
+        double const transition =
+                (attenuation - 8.) /
+                (2.285 * 2. * std::numbers::pi *
+                 static_cast<double>(m_num_taps));
+        double const cutoff = std::min(1., ratio) * (0.5 - transition / 2.);
+
+        auto const zc = static_cast<double>(zero_crossings);
+        for (std::size_t p = 0; p <= num_phases; ++p)
+        {
+            auto const row = phase(p);
+            double const frac =
+                    static_cast<double>(p) / static_cast<double>(num_phases);
+
+            std::vector<double> taps(m_num_taps);
+            for (std::size_t j = 0; j < m_num_taps; ++j)
+            {
+                // distance of tap j from the position of the output
+                double const d = frac + zc - 1. - static_cast<double>(j);
+                double const x = 2. * cutoff * d;
+                double const sinc =
+                        x == 0. ? 1.
+                                : std::sin(std::numbers::pi * x) /
+                                          (std::numbers::pi * x);
+                taps[j] = std::abs(d) < zc ? 2. * cutoff * sinc *
+                                                     kaiser_window(
+                                                             d / zc,
+                                                             kaiser_beta)
+                                           : 0.;
+            }
+
+            // unity gain at DC for every phase
+            double const sum = std::accumulate(taps.begin(), taps.end(), 0.);
+            std::ranges::transform(taps, row.begin(), [sum](double const t) {
+                return static_cast<float>(t / sum);
+            });
+        }
+    }
+
+    //! Output rate divided by input rate.
+    [[nodiscard]]
+    auto ratio() const noexcept -> double
+    {
+        return m_ratio;
+    }
+
+    //! Takes effect from the next output sample on. The cutoff isn't
+    //! adjusted, so the ratio should stay close to the nominal one.
+    void set_ratio(double const ratio) noexcept
+    {
+        BOOST_ASSERT(ratio > 0.);
+        m_ratio = ratio;
+        m_step = 1. / ratio;
+    }
+
+    //! In input frames. The first output frame is aligned to the first
+    //! input frame, but needs latency() more input frames to be computed.
+    [[nodiscard]]
+    auto latency() const noexcept -> std::size_t
+    {
+        return m_num_taps / 2;
+    }
+
+    //! Upper bound of the output frames for num_input frames at the
+    //! current ratio.
+    [[nodiscard]]
+    auto max_output_size(std::size_t const num_input) const noexcept
+            -> std::size_t
+    {
+        return static_cast<std::size_t>(
+                       std::ceil(static_cast<double>(num_input) * m_ratio)) +
+               1;
+    }
+
+    //! Consumes all of in, returns the number of frames written to out.
+    //! out needs room for max_output_size(in.size()) frames.
+    auto process(std::span<float const> const in, std::span<float> const out)
+            -> std::size_t
+    {
+        BOOST_ASSERT(out.size() >= max_output_size(in.size()));
+
+        double const first_phase = 1. - static_cast<double>(latency());
+        auto const num_phases = static_cast<double>(m_num_phases);
+
+        std::size_t written{};
+        for (float const x : in)
+        {
+            m_history.push(x);
+            m_next -= 1.;
+
+            // m_next is the position of the next output, relative to the
+            // last input. It can be computed once all taps are there.
+            while (m_next < first_phase)
+            {
+                double const pos = (m_next - first_phase + 1.) * num_phases;
+                auto const p = static_cast<std::size_t>(pos);
+                out[written++] = interpolate(
+                        phase(p),
+                        phase(p + 1),
+                        static_cast<float>(pos - static_cast<double>(p)));
+                m_next += m_step;
+            }
+        }
+
+        return written;
+    }
+
+    void reset() noexcept
+    {
+        m_history.clear();
+        m_next = 1.;
+    }
+
+private:
+    [[nodiscard]]
+    auto phase(std::size_t const p) noexcept -> std::span<float>
+    {
+        return std::span{m_table}.subspan(p * m_num_taps, m_num_taps);
+    }
+
+    [[nodiscard]]
+    auto interpolate(
+            std::span<float const> const row0,
+            std::span<float const> const row1,
+            float const frac) const noexcept -> float
+    {
+        auto const window = m_history.window();
+
+        constexpr std::size_t N = mipp::N<float>();
+
+        std::size_t const main_size = (m_num_taps / N) * N;
+
+        mipp::Reg<float> acc0(0.f);
+        mipp::Reg<float> acc1(0.f);
+        std::size_t i = 0;
+        for (; i < main_size; i += N)
+        {
+            mipp::Reg<float> x, r0, r1;
+            x.loadu(window.data() + i);
+            r0.loadu(row0.data() + i);
+            r1.loadu(row1.data() + i);
+            acc0 = mipp::fmadd(r0, x, acc0);
+            acc1 = mipp::fmadd(r1, x, acc1);
+        }
+
+        float y0 = mipp::sum(acc0);
+        float y1 = mipp::sum(acc1);
+        for (; i < m_num_taps; ++i)
+        {
+            y0 += row0[i] * window[i];
+            y1 += row1[i] * window[i];
+        }
+
+        return y0 + frac * (y1 - y0);
+    }
+
+    std::size_t m_num_taps;
+    std::size_t m_num_phases;
+    std::vector<float> m_table;
+    mirrored_history m_history;
+    double m_ratio;
+    double m_step;
+
+    // before the first input, the first output is one frame ahead
+    double m_next{1.};
+};
+
+//! Resamples a whole signal, e.g. a file recorded at another rate. The
+//! latency is compensated, the result has ceil(in.size() * ratio) frames.
+[[nodiscard]]
+inline auto
+resample(std::span<float const> const in, double const ratio)
+        -> std::vector<float>
+{
+    resampler r(ratio);
+
+    std::vector<float> out(
+            r.max_output_size(in.size()) + r.max_output_size(r.latency()));
+    std::size_t written = r.process(in, out);
+
+    std::vector<float> const flush(r.latency(), 0.f);
+    written += r.process(flush, std::span{out}.subspan(written));
+
+    // the output positions are accumulated, they may be off by a tiny bit
+    auto const size = static_cast<std::size_t>(
+            std::ceil(static_cast<double>(in.size()) * ratio - 1e-6));
+    out.resize(std::min(written, size));
+    return out;
+}
+
+} // namespace piejam::audio::dsp
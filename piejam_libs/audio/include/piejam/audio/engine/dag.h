@@ -25,6 +25,8 @@ public:
     using tasks_t = std::vector<std::pair<task_id_t, task_t>>;
     using graph_t = std::unordered_map<task_id_t, std::vector<task_id_t>>;
 
+    static constexpr std::size_t default_event_memory_size = 1u << 16;
+
     dag();
     dag(dag const&) = delete;
     dag(dag&&) = default;
@@ -41,10 +43,12 @@ public:
     auto add_child_task(task_id_t parent, task_t) -> task_id_t;
     void add_child(task_id_t parent, task_id_t child);
 
+    //! With a telemetry, the executing threads account their time into it,
+    //! it needs a slot for each worker thread plus the calling thread.
     auto make_runnable(
             std::span<thread::worker> = {},
-            std::size_t event_memory_size = (1u << 16))
-            -> std::unique_ptr<dag_executor>;
+            std::size_t event_memory_size = default_event_memory_size,
+            worker_telemetry* = nullptr) -> std::unique_ptr<dag_executor>;
 
 private:
     std::size_t m_free_id{};
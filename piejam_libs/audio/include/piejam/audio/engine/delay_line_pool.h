@@ -0,0 +1,97 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+class delay_line_pool;
+
+//! Ring buffer memory, borrowed from a delay_line_pool and returned on
+//! destruction. The size is a power of two.
+class delay_line_buffer
+{
+public:
+    delay_line_buffer() noexcept = default;
+    delay_line_buffer(delay_line_buffer&&) noexcept;
+    ~delay_line_buffer();
+
+    auto operator=(delay_line_buffer&&) noexcept -> delay_line_buffer&;
+
+    [[nodiscard]]
+    auto frames() const noexcept -> std::span<float>
+    {
+        return m_frames;
+    }
+
+    [[nodiscard]]
+    explicit operator bool() const noexcept
+    {
+        return !m_frames.empty();
+    }
+
+private:
+    friend class delay_line_pool;
+
+    delay_line_buffer(delay_line_pool&, std::span<float>) noexcept;
+
+    delay_line_pool* m_pool{};
+    std::span<float> m_frames;
+};
+
+//! Preallocated memory for delay lines, shared by all fx. Buffers are
+//! handed out when the graph is rebuilt and come back when the owning
+//! component is destroyed, which may happen on another thread. Both are
+//! lock-free, a bit per block marks it as used.
+//!
+//! Buffers are a power of two number of blocks, aligned to their size.
+//! Up to 64 blocks are taken from one bitmap word, larger buffers take a
+//! run of whole words.
+class delay_line_pool
+{
+public:
+    static constexpr std::size_t block_frames = 4096;
+    static constexpr std::size_t blocks_per_word = 64;
+
+    //! num_blocks is rounded up to a multiple of 64.
+    explicit delay_line_pool(std::size_t num_blocks);
+    ~delay_line_pool();
+
+    [[nodiscard]]
+    auto num_blocks() const noexcept -> std::size_t;
+    [[nodiscard]]
+    auto num_free_blocks() const noexcept -> std::size_t;
+
+    //! At least min_frames, rounded up to a power of two. Empty, if the
+    //! pool is exhausted.
+    [[nodiscard]]
+    auto allocate(std::size_t min_frames) -> delay_line_buffer;
+
+private:
+    friend class delay_line_buffer;
+
+    [[nodiscard]]
+    auto allocate_in_word(std::size_t run_blocks) -> std::span<float>;
+    [[nodiscard]]
+    auto allocate_words(std::size_t run_words) -> std::span<float>;
+
+    void release(std::span<float>) noexcept;
+
+    struct alignas(64) block
+    {
+        float frames[block_frames];
+    };
+
+    std::unique_ptr<block[]> m_blocks;
+    std::vector<std::atomic<std::uint64_t>> m_used;
+};
+
+} // namespace piejam::audio::engine
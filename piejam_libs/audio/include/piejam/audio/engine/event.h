@@ -4,15 +4,15 @@
 
 #pragma once
 
-#include <boost/intrusive/set_hook.hpp>
-
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace piejam::audio::engine
 {
 
 template <class T>
-class event final : public boost::intrusive::set_base_hook<>
+class event final
 {
     static_assert(std::is_trivially_destructible_v<T>);
     static_assert(std::is_nothrow_default_constructible_v<T>);
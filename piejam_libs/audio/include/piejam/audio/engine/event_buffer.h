@@ -7,10 +7,13 @@
 #include <piejam/audio/engine/event.h>
 
 #include <boost/assert.hpp>
-#include <boost/intrusive/set.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
 
+#include <algorithm>
 #include <concepts>
+#include <memory>
 #include <memory_resource>
+#include <span>
 #include <typeindex>
 
 namespace piejam::audio::engine
@@ -24,33 +27,82 @@ public:
     [[nodiscard]]
     virtual auto type() const -> std::type_index const& = 0;
 
+    [[nodiscard]]
+    virtual auto empty() const noexcept -> bool = 0;
+
     virtual void clear() = 0;
 };
 
+// Events are stored in offset order, in separate offset and value arrays.
+// Most producers emit events in nondecreasing offset order, which makes an
+// insert an append. Out-of-order events are merged in after the events with
+// the same or lower offset, so insertion order is kept for equal offsets.
 template <class T>
 class event_buffer final : public abstract_event_buffer
 {
-    struct event_offset
+public:
+    class const_iterator
+        : public boost::stl_interfaces::iterator_interface<
+                  const_iterator,
+                  std::random_access_iterator_tag,
+                  event<T>,
+                  event<T>,
+                  boost::stl_interfaces::proxy_arrow_result<event<T>>>
     {
-        using type = std::size_t;
+    public:
+        constexpr const_iterator() noexcept = default;
+
+        constexpr const_iterator(
+                event_buffer const* buffer,
+                std::size_t index) noexcept
+            : m_buffer{buffer}
+            , m_index{index}
+        {
+        }
 
-        auto operator()(event<T> const& ev) const noexcept -> std::size_t
+        [[nodiscard]]
+        auto operator*() const noexcept -> event<T>
         {
-            return ev.offset();
+            return {m_buffer->m_offsets[m_index], m_buffer->m_values[m_index]};
+        }
+
+        constexpr auto operator+=(std::ptrdiff_t n) noexcept -> const_iterator&
+        {
+            m_index = static_cast<std::size_t>(
+                    static_cast<std::ptrdiff_t>(m_index) + n);
+            return *this;
         }
-    };
 
-    using event_container_t = boost::intrusive::
-            multiset<event<T>, boost::intrusive::key_of_value<event_offset>>;
+        [[nodiscard]]
+        constexpr auto
+        operator-(const_iterator const& rhs) const noexcept -> std::ptrdiff_t
+        {
+            return static_cast<std::ptrdiff_t>(m_index) -
+                   static_cast<std::ptrdiff_t>(rhs.m_index);
+        }
 
-public:
-    using const_iterator = typename event_container_t::const_iterator;
+        [[nodiscard]]
+        constexpr auto
+        operator==(const_iterator const& rhs) const noexcept -> bool
+        {
+            return m_index == rhs.m_index;
+        }
+
+    private:
+        event_buffer const* m_buffer{};
+        std::size_t m_index{};
+    };
 
     event_buffer(std::pmr::memory_resource*& event_memory)
         : m_event_memory(event_memory)
     {
     }
 
+    ~event_buffer() override
+    {
+        deallocate();
+    }
+
     [[nodiscard]]
     auto type() const -> std::type_index const& override
     {
@@ -59,50 +111,142 @@ public:
     }
 
     [[nodiscard]]
-    auto empty() const noexcept -> bool
+    auto empty() const noexcept -> bool override
     {
-        return m_event_container.empty();
+        return m_size == 0;
     }
 
     [[nodiscard]]
     auto size() const noexcept
     {
-        return m_event_container.size();
+        return m_size;
     }
 
     [[nodiscard]]
     auto begin() const noexcept -> const_iterator
     {
-        return m_event_container.begin();
+        return {this, 0};
     }
 
     [[nodiscard]]
     auto end() const noexcept -> const_iterator
     {
-        return m_event_container.end();
+        return {this, m_size};
+    }
+
+    [[nodiscard]]
+    auto offsets() const noexcept -> std::span<std::size_t const>
+    {
+        return {m_offsets, m_size};
+    }
+
+    [[nodiscard]]
+    auto values() const noexcept -> std::span<T const>
+    {
+        return {m_values, m_size};
     }
 
     template <std::convertible_to<T> V>
     void insert(std::size_t const offset, V&& value)
     {
-        BOOST_ASSERT(m_event_memory);
-        std::pmr::polymorphic_allocator<event<T>> allocator(m_event_memory);
-        m_event_container.insert(*allocator.template new_object<event<T>>(
-                offset,
-                std::forward<V>(value)));
+        if (m_size == m_capacity)
+        {
+            grow();
+        }
+
+        if (m_size == 0 || m_offsets[m_size - 1] <= offset)
+        {
+            m_offsets[m_size] = offset;
+            std::construct_at(m_values + m_size, std::forward<V>(value));
+        }
+        else
+        {
+            std::size_t const pos = static_cast<std::size_t>(
+                    std::upper_bound(m_offsets, m_offsets + m_size, offset) -
+                    m_offsets);
+
+            std::copy_backward(
+                    m_offsets + pos,
+                    m_offsets + m_size,
+                    m_offsets + m_size + 1);
+            std::construct_at(
+                    m_values + m_size,
+                    std::move(m_values[m_size - 1]));
+            std::move_backward(
+                    m_values + pos,
+                    m_values + m_size - 1,
+                    m_values + m_size);
+
+            m_offsets[pos] = offset;
+            m_values[pos] = T(std::forward<V>(value));
+        }
+
+        ++m_size;
     }
 
+    event_buffer(event_buffer const&) = delete;
+    event_buffer(event_buffer&&) = delete;
+
     auto operator=(event_buffer const&) = delete;
     auto operator=(event_buffer&&) = delete;
 
+    // The event memory is released after each cycle, so the storage is
+    // given up here as well.
     void clear() override
     {
-        m_event_container.clear();
+        deallocate();
     }
 
 private:
+    static constexpr std::size_t min_capacity{16};
+
+    void grow()
+    {
+        BOOST_ASSERT(m_event_memory);
+
+        std::pmr::polymorphic_allocator<> allocator(m_event_memory);
+
+        std::size_t const capacity = std::max(min_capacity, m_capacity * 2);
+        auto* const offsets = allocator.allocate_object<std::size_t>(capacity);
+        auto* const values = allocator.allocate_object<T>(capacity);
+
+        std::copy_n(m_offsets, m_size, offsets);
+        std::uninitialized_move_n(m_values, m_size, values);
+
+        std::size_t const size = m_size;
+        deallocate();
+
+        m_memory = m_event_memory;
+        m_offsets = offsets;
+        m_values = values;
+        m_size = size;
+        m_capacity = capacity;
+    }
+
+    void deallocate() noexcept
+    {
+        if (m_capacity > 0)
+        {
+            // values are trivially destructible
+            std::pmr::polymorphic_allocator<> allocator(m_memory);
+            allocator.deallocate_object(m_offsets, m_capacity);
+            allocator.deallocate_object(m_values, m_capacity);
+        }
+
+        m_memory = nullptr;
+        m_offsets = nullptr;
+        m_values = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+    }
+
     std::pmr::memory_resource*& m_event_memory;
-    event_container_t m_event_container;
+
+    std::pmr::memory_resource* m_memory{};
+    std::size_t* m_offsets{};
+    T* m_values{};
+    std::size_t m_size{};
+    std::size_t m_capacity{};
 };
 
 } // namespace piejam::audio::engine
@@ -9,6 +9,7 @@
 
 #include <boost/polymorphic_cast.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace piejam::audio::engine
@@ -39,6 +40,14 @@ public:
         return m_event_buffers.end();
     }
 
+    [[nodiscard]]
+    auto all_empty() const noexcept -> bool
+    {
+        return std::ranges::all_of(
+                m_event_buffers,
+                &abstract_event_buffer::empty);
+    }
+
     void add(event_port const& port)
     {
         m_event_buffers.push_back(std::addressof(port.empty_event_buffer()));
@@ -18,6 +18,8 @@ class event_output_buffers;
 class event_port;
 
 class component;
+class delay_line_buffer;
+class delay_line_pool;
 class processor;
 class named_processor;
 class input_processor;
@@ -34,5 +36,6 @@ class process;
 struct process_context;
 class processor_job;
 class thread_context;
+class worker_telemetry;
 
 } // namespace piejam::audio::engine
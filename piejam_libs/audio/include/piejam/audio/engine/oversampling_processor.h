@@ -0,0 +1,42 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/engine/fwd.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+enum class oversampling_factor : unsigned
+{
+    x2 = 2,
+    x4 = 4,
+};
+
+enum class oversampling_phase : bool
+{
+    //! FIR half-band filters, no phase distortion.
+    linear,
+    //! IIR half-band filters, a fraction of the latency and the cost.
+    minimum,
+};
+
+//! Runs a chain of processors at a multiple of the sample rate, so the
+//! harmonics a nonlinear processor creates are filtered, instead of being
+//! aliased back into the audible range. Every processor of the chain needs
+//! num_channels audio inputs and outputs and no event ports, they are
+//! connected in order.
+auto make_oversampling_processor(
+        std::size_t num_channels,
+        std::vector<std::unique_ptr<processor>> chain,
+        oversampling_factor,
+        oversampling_phase,
+        std::string_view name = {}) -> std::unique_ptr<processor>;
+
+} // namespace piejam::audio::engine
@@ -7,28 +7,58 @@
 #include <piejam/audio/engine/graph.h>
 
 #include <atomic>
-#include <future>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace piejam::audio::engine
 {
 
+//! Runs the current dag executor on the audio thread.
+//!
+//! Swapping the executor doesn't block. The next executor is published to
+//! the audio thread, which picks it up at the start of its next period.
+//! Executors which are out of use are destroyed by reclaim(), which is
+//! meant to be called periodically from a housekeeping thread.
 class process
 {
 public:
+    using resources_t = std::shared_ptr<void>;
+    using on_active_t = std::function<void()>;
+
     process();
     ~process();
 
-    [[nodiscard]]
-    bool swap_executor(std::unique_ptr<dag_executor>);
+    //! The resources are objects the executor refers to. They are kept
+    //! alive until the executor is reclaimed. on_active is called by
+    //! reclaim(), once the executor completed its first period. If another
+    //! executor is swapped in before that, the pending one is dropped.
+    void swap_executor(
+            std::unique_ptr<dag_executor>,
+            resources_t = {},
+            on_active_t on_active = {});
+
+    //! Destroys the executors, and their resources, which were replaced by
+    //! the active one. Returns the number of destroyed executors.
+    auto reclaim() -> std::size_t;
 
     void operator()(std::size_t buffer_size) noexcept;
 
 private:
-    std::unique_ptr<dag_executor> m_executor;
+    struct generation
+    {
+        std::unique_ptr<dag_executor> executor;
+        resources_t resources;
+        on_active_t on_active;
+    };
+
+    std::mutex m_generations_mutex;
+    std::deque<generation> m_generations;
 
+    dag_executor* m_executor{};
     std::atomic<dag_executor*> m_next_executor{};
-    std::promise<std::unique_ptr<dag_executor>> m_prev_executor{};
+    std::atomic<dag_executor*> m_active_executor{};
 };
 
 } // namespace piejam::audio::engine
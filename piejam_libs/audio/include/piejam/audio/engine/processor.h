@@ -5,6 +5,7 @@
 #pragma once
 
 #include <piejam/audio/engine/fwd.h>
+#include <piejam/npos.h>
 
 #include <span>
 #include <string_view>
@@ -34,6 +35,33 @@ public:
     [[nodiscard]]
     virtual auto event_outputs() const noexcept -> event_ports = 0;
 
+    //! Whether results may refer to input buffers. Output buffers are
+    //! shared between processors, a buffer forwarded as result is kept
+    //! alive until the consumers of the result are done.
+    [[nodiscard]]
+    virtual auto may_forward_inputs() const noexcept -> bool
+    {
+        return true;
+    }
+
+    //! Number of frames the outputs may still be non-silent, after all
+    //! audio inputs became constant zero. Once the inputs stayed silent
+    //! for longer and no events are pending, the processor isn't called
+    //! anymore and its results are silent. npos, if it must always run.
+    [[nodiscard]]
+    virtual auto silence_tail() const noexcept -> std::size_t
+    {
+        return npos;
+    }
+
+    //! Number of frames the outputs lag behind the inputs, e.g. due to
+    //! lookahead or block-wise processing.
+    [[nodiscard]]
+    virtual auto latency() const noexcept -> std::size_t
+    {
+        return 0;
+    }
+
     virtual void process(process_context const&) = 0;
 };
 
@@ -13,6 +13,7 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -26,9 +27,22 @@ class processor_job final
 {
 public:
     using output_buffer_t = std::array<float, max_period_size.value()>;
+    using output_buffers_t = mipp::vector<output_buffer_t>;
 
     processor_job(processor& proc);
 
+    [[nodiscard]]
+    auto proc() const noexcept -> processor&
+    {
+        return m_proc;
+    }
+
+    //! Output buffers are taken from a pool shared with other jobs, the
+    //! indices select one pool buffer per output.
+    void assign_output_buffers(
+            std::shared_ptr<output_buffers_t> pool,
+            std::span<std::size_t const> indices);
+
     auto result_ref(std::size_t index) const -> slice<float> const&;
     void connect_result(std::size_t index, slice<float> const& res);
 
@@ -42,8 +56,11 @@ public:
     void operator()(thread_context const&);
 
 private:
+    [[nodiscard]]
+    auto skip_silent() -> bool;
+
     processor& m_proc;
-    mipp::vector<output_buffer_t> m_output_buffers;
+    std::shared_ptr<output_buffers_t> m_output_buffers;
 
     std::vector<std::reference_wrapper<slice<float> const>> m_inputs;
     std::vector<std::span<float>> m_outputs;
@@ -53,6 +70,8 @@ private:
     event_output_buffers m_event_outputs;
 
     process_context m_process_context;
+
+    std::size_t m_silent_frames{};
 };
 
 } // namespace piejam::audio::engine
@@ -0,0 +1,98 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/thread/cache_line_size.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::engine
+{
+
+//! Time accounting of one thread executing a dag, within one period. Busy is
+//! the time spent in tasks, steal the time spent polling the shared run
+//! queue for work. The remaining time of the period, the thread is idle.
+struct worker_period
+{
+    std::chrono::nanoseconds busy{};
+    std::chrono::nanoseconds steal{};
+    std::uint64_t tasks{};
+    std::uint64_t steals{};
+};
+
+//! Accumulated accounting of a thread, cpu_time is the thread CPU clock.
+struct worker_stats
+{
+    std::chrono::nanoseconds busy{};
+    std::chrono::nanoseconds steal{};
+    std::chrono::nanoseconds cpu_time{};
+    std::uint64_t tasks{};
+    std::uint64_t steals{};
+};
+
+//! Load of a thread over an interval, as fractions of the interval.
+struct worker_load
+{
+    float busy{};
+    float steal{};
+    float idle{};
+    float cpu{};
+
+    auto operator==(worker_load const&) const noexcept -> bool = default;
+};
+
+//! Per thread counters, written by the threads executing a dag once per
+//! period and read by non-realtime threads. Index 0 is the thread calling
+//! the executor, the others correspond to the worker threads.
+class worker_telemetry
+{
+public:
+    explicit worker_telemetry(std::size_t num_threads);
+
+    [[nodiscard]]
+    auto num_threads() const noexcept -> std::size_t
+    {
+        return m_num_threads;
+    }
+
+    //! Called by the thread itself at the end of a period, also samples its
+    //! CPU clock.
+    void update(std::size_t thread_index, worker_period const&) noexcept;
+
+    [[nodiscard]]
+    auto stats() const -> std::vector<worker_stats>;
+
+private:
+    struct alignas(thread::cache_line_size) counters
+    {
+        std::atomic_uint64_t busy_ns{};
+        std::atomic_uint64_t steal_ns{};
+        std::atomic_uint64_t cpu_time_ns{};
+        std::atomic_uint64_t tasks{};
+        std::atomic_uint64_t steals{};
+    };
+
+    std::size_t m_num_threads;
+    std::unique_ptr<counters[]> m_counters;
+};
+
+//! CLOCK_THREAD_CPUTIME_ID of the calling thread.
+[[nodiscard]]
+auto thread_cpu_time() noexcept -> std::chrono::nanoseconds;
+
+//! Loads over the interval between two stats snapshots. Threads without a
+//! previous snapshot are taken as starting from zero.
+[[nodiscard]]
+auto worker_loads(
+        std::span<worker_stats const> prev,
+        std::span<worker_stats const> curr,
+        std::chrono::nanoseconds interval) -> std::vector<worker_load>;
+
+} // namespace piejam::audio::engine
@@ -11,10 +11,16 @@ namespace piejam::audio
 
 enum class pcm_format : unsigned;
 
+class async_input_buffer;
 class io_process;
 class sound_card_manager;
 class process_thread;
+class period_timing_history;
+struct period_timing;
 
+struct aggregate_input_config;
+struct aggregate_input_stats;
+struct sound_card_capabilities;
 struct sound_card_descriptor;
 struct sound_card_config;
 struct sound_card_hw_params;
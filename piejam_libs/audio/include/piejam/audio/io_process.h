@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <piejam/audio/aggregate_input_stats.h>
+#include <piejam/audio/period_timing.h>
 #include <piejam/audio/process_function.h>
 #include <piejam/thread/fwd.h>
 
 #include <memory>
+#include <vector>
 
 namespace piejam::audio
 {
@@ -36,6 +39,16 @@ public:
     virtual auto cpu_load() const noexcept -> float = 0;
     [[nodiscard]]
     virtual auto xruns() const noexcept -> std::size_t = 0;
+
+    //! Timings of the periods before the last xrun, empty if there was no
+    //! xrun since the previous call.
+    [[nodiscard]]
+    virtual auto take_xrun_period_timings() -> std::vector<period_timing> = 0;
+
+    //! In the order of io_process_config::aggregate_inputs.
+    [[nodiscard]]
+    virtual auto aggregate_inputs() const
+            -> std::vector<aggregate_input_stats> = 0;
 };
 
 auto make_dummy_io_process() -> std::unique_ptr<io_process>;
@@ -7,6 +7,9 @@
 #include <piejam/audio/period_count.h>
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
+#include <piejam/audio/sound_card_descriptor.h>
+
+#include <vector>
 
 namespace piejam::audio
 {
@@ -27,11 +30,21 @@ struct sound_card_buffer_config
     audio::period_count period_count;
 };
 
+//! An additional capture device, running on its own clock. Its channels
+//! follow the ones of the input device.
+struct aggregate_input_config
+{
+    sound_card_descriptor device;
+    sound_card_config config;
+    sound_card_buffer_config buffer_config;
+};
+
 struct io_process_config
 {
     sound_card_config in_config;
     sound_card_config out_config;
     sound_card_buffer_config buffer_config;
+    std::vector<aggregate_input_config> aggregate_inputs;
 };
 
 } // namespace piejam::audio
@@ -0,0 +1,103 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace piejam::audio
+{
+
+enum class period_event : std::uint8_t
+{
+    start,
+    read_complete,
+    graph_start,
+    executor_swap,
+    graph_end,
+    write_complete,
+    xrun,
+
+    _count
+};
+
+inline constexpr std::size_t num_period_events =
+        static_cast<std::size_t>(period_event::_count);
+
+[[nodiscard]]
+auto to_string(period_event) noexcept -> std::string_view;
+
+//! Timestamps of the events within one period, in nanoseconds of
+//! CLOCK_MONOTONIC_RAW. Zero, if the event didn't occur.
+struct period_timing
+{
+    std::uint64_t period{};
+    std::array<std::uint64_t, num_period_events> timestamps{};
+
+    [[nodiscard]]
+    auto operator[](period_event ev) const noexcept -> std::uint64_t
+    {
+        return timestamps[static_cast<std::size_t>(ev)];
+    }
+};
+
+//! Timings of the last periods of the audio thread. Recording and taking
+//! snapshots is real-time safe, the snapshot is collected from another
+//! thread with take_snapshot.
+class period_timing_history
+{
+public:
+    explicit period_timing_history(std::size_t num_periods = 256);
+
+    //! Calls of mark_period_event on the calling thread are recorded into
+    //! this history.
+    void make_current() noexcept;
+
+    void begin_period() noexcept;
+    void mark(period_event) noexcept;
+
+    //! Copies the history into the snapshot buffer, if the previous
+    //! snapshot was taken already.
+    void snapshot() noexcept;
+
+    //! Oldest period first, empty if there is no new snapshot.
+    [[nodiscard]]
+    auto take_snapshot() -> std::vector<period_timing>;
+
+private:
+    enum snapshot_state : int
+    {
+        snapshot_empty,
+        snapshot_ready,
+    };
+
+    std::vector<period_timing> m_periods;
+    std::uint64_t m_period{};
+
+    std::vector<period_timing> m_snapshot;
+    std::size_t m_snapshot_size{};
+    std::atomic_int m_snapshot_state{snapshot_empty};
+};
+
+//! Marks an event in the current period of the history, which is current
+//! on the calling thread. Does nothing if there is none.
+void mark_period_event(period_event) noexcept;
+
+//! Compact binary file of period timings, see tools/xrun_decode.
+[[nodiscard]]
+auto write_period_timings(
+        std::filesystem::path const& file,
+        std::span<period_timing const>) -> bool;
+
+[[nodiscard]]
+auto read_period_timings(std::filesystem::path const& file)
+        -> std::vector<period_timing>;
+
+} // namespace piejam::audio
@@ -0,0 +1,62 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/sound_card_hw_params.h>
+
+#include <vector>
+
+namespace piejam::audio
+{
+
+//! Full capability set of a sound card, probed in one pass. Any
+//! sound_card_hw_params query can be answered from it, without accessing
+//! the device again.
+struct sound_card_capabilities
+{
+    //! Period counts, constrained by a period size.
+    struct period_size_capabilities
+    {
+        period_counts_t period_counts;
+
+        auto operator==(period_size_capabilities const&) const noexcept
+                -> bool = default;
+    };
+
+    //! Period sizes and counts, constrained by a sample rate.
+    struct sample_rate_capabilities
+    {
+        period_sizes_t period_sizes;
+        period_counts_t period_counts;
+
+        //! Parallel to period_sizes, constrained by rate and size.
+        std::vector<period_size_capabilities> by_period_size;
+
+        auto operator==(sample_rate_capabilities const&) const noexcept
+                -> bool = default;
+    };
+
+    //! Unconstrained parameters.
+    sound_card_hw_params hw_params;
+
+    //! Parallel to hw_params.sample_rates.
+    std::vector<sample_rate_capabilities> by_sample_rate;
+
+    //! Parallel to hw_params.period_sizes.
+    std::vector<period_size_capabilities> by_period_size;
+
+    auto operator==(sound_card_capabilities const&) const noexcept
+            -> bool = default;
+};
+
+//! Same result as probing the device with the given, optional, constraints.
+//! Constraints which aren't supported by the device are ignored.
+[[nodiscard]]
+auto hw_params(
+        sound_card_capabilities const&,
+        sample_rate const*,
+        period_size const*) -> sound_card_hw_params;
+
+} // namespace piejam::audio
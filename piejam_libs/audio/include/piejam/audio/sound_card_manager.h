@@ -7,6 +7,7 @@
 #include <piejam/audio/fwd.h>
 #include <piejam/audio/sound_card_descriptor.h>
 
+#include <functional>
 #include <memory>
 
 namespace piejam::audio
@@ -19,6 +20,11 @@ public:
 
     virtual auto io_descriptors() -> io_sound_cards = 0;
 
+    //! Returns true, if all cards are probed, and hw_params doesn't block.
+    //! Otherwise on_probed is called, from a probe thread, once they are.
+    virtual auto wait_for_probes(std::function<void()> on_probed) -> bool = 0;
+
+    //! Blocks, while the card is being probed.
     virtual auto hw_params(
             sound_card_descriptor const&,
             sample_rate const*,
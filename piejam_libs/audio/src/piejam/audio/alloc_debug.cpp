@@ -4,18 +4,105 @@
 
 #include <piejam/audio/alloc_debug.h>
 
+#include <spdlog/spdlog.h>
+
+#include <execinfo.h>
+
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
+#include <memory>
 #include <new>
+#include <span>
+
+namespace
+{
+
+thread_local bool s_prohibit_dynamic_memory_allocation = false;
+
+constinit std::atomic_size_t s_rt_allocation_count{};
+
+struct rt_allocation_sample
+{
+    static constexpr std::size_t max_frames = 16;
+
+    std::size_t size{};
+    int num_frames{};
+    std::array<void*, max_frames> frames{};
+};
+
+enum sample_slot_state : int
+{
+    free_slot,
+    writing_slot,
+    ready_slot,
+};
+
+struct sample_slot
+{
+    std::atomic_int state{free_slot};
+    rt_allocation_sample sample;
+};
+
+// Slots are claimed round-robin by the real-time threads. A sample is
+// dropped, if its slot wasn't logged yet or another thread is writing to it.
+constinit std::array<sample_slot, 16> s_samples{};
+constinit std::atomic_size_t s_next_sample{};
+
+void
+record_rt_allocation(std::size_t const size) noexcept
+{
+    s_rt_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    sample_slot& slot =
+            s_samples[s_next_sample.fetch_add(1, std::memory_order_relaxed) %
+                      s_samples.size()];
+
+    int expected = free_slot;
+    if (!slot.state.compare_exchange_strong(
+                expected,
+                writing_slot,
+                std::memory_order_acquire,
+                std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    slot.sample.size = size;
+
+    // backtrace is prepared in prohibit_dynamic_memory_allocation, it
+    // doesn't allocate here anymore
+    slot.sample.num_frames = backtrace(
+            slot.sample.frames.data(),
+            static_cast<int>(slot.sample.frames.size()));
+
+    slot.state.store(ready_slot, std::memory_order_release);
+}
+
+auto
+allocation_allowed(std::size_t const size) noexcept -> bool
+{
+    if (!s_prohibit_dynamic_memory_allocation)
+    {
+        return true;
+    }
+
+    record_rt_allocation(size);
 
 #ifndef NDEBUG
+    return false;
+#else
+    return true;
+#endif
+}
 
-static thread_local bool s_prohibit_dynamic_memory_allocation = false;
+} // namespace
 
 auto
 operator new(std::size_t count) -> void*
 {
-    if (!s_prohibit_dynamic_memory_allocation)
+    if (allocation_allowed(count))
     {
         if (count == 0)
         {
@@ -34,7 +121,7 @@ operator new(std::size_t count) -> void*
 auto
 operator new(std::size_t count, std::align_val_t al) -> void*
 {
-    if (!s_prohibit_dynamic_memory_allocation)
+    if (allocation_allowed(count))
     {
         if (count == 0)
         {
@@ -68,17 +155,64 @@ operator delete(void* ptr, std::align_val_t /*al*/) noexcept
     std::free(ptr);
 }
 
-#endif
-
 namespace piejam::audio
 {
 
 void
 prohibit_dynamic_memory_allocation()
 {
-#ifndef NDEBUG
+    if (s_prohibit_dynamic_memory_allocation)
+    {
+        return;
+    }
+
+    // the first call of backtrace loads libgcc, which allocates
+    std::array<void*, 1> frames;
+    backtrace(frames.data(), static_cast<int>(frames.size()));
+
     s_prohibit_dynamic_memory_allocation = true;
-#endif
+}
+
+auto
+rt_allocation_count() noexcept -> std::size_t
+{
+    return s_rt_allocation_count.load(std::memory_order_relaxed);
+}
+
+void
+log_rt_allocation_samples()
+{
+    for (sample_slot& slot : s_samples)
+    {
+        if (slot.state.load(std::memory_order_acquire) != ready_slot)
+        {
+            continue;
+        }
+
+        rt_allocation_sample const sample = slot.sample;
+        slot.state.store(free_slot, std::memory_order_release);
+
+        std::unique_ptr<char*, decltype(&std::free)> symbols(
+                backtrace_symbols(sample.frames.data(), sample.num_frames),
+                &std::free);
+
+        spdlog::warn(
+                "dynamic memory allocation of {} bytes on a real-time "
+                "thread",
+                sample.size);
+
+        if (!symbols)
+        {
+            continue;
+        }
+
+        for (char const* const symbol : std::span(
+                     symbols.get(),
+                     static_cast<std::size_t>(sample.num_frames)))
+        {
+            spdlog::warn("    {}", symbol);
+        }
+    }
 }
 
 } // namespace piejam::audio
@@ -0,0 +1,166 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "aggregate_input.h"
+
+#include "open_pcm.h"
+#include "pcm_reader.h"
+
+#include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/audio/io_process_config.h>
+#include <piejam/audio/process_thread.h>
+#include <piejam/range/iota.h>
+#include <piejam/system/monotonic_raw_clock.h>
+
+#include <spdlog/spdlog.h>
+
+#include <sound/asound.h>
+#include <sys/ioctl.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+namespace piejam::audio::alsa
+{
+
+aggregate_input::aggregate_input(
+        aggregate_input_config const& config,
+        sound_card_buffer_config const& master)
+    : m_fd(open_pcm(config.device.path, config.config, config.buffer_config))
+    , m_period_size(config.buffer_config.period_size.value())
+    , m_reader(make_reader(
+              m_fd,
+              config.config,
+              config.buffer_config.period_size))
+    , m_buffer(config.config.num_channels, config.buffer_config, master)
+    , m_capture_buffer(config.config.num_channels * m_period_size)
+    , m_captured(algorithm::transform_to_vector(
+              range::iota(std::size_t{config.config.num_channels}),
+              [this](std::size_t const channel) {
+                  return std::span<float const>{m_capture_buffer}.subspan(
+                          channel * m_period_size,
+                          m_period_size);
+              }))
+    , m_converter(algorithm::transform_to_vector(
+              range::iota(std::size_t{config.config.num_channels}),
+              [this](std::size_t const channel) {
+                  return pcm_input_buffer_converter(
+                          [this, channel](std::span<float> const buffer) {
+                              BOOST_ASSERT(
+                                      m_buffer.channel(channel).size() ==
+                                      buffer.size());
+                              std::ranges::copy(
+                                      m_buffer.channel(channel),
+                                      buffer.begin());
+                          });
+              }))
+{
+    BOOST_ASSERT(m_fd);
+}
+
+aggregate_input::~aggregate_input()
+{
+    if (m_capture_thread)
+    {
+        stop();
+    }
+}
+
+void
+aggregate_input::start(thread::configuration const& thread_config)
+{
+    BOOST_ASSERT(!m_capture_thread);
+
+    m_starting = true;
+
+    m_capture_thread = std::make_unique<process_thread>();
+    m_capture_thread->start(thread_config, [this]() { return capture(); });
+}
+
+void
+aggregate_input::stop()
+{
+    BOOST_ASSERT(m_capture_thread);
+
+    if (m_capture_thread->is_running())
+    {
+        m_capture_thread->stop();
+    }
+    else if (auto err = m_capture_thread->error())
+    {
+        auto const message = err.message();
+        spdlog::error("Capture thread stopped with: {}", message);
+    }
+
+    m_capture_thread.reset();
+
+    if (auto err = m_fd.ioctl(SNDRV_PCM_IOCTL_DROP))
+    {
+        auto const message = err.message();
+        spdlog::error("aggregate_input::stop: {}", message);
+    }
+}
+
+void
+aggregate_input::read(std::size_t const frames) noexcept
+{
+    m_buffer.read(frames, system::monotonic_raw_clock::now());
+}
+
+auto
+aggregate_input::stats() const noexcept -> aggregate_input_stats
+{
+    auto result = m_buffer.stats();
+    result.xruns = m_xruns.load(std::memory_order_relaxed);
+    return result;
+}
+
+auto
+aggregate_input::capture() -> std::error_condition
+{
+    if (m_starting)
+    {
+        if (auto err = m_fd.ioctl(SNDRV_PCM_IOCTL_PREPARE))
+        {
+            return err.default_error_condition();
+        }
+
+        if (auto err = m_fd.ioctl(SNDRV_PCM_IOCTL_START))
+        {
+            return err.default_error_condition();
+        }
+
+        m_starting = false;
+    }
+
+    if (auto err = m_reader->transfer())
+    {
+        // Restart, the audio thread bridges the gap with silence.
+        if (err == std::make_error_code(std::errc::broken_pipe))
+        {
+            m_xruns.fetch_add(1, std::memory_order_relaxed);
+            m_starting = true;
+            return {};
+        }
+
+        return err.default_error_condition();
+    }
+
+    auto const now = system::monotonic_raw_clock::now();
+
+    auto const converter = m_reader->converter();
+    for (std::size_t ch = 0; ch < converter.size(); ++ch)
+    {
+        converter[ch](std::span{m_capture_buffer}.subspan(
+                ch * m_period_size,
+                m_period_size));
+    }
+
+    m_buffer.write(m_captured, now);
+
+    return {};
+}
+
+} // namespace piejam::audio::alsa
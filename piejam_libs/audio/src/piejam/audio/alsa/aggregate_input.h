@@ -0,0 +1,71 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/aggregate_input_stats.h>
+#include <piejam/audio/async_input_buffer.h>
+#include <piejam/audio/fwd.h>
+#include <piejam/audio/pcm_buffer_converter.h>
+#include <piejam/system/device.h>
+#include <piejam/thread/fwd.h>
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace piejam::audio::alsa
+{
+
+class pcm_reader;
+
+//! An additional capture device, read on its own thread. The audio thread
+//! of the master device takes the frames over, after they were resampled
+//! to its clock.
+class aggregate_input
+{
+public:
+    aggregate_input(
+            aggregate_input_config const&,
+            sound_card_buffer_config const& master);
+    ~aggregate_input();
+
+    //! Converters of the channels, they hand out the last read period.
+    [[nodiscard]]
+    auto converter() const noexcept
+            -> std::span<pcm_input_buffer_converter const>
+    {
+        return m_converter;
+    }
+
+    void start(thread::configuration const&);
+    void stop();
+
+    //! Called by the audio thread of the master device, each period.
+    void read(std::size_t frames) noexcept;
+
+    [[nodiscard]]
+    auto stats() const noexcept -> aggregate_input_stats;
+
+private:
+    auto capture() -> std::error_condition;
+
+    system::device m_fd;
+    std::size_t m_period_size;
+    std::unique_ptr<pcm_reader> m_reader;
+    async_input_buffer m_buffer;
+
+    std::vector<float> m_capture_buffer;
+    std::vector<std::span<float const>> m_captured;
+    std::vector<pcm_input_buffer_converter> m_converter;
+
+    bool m_starting{true};
+    std::atomic_size_t m_xruns{};
+
+    std::unique_ptr<process_thread> m_capture_thread;
+};
+
+} // namespace piejam::audio::alsa
@@ -4,7 +4,6 @@
 
 #include "get_io_sound_cards.h"
 
-#include <piejam/box.h>
 #include <piejam/io_pair.h>
 #include <piejam/system/device.h>
 
@@ -145,18 +144,26 @@ struct to_sound_card_descriptor
         BOOST_ASSERT(stream_type == 'c' || stream_type == 'p');
     }
 
-    auto operator()(snd_pcm_info const& pcm_info) const -> sound_card_descriptor
+    auto operator()(snd_pcm_info const& pcm_info) const -> sound_card_pcm
     {
-        return sound_card_descriptor{
-                .name = fmt::format(
-                        "{} - {}",
-                        reinterpret_cast<char const*>(sc.info.name),
-                        reinterpret_cast<char const*>(pcm_info.name)),
-                .path = fmt::format(
-                        "/dev/snd/pcmC{}D{}{}",
-                        pcm_info.card,
-                        pcm_info.device,
-                        stream_type)};
+        return sound_card_pcm{
+                .descriptor =
+                        sound_card_descriptor{
+                                .name = fmt::format(
+                                        "{} - {}",
+                                        reinterpret_cast<char const*>(
+                                                sc.info.name),
+                                        reinterpret_cast<char const*>(
+                                                pcm_info.name)),
+                                .path = fmt::format(
+                                        "/dev/snd/pcmC{}D{}{}",
+                                        pcm_info.card,
+                                        pcm_info.device,
+                                        stream_type)},
+                .card_identity = fmt::format(
+                        "{}/{}",
+                        reinterpret_cast<char const*>(sc.info.id),
+                        reinterpret_cast<char const*>(sc.info.longname))};
     }
 
     sound_card_info const& sc;
@@ -166,9 +173,9 @@ struct to_sound_card_descriptor
 } // namespace
 
 auto
-get_io_sound_cards() -> io_sound_cards
+get_io_sound_card_pcms() -> io_pair<std::vector<sound_card_pcm>>
 {
-    io_pair<std::vector<sound_card_descriptor>> result;
+    io_pair<std::vector<sound_card_pcm>> result;
 
     for (sound_card_info const& sc_info : scan_for_sound_cards())
     {
@@ -182,10 +189,7 @@ get_io_sound_cards() -> io_sound_cards
                 to_sound_card_descriptor{sc_info, 'p'});
     }
 
-    return io_sound_cards{
-            box(std::move(result.in)),
-            box(std::move(result.out)),
-    };
+    return result;
 }
 
 } // namespace piejam::audio::alsa
@@ -6,9 +6,22 @@
 
 #include <piejam/audio/sound_card_descriptor.h>
 
+#include <string>
+#include <vector>
+
 namespace piejam::audio::alsa
 {
 
-auto get_io_sound_cards() -> io_sound_cards;
+//! A pcm device along with the identity of its card, which is the card id
+//! and long name. For USB devices the long name contains the port path, so
+//! a card plugged into another port, or a different card getting the same
+//! index, has a different identity.
+struct sound_card_pcm
+{
+    sound_card_descriptor descriptor;
+    std::string card_identity;
+};
+
+auto get_io_sound_card_pcms() -> io_pair<std::vector<sound_card_pcm>>;
 
 } // namespace piejam::audio::alsa
@@ -9,6 +9,7 @@
 #include <piejam/audio/pcm_format.h>
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
+#include <piejam/audio/sound_card_capabilities.h>
 #include <piejam/audio/sound_card_descriptor.h>
 #include <piejam/audio/sound_card_hw_params.h>
 #include <piejam/system/device.h>
@@ -232,12 +233,21 @@ get_hw_params(
         sound_card_descriptor const& sound_card,
         sample_rate const* const sample_rate,
         period_size const* const period_size) -> sound_card_hw_params
+{
+    system::device fd(sound_card.path);
+    return get_hw_params(fd, sample_rate, period_size);
+}
+
+auto
+get_hw_params(
+        system::device& fd,
+        sample_rate const* const sample_rate,
+        period_size const* const period_size) -> sound_card_hw_params
 {
     sound_card_hw_params result;
 
     auto hw_params = make_snd_pcm_hw_params_for_refine_any();
 
-    system::device fd(sound_card.path);
     if (auto err = fd.ioctl(SNDRV_PCM_IOCTL_HW_REFINE, hw_params))
     {
         throw std::system_error(err);
@@ -324,6 +334,80 @@ get_hw_params(
     return result;
 }
 
+auto
+get_capabilities(sound_card_descriptor const& sound_card)
+        -> sound_card_capabilities
+{
+    sound_card_capabilities result;
+
+    system::device fd(sound_card.path);
+
+    // The unconstrained parameters are refined as usual, the constrained
+    // ones are refined from the same device handle.
+    auto const refine_period_counts = [&fd](snd_pcm_hw_params const& params) {
+        period_counts_t period_counts;
+        std::ranges::copy_if(
+                preferred_period_counts,
+                std::back_inserter(period_counts),
+                test_interval_value(fd, params, SNDRV_PCM_HW_PARAM_PERIODS),
+                &audio::period_count::value);
+        return period_counts;
+    };
+
+    auto const refine_by_period_size =
+            [&](snd_pcm_hw_params const& params,
+                period_sizes_t const& period_sizes) {
+                std::vector<sound_card_capabilities::period_size_capabilities>
+                        by_period_size;
+                for (period_size const ps : period_sizes)
+                {
+                    auto size_params = params;
+                    set_interval_value(
+                            size_params,
+                            SNDRV_PCM_HW_PARAM_PERIOD_SIZE,
+                            ps.value());
+                    by_period_size.push_back(
+                            {.period_counts =
+                                     refine_period_counts(size_params)});
+                }
+                return by_period_size;
+            };
+
+    result.hw_params = get_hw_params(fd, nullptr, nullptr);
+
+    auto hw_params = make_snd_pcm_hw_params_for_refine_any();
+    if (auto err = fd.ioctl(SNDRV_PCM_IOCTL_HW_REFINE, hw_params))
+    {
+        throw std::system_error(err);
+    }
+
+    result.by_period_size =
+            refine_by_period_size(hw_params, result.hw_params.period_sizes);
+
+    for (sample_rate const sr : result.hw_params.sample_rates)
+    {
+        auto rate_params = hw_params;
+        set_interval_value(rate_params, SNDRV_PCM_HW_PARAM_RATE, sr.value());
+
+        sound_card_capabilities::sample_rate_capabilities rate_caps;
+        std::ranges::copy_if(
+                preferred_period_sizes,
+                std::back_inserter(rate_caps.period_sizes),
+                test_interval_value(
+                        fd,
+                        rate_params,
+                        SNDRV_PCM_HW_PARAM_PERIOD_SIZE),
+                &audio::period_size::value);
+        rate_caps.period_counts = refine_period_counts(rate_params);
+        rate_caps.by_period_size =
+                refine_by_period_size(rate_params, rate_caps.period_sizes);
+
+        result.by_sample_rate.push_back(std::move(rate_caps));
+    }
+
+    return result;
+}
+
 void
 set_hw_params(
         system::device& fd,
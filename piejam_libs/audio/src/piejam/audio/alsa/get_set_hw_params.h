@@ -15,6 +15,12 @@ auto get_hw_params(
         sample_rate const*,
         period_size const*) -> sound_card_hw_params;
 
+auto get_hw_params(system::device&, sample_rate const*, period_size const*)
+        -> sound_card_hw_params;
+
+//! Probes all parameter combinations, opening the device only once.
+auto get_capabilities(sound_card_descriptor const&) -> sound_card_capabilities;
+
 void set_hw_params(
         system::device&,
         sound_card_config const&,
@@ -0,0 +1,65 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "open_pcm.h"
+
+#include "get_set_hw_params.h"
+
+#include <piejam/audio/io_process_config.h>
+
+#include <sound/asound.h>
+#include <sys/ioctl.h>
+
+#include <limits>
+#include <system_error>
+
+namespace piejam::audio::alsa
+{
+
+auto
+open_pcm(
+        std::filesystem::path const& path,
+        sound_card_config const& device_config,
+        sound_card_buffer_config const& process_config) -> system::device
+{
+    if (!path.empty())
+    {
+        system::device fd(path);
+
+        set_hw_params(fd, device_config, process_config);
+
+        unsigned const buffer_size = process_config.period_size.value() *
+                                     process_config.period_count.value();
+        snd_pcm_sw_params sw_params{};
+        sw_params.proto = SNDRV_PCM_VERSION;
+        sw_params.tstamp_mode = SNDRV_PCM_TSTAMP_ENABLE;
+        sw_params.tstamp_type = SNDRV_PCM_TSTAMP_TYPE_MONOTONIC_RAW;
+        sw_params.period_step = 1;
+        sw_params.sleep_min = 0;
+        sw_params.avail_min = process_config.period_size.value();
+        sw_params.xfer_align = 1;
+        sw_params.start_threshold = buffer_size;
+        sw_params.stop_threshold = buffer_size;
+        sw_params.silence_threshold = 0;
+        sw_params.boundary = buffer_size;
+        while (sw_params.boundary * 2 <=
+               static_cast<long unsigned>(
+                       std::numeric_limits<long>::max() - buffer_size))
+        {
+            sw_params.boundary *= 2;
+        }
+        sw_params.silence_size = sw_params.boundary;
+
+        if (auto err = fd.ioctl(SNDRV_PCM_IOCTL_SW_PARAMS, sw_params))
+        {
+            throw std::system_error(err);
+        }
+
+        return fd;
+    }
+
+    return {};
+}
+
+} // namespace piejam::audio::alsa
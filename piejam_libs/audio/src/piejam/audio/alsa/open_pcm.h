@@ -0,0 +1,22 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/fwd.h>
+#include <piejam/system/device.h>
+
+#include <filesystem>
+
+namespace piejam::audio::alsa
+{
+
+//! Opens the pcm and sets its hw and sw params. Returns a closed device for
+//! an empty path.
+auto open_pcm(
+        std::filesystem::path const&,
+        sound_card_config const&,
+        sound_card_buffer_config const&) -> system::device;
+
+} // namespace piejam::audio::alsa
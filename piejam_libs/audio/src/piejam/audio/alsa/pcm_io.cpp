@@ -4,12 +4,15 @@
 
 #include "pcm_io.h"
 
-#include "get_set_hw_params.h"
+#include "aggregate_input.h"
+#include "open_pcm.h"
 #include "process_step.h"
 
+#include <piejam/algorithm/transform_to_vector.h>
 #include <piejam/audio/process_thread.h>
 #include <piejam/audio/sound_card_descriptor.h>
-#include <piejam/audio/sound_card_hw_params.h>
+
+#include <fmt/format.h>
 
 #include <spdlog/spdlog.h>
 
@@ -19,54 +22,43 @@
 
 #include <boost/assert.hpp>
 
+#include <exception>
+
 namespace piejam::audio::alsa
 {
 
-static auto
-open_pcm(
-        std::filesystem::path const& path,
-        sound_card_config const& device_config,
-        sound_card_buffer_config const& process_config) -> system::device
+namespace
 {
-    if (!path.empty())
-    {
-        system::device fd(path);
-
-        set_hw_params(fd, device_config, process_config);
-
-        unsigned const buffer_size = process_config.period_size.value() *
-                                     process_config.period_count.value();
-        snd_pcm_sw_params sw_params{};
-        sw_params.proto = SNDRV_PCM_VERSION;
-        sw_params.tstamp_mode = SNDRV_PCM_TSTAMP_ENABLE;
-        sw_params.tstamp_type = SNDRV_PCM_TSTAMP_TYPE_MONOTONIC_RAW;
-        sw_params.period_step = 1;
-        sw_params.sleep_min = 0;
-        sw_params.avail_min = process_config.period_size.value();
-        sw_params.xfer_align = 1;
-        sw_params.start_threshold = buffer_size;
-        sw_params.stop_threshold = buffer_size;
-        sw_params.silence_threshold = 0;
-        sw_params.boundary = buffer_size;
-        while (sw_params.boundary * 2 <=
-               static_cast<long unsigned>(
-                       std::numeric_limits<long>::max() - buffer_size))
-        {
-            sw_params.boundary *= 2;
-        }
-        sw_params.silence_size = sw_params.boundary;
 
-        if (auto err = fd.ioctl(SNDRV_PCM_IOCTL_SW_PARAMS, sw_params))
-        {
-            throw std::system_error(err);
-        }
-
-        return fd;
-    }
-
-    return {};
+// A device, which can't be opened, is left out, instead of failing the
+// master device along with it.
+auto
+open_aggregate_inputs(io_process_config const& io_config)
+        -> std::vector<std::unique_ptr<aggregate_input>>
+{
+    return algorithm::transform_to_vector(
+            io_config.aggregate_inputs,
+            [&io_config](aggregate_input_config const& config)
+                    -> std::unique_ptr<aggregate_input> {
+                try
+                {
+                    return std::make_unique<aggregate_input>(
+                            config,
+                            io_config.buffer_config);
+                }
+                catch (std::exception const& err)
+                {
+                    spdlog::error(
+                            "pcm_io: aggregate input {} not opened: {}",
+                            config.device.name,
+                            err.what());
+                    return nullptr;
+                }
+            });
 }
 
+} // namespace
+
 pcm_io::pcm_io() noexcept = default;
 
 pcm_io::pcm_io(
@@ -78,6 +70,7 @@ pcm_io::pcm_io(
     , m_output_fd(
               open_pcm(out.path, io_config.out_config, io_config.buffer_config))
     , m_io_config(io_config)
+    , m_aggregate_inputs(open_aggregate_inputs(io_config))
 {
     if (m_input_fd && m_output_fd)
     {
@@ -114,6 +107,8 @@ pcm_io::close()
 {
     BOOST_ASSERT(!is_running());
 
+    m_aggregate_inputs.clear();
+
     auto input_fd = std::move(m_input_fd);
     auto output_fd = std::move(m_output_fd);
 
@@ -144,15 +139,32 @@ pcm_io::start(
 
     m_xruns.store(0, std::memory_order_relaxed);
 
+    // The capture threads only resample, they can run on any cpu. They
+    // need to be scheduled as timely as the audio thread, though.
+    for (std::size_t i = 0; i < m_aggregate_inputs.size(); ++i)
+    {
+        if (!m_aggregate_inputs[i])
+        {
+            continue;
+        }
+
+        m_aggregate_inputs[i]->start(
+                {.affinity = {},
+                 .realtime_priority = thread_config.realtime_priority,
+                 .name = fmt::format("audio_capture_{}", i)});
+    }
+
     m_process_thread = std::make_unique<process_thread>();
     m_process_thread->start(
             thread_config,
             process_step(
                     m_input_fd,
                     m_output_fd,
+                    m_aggregate_inputs,
                     m_io_config,
                     m_cpu_load,
                     m_xruns,
+                    m_timing_history,
                     init_process_function,
                     std::move(process_function)));
 }
@@ -181,6 +193,26 @@ pcm_io::stop()
         auto const message = err.message();
         spdlog::error("pcm_io::stop: {}", message);
     }
+
+    for (auto& aggregate_input : m_aggregate_inputs)
+    {
+        if (aggregate_input)
+        {
+            aggregate_input->stop();
+        }
+    }
+}
+
+auto
+pcm_io::aggregate_inputs() const -> std::vector<aggregate_input_stats>
+{
+    return algorithm::transform_to_vector(
+            m_aggregate_inputs,
+            [](auto const& aggregate_input) {
+                return aggregate_input
+                               ? aggregate_input->stats()
+                               : aggregate_input_stats{.failed = true};
+            });
 }
 
 } // namespace piejam::audio::alsa
@@ -7,14 +7,18 @@
 #include <piejam/audio/fwd.h>
 #include <piejam/audio/io_process.h>
 #include <piejam/audio/io_process_config.h>
+#include <piejam/audio/period_timing.h>
 #include <piejam/system/device.h>
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 namespace piejam::audio::alsa
 {
 
+class aggregate_input;
+
 class pcm_io final : public piejam::audio::io_process
 {
 public:
@@ -50,13 +54,25 @@ public:
         return m_xruns.load(std::memory_order_relaxed);
     }
 
+    [[nodiscard]]
+    auto take_xrun_period_timings() -> std::vector<period_timing> override
+    {
+        return m_timing_history.take_snapshot();
+    }
+
+    [[nodiscard]]
+    auto aggregate_inputs() const
+            -> std::vector<aggregate_input_stats> override;
+
 private:
     system::device m_input_fd;
     system::device m_output_fd;
     io_process_config m_io_config;
+    std::vector<std::unique_ptr<aggregate_input>> m_aggregate_inputs;
 
     std::atomic<float> m_cpu_load{};
     std::atomic_size_t m_xruns{};
+    period_timing_history m_timing_history;
 
     std::unique_ptr<process_thread> m_process_thread;
 };
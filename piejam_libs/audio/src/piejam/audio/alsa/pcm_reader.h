@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <piejam/audio/fwd.h>
 #include <piejam/audio/pcm_buffer_converter.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/system/fwd.h>
 
+#include <memory>
 #include <span>
 #include <system_error>
 
@@ -28,4 +32,8 @@ public:
     virtual void clear() noexcept = 0;
 };
 
+//! Reads periods of the device, a dummy one if it is closed.
+auto make_reader(system::device&, sound_card_config const&, period_size)
+        -> std::unique_ptr<pcm_reader>;
+
 } // namespace piejam::audio::alsa
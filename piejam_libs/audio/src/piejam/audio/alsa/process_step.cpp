@@ -4,6 +4,7 @@
 
 #include "process_step.h"
 
+#include "aggregate_input.h"
 #include "pcm_reader.h"
 #include "pcm_writer.h"
 
@@ -13,6 +14,7 @@
 #include <piejam/audio/pcm_convert.h>
 #include <piejam/audio/pcm_format.h>
 #include <piejam/audio/pcm_sample_type.h>
+#include <piejam/audio/period_timing.h>
 #include <piejam/audio/types.h>
 #include <piejam/numeric/rolling_mean.h>
 #include <piejam/range/iota.h>
@@ -25,6 +27,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <iterator>
 
 namespace piejam::audio::alsa
 {
@@ -184,6 +187,8 @@ private:
     std::vector<converter_f> m_converter;
 };
 
+} // namespace
+
 auto
 make_reader(
         system::device& fd,
@@ -235,6 +240,9 @@ make_reader(
     }
 }
 
+namespace
+{
+
 struct dummy_writer final : pcm_writer
 {
     [[nodiscard]]
@@ -396,16 +404,20 @@ make_writer(
 process_step::process_step(
         system::device& input_fd,
         system::device& output_fd,
+        std::span<std::unique_ptr<aggregate_input> const> aggregate_inputs,
         io_process_config const& io_config,
         std::atomic<float>& cpu_load,
         std::atomic_size_t& xruns,
+        period_timing_history& timing_history,
         init_process_function const& init_process_function,
         process_function process_function)
     : m_input_fd(input_fd)
     , m_output_fd(output_fd)
+    , m_aggregate_inputs(aggregate_inputs)
     , m_io_config(io_config)
     , m_cpu_load(cpu_load)
     , m_xruns(xruns)
+    , m_timing_history(timing_history)
     , m_process_function(std::move(process_function))
     , m_reader(make_reader(
               m_input_fd,
@@ -422,7 +434,34 @@ process_step::process_step(
 {
     m_xruns.store(0, std::memory_order_relaxed);
 
-    init_process_function(m_reader->converter(), m_writer->converter());
+    // the channels of the aggregate inputs follow the ones of the device,
+    // the ones of a device which couldn't be opened are silent
+    std::ranges::copy(
+            m_reader->converter(),
+            std::back_inserter(m_input_converter));
+    BOOST_ASSERT(
+            m_aggregate_inputs.size() == m_io_config.aggregate_inputs.size());
+    for (std::size_t i = 0; i < m_aggregate_inputs.size(); ++i)
+    {
+        if (m_aggregate_inputs[i])
+        {
+            std::ranges::copy(
+                    m_aggregate_inputs[i]->converter(),
+                    std::back_inserter(m_input_converter));
+        }
+        else
+        {
+            std::fill_n(
+                    std::back_inserter(m_input_converter),
+                    m_io_config.aggregate_inputs[i].config.num_channels,
+                    pcm_input_buffer_converter(
+                            [](std::span<float> const buffer) {
+                                std::ranges::fill(buffer, 0.f);
+                            }));
+        }
+    }
+
+    init_process_function(m_input_converter, m_writer->converter());
 }
 
 process_step::process_step(process_step&&) = default;
@@ -465,30 +504,57 @@ process_step::operator()() -> std::error_condition
 
         m_reader->clear();
 
+        m_timing_history.make_current();
+
         m_starting = false;
     }
 
+    m_timing_history.begin_period();
+
     auto err = m_reader->transfer();
 
     if (!err)
     {
+        for (auto const& aggregate_input : m_aggregate_inputs)
+        {
+            if (aggregate_input)
+            {
+                aggregate_input->read(
+                        m_io_config.buffer_config.period_size.value());
+            }
+        }
+
+        m_timing_history.mark(period_event::read_complete);
+
         cpu_load_meter cpu_load_meter(
                 m_io_config.buffer_config.period_size.value(),
                 m_io_config.buffer_config.sample_rate);
 
+        m_timing_history.mark(period_event::graph_start);
+
         m_process_function(m_io_config.buffer_config.period_size.value());
 
+        m_timing_history.mark(period_event::graph_end);
+
         m_cpu_load.store(
                 m_cpu_load_mean_acc(cpu_load_meter.stop()),
                 std::memory_order_relaxed);
 
         err = m_writer->transfer();
+
+        if (!err)
+        {
+            m_timing_history.mark(period_event::write_complete);
+        }
     }
 
     if (err)
     {
         if (err == std::make_error_code(std::errc::broken_pipe))
         {
+            m_timing_history.mark(period_event::xrun);
+            m_timing_history.snapshot();
+
             m_starting = true;
             ++m_xruns;
         }
@@ -4,19 +4,23 @@
 
 #pragma once
 
+#include <piejam/audio/fwd.h>
 #include <piejam/audio/io_process_config.h>
+#include <piejam/audio/pcm_buffer_converter.h>
 #include <piejam/audio/process_function.h>
 #include <piejam/numeric/rolling_mean.h>
 #include <piejam/system/fwd.h>
 
 #include <atomic>
 #include <memory>
+#include <span>
 #include <system_error>
 #include <vector>
 
 namespace piejam::audio::alsa
 {
 
+class aggregate_input;
 class pcm_reader;
 class pcm_writer;
 
@@ -26,9 +30,11 @@ public:
     process_step(
             system::device& input_fd,
             system::device& output_fd,
+            std::span<std::unique_ptr<aggregate_input> const> aggregate_inputs,
             io_process_config const&,
             std::atomic<float>& cpu_load,
             std::atomic_size_t& xruns,
+            period_timing_history&,
             init_process_function const&,
             process_function);
     process_step(process_step&&);
@@ -40,14 +46,17 @@ public:
 private:
     system::device& m_input_fd;
     system::device& m_output_fd;
+    std::span<std::unique_ptr<aggregate_input> const> m_aggregate_inputs;
     io_process_config m_io_config;
     std::atomic<float>& m_cpu_load;
     std::atomic_size_t& m_xruns;
+    period_timing_history& m_timing_history;
     process_function m_process_function;
 
     bool m_starting{true};
     std::unique_ptr<pcm_reader> m_reader;
     std::unique_ptr<pcm_writer> m_writer;
+    std::vector<pcm_input_buffer_converter> m_input_converter;
     numeric::rolling_mean<float> m_cpu_load_mean_acc;
 };
 
@@ -0,0 +1,252 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/async_input_buffer.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace piejam::audio
+{
+
+namespace
+{
+
+// Averages out the scheduling jitter of both threads.
+constexpr double fill_smoothing_time = 0.5; // sec
+
+// Time constant of the control loop, which is critically damped. Slow
+// enough to not modulate the pitch audibly, fast enough to catch up with
+// a cold start within a few seconds.
+constexpr double control_time = 4.; // sec
+
+// Crystals deviate by tens of ppm, anything beyond is a misconfiguration.
+constexpr double max_correction = 0.002;
+
+} // namespace
+
+async_input_buffer::async_input_buffer(
+        std::size_t const num_channels,
+        sound_card_buffer_config const& device,
+        sound_card_buffer_config const& master)
+    : m_num_channels(num_channels)
+    , m_max_frames(master.period_size.value())
+    , m_nominal_ratio(
+              static_cast<double>(master.sample_rate.value()) /
+              static_cast<double>(device.sample_rate.value()))
+    , m_sample_rate(static_cast<double>(master.sample_rate.value()))
+    , m_device_period(
+              static_cast<double>(device.period_size.value()) *
+              m_nominal_ratio)
+    // The audio thread needs a period, the device delivers in periods as
+    // well. The remaining period covers the scheduling jitter of the
+    // capture thread and the control error.
+    , m_target_fill(
+              static_cast<double>(master.period_size.value()) +
+              2. * m_device_period)
+    , m_resamplers(num_channels, dsp::resampler(m_nominal_ratio))
+    , m_ring(4 * static_cast<std::size_t>(m_target_fill) * num_channels)
+    , m_read_buffer(m_max_frames * num_channels)
+    , m_output(m_max_frames * num_channels)
+{
+    BOOST_ASSERT(num_channels > 0);
+
+    m_resampler_latency = static_cast<double>(m_resamplers[0].latency()) *
+                          m_nominal_ratio;
+
+    // room for the output at the highest corrected ratio
+    double const max_ratio = m_nominal_ratio * (1. + max_correction);
+    std::size_t const max_resampled =
+            static_cast<std::size_t>(
+                    std::ceil(device.period_size.value() * max_ratio)) +
+            1;
+    m_resampled.resize(max_resampled * num_channels);
+    m_write_buffer.resize(max_resampled * num_channels);
+}
+
+async_input_buffer::~async_input_buffer() = default;
+
+void
+async_input_buffer::write(
+        std::span<std::span<float const> const> const channels,
+        time_point const now) noexcept
+{
+    BOOST_ASSERT(channels.size() == m_num_channels);
+
+    double const ratio = m_nominal_ratio *
+                         m_ratio_correction.load(std::memory_order_relaxed);
+
+    std::size_t const max_resampled = m_resampled.size() / m_num_channels;
+
+    std::size_t frames{};
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        auto& resampler = m_resamplers[ch];
+        resampler.set_ratio(ratio);
+
+        // all channels advance in lockstep
+        std::size_t const written = resampler.process(
+                channels[ch],
+                std::span{m_resampled}.subspan(
+                        ch * max_resampled,
+                        max_resampled));
+        BOOST_ASSERT(ch == 0 || written == frames);
+        frames = written;
+    }
+
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            m_write_buffer[frame * m_num_channels + ch] =
+                    m_resampled[ch * max_resampled + frame];
+        }
+    }
+
+    if (m_ring.push(std::span<float const>{m_write_buffer}.first(
+                frames * m_num_channels)))
+    {
+        m_frames_written += frames;
+        m_deliveries.push(delivery{.time = now, .frames = m_frames_written});
+    }
+    else
+    {
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+async_input_buffer::read(
+        std::size_t const frames,
+        time_point const now) noexcept
+{
+    BOOST_ASSERT(frames <= m_max_frames);
+
+    m_frames = frames;
+
+    // After a cold start, an underrun or a stall of the audio thread, the
+    // buffer is brought to the target at once, instead of drifting there.
+    if (std::size_t const fill = m_ring.size() / m_num_channels;
+        !m_running || static_cast<double>(fill) > 2. * m_target_fill)
+    {
+        if (static_cast<double>(fill) < m_target_fill)
+        {
+            std::ranges::fill(m_output, 0.f);
+            return;
+        }
+
+        resync(fill);
+    }
+
+    double const fill = estimate_fill(now);
+
+    auto const read_buffer =
+            std::span{m_read_buffer}.first(frames * m_num_channels);
+    if (!m_ring.pop(read_buffer))
+    {
+        m_underruns.fetch_add(1, std::memory_order_relaxed);
+        m_running = false;
+        std::ranges::fill(m_output, 0.f);
+        return;
+    }
+
+    m_frames_read += frames;
+
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        for (std::size_t frame = 0; frame < frames; ++frame)
+        {
+            m_output[ch * frames + frame] =
+                    read_buffer[frame * m_num_channels + ch];
+        }
+    }
+
+    control(fill);
+}
+
+void
+async_input_buffer::resync(std::size_t fill) noexcept
+{
+    auto const target = static_cast<std::size_t>(m_target_fill);
+    while (fill > target)
+    {
+        std::size_t const drop = std::min(fill - target, m_max_frames);
+        m_ring.pop(std::span{m_read_buffer}.first(drop * m_num_channels));
+        m_frames_read += drop;
+        fill -= drop;
+    }
+
+    m_fill_mean = m_target_fill;
+    m_running = true;
+}
+
+auto
+async_input_buffer::estimate_fill(time_point const now) noexcept -> double
+{
+    m_deliveries.pull(m_last_delivery);
+
+    // The fill level jumps by a period, whenever the device delivers. The
+    // frames it captured since its last delivery are counted in as well,
+    // otherwise the phase between both clocks would show up as a slowly
+    // wandering fill level.
+    double const since_delivery =
+            std::chrono::duration<double>(now - m_last_delivery.time).count() *
+            m_sample_rate;
+
+    return static_cast<double>(m_last_delivery.frames) -
+           static_cast<double>(m_frames_read) +
+           std::clamp(since_delivery, 0., m_device_period);
+}
+
+void
+async_input_buffer::control(double const fill) noexcept
+{
+    double const dt = static_cast<double>(m_frames) / m_sample_rate;
+
+    m_fill_mean +=
+            (fill - m_fill_mean) * (1. - std::exp(-dt / fill_smoothing_time));
+
+    // The fill level changes by correction * sample_rate frames per second.
+    // With these gains, both poles of the loop are at -1 / control_time.
+    double const error = (m_fill_mean - m_target_fill) / m_sample_rate;
+
+    m_drift = std::clamp(
+            m_drift + error * dt / (control_time * control_time),
+            -max_correction,
+            max_correction);
+
+    double const correction = std::clamp(
+            2. * error / control_time + m_drift,
+            -max_correction,
+            max_correction);
+
+    m_ratio_correction.store(1. - correction, std::memory_order_relaxed);
+
+    m_stats_fill.store(
+            static_cast<float>(m_fill_mean / m_target_fill),
+            std::memory_order_relaxed);
+    m_stats_drift.store(
+            static_cast<float>(m_drift * 1e6),
+            std::memory_order_relaxed);
+    m_stats_latency.store(
+            static_cast<float>(m_fill_mean + m_resampler_latency),
+            std::memory_order_relaxed);
+}
+
+auto
+async_input_buffer::stats() const noexcept -> aggregate_input_stats
+{
+    return {.latency = static_cast<std::size_t>(std::lround(
+                    m_stats_latency.load(std::memory_order_relaxed))),
+            .buffer_fill = m_stats_fill.load(std::memory_order_relaxed),
+            .drift_ppm = m_stats_drift.load(std::memory_order_relaxed),
+            .underruns = m_underruns.load(std::memory_order_relaxed),
+            .overruns = m_overruns.load(std::memory_order_relaxed),
+            .xruns = {}};
+}
+
+} // namespace piejam::audio
@@ -5,9 +5,11 @@
 #include <piejam/audio/engine/dag.h>
 
 #include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/audio/alloc_debug.h>
 #include <piejam/audio/engine/dag_executor.h>
 #include <piejam/audio/engine/event_buffer_memory.h>
 #include <piejam/audio/engine/thread_context.h>
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/range/indices.h>
 #include <piejam/thread/worker.h>
 
@@ -16,6 +18,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <ranges>
 #include <span>
 #include <vector>
@@ -26,6 +29,8 @@ namespace piejam::audio::engine
 namespace
 {
 
+using clock = std::chrono::steady_clock;
+
 class dag_executor_base : public dag_executor
 {
 protected:
@@ -91,9 +96,11 @@ public:
     dag_executor_st(
             dag::tasks_t const& tasks,
             dag::graph_t const& graph,
-            std::size_t const event_memory_size)
+            std::size_t const event_memory_size,
+            worker_telemetry* const telemetry)
         : dag_executor_base(tasks, graph)
         , m_event_memory(event_memory_size)
+        , m_telemetry(telemetry)
     {
         m_run_queue.reserve(m_nodes.size());
     }
@@ -113,6 +120,9 @@ public:
 
         m_thread_context.buffer_size = buffer_size;
 
+        auto const start = m_telemetry ? clock::now() : clock::time_point{};
+        std::uint64_t tasks{};
+
         while (!m_run_queue.empty())
         {
             node* const nd = m_run_queue.back();
@@ -122,6 +132,7 @@ public:
                     nd->parents_to_process.load(std::memory_order_relaxed) ==
                     0);
             nd->task(m_thread_context);
+            ++tasks;
 
             for (node& child : nd->children)
             {
@@ -135,6 +146,16 @@ public:
             }
         }
 
+        if (m_telemetry)
+        {
+            m_telemetry->update(
+                    0,
+                    {.busy = clock::now() - start,
+                     .steal = {},
+                     .tasks = tasks,
+                     .steals = 0});
+        }
+
         m_event_memory.release();
     }
 
@@ -143,6 +164,7 @@ private:
     audio::engine::thread_context m_thread_context{
             &m_event_memory.memory_resource()};
     std::vector<node*> m_run_queue;
+    worker_telemetry* m_telemetry;
 };
 
 class dag_executor_mt final : public dag_executor_base
@@ -158,7 +180,8 @@ public:
             dag::tasks_t const& tasks,
             dag::graph_t const& graph,
             std::size_t const event_memory_size,
-            std::span<thread::worker> const worker_threads)
+            std::span<thread::worker> const worker_threads,
+            worker_telemetry* const telemetry)
         : dag_executor_base(tasks, graph)
         , m_worker_threads(worker_threads)
         , m_initial_tasks(collect_initial_tasks(m_nodes))
@@ -166,13 +189,16 @@ public:
                   event_memory_size,
                   m_nodes_to_process,
                   m_buffer_size,
-                  m_run_queue)
+                  m_run_queue,
+                  telemetry,
+                  0)
         , m_workers(make_workers(
                   worker_threads.size(),
                   event_memory_size,
                   m_nodes_to_process,
                   m_buffer_size,
-                  m_run_queue))
+                  m_run_queue,
+                  telemetry))
     {
     }
 
@@ -232,35 +258,92 @@ private:
                 std::size_t const event_memory_size,
                 std::atomic_size_t& nodes_to_process,
                 std::atomic_size_t& buffer_size,
-                jobs_t& run_queue)
+                jobs_t& run_queue,
+                worker_telemetry* const telemetry,
+                std::size_t const thread_index)
             : m_event_memory(event_memory_size)
             , m_nodes_to_process(nodes_to_process)
             , m_buffer_size(buffer_size)
             , m_run_queue(run_queue)
+            , m_telemetry(telemetry)
+            , m_thread_index(thread_index)
         {
         }
 
         void operator()()
         {
+            // The worker threads are owned by the runtime, they become
+            // real-time threads with their first task. The main worker runs
+            // on the calling thread, which is marked by its owner.
+            if (m_thread_index != 0)
+            {
+                prohibit_dynamic_memory_allocation();
+            }
+
             m_thread_context.buffer_size =
                     m_buffer_size.load(std::memory_order_relaxed);
 
+            if (m_telemetry)
+            {
+                run_measured();
+            }
+            else
+            {
+                run();
+            }
+
+            m_event_memory.release();
+        }
+
+    private:
+        void run()
+        {
             while (m_nodes_to_process.load(std::memory_order_acquire))
             {
                 node* n{};
                 if (m_run_queue.pop(n))
                 {
-                    while (n)
-                    {
-                        n = process_node(*n);
-                    }
+                    process_chain(n);
                 }
             }
+        }
 
-            m_event_memory.release();
+        // Everything outside of a task chain counts as steal time, this is
+        // the time spent spinning on the shared run queue.
+        void run_measured()
+        {
+            worker_period period;
+            auto const start = clock::now();
+
+            while (m_nodes_to_process.load(std::memory_order_acquire))
+            {
+                node* n{};
+                if (m_run_queue.pop(n))
+                {
+                    auto const chain_start = clock::now();
+                    period.tasks += process_chain(n);
+                    period.busy += clock::now() - chain_start;
+                    ++period.steals;
+                }
+            }
+
+            period.steal = (clock::now() - start) - period.busy;
+            m_telemetry->update(m_thread_index, period);
+        }
+
+        auto process_chain(node* n) -> std::size_t
+        {
+            std::size_t num_processed{};
+
+            while (n)
+            {
+                n = process_node(*n);
+                ++num_processed;
+            }
+
+            return num_processed;
         }
 
-    private:
         auto process_node(node& n) -> node*
         {
             BOOST_ASSERT(
@@ -299,6 +382,8 @@ private:
         std::atomic_size_t& m_nodes_to_process;
         std::atomic_size_t& m_buffer_size;
         jobs_t& m_run_queue;
+        worker_telemetry* m_telemetry;
+        std::size_t m_thread_index;
 
         static_assert(std::atomic_size_t::is_always_lock_free);
     };
@@ -310,7 +395,8 @@ private:
             std::size_t const event_memory_size,
             std::atomic_size_t& nodes_to_process,
             std::atomic_size_t& buffer_size,
-            jobs_t& run_queue) -> workers_t
+            jobs_t& run_queue,
+            worker_telemetry* const telemetry) -> workers_t
     {
         workers_t workers;
         workers.reserve(num_workers);
@@ -321,7 +407,9 @@ private:
                     event_memory_size,
                     nodes_to_process,
                     buffer_size,
-                    run_queue);
+                    run_queue,
+                    telemetry,
+                    i);
         }
 
         return workers;
@@ -400,21 +488,27 @@ dag::add_child(task_id_t const parent, task_id_t const child)
 auto
 dag::make_runnable(
         std::span<thread::worker> const worker_threads,
-        std::size_t const event_memory_size) -> std::unique_ptr<dag_executor>
+        std::size_t const event_memory_size,
+        worker_telemetry* const telemetry) -> std::unique_ptr<dag_executor>
 {
+    BOOST_ASSERT(
+            !telemetry || telemetry->num_threads() > worker_threads.size());
+
     if (worker_threads.empty())
     {
         return std::make_unique<dag_executor_st>(
                 m_tasks,
                 m_graph,
-                event_memory_size);
+                event_memory_size,
+                telemetry);
     }
 
     return std::make_unique<dag_executor_mt>(
             m_tasks,
             m_graph,
             event_memory_size,
-            worker_threads);
+            worker_threads,
+            telemetry);
 }
 
 } // namespace piejam::audio::engine
@@ -0,0 +1,247 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/delay_line_pool.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <utility>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+constexpr auto
+run_mask(std::size_t const num_blocks) noexcept -> std::uint64_t
+{
+    return num_blocks == delay_line_pool::blocks_per_word
+                   ? ~std::uint64_t{}
+                   : (std::uint64_t{1} << num_blocks) - 1;
+}
+
+constexpr auto
+num_words(std::size_t const num_blocks) noexcept -> std::size_t
+{
+    return (num_blocks + delay_line_pool::blocks_per_word - 1) /
+           delay_line_pool::blocks_per_word;
+}
+
+} // namespace
+
+delay_line_buffer::delay_line_buffer(
+        delay_line_pool& pool,
+        std::span<float> const frames) noexcept
+    : m_pool(&pool)
+    , m_frames(frames)
+{
+}
+
+delay_line_buffer::delay_line_buffer(delay_line_buffer&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr))
+    , m_frames(std::exchange(other.m_frames, {}))
+{
+}
+
+delay_line_buffer::~delay_line_buffer()
+{
+    if (m_pool)
+    {
+        m_pool->release(m_frames);
+    }
+}
+
+auto
+delay_line_buffer::operator=(delay_line_buffer&& other) noexcept
+        -> delay_line_buffer&
+{
+    if (this != &other)
+    {
+        if (m_pool)
+        {
+            m_pool->release(m_frames);
+        }
+
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_frames = std::exchange(other.m_frames, {});
+    }
+
+    return *this;
+}
+
+// The blocks are zeroed here, so the pages are mapped before the audio
+// thread writes to them.
+delay_line_pool::delay_line_pool(std::size_t const num_blocks)
+    : m_blocks(std::make_unique<block[]>(
+              num_words(num_blocks) * blocks_per_word))
+    , m_used(num_words(num_blocks))
+{
+}
+
+delay_line_pool::~delay_line_pool()
+{
+    BOOST_ASSERT(num_free_blocks() == num_blocks());
+}
+
+auto
+delay_line_pool::num_blocks() const noexcept -> std::size_t
+{
+    return m_used.size() * blocks_per_word;
+}
+
+auto
+delay_line_pool::num_free_blocks() const noexcept -> std::size_t
+{
+    return std::accumulate(
+            m_used.begin(),
+            m_used.end(),
+            num_blocks(),
+            [](std::size_t const free, auto const& used) {
+                return free - static_cast<std::size_t>(std::popcount(
+                                      used.load(std::memory_order_relaxed)));
+            });
+}
+
+auto
+delay_line_pool::allocate(std::size_t const min_frames) -> delay_line_buffer
+{
+    std::size_t const min_blocks = std::max(
+            (min_frames + block_frames - 1) / block_frames,
+            std::size_t{1});
+    if (min_blocks > num_blocks())
+    {
+        return {};
+    }
+
+    std::size_t const run_blocks = std::bit_ceil(min_blocks);
+    auto const frames = run_blocks <= blocks_per_word
+                                ? allocate_in_word(run_blocks)
+                                : allocate_words(run_blocks / blocks_per_word);
+    if (frames.empty())
+    {
+        return {};
+    }
+
+    std::ranges::fill(frames, 0.f);
+    return delay_line_buffer{*this, frames};
+}
+
+auto
+delay_line_pool::allocate_in_word(std::size_t const run_blocks)
+        -> std::span<float>
+{
+    std::uint64_t const mask = run_mask(run_blocks);
+
+    for (std::size_t word = 0; word < m_used.size(); ++word)
+    {
+        std::uint64_t used = m_used[word].load(std::memory_order_relaxed);
+
+        for (std::size_t offset = 0; offset < blocks_per_word;)
+        {
+            std::uint64_t const run = mask << offset;
+            if (used & run)
+            {
+                offset += run_blocks;
+                continue;
+            }
+
+            if (m_used[word].compare_exchange_weak(
+                        used,
+                        used | run,
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed))
+            {
+                std::size_t const first = word * blocks_per_word + offset;
+                return std::span{
+                        m_blocks[first].frames,
+                        run_blocks * block_frames};
+            }
+
+            // used was reloaded, try the same run again
+        }
+    }
+
+    return {};
+}
+
+// The words are claimed one by one. If one of them is taken, the ones
+// claimed so far are given back and the next aligned run is tried.
+auto
+delay_line_pool::allocate_words(std::size_t const run_words) -> std::span<float>
+{
+    for (std::size_t word = 0; word + run_words <= m_used.size();
+         word += run_words)
+    {
+        std::size_t claimed = 0;
+        for (; claimed < run_words; ++claimed)
+        {
+            std::uint64_t expected{};
+            if (!m_used[word + claimed].compare_exchange_strong(
+                        expected,
+                        ~std::uint64_t{},
+                        std::memory_order_acquire,
+                        std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        if (claimed == run_words)
+        {
+            return std::span{
+                    m_blocks[word * blocks_per_word].frames,
+                    run_words * blocks_per_word * block_frames};
+        }
+
+        while (claimed > 0)
+        {
+            m_used[word + --claimed].store(0, std::memory_order_release);
+        }
+    }
+
+    return {};
+}
+
+void
+delay_line_pool::release(std::span<float> const frames) noexcept
+{
+    auto const first = static_cast<std::size_t>(
+            reinterpret_cast<block const*>(frames.data()) - m_blocks.get());
+    std::size_t const run_blocks = frames.size() / block_frames;
+
+    BOOST_ASSERT(first < num_blocks());
+    BOOST_ASSERT(std::has_single_bit(run_blocks));
+
+    if (run_blocks > blocks_per_word)
+    {
+        std::size_t const first_word = first / blocks_per_word;
+        for (std::size_t word = first_word;
+             word < first_word + run_blocks / blocks_per_word;
+             ++word)
+        {
+            BOOST_ASSERT(
+                    m_used[word].load(std::memory_order_relaxed) ==
+                    ~std::uint64_t{});
+            m_used[word].store(0, std::memory_order_release);
+        }
+
+        return;
+    }
+
+    std::uint64_t const run = run_mask(run_blocks)
+                              << (first % blocks_per_word);
+    BOOST_ASSERT(
+            (m_used[first / blocks_per_word].load(std::memory_order_relaxed) &
+             run) == run);
+
+    m_used[first / blocks_per_word].fetch_and(
+            ~run,
+            std::memory_order_release);
+}
+
+} // namespace piejam::audio::engine
@@ -15,27 +15,187 @@
 #include <piejam/functional/address_compare.h>
 
 #include <boost/assert.hpp>
+#include <boost/dynamic_bitset.hpp>
 
 #include <array>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace piejam::audio::engine
 {
 
+namespace
+{
+
+using processor_job_mapping_t = std::map<
+        std::reference_wrapper<processor>,
+        std::pair<dag::task_id_t, processor_job*>,
+        decltype(address_less<processor>)>;
+
+using job_set = boost::dynamic_bitset<>;
+
+// Output buffers are allocated from a shared pool, register allocation
+// style. A buffer is reused by a job, when all users of its previous
+// assignment are ancestors of the job in the DAG. Jobs which may run
+// concurrently in the multithreaded executor never share a buffer.
+//
+// Users of an output are the producer and all consumers of the output.
+// If a consumer may forward its inputs as results, the consumers of its
+// results are users of the output as well.
+void
+assign_output_buffers(
+        graph const& g,
+        dag const& d,
+        processor_job_mapping_t const& processor_job_mapping)
+{
+    std::size_t const num_jobs = processor_job_mapping.size();
+
+    std::vector<processor_job*> jobs;
+    jobs.reserve(num_jobs);
+    std::unordered_map<dag::task_id_t, std::size_t> job_index;
+    for (auto const& [id, job] : processor_job_mapping | std::views::values)
+    {
+        job_index.emplace(id, jobs.size());
+        jobs.push_back(job);
+    }
+
+    std::vector<std::vector<std::size_t>> children(num_jobs);
+    std::vector<std::size_t> num_parents(num_jobs);
+    for (auto const& [parent_id, child_ids] : d.graph())
+    {
+        for (dag::task_id_t const child_id : child_ids)
+        {
+            children[job_index.at(parent_id)].push_back(
+                    job_index.at(child_id));
+            ++num_parents[job_index.at(child_id)];
+        }
+    }
+
+    // topological order, ancestors are propagated along the way
+    std::vector<std::size_t> order;
+    order.reserve(num_jobs);
+    for (std::size_t i = 0; i < num_jobs; ++i)
+    {
+        if (num_parents[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+
+    std::vector<job_set> ancestors(num_jobs, job_set(num_jobs));
+    for (std::size_t n = 0; n < order.size(); ++n)
+    {
+        std::size_t const parent = order[n];
+        for (std::size_t const child : children[parent])
+        {
+            ancestors[child] |= ancestors[parent];
+            ancestors[child].set(parent);
+
+            if (--num_parents[child] == 0)
+            {
+                order.push_back(child);
+            }
+        }
+    }
+
+    BOOST_ASSERT(order.size() == num_jobs);
+
+    // (output port, consumer) per job
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> consumers(
+            num_jobs);
+    for (auto const& [src, dst] : g.audio)
+    {
+        consumers[job_index.at(processor_job_mapping.at(src.proc).first)]
+                .emplace_back(
+                        src.port,
+                        job_index.at(processor_job_mapping.at(dst.proc).first));
+    }
+
+    auto users_of = [&](std::size_t const producer, std::size_t const port) {
+        job_set users(num_jobs);
+        users.set(producer);
+
+        std::vector<std::size_t> forwarding;
+        auto add_user = [&](std::size_t const consumer) {
+            if (!users.test(consumer))
+            {
+                users.set(consumer);
+                if (jobs[consumer]->proc().may_forward_inputs())
+                {
+                    forwarding.push_back(consumer);
+                }
+            }
+        };
+
+        for (auto const& [src_port, consumer] : consumers[producer])
+        {
+            if (src_port == port)
+            {
+                add_user(consumer);
+            }
+        }
+
+        while (!forwarding.empty())
+        {
+            std::size_t const forwarder = forwarding.back();
+            forwarding.pop_back();
+
+            for (std::size_t const consumer :
+                 consumers[forwarder] | std::views::values)
+            {
+                add_user(consumer);
+            }
+        }
+
+        return users;
+    };
+
+    std::vector<job_set> buffer_users;
+    std::vector<std::vector<std::size_t>> assignments(num_jobs);
+    for (std::size_t const job : order)
+    {
+        std::size_t const num_outputs = jobs[job]->proc().num_outputs();
+        for (std::size_t port = 0; port < num_outputs; ++port)
+        {
+            auto it = std::ranges::find_if(
+                    buffer_users,
+                    [&](job_set const& users) {
+                        return users.is_subset_of(ancestors[job]);
+                    });
+
+            if (it == buffer_users.end())
+            {
+                it = buffer_users.insert(it, job_set(num_jobs));
+            }
+
+            // the job itself is a user, so its other outputs won't get the
+            // same buffer
+            *it = users_of(job, port);
+            assignments[job].push_back(
+                    static_cast<std::size_t>(it - buffer_users.begin()));
+        }
+    }
+
+    auto pool = std::make_shared<processor_job::output_buffers_t>(
+            buffer_users.size());
+    for (std::size_t job = 0; job < num_jobs; ++job)
+    {
+        jobs[job]->assign_output_buffers(pool, assignments[job]);
+    }
+}
+
+} // namespace
+
 auto
 graph_to_dag(graph const& g) -> dag
 {
     dag result;
 
-    std::map<
-            std::reference_wrapper<processor>,
-            std::pair<dag::task_id_t, processor_job*>,
-            decltype(address_less<processor>)>
-            processor_job_mapping;
+    processor_job_mapping_t processor_job_mapping;
 
     std::vector<processor_job*> clear_event_buffer_jobs;
 
@@ -111,6 +271,8 @@ graph_to_dag(graph const& g) -> dag
                 src_job->event_result_ref(src.port));
     }
 
+    assign_output_buffers(g, result, processor_job_mapping);
+
     // if we have processors with event outputs, we need to clear their
     // buffers as last step
     if (!clear_event_buffer_jobs.empty())
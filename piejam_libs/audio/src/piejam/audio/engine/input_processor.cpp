@@ -6,6 +6,9 @@
 
 #include <piejam/audio/engine/process_context.h>
 #include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/slice.h>
+
+#include <algorithm>
 
 namespace piejam::audio::engine
 {
@@ -21,7 +24,17 @@ input_processor::process(process_context const& ctx)
     verify_process_context(*this, ctx);
 
     m_engine_input(ctx.outputs[0]);
-    ctx.results[0] = ctx.outputs[0];
+
+    // Silence from an unplugged input is passed on as constant, so the
+    // processors downstream can take their constant paths or are skipped.
+    if (std::ranges::all_of(ctx.outputs[0], [](float x) { return x == 0.f; }))
+    {
+        ctx.results[0] = 0.f;
+    }
+    else
+    {
+        ctx.results[0] = ctx.outputs[0];
+    }
 }
 
 } // namespace piejam::audio::engine
@@ -97,6 +97,11 @@ public:
         return {};
     }
 
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return 0;
+    }
+
     void process(process_context const& ctx) override
     {
         verify_process_context(*this, ctx);
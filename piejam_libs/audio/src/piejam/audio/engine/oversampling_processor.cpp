@@ -0,0 +1,322 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/oversampling_processor.h>
+
+#include <piejam/audio/dsp/halfband.h>
+#include <piejam/audio/engine/event_input_buffers.h>
+#include <piejam/audio/engine/event_output_buffers.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/process_context.h>
+#include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/period_size.h>
+#include <piejam/audio/slice.h>
+#include <piejam/npos.h>
+
+#include <mipp.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+// The filters, the IIR ones included, have decayed below -120 dB after
+// that many frames.
+constexpr std::size_t filters_silence_tail = 512;
+
+// The first stage, between the base and the doubled rate, passes up to
+// 20 kHz at 48 kHz. The second stage only needs to reject what the first
+// one leaves, so it can be much shorter.
+struct fir_design
+{
+    using upsampler = dsp::fir_halfband_upsampler;
+    using downsampler = dsp::fir_halfband_downsampler;
+
+    static auto make(std::size_t const stage) -> std::vector<float>
+    {
+        return stage == 0 ? dsp::make_fir_halfband_taps(32, 8.)
+                          : dsp::make_fir_halfband_taps(16, 7.);
+    }
+};
+
+struct iir_design
+{
+    using upsampler = dsp::iir_halfband_upsampler;
+    using downsampler = dsp::iir_halfband_downsampler;
+
+    static auto make(std::size_t const stage) -> std::vector<float>
+    {
+        return stage == 0 ? dsp::make_iir_halfband_coefficients(8, 0.04)
+                          : dsp::make_iir_halfband_coefficients(4, 0.2);
+    }
+};
+
+template <class Design>
+class oversampling_processor final : public named_processor
+{
+public:
+    oversampling_processor(
+            std::size_t const num_channels,
+            std::vector<std::unique_ptr<processor>> chain,
+            std::size_t const num_stages,
+            std::string_view const name)
+        : named_processor(name)
+        , m_num_channels(num_channels)
+        , m_factor(std::size_t{1} << num_stages)
+        , m_chain(std::move(chain))
+        , m_memory(
+                  (num_stages + 1 + m_chain.size()) * num_channels *
+                  max_period_size.value() * m_factor)
+        , m_upsampled(num_channels)
+    {
+        BOOST_ASSERT(!m_chain.empty());
+        BOOST_ASSERT(std::ranges::all_of(m_chain, [=](auto const& proc) {
+            return proc->num_inputs() == num_channels &&
+                   proc->num_outputs() == num_channels &&
+                   proc->event_inputs().empty() &&
+                   proc->event_outputs().empty();
+        }));
+
+        std::size_t const max_frames = max_period_size.value() * m_factor;
+        std::size_t memory_offset{};
+        auto const next_buffer = [&]() {
+            auto const buffer =
+                    std::span{m_memory}.subspan(memory_offset, max_frames);
+            memory_offset += max_frames;
+            return buffer;
+        };
+
+        m_stages.resize(num_stages);
+        for (std::size_t s = 0; s < num_stages; ++s)
+        {
+            auto const coefficients = Design::make(s);
+            for (std::size_t ch = 0; ch < num_channels; ++ch)
+            {
+                m_stages[s].upsamplers.emplace_back(coefficients);
+                m_stages[s].downsamplers.emplace_back(coefficients);
+                m_stages[s].buffers.push_back(next_buffer());
+            }
+        }
+
+        std::ranges::generate_n(
+                std::back_inserter(m_constant_buffers),
+                num_channels,
+                next_buffer);
+
+        m_links.resize(m_chain.size());
+        for (std::size_t p = 0; p < m_chain.size(); ++p)
+        {
+            auto& link = m_links[p];
+            link.results.resize(num_channels);
+            for (std::size_t ch = 0; ch < num_channels; ++ch)
+            {
+                link.buffers.push_back(next_buffer());
+                link.outputs.push_back(link.buffers.back());
+                link.inputs.emplace_back(
+                        p == 0 ? m_upsampled[ch]
+                               : m_links[p - 1].results[ch]);
+            }
+        }
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "oversampling";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        std::size_t tail{};
+        for (auto const& proc : m_chain)
+        {
+            std::size_t const proc_tail = proc->silence_tail();
+            if (proc_tail == npos)
+            {
+                return npos;
+            }
+
+            tail += proc_tail;
+        }
+
+        return (tail + m_factor - 1) / m_factor + filters_silence_tail;
+    }
+
+    auto latency() const noexcept -> std::size_t override
+    {
+        float frames{};
+        for (std::size_t s = 0; s < m_stages.size(); ++s)
+        {
+            frames += (m_stages[s].upsamplers.front().latency() +
+                       m_stages[s].downsamplers.front().latency()) /
+                      static_cast<float>(std::size_t{2} << s);
+        }
+
+        for (auto const& proc : m_chain)
+        {
+            frames += static_cast<float>(proc->latency()) /
+                      static_cast<float>(m_factor);
+        }
+
+        return static_cast<std::size_t>(std::lround(frames));
+    }
+
+    void process(process_context const& ctx) override
+    {
+        verify_process_context(*this, ctx);
+
+        std::size_t const frames = ctx.buffer_size * m_factor;
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            std::span<float const> in = to_span(
+                    ctx.inputs[ch].get(),
+                    m_constant_buffers[ch].first(ctx.buffer_size));
+
+            for (auto& stage : m_stages)
+            {
+                auto const out = stage.buffers[ch].first(2 * in.size());
+                stage.upsamplers[ch].process(in, out);
+                in = out;
+            }
+
+            m_upsampled[ch] = in;
+        }
+
+        for (std::size_t p = 0; p < m_chain.size(); ++p)
+        {
+            auto& link = m_links[p];
+            for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+            {
+                link.outputs[ch] = link.buffers[ch].first(frames);
+            }
+
+            m_chain[p]->process(
+                    {.inputs = link.inputs,
+                     .outputs = link.outputs,
+                     .results = link.results,
+                     .event_inputs = m_event_inputs,
+                     .event_outputs = m_event_outputs,
+                     .buffer_size = frames});
+        }
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            std::span<float const> in = to_span(
+                    m_links.back().results[ch],
+                    m_constant_buffers[ch].first(frames));
+
+            for (std::size_t s = m_stages.size(); s-- > 0;)
+            {
+                auto const out =
+                        s == 0 ? ctx.outputs[ch]
+                               : m_stages[s - 1].buffers[ch].first(
+                                         in.size() / 2);
+                m_stages[s].downsamplers[ch].process(in, out);
+                in = out;
+            }
+
+            ctx.results[ch] = ctx.outputs[ch];
+        }
+    }
+
+private:
+    // The filters need to run on constants as well, to stay in sync.
+    static auto to_span(slice<float> const& s, std::span<float> const buffer)
+            -> std::span<float const>
+    {
+        if (s.is_constant())
+        {
+            std::ranges::fill(buffer, s.constant());
+            return buffer;
+        }
+
+        return s.span();
+    }
+
+    struct stage
+    {
+        std::vector<typename Design::upsampler> upsamplers;
+        std::vector<typename Design::downsampler> downsamplers;
+        std::vector<std::span<float>> buffers;
+    };
+
+    struct link
+    {
+        std::vector<std::reference_wrapper<slice<float> const>> inputs;
+        std::vector<std::span<float>> buffers;
+        std::vector<std::span<float>> outputs;
+        std::vector<slice<float>> results;
+    };
+
+    std::size_t m_num_channels;
+    std::size_t m_factor;
+    std::vector<std::unique_ptr<processor>> m_chain;
+    mipp::vector<float> m_memory;
+    std::vector<stage> m_stages;
+    std::vector<std::span<float>> m_constant_buffers;
+    std::vector<slice<float>> m_upsampled;
+    std::vector<link> m_links;
+    event_input_buffers m_event_inputs;
+    event_output_buffers m_event_outputs;
+};
+
+} // namespace
+
+auto
+make_oversampling_processor(
+        std::size_t const num_channels,
+        std::vector<std::unique_ptr<processor>> chain,
+        oversampling_factor const factor,
+        oversampling_phase const phase,
+        std::string_view const name) -> std::unique_ptr<processor>
+{
+    std::size_t const num_stages =
+            factor == oversampling_factor::x2 ? 1 : 2;
+
+    switch (phase)
+    {
+        case oversampling_phase::linear:
+            return std::make_unique<oversampling_processor<fir_design>>(
+                    num_channels,
+                    std::move(chain),
+                    num_stages,
+                    name);
+
+        case oversampling_phase::minimum:
+            return std::make_unique<oversampling_processor<iir_design>>(
+                    num_channels,
+                    std::move(chain),
+                    num_stages,
+                    name);
+    }
+}
+
+} // namespace piejam::audio::engine
@@ -5,9 +5,14 @@
 #include <piejam/audio/engine/process.h>
 
 #include <piejam/audio/engine/dag_executor.h>
+#include <piejam/audio/period_timing.h>
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
 namespace piejam::audio::engine
 {
 
@@ -25,54 +30,102 @@ public:
 } // namespace
 
 process::process()
-    : m_executor(std::make_unique<dummy_dag_executor>())
 {
+    auto dummy = std::make_unique<dummy_dag_executor>();
+    m_executor = dummy.get();
+    m_active_executor.store(m_executor, std::memory_order_relaxed);
+    m_generations.push_back(
+            {.executor = std::move(dummy), .resources = {}, .on_active = {}});
 }
 
-process::~process()
-{
-    BOOST_ASSERT(!m_next_executor);
-    delete m_next_executor.load();
-}
+process::~process() = default;
 
-auto
-process::swap_executor(std::unique_ptr<dag_executor> next_dag_executor) -> bool
+void
+process::swap_executor(
+        std::unique_ptr<dag_executor> next_dag_executor,
+        resources_t resources,
+        on_active_t on_active)
 {
     if (!next_dag_executor)
     {
         next_dag_executor = std::make_unique<dummy_dag_executor>();
     }
 
-    m_prev_executor = {};
-    auto prev_executor_future = m_prev_executor.get_future();
+    dag_executor* const next = next_dag_executor.get();
+
+    std::lock_guard const lock(m_generations_mutex);
 
-    m_next_executor.store(
-            next_dag_executor.release(),
-            std::memory_order_release);
+    m_generations.push_back(
+            {.executor = std::move(next_dag_executor),
+             .resources = std::move(resources),
+             .on_active = std::move(on_active)});
 
-    if (auto const status =
-                prev_executor_future.wait_for(std::chrono::milliseconds(200));
-        status == std::future_status::ready)
+    // Not picked up by the audio thread yet, it never will be. So it can
+    // be destroyed right away.
+    if (dag_executor* const superseded =
+                m_next_executor.exchange(next, std::memory_order_acq_rel))
     {
-        prev_executor_future.get();
-        return true;
+        std::erase_if(m_generations, [superseded](generation const& g) {
+            return g.executor.get() == superseded;
+        });
     }
+}
+
+auto
+process::reclaim() -> std::size_t
+{
+    dag_executor* const active =
+            m_active_executor.load(std::memory_order_acquire);
+
+    std::deque<generation> retired;
+    on_active_t on_active;
 
-    delete m_next_executor.exchange(nullptr, std::memory_order_acq_rel);
-    return false;
+    {
+        std::lock_guard const lock(m_generations_mutex);
+
+        // Executors are picked up in the order they were swapped in, all
+        // before the active one are out of use.
+        auto const it = std::ranges::find_if(
+                m_generations,
+                [active](generation const& g) {
+                    return g.executor.get() == active;
+                });
+        BOOST_ASSERT(it != m_generations.end());
+
+        std::move(m_generations.begin(), it, std::back_inserter(retired));
+        m_generations.erase(m_generations.begin(), it);
+
+        on_active = std::exchange(m_generations.front().on_active, {});
+    }
+
+    // Destroy outside of the lock, tearing down a graph might take a while.
+    std::size_t const num_retired = retired.size();
+    retired.clear();
+
+    if (on_active)
+    {
+        on_active();
+    }
+
+    return num_retired;
 }
 
 void
 process::operator()(std::size_t const buffer_size) noexcept
 {
-    if (auto next_dag_executor = std::unique_ptr<dag_executor>(
-                m_next_executor.exchange(nullptr, std::memory_order_acq_rel)))
+    if (dag_executor* const next =
+                m_next_executor.exchange(nullptr, std::memory_order_acq_rel))
     {
-        std::swap(m_executor, next_dag_executor);
-        m_prev_executor.set_value(std::move(next_dag_executor));
+        m_executor = next;
+
+        mark_period_event(period_event::executor_swap);
     }
 
     (*m_executor)(buffer_size);
+
+    // After a completed period, the dag workers are done with the previous
+    // executor as well, so it can be reclaimed.
+    m_active_executor.store(m_executor, std::memory_order_release);
 }
 
 } // namespace piejam::audio::engine
@@ -7,6 +7,7 @@
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/engine/thread_context.h>
 #include <piejam/audio/slice.h>
+#include <piejam/npos.h>
 
 #include <boost/assert.hpp>
 
@@ -24,16 +25,12 @@ empty_result_ref() -> std::reference_wrapper<slice<float> const>
 
 processor_job::processor_job(processor& proc)
     : m_proc(proc)
-    , m_output_buffers(m_proc.num_outputs(), output_buffer_t{})
     , m_inputs(m_proc.num_inputs(), empty_result_ref())
-    , m_outputs(m_output_buffers.begin(), m_output_buffers.end())
+    , m_outputs(m_proc.num_outputs())
     , m_results(m_proc.num_outputs())
     , m_process_context(
               {m_inputs, m_outputs, m_results, m_event_inputs, m_event_outputs})
 {
-    BOOST_ASSERT((std::ranges::all_of(m_output_buffers, [](auto const& b) {
-        return mipp::isAligned(b.data());
-    })));
     for (event_port const& port : m_proc.event_inputs())
     {
         m_event_inputs.add(port);
@@ -46,6 +43,29 @@ processor_job::processor_job(processor& proc)
     BOOST_ASSERT(m_proc.event_outputs().size() == m_event_outputs.size());
 }
 
+void
+processor_job::assign_output_buffers(
+        std::shared_ptr<output_buffers_t> pool,
+        std::span<std::size_t const> const indices)
+{
+    BOOST_ASSERT(pool);
+    BOOST_ASSERT(indices.size() == m_outputs.size());
+
+    m_output_buffers = std::move(pool);
+
+    std::ranges::transform(
+            indices,
+            m_outputs.begin(),
+            [this](std::size_t const index) {
+                BOOST_ASSERT(index < m_output_buffers->size());
+                BOOST_ASSERT(
+                        mipp::isAligned((*m_output_buffers)[index].data()));
+                return std::span<float>{
+                        (*m_output_buffers)[index].data(),
+                        m_process_context.buffer_size};
+            });
+}
+
 auto
 processor_job::result_ref(std::size_t const index) const -> slice<float> const&
 {
@@ -95,10 +115,50 @@ processor_job::operator()(thread_context const& ctx)
         m_process_context.buffer_size = buffer_size;
     }
 
+    BOOST_ASSERT(m_output_buffers || m_outputs.empty());
     BOOST_ASSERT(ctx.event_memory);
     m_event_outputs.set_event_memory(ctx.event_memory);
 
+    if (skip_silent())
+    {
+        std::ranges::fill(m_results, slice<float>{0.f});
+        return;
+    }
+
     m_proc.process(m_process_context);
 }
 
+auto
+processor_job::skip_silent() -> bool
+{
+    std::size_t const tail = m_proc.silence_tail();
+    if (tail == npos)
+    {
+        return false;
+    }
+
+    bool const inputs_silent =
+            !m_inputs.empty() &&
+            std::ranges::all_of(
+                    m_inputs,
+                    [](slice<float> const& in) {
+                        return in.is_constant() && in.constant() == 0.f;
+                    }) &&
+            m_event_inputs.all_empty();
+
+    if (!inputs_silent)
+    {
+        m_silent_frames = 0;
+        return false;
+    }
+
+    if (m_silent_frames < tail)
+    {
+        m_silent_frames += m_process_context.buffer_size;
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace piejam::audio::engine
@@ -0,0 +1,131 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/worker_telemetry.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+#include <time.h>
+
+namespace piejam::audio::engine
+{
+
+namespace
+{
+
+auto
+to_ns(std::chrono::nanoseconds const t) noexcept -> std::uint64_t
+{
+    return static_cast<std::uint64_t>(t.count());
+}
+
+auto
+from_ns(std::uint64_t const ns) noexcept -> std::chrono::nanoseconds
+{
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(ns)};
+}
+
+// Counters start over, when the telemetry is recreated along with the
+// engine. The current value is the delta then.
+auto
+delta(std::chrono::nanoseconds const prev,
+      std::chrono::nanoseconds const curr) noexcept -> std::chrono::nanoseconds
+{
+    return curr >= prev ? curr - prev : curr;
+}
+
+} // namespace
+
+worker_telemetry::worker_telemetry(std::size_t const num_threads)
+    : m_num_threads(num_threads)
+    , m_counters(std::make_unique<counters[]>(num_threads))
+{
+}
+
+void
+worker_telemetry::update(
+        std::size_t const thread_index,
+        worker_period const& period) noexcept
+{
+    BOOST_ASSERT(thread_index < m_num_threads);
+
+    // Each counter has a single writer, relaxed increments are sufficient.
+    counters& c = m_counters[thread_index];
+    c.busy_ns.fetch_add(to_ns(period.busy), std::memory_order_relaxed);
+    c.steal_ns.fetch_add(to_ns(period.steal), std::memory_order_relaxed);
+    c.tasks.fetch_add(period.tasks, std::memory_order_relaxed);
+    c.steals.fetch_add(period.steals, std::memory_order_relaxed);
+    c.cpu_time_ns.store(to_ns(thread_cpu_time()), std::memory_order_relaxed);
+}
+
+auto
+worker_telemetry::stats() const -> std::vector<worker_stats>
+{
+    std::vector<worker_stats> result(m_num_threads);
+
+    for (std::size_t i = 0; i < m_num_threads; ++i)
+    {
+        counters const& c = m_counters[i];
+        result[i] = {
+                .busy = from_ns(c.busy_ns.load(std::memory_order_relaxed)),
+                .steal = from_ns(c.steal_ns.load(std::memory_order_relaxed)),
+                .cpu_time =
+                        from_ns(c.cpu_time_ns.load(std::memory_order_relaxed)),
+                .tasks = c.tasks.load(std::memory_order_relaxed),
+                .steals = c.steals.load(std::memory_order_relaxed)};
+    }
+
+    return result;
+}
+
+auto
+thread_cpu_time() noexcept -> std::chrono::nanoseconds
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} +
+           std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+auto
+worker_loads(
+        std::span<worker_stats const> const prev,
+        std::span<worker_stats const> const curr,
+        std::chrono::nanoseconds const interval) -> std::vector<worker_load>
+{
+    std::vector<worker_load> result(curr.size());
+
+    if (interval <= std::chrono::nanoseconds::zero())
+    {
+        return result;
+    }
+
+    auto const fraction = [interval](std::chrono::nanoseconds const t) {
+        return std::clamp(
+                static_cast<float>(t.count()) /
+                        static_cast<float>(interval.count()),
+                0.f,
+                1.f);
+    };
+
+    for (std::size_t i = 0; i < curr.size(); ++i)
+    {
+        worker_stats const p = i < prev.size() ? prev[i] : worker_stats{};
+
+        float const busy = fraction(delta(p.busy, curr[i].busy));
+        float const steal = fraction(delta(p.steal, curr[i].steal));
+
+        result[i] = {
+                .busy = busy,
+                .steal = steal,
+                .idle = std::max(1.f - busy - steal, 0.f),
+                .cpu = fraction(delta(p.cpu_time, curr[i].cpu_time))};
+    }
+
+    return result;
+}
+
+} // namespace piejam::audio::engine
@@ -51,6 +51,19 @@ public:
     {
         return 0;
     }
+
+    [[nodiscard]]
+    auto take_xrun_period_timings() -> std::vector<period_timing> override
+    {
+        return {};
+    }
+
+    [[nodiscard]]
+    auto aggregate_inputs() const
+            -> std::vector<aggregate_input_stats> override
+    {
+        return {};
+    }
 };
 
 } // namespace
@@ -0,0 +1,209 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/period_timing.h>
+
+#include <piejam/system/monotonic_raw_clock.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace piejam::audio
+{
+
+namespace
+{
+
+thread_local period_timing_history* s_current_history{};
+
+// written in native byte order, like the other binary files
+static_assert(std::endian::native == std::endian::little);
+
+constexpr char file_magic[4]{'P', 'J', 'P', 'T'};
+constexpr std::uint32_t file_version = 1;
+
+struct file_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t num_events;
+    std::uint32_t num_periods;
+};
+
+static_assert(sizeof(file_header) == 16);
+static_assert(sizeof(period_timing) == 8 * (1 + num_period_events));
+
+auto
+now_ns() noexcept -> std::uint64_t
+{
+    return static_cast<std::uint64_t>(
+            system::monotonic_raw_clock::now().time_since_epoch().count());
+}
+
+} // namespace
+
+auto
+to_string(period_event const ev) noexcept -> std::string_view
+{
+    switch (ev)
+    {
+        case period_event::start:
+            return "start";
+        case period_event::read_complete:
+            return "read_complete";
+        case period_event::graph_start:
+            return "graph_start";
+        case period_event::executor_swap:
+            return "executor_swap";
+        case period_event::graph_end:
+            return "graph_end";
+        case period_event::write_complete:
+            return "write_complete";
+        case period_event::xrun:
+            return "xrun";
+        default:
+            return "unknown";
+    }
+}
+
+period_timing_history::period_timing_history(std::size_t const num_periods)
+    : m_periods(num_periods)
+    , m_snapshot(num_periods)
+{
+    BOOST_ASSERT(num_periods > 0);
+}
+
+void
+period_timing_history::make_current() noexcept
+{
+    s_current_history = this;
+}
+
+void
+period_timing_history::begin_period() noexcept
+{
+    period_timing& current = m_periods[++m_period % m_periods.size()];
+    current.period = m_period;
+    current.timestamps = {};
+    current.timestamps[static_cast<std::size_t>(period_event::start)] =
+            now_ns();
+}
+
+void
+period_timing_history::mark(period_event const ev) noexcept
+{
+    m_periods[m_period % m_periods.size()]
+            .timestamps[static_cast<std::size_t>(ev)] = now_ns();
+}
+
+void
+period_timing_history::snapshot() noexcept
+{
+    if (m_snapshot_state.load(std::memory_order_acquire) != snapshot_empty)
+    {
+        return;
+    }
+
+    // oldest period first, periods are counted from one
+    std::size_t const size = std::min<std::size_t>(m_period, m_periods.size());
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_snapshot[i] = m_periods[(m_period + 1 - size + i) % m_periods.size()];
+    }
+
+    m_snapshot_size = size;
+
+    m_snapshot_state.store(snapshot_ready, std::memory_order_release);
+}
+
+auto
+period_timing_history::take_snapshot() -> std::vector<period_timing>
+{
+    if (m_snapshot_state.load(std::memory_order_acquire) != snapshot_ready)
+    {
+        return {};
+    }
+
+    std::vector<period_timing> result(
+            m_snapshot.begin(),
+            std::next(
+                    m_snapshot.begin(),
+                    static_cast<long>(m_snapshot_size)));
+
+    m_snapshot_state.store(snapshot_empty, std::memory_order_release);
+
+    return result;
+}
+
+void
+mark_period_event(period_event const ev) noexcept
+{
+    if (s_current_history)
+    {
+        s_current_history->mark(ev);
+    }
+}
+
+auto
+write_period_timings(
+        std::filesystem::path const& file,
+        std::span<period_timing const> const timings) -> bool
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        spdlog::error("could not open period timings file: {}", file.string());
+        return false;
+    }
+
+    file_header header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.num_events = static_cast<std::uint32_t>(num_period_events);
+    header.num_periods = static_cast<std::uint32_t>(timings.size());
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    out.write(
+            reinterpret_cast<char const*>(timings.data()),
+            static_cast<std::streamsize>(timings.size_bytes()));
+
+    return out.good();
+}
+
+auto
+read_period_timings(std::filesystem::path const& file)
+        -> std::vector<period_timing>
+{
+    std::ifstream in(file, std::ios::binary);
+
+    file_header header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+        header.version != file_version ||
+        header.num_events != num_period_events)
+    {
+        spdlog::error("invalid period timings file: {}", file.string());
+        return {};
+    }
+
+    std::vector<period_timing> result(header.num_periods);
+    if (!in.read(
+                reinterpret_cast<char*>(result.data()),
+                static_cast<std::streamsize>(
+                        result.size() * sizeof(period_timing))))
+    {
+        spdlog::error("truncated period timings file: {}", file.string());
+        return {};
+    }
+
+    return result;
+}
+
+} // namespace piejam::audio
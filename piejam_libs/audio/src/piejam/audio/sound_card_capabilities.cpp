@@ -0,0 +1,62 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/sound_card_capabilities.h>
+
+#include <piejam/algorithm/index_of.h>
+#include <piejam/npos.h>
+
+#include <boost/assert.hpp>
+
+#include <span>
+
+namespace piejam::audio
+{
+
+auto
+hw_params(
+        sound_card_capabilities const& caps,
+        sample_rate const* const sample_rate,
+        period_size const* const period_size) -> sound_card_hw_params
+{
+    BOOST_ASSERT(
+            caps.by_sample_rate.size() == caps.hw_params.sample_rates.size());
+    BOOST_ASSERT(
+            caps.by_period_size.size() == caps.hw_params.period_sizes.size());
+
+    sound_card_hw_params result = caps.hw_params;
+    std::span<sound_card_capabilities::period_size_capabilities const>
+            by_period_size = caps.by_period_size;
+
+    if (std::size_t const rate_index =
+                sample_rate ? algorithm::index_of(
+                                      caps.hw_params.sample_rates,
+                                      *sample_rate)
+                            : npos;
+        rate_index != npos)
+    {
+        auto const& rate_caps = caps.by_sample_rate[rate_index];
+        BOOST_ASSERT(
+                rate_caps.by_period_size.size() ==
+                rate_caps.period_sizes.size());
+
+        result.period_sizes = rate_caps.period_sizes;
+        result.period_counts = rate_caps.period_counts;
+        by_period_size = rate_caps.by_period_size;
+    }
+
+    if (std::size_t const size_index =
+                period_size ? algorithm::index_of(
+                                      result.period_sizes,
+                                      *period_size)
+                            : npos;
+        size_index != npos)
+    {
+        result.period_counts = by_period_size[size_index].period_counts;
+    }
+
+    return result;
+}
+
+} // namespace piejam::audio
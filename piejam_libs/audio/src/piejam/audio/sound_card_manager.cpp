@@ -8,24 +8,91 @@
 #include "alsa/get_set_hw_params.h"
 #include "alsa/pcm_io.h"
 
+#include <piejam/audio/sound_card_capabilities.h>
 #include <piejam/audio/sound_card_descriptor.h>
 #include <piejam/audio/sound_card_hw_params.h>
 
 #include <piejam/box.h>
 #include <piejam/io_pair.h>
 
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace piejam::audio
 {
 
 namespace
 {
 
+// Probing a card opens it and refines all its parameter combinations,
+// which takes a while, especially with USB devices. Each card is probed
+// once, concurrently to the others, in the background. Results are kept
+// as long as the card identity under the same path doesn't change.
+//
+// A probe which is still running is waited for on destruction, so the
+// futures of dropped probes are released outside of the lock, which the
+// probe needs to finish.
 class alsa_sound_card_manager final : public sound_card_manager
 {
 public:
+    alsa_sound_card_manager()
+    {
+        // Start probing right away, the results are likely ready by the
+        // time the cards are refreshed for the first time.
+        io_descriptors();
+    }
+
     auto io_descriptors() -> io_sound_cards override
     {
-        return alsa::get_io_sound_cards();
+        auto const pcms = alsa::get_io_sound_card_pcms();
+
+        // probes of removed cards are dropped
+        std::map<std::filesystem::path, probe> probes;
+
+        {
+            std::lock_guard const lock(m_mutex);
+
+            for (auto const* const pcms_of_dir : {&pcms.in, &pcms.out})
+            {
+                for (alsa::sound_card_pcm const& pcm : *pcms_of_dir)
+                {
+                    auto it = m_probes.find(pcm.descriptor.path);
+                    probes.emplace(
+                            pcm.descriptor.path,
+                            it != m_probes.end() &&
+                                            it->second.card_identity ==
+                                                    pcm.card_identity
+                                    ? std::move(it->second)
+                                    : start_probe(pcm));
+                }
+            }
+
+            m_probes.swap(probes);
+        }
+
+        return io_sound_cards{
+                box(to_descriptors(pcms.in)),
+                box(to_descriptors(pcms.out)),
+        };
+    }
+
+    auto wait_for_probes(std::function<void()> on_probed) -> bool override
+    {
+        std::lock_guard const lock(m_mutex);
+
+        if (m_num_running_probes == 0)
+        {
+            return true;
+        }
+
+        m_on_probed.push_back(std::move(on_probed));
+        return false;
     }
 
     auto hw_params(
@@ -34,7 +101,50 @@ public:
             period_size const* const period_size)
             -> sound_card_hw_params override
     {
-        return alsa::get_hw_params(d, sample_rate, period_size);
+        std::shared_future<sound_card_capabilities> capabilities;
+        std::size_t probe_id{};
+
+        {
+            std::lock_guard const lock(m_mutex);
+
+            auto it = m_probes.find(d.path);
+            if (it == m_probes.end())
+            {
+                it = m_probes
+                             .emplace(
+                                     d.path,
+                                     start_probe({.descriptor = d,
+                                                  .card_identity = {}}))
+                             .first;
+            }
+
+            capabilities = it->second.capabilities;
+            probe_id = it->second.id;
+        }
+
+        try
+        {
+            return audio::hw_params(
+                    capabilities.get(),
+                    sample_rate,
+                    period_size);
+        }
+        catch (...)
+        {
+            // Don't cache failures, the card is probed again next time. A
+            // newer probe of the same path might have replaced this one.
+            std::map<std::filesystem::path, probe>::node_type failed;
+            {
+                std::lock_guard const lock(m_mutex);
+
+                auto const it = m_probes.find(d.path);
+                if (it != m_probes.end() && it->second.id == probe_id)
+                {
+                    failed = m_probes.extract(it);
+                }
+            }
+            throw;
+        }
     }
 
     auto make_io_process(
@@ -45,6 +155,80 @@ public:
     {
         return std::make_unique<alsa::pcm_io>(in, out, config);
     }
+
+private:
+    struct probe
+    {
+        std::size_t id{};
+        std::string card_identity;
+        std::shared_future<sound_card_capabilities> capabilities;
+    };
+
+    // Must be called with the lock held.
+    auto start_probe(alsa::sound_card_pcm const& pcm) -> probe
+    {
+        ++m_num_running_probes;
+
+        return probe{
+                .id = ++m_last_probe_id,
+                .card_identity = pcm.card_identity,
+                .capabilities = std::async(
+                        std::launch::async,
+                        [this, descriptor = pcm.descriptor]() {
+                            try
+                            {
+                                auto result =
+                                        alsa::get_capabilities(descriptor);
+                                probe_finished();
+                                return result;
+                            }
+                            catch (...)
+                            {
+                                probe_finished();
+                                throw;
+                            }
+                        })};
+    }
+
+    void probe_finished()
+    {
+        std::vector<std::function<void()>> on_probed;
+
+        {
+            std::lock_guard const lock(m_mutex);
+
+            BOOST_ASSERT(m_num_running_probes > 0);
+            if (--m_num_running_probes == 0)
+            {
+                on_probed.swap(m_on_probed);
+            }
+        }
+
+        for (auto const& f : on_probed)
+        {
+            f();
+        }
+    }
+
+    static auto to_descriptors(std::vector<alsa::sound_card_pcm> const& pcms)
+            -> std::vector<sound_card_descriptor>
+    {
+        std::vector<sound_card_descriptor> result;
+        std::ranges::transform(
+                pcms,
+                std::back_inserter(result),
+                &alsa::sound_card_pcm::descriptor);
+        return result;
+    }
+
+    std::mutex m_mutex;
+    std::size_t m_num_running_probes{};
+    std::size_t m_last_probe_id{};
+    std::vector<std::function<void()>> m_on_probed;
+
+    // declared last, running probes are waited for before the members
+    // they use are destroyed
+    std::map<std::filesystem::path, probe> m_probes;
 };
 
 } // namespace
@@ -0,0 +1,206 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/async_input_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace piejam::audio::test
+{
+
+namespace
+{
+
+auto
+at(double const seconds) -> async_input_buffer::time_point
+{
+    return async_input_buffer::time_point{
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<double>(seconds))};
+}
+
+auto
+buffer_config(unsigned const rate, unsigned const period)
+        -> sound_card_buffer_config
+{
+    return {sample_rate{rate}, period_size{period}, period_count{2}};
+}
+
+// Runs a capture device and the master device side by side, in simulated
+// time. The device clock deviates by drift_ppm from its nominal rate.
+struct two_clocks
+{
+    two_clocks(
+            sound_card_buffer_config const& device,
+            sound_card_buffer_config const& master,
+            double const drift_ppm = 0.)
+        : device(device)
+        , master(master)
+        , drift_ppm(drift_ppm)
+        , sut(1, device, master)
+        , device_period(device.period_size.value())
+    {
+    }
+
+    sound_card_buffer_config device;
+    sound_card_buffer_config master;
+    double drift_ppm;
+
+    async_input_buffer sut;
+
+    std::vector<float> device_period;
+    std::size_t device_frames{};
+
+    double device_time{};
+    double master_time{};
+
+    std::vector<float> received;
+
+    void run(double const seconds, double const freq = 1000.)
+    {
+        double const device_period_duration =
+                device.period_size.value() /
+                (device.sample_rate.value() * (1. + drift_ppm * 1e-6));
+        double const master_period_duration =
+                static_cast<double>(master.period_size.value()) /
+                master.sample_rate.value();
+
+        double const end = master_time + seconds;
+        while (master_time < end)
+        {
+            if (device_time + device_period_duration <=
+                master_time + master_period_duration)
+            {
+                device_time += device_period_duration;
+
+                for (float& x : device_period)
+                {
+                    x = static_cast<float>(std::sin(
+                            2. * std::numbers::pi * freq *
+                            static_cast<double>(device_frames++) /
+                            device.sample_rate.value()));
+                }
+
+                std::span<float const> const channels[]{device_period};
+                sut.write(channels, at(device_time));
+            }
+            else
+            {
+                master_time += master_period_duration;
+
+                sut.read(master.period_size.value(), at(master_time));
+                auto const out = sut.channel(0);
+                received.insert(received.end(), out.begin(), out.end());
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(async_input_buffer, silence_until_the_target_is_reached)
+{
+    auto const config = buffer_config(48000, 128);
+    async_input_buffer sut(1, config, config);
+
+    std::vector<float> const ones(128, 1.f);
+    std::span<float const> const channels[]{ones};
+    sut.write(channels, at(0.));
+
+    sut.read(128, at(0.));
+    EXPECT_TRUE(std::ranges::all_of(sut.channel(0), [](float x) {
+        return x == 0.f;
+    }));
+    EXPECT_EQ(0u, sut.stats().underruns);
+}
+
+TEST(async_input_buffer, running_empty_is_an_underrun)
+{
+    two_clocks clocks(
+            buffer_config(48000, 128),
+            buffer_config(48000, 128));
+
+    clocks.run(1.);
+    ASSERT_EQ(0u, clocks.sut.stats().underruns);
+
+    // the device stops delivering
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        clocks.sut.read(128, at(clocks.master_time));
+    }
+
+    EXPECT_EQ(1u, clocks.sut.stats().underruns);
+}
+
+TEST(async_input_buffer, compensates_a_fast_device_clock)
+{
+    two_clocks clocks(
+            buffer_config(48000, 128),
+            buffer_config(48000, 128),
+            200.);
+
+    clocks.run(60.);
+
+    auto const stats = clocks.sut.stats();
+    EXPECT_NEAR(200.f, stats.drift_ppm, 10.f);
+    EXPECT_NEAR(1.f, stats.buffer_fill, 0.05f);
+    EXPECT_EQ(0u, stats.underruns);
+    EXPECT_EQ(0u, stats.overruns);
+}
+
+TEST(async_input_buffer, compensates_a_slow_device_clock_at_another_rate)
+{
+    two_clocks clocks(
+            buffer_config(44100, 256),
+            buffer_config(48000, 64),
+            -100.);
+
+    clocks.run(60.);
+
+    auto const stats = clocks.sut.stats();
+    EXPECT_NEAR(-100.f, stats.drift_ppm, 10.f);
+    EXPECT_NEAR(1.f, stats.buffer_fill, 0.05f);
+    EXPECT_EQ(0u, stats.underruns);
+    EXPECT_EQ(0u, stats.overruns);
+
+    // latency: the target fill of a master period and two device periods,
+    // plus the delay of the resampler
+    EXPECT_NEAR(64. + 2. * 256. * 48. / 44.1 + 32. * 48. / 44.1,
+                static_cast<double>(stats.latency),
+                10.);
+}
+
+TEST(async_input_buffer, signal_passes_without_gaps)
+{
+    two_clocks clocks(
+            buffer_config(48000, 128),
+            buffer_config(48000, 128),
+            50.);
+
+    clocks.run(10.);
+
+    // once running, the sine continues without any clicks
+    auto const first = std::ranges::find_if(clocks.received, [](float x) {
+        return x != 0.f;
+    });
+    ASSERT_NE(clocks.received.end(), first);
+
+    // past the jump out of the initial silence
+    float max_step{};
+    for (auto it = std::next(first, 1000); it != clocks.received.end(); ++it)
+    {
+        max_step = std::max(max_step, std::abs(*it - *std::prev(it)));
+    }
+
+    // the largest step of a 1 kHz sine at 48 kHz is 2 pi / 48
+    EXPECT_LT(max_step, 2.f * std::numbers::pi_v<float> / 48.f * 1.01f);
+}
+
+} // namespace piejam::audio::test
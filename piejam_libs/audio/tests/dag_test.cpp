@@ -4,12 +4,19 @@
 
 #include <piejam/audio/engine/dag.h>
 
+#include <piejam/audio/alloc_debug.h>
 #include <piejam/audio/engine/dag_executor.h>
 #include <piejam/audio/engine/thread_context.h>
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/thread/worker.h>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+
 namespace piejam::audio::engine::test
 {
 
@@ -95,4 +102,118 @@ TEST(dag, split_and_merge_graph_mt)
     }
 }
 
+TEST(dag, telemetry_st_accounts_tasks_to_calling_thread)
+{
+    dag sut;
+    auto parent_id = sut.add_task([](auto const&) {});
+    sut.add_child_task(parent_id, [](auto const&) {});
+
+    worker_telemetry telemetry(1);
+    auto executor =
+            sut.make_runnable({}, dag::default_event_memory_size, &telemetry);
+    (*executor)(1);
+    (*executor)(1);
+
+    auto const stats = telemetry.stats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ(4u, stats[0].tasks);
+    EXPECT_EQ(0u, stats[0].steals);
+    EXPECT_GT(stats[0].cpu_time.count(), 0);
+}
+
+TEST(dag, telemetry_mt_accounts_all_tasks)
+{
+    dag sut;
+    auto parent_id = sut.add_task([](auto const&) {});
+    auto child1_id = sut.add_child_task(parent_id, [](auto const&) {});
+    auto child2_id = sut.add_child_task(parent_id, [](auto const&) {});
+    auto result_id = sut.add_child_task(child1_id, [](auto const&) {});
+    sut.add_child(child2_id, result_id);
+
+    worker_telemetry telemetry(3);
+    std::unique_ptr<audio::engine::dag_executor> executor;
+    {
+        std::vector<thread::worker> workers(2);
+        executor = sut.make_runnable(
+                workers,
+                dag::default_event_memory_size,
+                &telemetry);
+        for (std::size_t n = 0; n < 10; ++n)
+        {
+            (*executor)(1);
+        }
+    }
+
+    // the workers are joined, all periods are accounted
+    auto const stats = telemetry.stats();
+    ASSERT_EQ(3u, stats.size());
+
+    std::uint64_t tasks{};
+    std::uint64_t steals{};
+    for (auto const& s : stats)
+    {
+        tasks += s.tasks;
+        steals += s.steals;
+        EXPECT_GE(s.steal.count(), 0);
+    }
+
+    EXPECT_EQ(40u, tasks);
+    EXPECT_LE(steals, tasks);
+    EXPECT_GE(steals, 10u);
+}
+
+namespace
+{
+
+// keeps the allocation from being optimized out
+int* volatile s_sink{};
+
+} // namespace
+
+TEST(dag, allocations_on_worker_threads_are_counted)
+{
+    auto const main_thread = std::this_thread::get_id();
+    std::atomic_size_t worker_allocations{};
+
+    dag sut;
+    auto parent_id = sut.add_task([](auto const&) {});
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        sut.add_child_task(parent_id, [&](auto const&) {
+            if (std::this_thread::get_id() == main_thread)
+            {
+                return;
+            }
+
+            // in debug builds, the allocation fails
+            try
+            {
+                auto value = std::make_unique<int>();
+                s_sink = value.get();
+            }
+            catch (std::bad_alloc const&)
+            {
+            }
+
+            worker_allocations.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    auto const allocations_before = rt_allocation_count();
+
+    std::unique_ptr<audio::engine::dag_executor> executor;
+    {
+        std::vector<thread::worker> workers(2);
+        executor = sut.make_runnable(workers);
+        for (std::size_t n = 0; n < 100; ++n)
+        {
+            (*executor)(1);
+        }
+    }
+
+    EXPECT_EQ(
+            worker_allocations.load(),
+            rt_allocation_count() - allocations_before);
+}
+
 } // namespace piejam::audio::engine::test
@@ -0,0 +1,133 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/delay_line_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace piejam::audio::engine::test
+{
+
+namespace
+{
+
+constexpr std::size_t word_frames =
+        delay_line_pool::blocks_per_word * delay_line_pool::block_frames;
+
+} // namespace
+
+TEST(delay_line_pool, size_is_rounded_up_to_power_of_two_blocks)
+{
+    delay_line_pool sut(64);
+    EXPECT_EQ(64u, sut.num_blocks());
+
+    auto const buf = sut.allocate(3 * delay_line_pool::block_frames - 1);
+    ASSERT_TRUE(buf);
+    EXPECT_EQ(4 * delay_line_pool::block_frames, buf.frames().size());
+    EXPECT_EQ(60u, sut.num_free_blocks());
+}
+
+TEST(delay_line_pool, buffers_are_zeroed_and_cache_aligned)
+{
+    delay_line_pool sut(64);
+
+    auto buf = sut.allocate(1);
+    ASSERT_TRUE(buf);
+    EXPECT_EQ(0u, std::bit_cast<std::uintptr_t>(buf.frames().data()) % 64);
+    std::ranges::fill(buf.frames(), 1.f);
+
+    buf = {};
+    buf = sut.allocate(1);
+    ASSERT_TRUE(buf);
+    EXPECT_TRUE(std::ranges::all_of(buf.frames(), [](float x) {
+        return x == 0.f;
+    }));
+}
+
+TEST(delay_line_pool, blocks_are_returned_on_destruction)
+{
+    delay_line_pool sut(128);
+
+    {
+        std::vector<delay_line_buffer> bufs;
+        bufs.push_back(sut.allocate(word_frames));
+        bufs.push_back(sut.allocate(word_frames));
+        EXPECT_TRUE(bufs[0]);
+        EXPECT_TRUE(bufs[1]);
+        EXPECT_NE(bufs[0].frames().data(), bufs[1].frames().data());
+
+        EXPECT_FALSE(sut.allocate(1));
+    }
+
+    EXPECT_EQ(128u, sut.num_free_blocks());
+    EXPECT_TRUE(sut.allocate(word_frames));
+}
+
+TEST(delay_line_pool, fragmented_pool_fits_smaller_buffers)
+{
+    delay_line_pool sut(64);
+
+    std::vector<delay_line_buffer> bufs;
+    for (int i = 0; i < 8; ++i)
+    {
+        bufs.push_back(sut.allocate(8 * delay_line_pool::block_frames));
+        ASSERT_TRUE(bufs.back());
+    }
+
+    bufs[2] = {};
+    bufs[5] = {};
+
+    // aligned runs only, the two holes aren't adjacent
+    EXPECT_FALSE(sut.allocate(16 * delay_line_pool::block_frames));
+    EXPECT_TRUE(sut.allocate(8 * delay_line_pool::block_frames));
+}
+
+TEST(delay_line_pool, buffers_beyond_a_word_take_whole_words)
+{
+    delay_line_pool sut(256);
+
+    auto const buf = sut.allocate(word_frames + 1);
+    ASSERT_TRUE(buf);
+    EXPECT_EQ(2 * word_frames, buf.frames().size());
+    EXPECT_EQ(128u, sut.num_free_blocks());
+
+    // the other two words are still available as one run
+    auto const buf2 = sut.allocate(2 * word_frames);
+    ASSERT_TRUE(buf2);
+    EXPECT_EQ(0u, sut.num_free_blocks());
+}
+
+TEST(delay_line_pool, words_are_given_back_if_a_run_cant_be_completed)
+{
+    delay_line_pool sut(256);
+
+    std::vector<delay_line_buffer> bufs;
+    for (int i = 0; i < 4; ++i)
+    {
+        bufs.push_back(sut.allocate(word_frames));
+        ASSERT_TRUE(bufs.back());
+    }
+
+    // only the last word stays taken
+    bufs[0] = {};
+    bufs[1] = {};
+    bufs[2] = {};
+
+    EXPECT_FALSE(sut.allocate(4 * word_frames));
+    EXPECT_EQ(192u, sut.num_free_blocks());
+    EXPECT_TRUE(sut.allocate(2 * word_frames));
+}
+
+TEST(delay_line_pool, too_long_for_the_pool)
+{
+    delay_line_pool sut(256);
+    EXPECT_FALSE(sut.allocate(4 * word_frames + 1));
+    EXPECT_EQ(256u, sut.num_free_blocks());
+}
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,88 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/delay_line.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+TEST(delay_line, integer_delays)
+{
+    std::vector<float> memory(64);
+    delay_line sut(memory);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        sut.push(static_cast<float>(i));
+    }
+
+    EXPECT_EQ(99.f, sut[1]);
+    EXPECT_EQ(90.f, sut[10]);
+    EXPECT_EQ(36.f, sut[64]);
+
+    std::vector<float> const delays{10.f, 10.f, 20.f};
+    std::vector<float> out(delays.size());
+    sut.read(delays, out);
+
+    // relative to the samples written next, 100, 101 and 102
+    EXPECT_FLOAT_EQ(90.f, out[0]);
+    EXPECT_FLOAT_EQ(91.f, out[1]);
+    EXPECT_FLOAT_EQ(82.f, out[2]);
+}
+
+TEST(delay_line, fractional_delays_of_a_ramp_are_exact)
+{
+    std::vector<float> memory(256);
+    delay_line sut(memory);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        sut.push(static_cast<float>(i));
+    }
+
+    std::vector<float> delays(45);
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        delays[i] = 50.f + static_cast<float>(i) * 0.37f;
+    }
+
+    std::vector<float> out(delays.size());
+    sut.read(delays, out);
+
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        EXPECT_NEAR(200.f + static_cast<float>(i) - delays[i], out[i], 1e-3f);
+    }
+}
+
+TEST(interpolate_hermite, simd_matches_scalar)
+{
+    std::vector<float> y0(19), y1(19), y2(19), y3(19), frac(19);
+    for (std::size_t i = 0; i < y0.size(); ++i)
+    {
+        float const x = static_cast<float>(i);
+        y0[i] = std::sin(x);
+        y1[i] = std::sin(x + 1.f);
+        y2[i] = std::sin(x + 2.f);
+        y3[i] = std::sin(x + 3.f);
+        frac[i] = x / 19.f;
+    }
+
+    std::vector<float> out(y0.size());
+    simd::interpolate_hermite(y0, y1, y2, y3, frac, out);
+
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        EXPECT_NEAR(
+                interpolate_hermite(y0[i], y1[i], y2[i], y3[i], frac[i]),
+                out[i],
+                1e-6f);
+    }
+}
+
+} // namespace piejam::audio::dsp::test
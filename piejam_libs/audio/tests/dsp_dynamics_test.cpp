@@ -0,0 +1,96 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/dynamics.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+TEST(dsp_compute_gain, unity_below_threshold)
+{
+    float const log_threshold = std::log(0.5f);
+
+    EXPECT_FLOAT_EQ(1.f, compute_gain(0.f, log_threshold, 0.75f));
+    EXPECT_FLOAT_EQ(1.f, compute_gain(0.25f, log_threshold, 0.75f));
+    EXPECT_FLOAT_EQ(1.f, compute_gain(0.5f, log_threshold, 0.75f));
+}
+
+TEST(dsp_compute_gain, ratio_above_threshold)
+{
+    float const log_threshold = std::log(0.25f);
+
+    // ratio 2:1, one octave above the threshold ends up half an octave
+    // above it
+    EXPECT_NEAR(
+            std::sqrt(2.f) * 0.25f,
+            0.5f * compute_gain(0.5f, log_threshold, 0.5f),
+            1e-6f);
+
+    // ratio 1:1, no compression, even for silence
+    EXPECT_FLOAT_EQ(1.f, compute_gain(0.5f, log_threshold, 0.f));
+    EXPECT_FLOAT_EQ(1.f, compute_gain(0.f, log_threshold, 0.f));
+}
+
+TEST(dsp_compute_gain, limiter_holds_threshold)
+{
+    float const log_threshold = std::log(0.25f);
+
+    for (float const level : {0.3f, 0.5f, 1.f, 4.f})
+    {
+        EXPECT_NEAR(
+                0.25f,
+                level * compute_gain(level, log_threshold, 1.f),
+                1e-6f);
+    }
+}
+
+TEST(dsp_compute_gain, simd_matches_raw_loop)
+{
+    std::vector<float> level(37);
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+        level[i] = static_cast<float>(i) / 16.f;
+    }
+
+    float const log_threshold = std::log(0.3f);
+    float const slope = 0.8f;
+
+    std::vector<float> gain(level.size());
+    simd::compute_gain<float>(level, log_threshold, slope, gain);
+
+    for (std::size_t i = 0; i < level.size(); ++i)
+    {
+        EXPECT_NEAR(
+                compute_gain(level[i], log_threshold, slope),
+                gain[i],
+                1e-5f);
+    }
+}
+
+TEST(dsp_gain_ballistics, attack_and_release)
+{
+    gain_ballistics<float> sut;
+    sut.set_coefficients(0.f, 0.5f);
+
+    // instantaneous attack
+    EXPECT_FLOAT_EQ(0.25f, sut(0.25f));
+
+    // halfway per sample on release
+    EXPECT_FLOAT_EQ(0.625f, sut(1.f));
+    EXPECT_FLOAT_EQ(0.8125f, sut(1.f));
+}
+
+TEST(dsp_one_pole_coefficient, zero_samples_is_immediate)
+{
+    EXPECT_EQ(0.f, one_pole_coefficient(0.f));
+    EXPECT_FLOAT_EQ(std::exp(-0.01f), one_pole_coefficient(100.f));
+}
+
+} // namespace piejam::audio::dsp::test
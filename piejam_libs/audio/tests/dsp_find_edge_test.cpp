@@ -0,0 +1,106 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/find_edge.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+TEST(find_edge, no_edge_in_constant_signal)
+{
+    std::vector<float> const signal(64, 0.5f);
+
+    EXPECT_EQ(npos, find_rising_edge<float>(signal, 0.f));
+    EXPECT_EQ(npos, simd::find_rising_edge<float>(signal, 0.f));
+    EXPECT_EQ(npos, find_falling_edge<float>(signal, 0.f));
+    EXPECT_EQ(npos, simd::find_falling_edge<float>(signal, 0.f));
+}
+
+TEST(find_edge, edge_in_tail)
+{
+    std::vector<float> signal(19, -1.f);
+    signal.back() = 1.f;
+
+    EXPECT_EQ(17u, simd::find_rising_edge<float>(signal, 0.f));
+    EXPECT_EQ(npos, simd::find_falling_edge<float>(signal, 0.f));
+}
+
+TEST(find_edge, hysteresis_ignores_noise_around_level)
+{
+    // noise around the level, followed by a real rising edge
+    std::vector<float> const signal{
+            -0.01f, 0.01f, -0.01f, 0.01f, -0.5f, -0.3f, 0.f, 0.3f, 0.5f};
+
+    EXPECT_EQ(0u, simd::find_rising_edge<float>(signal, 0.f));
+    EXPECT_EQ(6u, simd::find_rising_edge<float>(signal, 0.f, 0.1f));
+    EXPECT_EQ(6u, find_rising_edge<float>(signal, 0.f, 0.1f));
+}
+
+TEST(find_edge, hysteresis_never_armed)
+{
+    std::vector<float> const signal{0.1f, -0.05f, 0.1f, -0.05f, 0.1f};
+
+    EXPECT_EQ(npos, simd::find_rising_edge<float>(signal, 0.f, 0.1f));
+    EXPECT_EQ(npos, find_rising_edge<float>(signal, 0.f, 0.1f));
+}
+
+// test param: size, hysteresis
+struct find_edge_test
+    : public testing::TestWithParam<std::tuple<std::size_t, float>>
+{
+    find_edge_test()
+        : signal(std::get<0>(GetParam()))
+    {
+        for (std::size_t i = 0; i < signal.size(); ++i)
+        {
+            auto const x = static_cast<float>(i);
+            signal[i] = std::sin(x * 0.05f * std::numbers::pi_v<float>) +
+                        0.2f * std::sin(x * 2.3f);
+        }
+    }
+
+    float hysteresis{std::get<1>(GetParam())};
+    std::vector<float> signal;
+};
+
+TEST_P(find_edge_test, simd_matches_scalar)
+{
+    for (float const level : {-0.5f, 0.f, 0.3f})
+    {
+        EXPECT_EQ(
+                find_rising_edge<float>(signal, level, hysteresis),
+                simd::find_rising_edge<float>(signal, level, hysteresis));
+        EXPECT_EQ(
+                find_falling_edge<float>(signal, level, hysteresis),
+                simd::find_falling_edge<float>(signal, level, hysteresis));
+    }
+}
+
+TEST_P(find_edge_test, simd_on_unaligned_subspan)
+{
+    auto const sub = std::span<float const>{signal}.subspan(
+            std::min<std::size_t>(3, signal.size()));
+
+    EXPECT_EQ(
+            find_rising_edge(sub, 0.1f, hysteresis),
+            simd::find_rising_edge(sub, 0.1f, hysteresis));
+    EXPECT_EQ(
+            find_falling_edge(sub, 0.1f, hysteresis),
+            simd::find_falling_edge(sub, 0.1f, hysteresis));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        all,
+        find_edge_test,
+        testing::Combine(
+                testing::Values(0u, 1u, 2u, 5u, 8u, 17u, 64u, 1023u),
+                testing::Values(0.f, 0.25f)));
+
+} // namespace piejam::audio::dsp::test
@@ -0,0 +1,146 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/halfband.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+auto
+make_sine(std::size_t const size, float const freq) -> std::vector<float>
+{
+    std::vector<float> result(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result[i] = std::sin(
+                2.f * std::numbers::pi_v<float> * freq *
+                static_cast<float>(i));
+    }
+    return result;
+}
+
+// Amplitude of the component at freq, relative to the sample rate.
+auto
+amplitude_at(std::span<float const> const in, float const freq) -> float
+{
+    std::complex<double> sum{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        sum += static_cast<double>(in[i]) *
+               std::polar(
+                       1.,
+                       -2. * std::numbers::pi * static_cast<double>(freq) *
+                               static_cast<double>(i));
+    }
+    return static_cast<float>(2. * std::abs(sum) / in.size());
+}
+
+} // namespace
+
+TEST(dsp_halfband, fir_taps_sum_up_to_half)
+{
+    auto const taps = make_fir_halfband_taps(32, 8.);
+
+    ASSERT_EQ(32u, taps.size());
+    EXPECT_NEAR(0.5f, std::accumulate(taps.begin(), taps.end(), 0.f), 1e-6f);
+    EXPECT_TRUE(std::equal(taps.begin(), taps.end(), taps.rbegin()));
+}
+
+TEST(dsp_halfband, iir_coefficients_are_stable)
+{
+    auto const coefficients = make_iir_halfband_coefficients(8, 0.04);
+
+    ASSERT_EQ(8u, coefficients.size());
+    EXPECT_TRUE(std::ranges::is_sorted(coefficients));
+    EXPECT_GT(coefficients.front(), 0.f);
+    EXPECT_LT(coefficients.back(), 1.f);
+}
+
+TEST(dsp_halfband, fir_round_trip_is_delayed_by_latency)
+{
+    auto const taps = make_fir_halfband_taps(32, 8.);
+    fir_halfband_upsampler up(taps);
+    fir_halfband_downsampler down(taps);
+
+    auto const in = make_sine(1024, 1.f / 48.f);
+    std::vector<float> upsampled(2 * in.size());
+    std::vector<float> out(in.size());
+    up.process(in, upsampled);
+    down.process(upsampled, out);
+
+    auto const latency = static_cast<std::size_t>(
+            (up.latency() + down.latency()) / 2.f);
+    ASSERT_EQ(31u, latency);
+    // past the ringing of the abrupt start
+    for (std::size_t i = 2 * latency; i < out.size(); ++i)
+    {
+        EXPECT_NEAR(in[i - latency], out[i], 1e-3f);
+    }
+}
+
+TEST(dsp_halfband, iir_round_trip_passes_low_frequencies)
+{
+    auto const coefficients = make_iir_halfband_coefficients(8, 0.04);
+    iir_halfband_upsampler up(coefficients);
+    iir_halfband_downsampler down(coefficients);
+
+    auto const in = make_sine(4096, 1.f / 48.f);
+    std::vector<float> upsampled(2 * in.size());
+    std::vector<float> out(in.size());
+    up.process(in, upsampled);
+    down.process(upsampled, out);
+
+    EXPECT_NEAR(
+            1.f,
+            amplitude_at(std::span{out}.subspan(1024, 2400), 1.f / 48.f),
+            1e-3f);
+}
+
+TEST(dsp_halfband, upsampling_rejects_images)
+{
+    // 10 kHz at 48 kHz, the image ends up at 38 kHz at 96 kHz
+    auto const in = make_sine(4800, 10.f / 48.f);
+    std::vector<float> out(2 * in.size());
+
+    auto const check = [&](auto&& up) {
+        up.process(in, out);
+        auto const settled = std::span<float const>{out}.subspan(960);
+        EXPECT_NEAR(1.f, amplitude_at(settled, 10.f / 96.f), 1e-2f);
+        EXPECT_LT(amplitude_at(settled, 38.f / 96.f), 1e-4f);
+    };
+
+    check(fir_halfband_upsampler{make_fir_halfband_taps(32, 8.)});
+    check(iir_halfband_upsampler{make_iir_halfband_coefficients(8, 0.04)});
+}
+
+TEST(dsp_halfband, downsampling_rejects_aliases)
+{
+    // 30 kHz at 96 kHz would alias to 18 kHz at 48 kHz
+    auto const in = make_sine(9600, 30.f / 96.f);
+    std::vector<float> out(in.size() / 2);
+
+    auto const check = [&](auto&& down) {
+        down.process(in, out);
+        auto const settled = std::span<float const>{out}.subspan(960);
+        EXPECT_LT(amplitude_at(settled, 18.f / 48.f), 1e-3f);
+    };
+
+    check(fir_halfband_downsampler{make_fir_halfband_taps(32, 8.)});
+    check(iir_halfband_downsampler{make_iir_halfband_coefficients(8, 0.04)});
+}
+
+} // namespace piejam::audio::dsp::test
@@ -0,0 +1,52 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/minmax.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+// test param: size
+struct minmax_test : public testing::TestWithParam<std::size_t>
+{
+    minmax_test()
+        : signal(GetParam())
+    {
+        std::iota(signal.begin(), signal.end(), -3.f);
+        std::ranges::reverse(signal);
+    }
+
+    std::vector<float> signal;
+};
+
+TEST_P(minmax_test, simd_matches_raw_loop)
+{
+    EXPECT_EQ(
+            minmax(std::span<float const>{signal}),
+            simd::minmax(std::span<float const>{signal}));
+}
+
+TEST_P(minmax_test, simd_on_unaligned_subspan)
+{
+    auto const sub = std::span<float const>{signal}.subspan(1);
+    if (sub.empty())
+    {
+        GTEST_SKIP();
+    }
+
+    EXPECT_EQ(minmax(sub), simd::minmax(sub));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        all,
+        minmax_test,
+        testing::Values(1u, 3u, 4u, 7u, 8u, 15u, 16u, 33u, 1024u));
+
+} // namespace piejam::audio::dsp::test
@@ -0,0 +1,162 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/partitioned_convolver.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+constexpr std::size_t block_size = 16;
+
+auto
+random_signal(std::size_t const size, unsigned const seed)
+        -> std::vector<float>
+{
+    std::minstd_rand gen(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    std::vector<float> result(size);
+    std::ranges::generate(result, [&]() { return dist(gen); });
+    return result;
+}
+
+auto
+direct_convolution(std::vector<float> const& x, std::vector<float> const& h)
+        -> std::vector<float>
+{
+    std::vector<float> y(x.size());
+    for (std::size_t n = 0; n < x.size(); ++n)
+    {
+        for (std::size_t k = 0; k < h.size() && k <= n; ++k)
+        {
+            y[n] += h[k] * x[n - k];
+        }
+    }
+
+    return y;
+}
+
+// feeds the input in chunks of varying size, as the audio engine does
+auto
+convolve(partitioned_convolver& sut, std::vector<float> const& x)
+        -> std::vector<float>
+{
+    std::vector<float> y(x.size());
+
+    std::size_t pos{};
+    std::size_t chunk{1};
+    while (pos < x.size())
+    {
+        std::size_t const n = std::min(chunk, x.size() - pos);
+        sut.process(
+                std::span{x}.subspan(pos, n),
+                std::span{y}.subspan(pos, n));
+        pos += n;
+        chunk = chunk % 23 + 7;
+    }
+
+    return y;
+}
+
+} // namespace
+
+TEST(partitioned_convolver, matches_direct_convolution_with_latency)
+{
+    auto const h = random_signal(5 * block_size + 3, 1);
+    auto const x = random_signal(20 * block_size, 2);
+
+    numeric::dft dft(2 * block_size);
+    convolution_kernel const kernel(h, dft);
+    EXPECT_EQ(6u, kernel.num_partitions());
+
+    partitioned_convolver sut(block_size, 8);
+    sut.set_kernel(&kernel);
+
+    auto const y = convolve(sut, x);
+    auto const expected = direct_convolution(x, h);
+
+    for (std::size_t i = 0; i < block_size; ++i)
+    {
+        EXPECT_EQ(0.f, y[i]);
+    }
+
+    for (std::size_t i = block_size; i < y.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i - block_size], y[i], 1e-4f);
+    }
+}
+
+TEST(partitioned_convolver, partitions_beyond_max_are_ignored)
+{
+    auto const h = random_signal(4 * block_size, 3);
+    auto const x = random_signal(12 * block_size, 4);
+
+    numeric::dft dft(2 * block_size);
+    convolution_kernel const kernel(h, dft);
+
+    partitioned_convolver sut(block_size, 2);
+    sut.set_kernel(&kernel);
+
+    auto const y = convolve(sut, x);
+    auto const expected = direct_convolution(
+            x,
+            std::vector<float>(h.begin(), h.begin() + 2 * block_size));
+
+    for (std::size_t i = block_size; i < y.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i - block_size], y[i], 1e-4f);
+    }
+}
+
+TEST(partitioned_convolver, kernel_switched_mid_block)
+{
+    auto const h1 = random_signal(3 * block_size, 6);
+    auto const h2 = random_signal(5 * block_size + 3, 7);
+    auto const x = random_signal(20 * block_size, 8);
+
+    numeric::dft dft(2 * block_size);
+    convolution_kernel const kernel1(h1, dft);
+    convolution_kernel const kernel2(h2, dft);
+
+    partitioned_convolver sut(block_size, 8);
+    sut.set_kernel(&kernel1);
+
+    std::size_t const switch_pos = 10 * block_size + block_size / 2;
+    std::vector<float> y(x.size());
+    sut.process(
+            std::span{x}.first(switch_pos),
+            std::span{y}.first(switch_pos));
+    sut.set_kernel(&kernel2);
+    sut.process(
+            std::span{x}.subspan(switch_pos),
+            std::span{y}.subspan(switch_pos));
+
+    // the block being filled at the switch is output with the new kernel
+    auto const expected = direct_convolution(x, h2);
+    for (std::size_t i = 11 * block_size; i < y.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i - block_size], y[i], 1e-4f);
+    }
+}
+
+TEST(partitioned_convolver, silent_without_kernel)
+{
+    auto const x = random_signal(4 * block_size, 5);
+
+    partitioned_convolver sut(block_size, 2);
+
+    auto const y = convolve(sut, x);
+    EXPECT_TRUE(std::ranges::all_of(y, [](float s) { return s == 0.f; }));
+}
+
+} // namespace piejam::audio::dsp::test
@@ -5,6 +5,7 @@
 #include <piejam/audio/dsp/pitch_yin.h>
 
 #include <piejam/audio/dsp/generate_sine.h>
+#include <piejam/audio/dsp/pitch_yin_fft.h>
 
 #include <mipp.h>
 
@@ -36,6 +37,22 @@ TEST_P(pitch_yin_test, simple)
     EXPECT_NEAR(GetParam(), result, 0.5);
 }
 
+TEST_P(pitch_yin_test, fft)
+{
+    pitch_yin_fft sut(buffer_size);
+    auto result = sut(signal, sr);
+
+    EXPECT_NEAR(GetParam(), result, 0.5);
+}
+
+TEST_P(pitch_yin_test, fft_with_decimated_pre_pass)
+{
+    pitch_yin_fft sut(buffer_size, 4);
+    auto result = sut(signal, sr);
+
+    EXPECT_NEAR(GetParam(), result, 0.5);
+}
+
 static auto s_test_frequencies = testing::Values(
         27.5f,
         30.87f,
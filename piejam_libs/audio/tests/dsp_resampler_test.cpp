@@ -0,0 +1,130 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/dsp/resampler.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace piejam::audio::dsp::test
+{
+
+namespace
+{
+
+// freq is relative to the sample rate
+auto
+make_sine(std::size_t const size, double const freq) -> std::vector<float>
+{
+    std::vector<float> result(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result[i] = static_cast<float>(std::sin(
+                2. * std::numbers::pi * freq * static_cast<double>(i)));
+    }
+    return result;
+}
+
+auto
+amplitude_at(std::span<float const> const in, double const freq) -> float
+{
+    std::complex<double> sum{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        sum += static_cast<double>(in[i]) *
+               std::polar(
+                       1.,
+                       -2. * std::numbers::pi * freq * static_cast<double>(i));
+    }
+    return static_cast<float>(2. * std::abs(sum) / in.size());
+}
+
+} // namespace
+
+TEST(dsp_resample, output_size)
+{
+    std::vector<float> const in(44100, 0.f);
+
+    EXPECT_EQ(48000u, resample(in, 48000. / 44100.).size());
+    EXPECT_EQ(44100u, resample(in, 1.).size());
+    EXPECT_EQ(22050u, resample(in, 0.5).size());
+}
+
+TEST(dsp_resample, sine_is_resampled_in_place)
+{
+    // 1 kHz from 44.1 kHz to 48 kHz
+    auto const in = make_sine(44100, 1. / 44.1);
+    auto const out = resample(in, 48000. / 44100.);
+
+    ASSERT_EQ(48000u, out.size());
+
+    // the abrupt start and end ring, compare in between
+    auto const expected = make_sine(out.size(), 1. / 48.);
+    for (std::size_t i = 1000; i < out.size() - 1000; ++i)
+    {
+        ASSERT_NEAR(expected[i], out[i], 1e-3f) << i;
+    }
+}
+
+TEST(dsp_resample, downsampling_rejects_aliases)
+{
+    // 23 kHz at 48 kHz would alias to 21.1 kHz at 44.1 kHz
+    auto const in = make_sine(48000, 23. / 48.);
+    auto const out = resample(in, 44100. / 48000.);
+
+    auto const settled = std::span<float const>{out}.subspan(1000, 40000);
+    EXPECT_LT(amplitude_at(settled, 21.1 / 44.1), 1e-3f);
+}
+
+TEST(dsp_resampler, result_is_independent_of_block_sizes)
+{
+    auto const in = make_sine(4096, 1. / 48.);
+    double const ratio = 48000. / 44100.;
+
+    resampler whole(ratio);
+    std::vector<float> expected(whole.max_output_size(in.size()));
+    expected.resize(whole.process(in, expected));
+
+    resampler blocks(ratio);
+    std::vector<float> out;
+    std::vector<float> buffer(blocks.max_output_size(97));
+    for (std::size_t pos = 0; pos < in.size(); pos += 97)
+    {
+        auto const block = std::span{in}.subspan(
+                pos,
+                std::min<std::size_t>(97, in.size() - pos));
+        std::size_t const written = blocks.process(block, buffer);
+        out.insert(out.end(), buffer.begin(), buffer.begin() + written);
+    }
+
+    EXPECT_EQ(expected, out);
+}
+
+TEST(dsp_resampler, set_ratio_changes_the_output_rate_smoothly)
+{
+    auto const in = make_sine(48000, 1. / 48.);
+
+    resampler sut(1.);
+    std::vector<float> out(24100);
+
+    std::size_t const first = sut.process(std::span{in}.first(24000), out);
+    EXPECT_EQ(24000u - sut.latency(), first);
+    float const last = out[first - 1];
+
+    // drift of 1000 ppm
+    sut.set_ratio(1.001);
+    std::size_t const second =
+            sut.process(std::span{in}.subspan(24000), out);
+    EXPECT_NEAR(24024., static_cast<double>(second), 1.);
+
+    // the signal continues, without a jump
+    EXPECT_LT(std::abs(out[0] - last), 0.2f);
+}
+
+} // namespace piejam::audio::dsp::test
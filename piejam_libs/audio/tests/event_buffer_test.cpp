@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace piejam::audio::engine::test
 {
 
@@ -72,6 +74,30 @@ TEST(event_buffer, events_are_sorted_on_offset)
     EXPECT_FLOAT_EQ(23.f, ev2.value());
 }
 
+TEST(event_buffer, out_of_order_inserts_are_merged_in)
+{
+    std::pmr::memory_resource* event_memory = std::pmr::get_default_resource();
+    event_buffer<int> sut(event_memory);
+
+    // more events than the initial capacity, to force a reallocation
+    for (int i = 0; i < 40; ++i)
+    {
+        sut.insert(static_cast<std::size_t>(i * 7 % 13), i);
+    }
+
+    ASSERT_EQ(40u, sut.size());
+    EXPECT_TRUE(std::ranges::is_sorted(sut.offsets()));
+
+    // insertion order is kept for equal offsets
+    for (auto it = sut.begin(); std::next(it) != sut.end(); ++it)
+    {
+        if (it->offset() == std::next(it)->offset())
+        {
+            EXPECT_LT(it->value(), std::next(it)->value());
+        }
+    }
+}
+
 TEST(event_buffer, clear)
 {
     std::pmr::memory_resource* event_memory = std::pmr::get_default_resource();
@@ -19,6 +19,37 @@
 namespace piejam::audio::engine::test
 {
 
+namespace
+{
+
+struct non_forwarding_processor_mock : processor_mock
+{
+    auto may_forward_inputs() const noexcept -> bool override
+    {
+        return false;
+    }
+};
+
+struct silence_tail_processor_mock : non_forwarding_processor_mock
+{
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return 2;
+    }
+};
+
+auto
+capture_output(float*& out, float value)
+{
+    return [&out, value](process_context const& ctx) {
+        out = ctx.outputs[0].data();
+        ctx.outputs[0][0] = value;
+        ctx.results[0] = ctx.outputs[0];
+    };
+}
+
+} // namespace
+
 TEST(graph_to_dag, audio_is_transferred_to_connected_proc)
 {
     ::testing::NiceMock<processor_mock> in_proc;
@@ -222,4 +253,153 @@ TEST(graph_to_dag, event_output_buffer_is_cleared_after_dag_run)
     EXPECT_TRUE(ev_buf->empty());
 }
 
+TEST(graph_to_dag, output_buffers_are_reused_along_a_chain)
+{
+    std::array<::testing::NiceMock<non_forwarding_processor_mock>, 4> procs;
+
+    using namespace testing;
+
+    graph g;
+    for (std::size_t i = 0; i < procs.size(); ++i)
+    {
+        ON_CALL(procs[i], num_inputs()).WillByDefault(Return(i == 0 ? 0 : 1));
+        ON_CALL(procs[i], num_outputs()).WillByDefault(Return(1));
+
+        if (i > 0)
+        {
+            g.audio.insert({procs[i - 1], 0}, {procs[i], 0});
+        }
+    }
+
+    std::array<float*, 4> outs{};
+    for (std::size_t i = 0; i < procs.size(); ++i)
+    {
+        EXPECT_CALL(procs[i], process(_))
+                .WillOnce(Invoke(
+                        capture_output(outs[i], static_cast<float>(i))));
+    }
+
+    auto d = graph_to_dag(g).make_runnable();
+    (*d)(1);
+
+    // a buffer can't be reused by the consumer of its content, but by the
+    // next one in the chain
+    EXPECT_NE(outs[0], outs[1]);
+    EXPECT_EQ(outs[0], outs[2]);
+    EXPECT_EQ(outs[1], outs[3]);
+}
+
+TEST(graph_to_dag, forwarded_output_buffer_is_not_reused_by_consumers)
+{
+    ::testing::NiceMock<non_forwarding_processor_mock> in_proc;
+    ::testing::NiceMock<processor_mock> forward_proc;
+    ::testing::NiceMock<non_forwarding_processor_mock> out_proc;
+
+    using namespace testing;
+
+    ON_CALL(in_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(forward_proc, num_inputs()).WillByDefault(Return(1));
+    ON_CALL(forward_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_inputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_outputs()).WillByDefault(Return(1));
+
+    graph g;
+    g.audio.insert({in_proc, 0}, {forward_proc, 0});
+    g.audio.insert({forward_proc, 0}, {out_proc, 0});
+
+    float* in_out{};
+    float* out_out{};
+    EXPECT_CALL(in_proc, process(_))
+            .WillOnce(Invoke(capture_output(in_out, 23.f)));
+    EXPECT_CALL(forward_proc, process(_))
+            .WillOnce(Invoke([](process_context const& ctx) {
+                ctx.results[0] = ctx.inputs[0];
+            }));
+    EXPECT_CALL(out_proc, process(_))
+            .WillOnce(Invoke([&out_out](process_context const& ctx) {
+                EXPECT_EQ(23.f, ctx.inputs[0].get().span()[0]);
+                out_out = ctx.outputs[0].data();
+                ctx.outputs[0][0] = 0.f;
+                ctx.results[0] = ctx.outputs[0];
+            }));
+
+    auto d = graph_to_dag(g).make_runnable();
+    (*d)(1);
+
+    EXPECT_NE(in_out, out_out);
+}
+
+TEST(graph_to_dag, parallel_jobs_get_distinct_output_buffers)
+{
+    ::testing::NiceMock<non_forwarding_processor_mock> in_proc1;
+    ::testing::NiceMock<non_forwarding_processor_mock> in_proc2;
+    ::testing::NiceMock<non_forwarding_processor_mock> out_proc;
+
+    using namespace testing;
+
+    ON_CALL(in_proc1, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(in_proc2, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_inputs()).WillByDefault(Return(2));
+
+    graph g;
+    g.audio.insert({in_proc1, 0}, {out_proc, 0});
+    g.audio.insert({in_proc2, 0}, {out_proc, 1});
+
+    float* out1{};
+    float* out2{};
+    EXPECT_CALL(in_proc1, process(_))
+            .WillOnce(Invoke(capture_output(out1, 1.f)));
+    EXPECT_CALL(in_proc2, process(_))
+            .WillOnce(Invoke(capture_output(out2, 2.f)));
+
+    auto d = graph_to_dag(g).make_runnable();
+    (*d)(1);
+
+    EXPECT_NE(out1, out2);
+}
+
+TEST(graph_to_dag, processor_with_silent_inputs_is_skipped_after_tail)
+{
+    ::testing::NiceMock<non_forwarding_processor_mock> in_proc;
+    ::testing::NiceMock<silence_tail_processor_mock> tail_proc;
+    ::testing::NiceMock<non_forwarding_processor_mock> out_proc;
+
+    using namespace testing;
+
+    ON_CALL(in_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(tail_proc, num_inputs()).WillByDefault(Return(1));
+    ON_CALL(tail_proc, num_outputs()).WillByDefault(Return(1));
+    ON_CALL(out_proc, num_inputs()).WillByDefault(Return(1));
+
+    graph g;
+    g.audio.insert({in_proc, 0}, {tail_proc, 0});
+    g.audio.insert({tail_proc, 0}, {out_proc, 0});
+
+    ON_CALL(in_proc, process(_))
+            .WillByDefault(Invoke([](process_context const& ctx) {
+                ctx.results[0] = 0.f;
+            }));
+    ON_CALL(tail_proc, process(_))
+            .WillByDefault(Invoke([](process_context const& ctx) {
+                ctx.outputs[0][0] = 1.f;
+                ctx.results[0] = ctx.outputs[0];
+            }));
+
+    auto output_is_silent = [](process_context const& ctx) {
+        return ctx.inputs[0].get().is_constant() &&
+               ctx.inputs[0].get().constant() == 0.f;
+    };
+
+    // tail of two frames, processed twice with a buffer size of one
+    EXPECT_CALL(tail_proc, process(_)).Times(2);
+    EXPECT_CALL(out_proc, process(Not(Truly(output_is_silent)))).Times(2);
+    EXPECT_CALL(out_proc, process(Truly(output_is_silent))).Times(2);
+
+    auto d = graph_to_dag(g).make_runnable();
+    for (int i = 0; i < 4; ++i)
+    {
+        (*d)(1);
+    }
+}
+
 } // namespace piejam::audio::engine::test
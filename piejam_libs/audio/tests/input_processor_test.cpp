@@ -13,6 +13,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace piejam::audio::engine::test
 {
 
@@ -25,8 +27,8 @@ TEST(input_processor, input_is_propagated_to_outputs)
     std::vector<std::span<float>> outputs{out_buf};
     std::vector<slice<float>> results(1);
     auto converter =
-            pcm_input_buffer_converter([&out_buf](std::span<float> const buf) {
-                std::ranges::copy(out_buf, buf.begin());
+            pcm_input_buffer_converter([&data](std::span<float> const buf) {
+                std::ranges::copy(data, buf.begin());
             });
     sut.set_input(converter);
     sut.process({{}, outputs, results, {}, {}, 4});
@@ -34,6 +36,25 @@ TEST(input_processor, input_is_propagated_to_outputs)
     ASSERT_TRUE(results[0].is_span());
     EXPECT_EQ(results[0].span().data(), out_buf.data());
     EXPECT_EQ(results[0].span().size(), out_buf.size());
+    EXPECT_TRUE(std::ranges::equal(data, out_buf));
+}
+
+TEST(input_processor, silent_input_results_in_constant_zero)
+{
+    input_processor sut;
+
+    alignas(mipp::RequiredAlignment) std::array<float, 4> out_buf{};
+    std::vector<std::span<float>> outputs{out_buf};
+    std::vector<slice<float>> results(1);
+    auto converter =
+            pcm_input_buffer_converter([](std::span<float> const buf) {
+                std::ranges::fill(buf, 0.f);
+            });
+    sut.set_input(converter);
+    sut.process({{}, outputs, results, {}, {}, 4});
+
+    ASSERT_TRUE(results[0].is_constant());
+    EXPECT_EQ(0.f, results[0].constant());
 }
 
 } // namespace piejam::audio::engine::test
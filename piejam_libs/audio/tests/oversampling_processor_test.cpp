@@ -0,0 +1,189 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/oversampling_processor.h>
+
+#include <piejam/audio/engine/clip_processor.h>
+#include <piejam/audio/engine/processor.h>
+#include <piejam/audio/engine/processor_test_environment.h>
+#include <piejam/audio/slice.h>
+
+#include <mipp.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace piejam::audio::engine::test
+{
+
+namespace
+{
+
+constexpr std::size_t buffer_size{256};
+constexpr std::size_t num_buffers{32};
+
+auto
+make_clip_chain(float const limit)
+{
+    std::vector<std::unique_ptr<processor>> chain;
+    chain.push_back(make_clip_processor(-limit, limit));
+    return chain;
+}
+
+// Runs a sine through the processor, buffer by buffer.
+auto
+process_sine(processor& proc, float const freq, float const amplitude)
+        -> std::vector<float>
+{
+    processor_test_environment env(proc, buffer_size);
+
+    mipp::vector<float> in(buffer_size);
+    env.audio_inputs[0] = std::span<float const>{in};
+
+    std::vector<float> out;
+    for (std::size_t b = 0; b < num_buffers; ++b)
+    {
+        for (std::size_t i = 0; i < buffer_size; ++i)
+        {
+            in[i] = amplitude *
+                    std::sin(
+                            2.f * std::numbers::pi_v<float> * freq *
+                            static_cast<float>(b * buffer_size + i));
+        }
+
+        proc.process(env.ctx);
+
+        auto const& result = env.audio_results[0];
+        if (result.is_constant())
+        {
+            out.insert(out.end(), buffer_size, result.constant());
+        }
+        else
+        {
+            out.insert(out.end(), result.span().begin(), result.span().end());
+        }
+    }
+
+    return out;
+}
+
+auto
+amplitude_at(std::span<float const> const in, float const freq) -> float
+{
+    std::complex<double> sum{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        sum += static_cast<double>(in[i]) *
+               std::polar(
+                       1.,
+                       -2. * std::numbers::pi * static_cast<double>(freq) *
+                               static_cast<double>(i));
+    }
+    return static_cast<float>(2. * std::abs(sum) / in.size());
+}
+
+} // namespace
+
+struct oversampling_processor_test
+    : testing::TestWithParam<
+              std::tuple<oversampling_factor, oversampling_phase>>
+{
+    auto make_sut(std::vector<std::unique_ptr<processor>> chain)
+    {
+        return make_oversampling_processor(
+                1,
+                std::move(chain),
+                std::get<0>(GetParam()),
+                std::get<1>(GetParam()));
+    }
+};
+
+TEST_P(oversampling_processor_test, transparent_chain_delays_by_latency)
+{
+    auto sut = make_sut(make_clip_chain(10.f));
+    ASSERT_GT(sut->latency(), 0u);
+
+    // 1 kHz at 48 kHz
+    float const freq = 1.f / 48.f;
+    auto const out = process_sine(*sut, freq, 1.f);
+
+    // Only the linear phase 2x latency is a whole number of frames, the
+    // others are rounded, off by half a frame at most.
+    bool const exact = GetParam() == std::tuple{
+                                             oversampling_factor::x2,
+                                             oversampling_phase::linear};
+    float const tolerance = exact ? 1e-3f : 0.07f;
+    for (std::size_t i = buffer_size; i < out.size(); ++i)
+    {
+        float const expected = std::sin(
+                2.f * std::numbers::pi_v<float> * freq *
+                static_cast<float>(i - sut->latency()));
+        EXPECT_NEAR(expected, out[i], tolerance);
+    }
+}
+
+TEST_P(oversampling_processor_test, clipping_aliases_less)
+{
+    // The 5th harmonic of 7 kHz, 35 kHz, aliases to 13 kHz at 48 kHz.
+    float const freq = 7.f / 48.f;
+    float const alias = 13.f / 48.f;
+
+    auto plain = make_clip_processor(-1.f, 1.f);
+    auto const plain_out = process_sine(*plain, freq, 4.f);
+
+    auto sut = make_sut(make_clip_chain(1.f));
+    auto const oversampled_out = process_sine(*sut, freq, 4.f);
+
+    auto const settled = [](std::vector<float> const& v) {
+        return std::span<float const>{v}.subspan(buffer_size);
+    };
+
+    EXPECT_LT(
+            10.f * amplitude_at(settled(oversampled_out), alias),
+            amplitude_at(settled(plain_out), alias));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        verify,
+        oversampling_processor_test,
+        testing::Combine(
+                testing::Values(
+                        oversampling_factor::x2,
+                        oversampling_factor::x4),
+                testing::Values(
+                        oversampling_phase::linear,
+                        oversampling_phase::minimum)));
+
+TEST(oversampling_processor, minimum_phase_has_lower_latency)
+{
+    auto const make = [](oversampling_factor const factor,
+                         oversampling_phase const phase) {
+        std::vector<std::unique_ptr<processor>> chain;
+        chain.push_back(make_clip_processor());
+        return make_oversampling_processor(1, std::move(chain), factor, phase);
+    };
+
+    EXPECT_EQ(
+            31u,
+            make(oversampling_factor::x2, oversampling_phase::linear)
+                    ->latency());
+    EXPECT_LT(
+            make(oversampling_factor::x2, oversampling_phase::minimum)
+                    ->latency(),
+            5u);
+    EXPECT_LT(
+            make(oversampling_factor::x4, oversampling_phase::minimum)
+                    ->latency(),
+            make(oversampling_factor::x4, oversampling_phase::linear)
+                    ->latency());
+}
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,93 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/period_timing.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace piejam::audio::test
+{
+
+TEST(period_timing_history, snapshot_is_empty_without_xrun)
+{
+    period_timing_history sut(4);
+    sut.begin_period();
+
+    EXPECT_TRUE(sut.take_snapshot().empty());
+}
+
+TEST(period_timing_history, snapshot_contains_periods_oldest_first)
+{
+    period_timing_history sut(4);
+    for (int i = 0; i < 6; ++i)
+    {
+        sut.begin_period();
+        sut.mark(period_event::graph_start);
+    }
+    sut.mark(period_event::xrun);
+    sut.snapshot();
+
+    auto const timings = sut.take_snapshot();
+    ASSERT_EQ(4u, timings.size());
+    EXPECT_EQ(3u, timings[0].period);
+    EXPECT_EQ(6u, timings[3].period);
+    EXPECT_NE(0u, timings[3][period_event::start]);
+    EXPECT_LE(
+            timings[3][period_event::start],
+            timings[3][period_event::graph_start]);
+    EXPECT_NE(0u, timings[3][period_event::xrun]);
+    EXPECT_EQ(0u, timings[2][period_event::xrun]);
+
+    EXPECT_TRUE(sut.take_snapshot().empty());
+}
+
+TEST(period_timing_history, snapshot_before_history_is_filled)
+{
+    period_timing_history sut(4);
+    sut.begin_period();
+    sut.begin_period();
+    sut.snapshot();
+
+    auto const timings = sut.take_snapshot();
+    ASSERT_EQ(2u, timings.size());
+    EXPECT_EQ(1u, timings[0].period);
+    EXPECT_EQ(2u, timings[1].period);
+}
+
+TEST(period_timing_history, mark_period_event_goes_to_current_history)
+{
+    period_timing_history sut(4);
+    sut.make_current();
+    sut.begin_period();
+    mark_period_event(period_event::executor_swap);
+    sut.snapshot();
+
+    auto const timings = sut.take_snapshot();
+    ASSERT_EQ(1u, timings.size());
+    EXPECT_NE(0u, timings[0][period_event::executor_swap]);
+}
+
+TEST(period_timing, write_read_roundtrip)
+{
+    period_timing_history history(4);
+    history.begin_period();
+    history.mark(period_event::read_complete);
+    history.snapshot();
+    auto const timings = history.take_snapshot();
+
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_period_timing_test.pjpt";
+    ASSERT_TRUE(write_period_timings(file, timings));
+
+    auto const read = read_period_timings(file);
+    std::filesystem::remove(file);
+
+    ASSERT_EQ(1u, read.size());
+    EXPECT_EQ(timings[0].period, read[0].period);
+    EXPECT_EQ(timings[0].timestamps, read[0].timestamps);
+}
+
+} // namespace piejam::audio::test
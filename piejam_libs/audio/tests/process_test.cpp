@@ -41,19 +41,77 @@ TEST(process_test, swap_executor)
 
     for (std::size_t i = 0; i < 10000; ++i)
     {
-        EXPECT_TRUE(
-                sut.swap_executor(std::make_unique<test_dummy_dag_executor>()));
+        sut.swap_executor(std::make_unique<test_dummy_dag_executor>());
+        sut.reclaim();
     }
 
     running = false;
     process_thread.join();
 }
 
-TEST(process_test, swap_executor_fails_if_processing_thread_is_not_running)
+TEST(process_test, swap_executor_does_not_block_if_not_processing)
 {
     process sut;
-    EXPECT_FALSE(
-            sut.swap_executor(std::make_unique<test_dummy_dag_executor>()));
+    sut.swap_executor(std::make_unique<test_dummy_dag_executor>());
+
+    EXPECT_EQ(0u, sut.reclaim());
+}
+
+TEST(process_test, previous_executor_is_reclaimed_after_a_period)
+{
+    process sut;
+    auto resources = std::make_shared<int>(5);
+    bool active{};
+
+    sut.swap_executor(std::make_unique<test_dummy_dag_executor>());
+    sut(2);
+    sut.swap_executor(
+            std::make_unique<test_dummy_dag_executor>(),
+            resources,
+            [&active]() { active = true; });
+
+    // the initial and the first swapped in executor
+    EXPECT_EQ(1u, sut.reclaim());
+    EXPECT_FALSE(active);
+
+    sut(2);
+    EXPECT_EQ(1u, sut.reclaim());
+    EXPECT_TRUE(active);
+    EXPECT_EQ(2, resources.use_count());
+}
+
+TEST(process_test, resources_are_released_with_the_executor)
+{
+    process sut;
+    auto resources = std::make_shared<int>(5);
+
+    sut.swap_executor(std::make_unique<test_dummy_dag_executor>(), resources);
+    sut(2);
+    sut.swap_executor(std::make_unique<test_dummy_dag_executor>());
+    sut(2);
+
+    EXPECT_EQ(2, resources.use_count());
+    EXPECT_EQ(2u, sut.reclaim());
+    EXPECT_EQ(1, resources.use_count());
+}
+
+TEST(process_test, pending_executor_is_dropped_when_superseded)
+{
+    process sut;
+    auto resources = std::make_shared<int>(5);
+    bool active{};
+
+    sut.swap_executor(
+            std::make_unique<test_dummy_dag_executor>(),
+            resources,
+            [&active]() { active = true; });
+    sut.swap_executor(std::make_unique<test_dummy_dag_executor>());
+
+    EXPECT_EQ(1, resources.use_count());
+
+    sut(2);
+    sut.reclaim();
+    EXPECT_FALSE(active);
 }
 
 } // namespace piejam::audio::engine::test
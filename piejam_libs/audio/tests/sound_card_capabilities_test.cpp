@@ -0,0 +1,94 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/sound_card_capabilities.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::audio::test
+{
+
+namespace
+{
+
+auto
+make_capabilities() -> sound_card_capabilities
+{
+    sound_card_capabilities caps;
+    caps.hw_params.num_channels = 2;
+    caps.hw_params.sample_rates = {sample_rate(44100u), sample_rate(48000u)};
+    caps.hw_params.period_sizes = {period_size(64u), period_size(128u)};
+    caps.hw_params.period_counts = {period_count(2u), period_count(3u)};
+    caps.by_period_size = {
+            {.period_counts = {period_count(3u)}},
+            {.period_counts = {period_count(2u)}}};
+
+    caps.by_sample_rate = {
+            {.period_sizes = {period_size(64u)},
+             .period_counts = {period_count(3u)},
+             .by_period_size = {{.period_counts = {period_count(3u)}}}},
+            {.period_sizes = {period_size(64u), period_size(128u)},
+             .period_counts = {period_count(2u), period_count(3u)},
+             .by_period_size = {
+                     {.period_counts = {period_count(2u)}},
+                     {.period_counts = {period_count(2u), period_count(3u)}},
+             }}};
+
+    return caps;
+}
+
+} // namespace
+
+TEST(sound_card_capabilities, unconstrained)
+{
+    auto const caps = make_capabilities();
+
+    EXPECT_EQ(caps.hw_params, hw_params(caps, nullptr, nullptr));
+}
+
+TEST(sound_card_capabilities, constrained_by_sample_rate)
+{
+    auto const caps = make_capabilities();
+    sample_rate const sr(44100u);
+
+    auto const result = hw_params(caps, &sr, nullptr);
+
+    EXPECT_EQ(caps.hw_params.sample_rates, result.sample_rates);
+    EXPECT_EQ(period_sizes_t{period_size(64u)}, result.period_sizes);
+    EXPECT_EQ(period_counts_t{period_count(3u)}, result.period_counts);
+}
+
+TEST(sound_card_capabilities, constrained_by_sample_rate_and_period_size)
+{
+    auto const caps = make_capabilities();
+    sample_rate const sr(48000u);
+    period_size const ps(64u);
+
+    auto const result = hw_params(caps, &sr, &ps);
+
+    EXPECT_EQ(caps.by_sample_rate[1].period_sizes, result.period_sizes);
+    EXPECT_EQ(period_counts_t{period_count(2u)}, result.period_counts);
+}
+
+TEST(sound_card_capabilities, constrained_by_period_size_only)
+{
+    auto const caps = make_capabilities();
+    period_size const ps(64u);
+
+    auto const result = hw_params(caps, nullptr, &ps);
+
+    EXPECT_EQ(caps.hw_params.period_sizes, result.period_sizes);
+    EXPECT_EQ(period_counts_t{period_count(3u)}, result.period_counts);
+}
+
+TEST(sound_card_capabilities, unsupported_constraints_are_ignored)
+{
+    auto const caps = make_capabilities();
+    sample_rate const sr(96000u);
+    period_size const ps(1024u);
+
+    EXPECT_EQ(caps.hw_params, hw_params(caps, &sr, &ps));
+}
+
+} // namespace piejam::audio::test
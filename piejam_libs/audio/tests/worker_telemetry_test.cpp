@@ -0,0 +1,59 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/audio/engine/worker_telemetry.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::audio::engine::test
+{
+
+using namespace std::chrono_literals;
+
+TEST(worker_telemetry, update_accumulates)
+{
+    worker_telemetry sut(2);
+
+    sut.update(1, {.busy = 3ns, .steal = 1ns, .tasks = 2, .steals = 1});
+    sut.update(1, {.busy = 4ns, .steal = 2ns, .tasks = 3, .steals = 2});
+
+    auto const stats = sut.stats();
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ(0u, stats[0].tasks);
+    EXPECT_EQ(7ns, stats[1].busy);
+    EXPECT_EQ(3ns, stats[1].steal);
+    EXPECT_EQ(5u, stats[1].tasks);
+    EXPECT_EQ(3u, stats[1].steals);
+    EXPECT_GT(stats[1].cpu_time, 0ns);
+}
+
+TEST(worker_telemetry, loads_are_fractions_of_the_interval)
+{
+    std::vector<worker_stats> const prev{
+            {.busy = 100ns, .steal = 50ns, .cpu_time = 200ns}};
+    std::vector<worker_stats> const curr{
+            {.busy = 600ns, .steal = 150ns, .cpu_time = 800ns}};
+
+    auto const loads = worker_loads(prev, curr, 1000ns);
+
+    ASSERT_EQ(1u, loads.size());
+    EXPECT_FLOAT_EQ(0.5f, loads[0].busy);
+    EXPECT_FLOAT_EQ(0.1f, loads[0].steal);
+    EXPECT_FLOAT_EQ(0.4f, loads[0].idle);
+    EXPECT_FLOAT_EQ(0.6f, loads[0].cpu);
+}
+
+TEST(worker_telemetry, loads_after_counter_restart)
+{
+    std::vector<worker_stats> const prev{{.busy = 900ns}};
+    std::vector<worker_stats> const curr{{.busy = 200ns}, {.busy = 300ns}};
+
+    auto const loads = worker_loads(prev, curr, 1000ns);
+
+    ASSERT_EQ(2u, loads.size());
+    EXPECT_FLOAT_EQ(0.2f, loads[0].busy);
+    EXPECT_FLOAT_EQ(0.3f, loads[1].busy);
+}
+
+} // namespace piejam::audio::engine::test
@@ -0,0 +1,80 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Prints the period timings written on an xrun. Times are in microseconds,
+// relative to the start of each period. The start column is the distance
+// to the start of the previous period.
+
+#include <piejam/audio/period_timing.h>
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+using namespace piejam::audio;
+
+namespace
+{
+
+auto
+to_us(std::uint64_t const ns) -> double
+{
+    return static_cast<double>(ns) / 1000.;
+}
+
+} // namespace
+
+auto
+main(int argc, char* argv[]) -> int
+{
+    if (argc != 2)
+    {
+        fmt::print(stderr, "usage: {} <file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto const timings = read_period_timings(argv[1]);
+    if (timings.empty())
+    {
+        return EXIT_FAILURE;
+    }
+
+    fmt::print("{:>12}", "period");
+    for (std::size_t i = 0; i < num_period_events; ++i)
+    {
+        fmt::print(" {:>15}", to_string(static_cast<period_event>(i)));
+    }
+    fmt::print("\n");
+
+    std::uint64_t prev_start{};
+    for (period_timing const& t : timings)
+    {
+        std::uint64_t const start = t[period_event::start];
+
+        fmt::print("{:>12}", t.period);
+        fmt::print(
+                " {:>15.1f}",
+                prev_start != 0 ? to_us(start - prev_start) : 0.);
+
+        for (std::size_t i = 1; i < num_period_events; ++i)
+        {
+            std::uint64_t const ts = t.timestamps[i];
+            if (ts == 0)
+            {
+                fmt::print(" {:>15}", "-");
+            }
+            else
+            {
+                fmt::print(" {:>15.1f}", to_us(ts - start));
+            }
+        }
+
+        fmt::print("\n");
+
+        prev_start = start;
+    }
+
+    return EXIT_SUCCESS;
+}
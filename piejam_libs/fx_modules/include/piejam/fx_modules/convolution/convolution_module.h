@@ -0,0 +1,31 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/types.h>
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/internal_fx_module_factory.h>
+
+#include <chrono>
+
+namespace piejam::fx_modules::convolution
+{
+
+enum class parameter_key : runtime::parameter::key
+{
+    decay,
+    mix,
+    impulse_response,
+};
+
+//! Upper bound of the decay parameter, which bounds the impulse response
+//! length as well. Impulse response files are cut after the decay time.
+inline constexpr std::chrono::seconds max_decay{4};
+
+auto make_module(runtime::internal_fx_module_factory_args const&)
+        -> runtime::fx::module;
+
+} // namespace piejam::fx_modules::convolution
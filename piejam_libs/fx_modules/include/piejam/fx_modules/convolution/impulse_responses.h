@@ -0,0 +1,37 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/sample_rate.h>
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace piejam::fx_modules::convolution
+{
+
+//! Looks for impulse response files in dir, they can be picked with the
+//! impulse response parameter afterwards. Scanned only once, so the
+//! parameter values keep pointing to the same files while running.
+void scan_impulse_responses(std::filesystem::path const& dir);
+
+//! Sorted by file name. Value n of the impulse response parameter picks
+//! the file at index n - 1, zero is the synthesized response.
+[[nodiscard]]
+auto impulse_responses() noexcept -> std::span<std::filesystem::path const>;
+
+//! One response per channel, resampled to sample_rate and cut after
+//! max_size samples. Mono files are used for all channels, surplus file
+//! channels are dropped. Throws std::runtime_error if the file can't be
+//! read.
+[[nodiscard]]
+auto read_impulse_response(
+        std::filesystem::path const&,
+        std::size_t num_channels,
+        audio::sample_rate,
+        std::size_t max_size) -> std::vector<std::vector<float>>;
+
+} // namespace piejam::fx_modules::convolution
@@ -0,0 +1,78 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/audio/types.h>
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/internal_fx_module_factory.h>
+
+#include <chrono>
+
+namespace piejam::fx_modules::delay
+{
+
+enum class parameter_key : runtime::parameter::key
+{
+    time,
+    sync,
+    tempo,
+    feedback,
+    mix,
+};
+
+//! Note values the delay time can be synced to, relative to the tempo.
+enum class sync : int
+{
+    off,
+    whole,
+    half,
+    quarter,
+    quarter_dotted,
+    quarter_triplet,
+    eighth,
+    eighth_dotted,
+    eighth_triplet,
+    sixteenth,
+};
+
+inline constexpr std::chrono::milliseconds min_time{10};
+inline constexpr std::chrono::milliseconds max_time{2000};
+
+//! Length of a note value in quarter notes, 0 if not synced.
+[[nodiscard]]
+constexpr auto
+sync_beats(sync const s) noexcept -> float
+{
+    switch (s)
+    {
+        case sync::whole:
+            return 4.f;
+        case sync::half:
+            return 2.f;
+        case sync::quarter:
+            return 1.f;
+        case sync::quarter_dotted:
+            return 1.5f;
+        case sync::quarter_triplet:
+            return 2.f / 3.f;
+        case sync::eighth:
+            return 0.5f;
+        case sync::eighth_dotted:
+            return 0.75f;
+        case sync::eighth_triplet:
+            return 1.f / 3.f;
+        case sync::sixteenth:
+            return 0.25f;
+
+        default:
+            return 0.f;
+    }
+}
+
+auto make_module(runtime::internal_fx_module_factory_args const&)
+        -> runtime::fx::module;
+
+} // namespace piejam::fx_modules::delay
@@ -0,0 +1,15 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/fx/fwd.h>
+
+namespace piejam::fx_modules::dynamics
+{
+
+auto compressor_internal_id() -> runtime::fx::internal_id;
+auto limiter_internal_id() -> runtime::fx::internal_id;
+
+} // namespace piejam::fx_modules::dynamics
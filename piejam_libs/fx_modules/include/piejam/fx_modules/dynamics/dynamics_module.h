@@ -0,0 +1,50 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/audio_stream.h>
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/internal_fx_module_factory.h>
+#include <piejam/runtime/parameters.h>
+
+#include <piejam/audio/types.h>
+
+#include <chrono>
+
+namespace piejam::fx_modules::dynamics
+{
+
+enum class compressor_parameter_key : runtime::parameter::key
+{
+    threshold,
+    ratio,
+    attack,
+    release,
+    makeup,
+};
+
+enum class limiter_parameter_key : runtime::parameter::key
+{
+    threshold,
+    release,
+};
+
+enum class stream_key : runtime::fx::stream_key
+{
+    gain_reduction
+};
+
+//! The signal is delayed by the lookahead, so the gain can be reduced
+//! before a peak arrives. Reported as processor latency.
+inline constexpr std::chrono::milliseconds lookahead{5};
+
+auto make_compressor_module(runtime::internal_fx_module_factory_args const&)
+        -> runtime::fx::module;
+
+auto make_limiter_module(runtime::internal_fx_module_factory_args const&)
+        -> runtime::fx::module;
+
+} // namespace piejam::fx_modules::dynamics
@@ -0,0 +1,52 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/gui/PropertyMacros.h>
+#include <piejam/gui/model/FxGenericModule.h>
+
+#include <piejam/pimpl.h>
+#include <piejam/runtime/fx/fwd.h>
+
+namespace piejam::fx_modules::dynamics::gui
+{
+
+//! Generic parameters plus the gain reduction, in dB.
+class FxDynamics : public piejam::gui::model::FxGenericModule
+{
+    Q_OBJECT
+
+    M_PIEJAM_GUI_PROPERTY(float, gainReduction, setGainReduction)
+
+public:
+    FxDynamics(
+            runtime::store_dispatch,
+            runtime::subscriber&,
+            runtime::fx::module_id);
+
+    Q_INVOKABLE void clear();
+
+private:
+    struct Impl;
+    pimpl<Impl> m_impl;
+};
+
+class FxCompressor final : public FxDynamics
+{
+public:
+    using FxDynamics::FxDynamics;
+
+    auto type() const noexcept -> piejam::gui::model::FxModuleType override;
+};
+
+class FxLimiter final : public FxDynamics
+{
+public:
+    using FxDynamics::FxDynamics;
+
+    auto type() const noexcept -> piejam::gui::model::FxModuleType override;
+};
+
+} // namespace piejam::fx_modules::dynamics::gui
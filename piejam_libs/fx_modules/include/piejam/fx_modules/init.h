@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <filesystem>
+
 namespace piejam::fx_modules
 {
 
-void init();
+//! Impulse responses for the convolution reverb are looked up in
+//! impulse_responses_dir.
+void init(std::filesystem::path const& impulse_responses_dir);
 
 } // namespace piejam::fx_modules
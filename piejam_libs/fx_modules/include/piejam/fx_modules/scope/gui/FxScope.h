@@ -31,6 +31,9 @@ class FxScope final : public piejam::gui::model::FxModule
     M_PIEJAM_GUI_CONSTANT_PROPERTY(
             piejam::gui::model::FloatParameter*,
             triggerLevel)
+    M_PIEJAM_GUI_CONSTANT_PROPERTY(
+            piejam::gui::model::FloatParameter*,
+            triggerHysteresis)
     M_PIEJAM_GUI_CONSTANT_PROPERTY(
             piejam::gui::model::FloatParameter*,
             holdTime)
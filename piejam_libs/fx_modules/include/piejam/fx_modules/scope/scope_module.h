@@ -72,6 +72,7 @@ enum class parameter_key : runtime::parameter::key
     gain_a,
     gain_b,
     freeze,
+    trigger_hysteresis,
 };
 
 enum class stream_key : runtime::fx::stream_key
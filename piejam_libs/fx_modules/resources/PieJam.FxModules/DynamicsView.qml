@@ -0,0 +1,77 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Material 2.15
+import QtQuick.Layouts 1.15
+
+import PieJam 1.0
+import PieJam.FxChainControls 1.0
+
+SubscribableItem {
+    id: root
+
+    property bool bypassed: false
+
+    readonly property real maxGainReduction: -24
+
+    implicitWidth: 460
+
+    RowLayout {
+        anchors.fill: parent
+
+        ListView {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+
+            spacing: 4
+            clip: true
+            orientation: ListView.Horizontal
+            boundsBehavior: Flickable.StopAtBounds
+            boundsMovement: Flickable.StopAtBounds
+
+            model: root.model ? root.model.parametersList : null
+
+            delegate: ParameterControl {
+                paramModel: model.item
+
+                height: parent ? parent.height : undefined
+            }
+        }
+
+        ColumnLayout {
+            Layout.preferredWidth: 48
+            Layout.fillHeight: true
+
+            Rectangle {
+                Layout.alignment: Qt.AlignHCenter
+                Layout.preferredWidth: 8
+                Layout.fillHeight: true
+
+                color: Material.color(Material.Grey, Material.Shade800)
+
+                Rectangle {
+                    width: parent.width
+                    height: root.model
+                            ? parent.height * Math.min(root.model.gainReduction / root.maxGainReduction, 1)
+                            : 0
+
+                    color: Material.color(Material.Orange)
+                }
+            }
+
+            Label {
+                Layout.fillWidth: true
+
+                font.pointSize: 7
+                horizontalAlignment: Text.AlignHCenter
+
+                text: root.model ? root.model.gainReduction.toFixed(1) + " dB" : "--"
+            }
+        }
+    }
+
+    onBypassedChanged: if (root.bypassed && root.model) root.model.clear()
+}
@@ -41,6 +41,7 @@ SubscribableItem {
         readonly property var mode: root.model ? root.model.mode : null
         readonly property var triggerSlope: root.model ? root.model.triggerSlope : null
         readonly property var triggerLevel: root.model ? root.model.triggerLevel : null
+        readonly property var triggerHysteresis: root.model ? root.model.triggerHysteresis : null
         readonly property var holdTime: root.model ? root.model.holdTime : null
         readonly property bool freeMode: mode && mode.value === FxScope.Mode.Free
         readonly property bool scopeWindowSize: root.model ? root.model.scopeWindowSize.value : 0
@@ -240,6 +241,26 @@ SubscribableItem {
                 Layout.fillHeight: true
             }
 
+            ColumnLayout {
+                enabled: !private_.freeMode
+
+                Label {
+                    text: "Hysteresis"
+                    topPadding: 4
+                }
+
+                ParameterQuickSpinBox {
+                    model: private_.triggerHysteresis
+                    stepScale: .5
+
+                    Layout.preferredWidth: 112
+                }
+            }
+
+            ToolSeparator {
+                Layout.fillHeight: true
+            }
+
             ColumnLayout {
                 enabled: !private_.freeMode
 
@@ -0,0 +1,717 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/convolution/convolution_component.h>
+
+#include <piejam/audio/dsp/partitioned_convolver.h>
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/event_converter_processor.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_endpoint.h>
+#include <piejam/audio/engine/graph_generic_algorithms.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/single_event_input_processor.h>
+#include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/sample_rate.h>
+#include <piejam/audio/slice_algorithms.h>
+#include <piejam/fx_modules/convolution/convolution_module.h>
+#include <piejam/fx_modules/convolution/impulse_responses.h>
+#include <piejam/numeric/dft.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_component_factory.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/hof/match.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+namespace piejam::fx_modules::convolution
+{
+
+namespace
+{
+
+// Also the latency of the wet signal, which doubles as pre-delay. The dry
+// signal isn't delayed, so there is no latency to compensate.
+constexpr std::size_t block_size = 512;
+
+struct event_value
+{
+    float decay{};
+    float mix{};
+    int impulse_response{};
+};
+
+auto
+make_params_converter_processor()
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_input_names{
+            "decay"sv,
+            "mix"sv,
+            "impulse_response"sv};
+    static constexpr std::array s_output_names{"params"sv};
+    return audio::engine::make_event_converter_processor(
+            [](float const decay, float const mix, int const ir) {
+                return event_value{
+                        .decay = decay,
+                        .mix = mix,
+                        .impulse_response = ir};
+            },
+            s_input_names,
+            s_output_names,
+            "convolution_params");
+}
+
+// What the kernels of a processor are made from.
+struct kernel_request
+{
+    float decay{};
+    int impulse_response{};
+
+    auto operator==(kernel_request const&) const noexcept -> bool = default;
+};
+
+// Normalized to unit energy, so the wet level doesn't depend on the
+// response.
+void
+normalize(std::vector<float>& ir)
+{
+    double energy{};
+    for (float const x : ir)
+    {
+        energy += static_cast<double>(x) * x;
+    }
+
+    if (energy > 0.)
+    {
+        float const scale = static_cast<float>(1. / std::sqrt(energy));
+        std::ranges::transform(ir, ir.begin(), [scale](float const x) {
+            return x * scale;
+        });
+    }
+}
+
+// Exponentially decaying noise, reaching -60 dB after the decay time. The
+// channels get noise of their own, for a wide stereo image.
+auto
+make_synthetic_impulse_response(std::size_t const size, unsigned const seed)
+        -> std::vector<float>
+{
+    std::minstd_rand gen(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    float const k = std::log(0.001f) / static_cast<float>(size);
+
+    std::vector<float> ir(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ir[i] = dist(gen) * std::exp(k * static_cast<float>(i));
+    }
+
+    return ir;
+}
+
+// The last eighth is faded out, so a file cut after the decay time doesn't
+// end with a click.
+void
+fade_out(std::vector<float>& ir)
+{
+    std::size_t const fade_size = std::max(ir.size() / 8, std::size_t{1});
+    std::size_t const fade_start = ir.size() - std::min(fade_size, ir.size());
+    for (std::size_t i = fade_start; i < ir.size(); ++i)
+    {
+        ir[i] *= static_cast<float>(ir.size() - i) /
+                 static_cast<float>(fade_size);
+    }
+}
+
+// One response per channel. Throws std::runtime_error, if the file can't be
+// read.
+auto
+make_impulse_responses(
+        kernel_request const& req,
+        std::size_t const num_channels,
+        audio::sample_rate const sample_rate)
+        -> std::vector<std::vector<float>>
+{
+    std::size_t const size = std::max(
+            sample_rate.to_samples(std::chrono::duration<float>(std::min(
+                    req.decay,
+                    static_cast<float>(max_decay.count())))),
+            std::size_t{1});
+
+    auto const files = impulse_responses();
+
+    std::vector<std::vector<float>> irs;
+    if (req.impulse_response > 0 &&
+        static_cast<std::size_t>(req.impulse_response) <= files.size())
+    {
+        irs = read_impulse_response(
+                files[static_cast<std::size_t>(req.impulse_response - 1)],
+                num_channels,
+                sample_rate,
+                size);
+        std::ranges::for_each(irs, &fade_out);
+    }
+    else
+    {
+        irs.reserve(num_channels);
+        for (std::size_t ch = 0; ch < num_channels; ++ch)
+        {
+            irs.push_back(make_synthetic_impulse_response(
+                    size,
+                    static_cast<unsigned>(ch + 1)));
+        }
+    }
+
+    std::ranges::for_each(irs, &normalize);
+
+    return irs;
+}
+
+// One kernel per channel.
+using kernels_t = std::vector<audio::dsp::convolution_kernel>;
+
+class kernel_slot;
+
+// Builds the kernels of all convolution processors on a thread of its own.
+// The thread sleeps until one of the processors requests new kernels.
+class kernel_loader
+{
+public:
+    kernel_loader()
+        : m_dft(2 * block_size)
+        , m_thread([this](std::stop_token const stoken) { run(stoken); })
+    {
+    }
+
+    ~kernel_loader()
+    {
+        m_thread.request_stop();
+        m_wake.release();
+    }
+
+    //! Shared by all processors, alive as long as one of them is.
+    [[nodiscard]]
+    static auto get() -> std::shared_ptr<kernel_loader>
+    {
+        static std::mutex s_mutex;
+        static std::weak_ptr<kernel_loader> s_loader;
+
+        std::lock_guard const lock(s_mutex);
+
+        auto loader = s_loader.lock();
+        if (!loader)
+        {
+            loader = std::make_shared<kernel_loader>();
+            s_loader = loader;
+        }
+
+        return loader;
+    }
+
+    void add(kernel_slot& slot)
+    {
+        std::lock_guard const lock(m_mutex);
+        m_slots.push_back(&slot);
+    }
+
+    //! Waits for the slot to be loaded, if it is being loaded right now.
+    void remove(kernel_slot& slot)
+    {
+        std::lock_guard const lock(m_mutex);
+        std::erase(m_slots, &slot);
+    }
+
+    //! Audio thread.
+    void wake() noexcept
+    {
+        if (!m_pending.exchange(true, std::memory_order_acq_rel))
+        {
+            m_wake.release();
+        }
+    }
+
+private:
+    void run(std::stop_token const& stoken);
+
+    // created here, the transform is planned on the constructing thread
+    numeric::dft m_dft;
+
+    std::mutex m_mutex;
+    std::vector<kernel_slot*> m_slots;
+
+    // counting, the destructor wakes the thread up regardless of m_pending
+    std::atomic_bool m_pending{};
+    std::counting_semaphore<> m_wake{0};
+
+    std::jthread m_thread;
+};
+
+// The kernels of one processor. Same as with the executors of
+// audio::engine::process, kernels are kept in the order they were loaded,
+// and the ones before the active kernels are reclaimed. This happens on
+// the next request, so a processor holds on to a few kernels at most.
+class kernel_slot
+{
+public:
+    kernel_slot(
+            std::size_t const num_channels,
+            audio::sample_rate const sample_rate)
+        : m_num_channels(num_channels)
+        , m_sample_rate(sample_rate)
+        , m_loader(kernel_loader::get())
+    {
+        m_loader->add(*this);
+    }
+
+    kernel_slot(kernel_slot const&) = delete;
+    auto operator=(kernel_slot const&) -> kernel_slot& = delete;
+
+    ~kernel_slot()
+    {
+        m_loader->remove(*this);
+    }
+
+    //! Audio thread, wakes up the loader if the request changed.
+    void request(kernel_request const& req) noexcept
+    {
+        if (m_requested.exchange(req, std::memory_order_acq_rel) != req)
+        {
+            m_loader->wake();
+        }
+    }
+
+    //! Audio thread, the latest loaded kernels, if there are new ones.
+    [[nodiscard]]
+    auto acquire() noexcept -> kernels_t const*
+    {
+        return m_next.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    //! Audio thread, after processing with the kernels.
+    void mark_active(kernels_t const* const kernels) noexcept
+    {
+        m_active.store(kernels, std::memory_order_release);
+    }
+
+    //! Loader thread.
+    void update(numeric::dft& dft)
+    {
+        reclaim();
+
+        kernel_request const req =
+                m_requested.load(std::memory_order_acquire);
+        if (req.decay <= 0.f || req == m_loaded)
+        {
+            return;
+        }
+
+        // not retried until the request changes
+        m_loaded = req;
+
+        try
+        {
+            publish(load(req, dft));
+        }
+        catch (std::exception const& err)
+        {
+            spdlog::error("convolution: {}", err.what());
+        }
+    }
+
+private:
+    auto load(kernel_request const& req, numeric::dft& dft)
+            -> std::unique_ptr<kernels_t>
+    {
+        auto const irs =
+                make_impulse_responses(req, m_num_channels, m_sample_rate);
+
+        auto kernels = std::make_unique<kernels_t>();
+        kernels->reserve(m_num_channels);
+        for (auto const& ir : irs)
+        {
+            kernels->emplace_back(ir, dft);
+        }
+
+        return kernels;
+    }
+
+    void publish(std::unique_ptr<kernels_t> kernels)
+    {
+        kernels_t const* const next = kernels.get();
+        m_generations.push_back(std::move(kernels));
+
+        // not picked up by the audio thread, it never will be
+        if (kernels_t const* const superseded =
+                    m_next.exchange(next, std::memory_order_acq_rel))
+        {
+            std::erase_if(m_generations, [superseded](auto const& k) {
+                return k.get() == superseded;
+            });
+        }
+    }
+
+    void reclaim()
+    {
+        kernels_t const* const active =
+                m_active.load(std::memory_order_acquire);
+        if (!active)
+        {
+            return;
+        }
+
+        auto const it = std::ranges::find_if(
+                m_generations,
+                [active](auto const& k) { return k.get() == active; });
+        BOOST_ASSERT(it != m_generations.end());
+
+        m_generations.erase(m_generations.begin(), it);
+    }
+
+    std::size_t m_num_channels;
+    audio::sample_rate m_sample_rate;
+
+    std::atomic<kernel_request> m_requested{};
+    std::atomic<kernels_t const*> m_next{};
+    std::atomic<kernels_t const*> m_active{};
+
+    // accessed from the loader thread only
+    kernel_request m_loaded{};
+    std::deque<std::unique_ptr<kernels_t>> m_generations;
+
+    std::shared_ptr<kernel_loader> m_loader;
+};
+
+static_assert(std::atomic<kernel_request>::is_always_lock_free);
+
+void
+kernel_loader::run(std::stop_token const& stoken)
+{
+    for (;;)
+    {
+        m_wake.acquire();
+
+        if (stoken.stop_requested())
+        {
+            break;
+        }
+
+        // requests from now on wake the loader again
+        m_pending.store(false, std::memory_order_release);
+
+        std::lock_guard const lock(m_mutex);
+        for (kernel_slot* const slot : m_slots)
+        {
+            slot->update(m_dft);
+        }
+    }
+}
+
+class processor final
+    : public audio::engine::named_processor
+    , public audio::engine::single_event_input_processor<processor, event_value>
+{
+public:
+    processor(
+            std::size_t const num_channels,
+            audio::sample_rate const sample_rate,
+            std::string_view const name)
+        : named_processor(name)
+        , m_max_ir_size(sample_rate.to_samples(max_decay))
+        , m_kernel_slot(num_channels, sample_rate)
+    {
+        std::size_t const max_partitions =
+                (m_max_ir_size + block_size - 1) / block_size;
+
+        m_convolvers.reserve(num_channels);
+        for (std::size_t ch = 0; ch < num_channels; ++ch)
+        {
+            m_convolvers.emplace_back(block_size, max_partitions);
+        }
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "convolution";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_convolvers.size();
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_convolvers.size();
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{audio::engine::event_port{
+                std::in_place_type<event_value>,
+                "params"}};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return m_max_ir_size + block_size;
+    }
+
+    void process(audio::engine::process_context const& ctx) override
+    {
+        verify_process_context(*this, ctx);
+
+        if (kernels_t const* const kernels = m_kernel_slot.acquire())
+        {
+            for (std::size_t ch = 0; ch < m_convolvers.size(); ++ch)
+            {
+                m_convolvers[ch].set_kernel(&(*kernels)[ch]);
+            }
+
+            m_kernels = kernels;
+        }
+
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
+
+        process_sliced(ctx);
+
+        m_kernel_slot.mark_active(m_kernels);
+    }
+
+    void process_buffer(audio::engine::process_context const& ctx)
+    {
+        process_slice(ctx, 0, ctx.buffer_size);
+    }
+
+    void process_slice(
+            audio::engine::process_context const& ctx,
+            std::size_t const offset,
+            std::size_t const count)
+    {
+        float const dry = 1.f - m_mix;
+        float const wet = m_mix;
+
+        for (std::size_t ch = 0; ch < m_convolvers.size(); ++ch)
+        {
+            auto& conv = m_convolvers[ch];
+            auto const out = ctx.outputs[ch].subspan(offset, count);
+
+            visit(boost::hof::match(
+                          [&](float const c) {
+                              std::array<float, 64> in;
+                              in.fill(c);
+                              for (std::size_t pos = 0; pos < count;
+                                   pos += in.size())
+                              {
+                                  std::size_t const n =
+                                          std::min(in.size(), count - pos);
+                                  conv.process(
+                                          std::span{in}.first(n),
+                                          out.subspan(pos, n));
+                              }
+
+                              std::ranges::transform(
+                                      out,
+                                      out.begin(),
+                                      [=](float const y) {
+                                          return dry * c + wet * y;
+                                      });
+                          },
+                          [&](audio::slice<float>::span_t const& in) {
+                              conv.process(in, out);
+
+                              std::ranges::transform(
+                                      in,
+                                      out,
+                                      out.begin(),
+                                      [=](float const x, float const y) {
+                                          return dry * x + wet * y;
+                                      });
+                          }),
+                  subslice(ctx.inputs[ch].get(), offset, count));
+        }
+    }
+
+    void process_event(
+            audio::engine::process_context const& /*ctx*/,
+            audio::engine::event<event_value> const& ev)
+    {
+        m_kernel_slot.request(
+                {.decay = ev.value().decay,
+                 .impulse_response = ev.value().impulse_response});
+        m_mix = ev.value().mix;
+    }
+
+private:
+    std::size_t m_max_ir_size;
+    std::vector<audio::dsp::partitioned_convolver> m_convolvers;
+    float m_mix{};
+
+    kernels_t const* m_kernels{};
+    kernel_slot m_kernel_slot;
+};
+
+template <std::size_t... Channel>
+class component final : public audio::engine::component
+{
+    static constexpr std::size_t num_channels = sizeof...(Channel);
+
+public:
+    component(runtime::internal_fx_component_factory_args const& args)
+        : m_decay_input_proc(
+                  runtime::processors::find_or_make_parameter_processor(
+                          args.param_procs,
+                          args.fx_mod.parameters->at(
+                                  to_underlying(parameter_key::decay)),
+                          "decay"))
+        , m_mix_input_proc(
+                  runtime::processors::find_or_make_parameter_processor(
+                          args.param_procs,
+                          args.fx_mod.parameters->at(
+                                  to_underlying(parameter_key::mix)),
+                          "mix"))
+        , m_impulse_response_input_proc(
+                  runtime::processors::find_or_make_parameter_processor(
+                          args.param_procs,
+                          args.fx_mod.parameters->at(to_underlying(
+                                  parameter_key::impulse_response)),
+                          "impulse_response"))
+        , m_params_proc(make_params_converter_processor())
+        , m_convolution_proc(std::make_unique<processor>(
+                  num_channels,
+                  args.sample_rate,
+                  "convolution"))
+    {
+    }
+
+    auto inputs() const -> endpoints override
+    {
+        return m_inputs;
+    }
+
+    auto outputs() const -> endpoints override
+    {
+        return m_outputs;
+    }
+
+    auto event_inputs() const -> endpoints override
+    {
+        return m_event_inputs;
+    }
+
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    void connect(audio::engine::graph& g) const override
+    {
+        using namespace audio::engine::endpoint_ports;
+
+        audio::engine::connect_event(
+                g,
+                *m_decay_input_proc,
+                from<0>,
+                *m_params_proc,
+                to<0>);
+
+        audio::engine::connect_event(
+                g,
+                *m_mix_input_proc,
+                from<0>,
+                *m_params_proc,
+                to<1>);
+
+        audio::engine::connect_event(
+                g,
+                *m_impulse_response_input_proc,
+                from<0>,
+                *m_params_proc,
+                to<2>);
+
+        audio::engine::connect_event(
+                g,
+                *m_params_proc,
+                from<0>,
+                *m_convolution_proc,
+                to<0>);
+    }
+
+private:
+    std::shared_ptr<audio::engine::processor> m_decay_input_proc;
+    std::shared_ptr<audio::engine::processor> m_mix_input_proc;
+    std::shared_ptr<audio::engine::processor> m_impulse_response_input_proc;
+    std::unique_ptr<audio::engine::processor> m_params_proc;
+    std::unique_ptr<audio::engine::processor> m_convolution_proc;
+    std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_convolution_proc,
+                    .port = Channel}...};
+    std::array<audio::engine::graph_endpoint, num_channels> m_outputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_convolution_proc,
+                    .port = Channel}...};
+    std::array<audio::engine::graph_endpoint, 3> m_event_inputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_decay_input_proc,
+                    .port = 0},
+            audio::engine::graph_endpoint{
+                    .proc = *m_mix_input_proc,
+                    .port = 0},
+            audio::engine::graph_endpoint{
+                    .proc = *m_impulse_response_input_proc,
+                    .port = 0}};
+};
+
+template <std::size_t... Channel>
+auto
+make_component(
+        runtime::internal_fx_component_factory_args const& args,
+        std::index_sequence<Channel...>)
+        -> std::unique_ptr<audio::engine::component>
+{
+    return std::make_unique<component<Channel...>>(args);
+}
+
+} // namespace
+
+auto
+make_component(runtime::internal_fx_component_factory_args const& args)
+        -> std::unique_ptr<audio::engine::component>
+{
+    switch (args.fx_mod.bus_type)
+    {
+        case audio::bus_type::mono:
+            return make_component(args, std::make_index_sequence<1>{});
+
+        case audio::bus_type::stereo:
+            return make_component(args, std::make_index_sequence<2>{});
+    }
+}
+
+} // namespace piejam::fx_modules::convolution
@@ -0,0 +1,35 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/convolution/convolution_internal_id.h>
+
+#include <piejam/fx_modules/convolution/convolution_component.h>
+#include <piejam/fx_modules/convolution/convolution_module.h>
+#include <piejam/fx_modules/convolution/gui/FxConvolution.h>
+#include <piejam/fx_modules/module_registration.h>
+
+namespace piejam::fx_modules::convolution
+{
+
+auto
+internal_id() -> runtime::fx::internal_id
+{
+    using namespace std::string_literals;
+
+    static auto const id = register_module(module_registration{
+            .available_for_mono = true,
+            .persistence_name = "convolution"s,
+            .fx_module_factory = &make_module,
+            .fx_component_factory = &make_component,
+            .fx_browser_entry_name = "Convolution Reverb",
+            .fx_browser_entry_description =
+                    "Reverberate an audio signal by convolving it with an "
+                    "impulse response.",
+            .fx_module_content_factory =
+                    &piejam::gui::model::makeFxModule<gui::FxConvolution>,
+            .viewSource = "/PieJam/FxChainControls/ParametersListView.qml"});
+    return id;
+}
+
+} // namespace piejam::fx_modules::convolution
@@ -0,0 +1,98 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/convolution/convolution_module.h>
+
+#include <piejam/fx_modules/convolution/convolution_internal_id.h>
+#include <piejam/fx_modules/convolution/impulse_responses.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/parameter/float_descriptor.h>
+#include <piejam/runtime/parameter/float_normalize.h>
+#include <piejam/runtime/parameter/int_descriptor.h>
+#include <piejam/runtime/parameter_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <fmt/format.h>
+
+#include <boost/container/flat_map.hpp>
+
+namespace piejam::fx_modules::convolution
+{
+
+namespace
+{
+
+auto
+to_decay_string(float const d) -> std::string
+{
+    return d < 1.f ? fmt::format("{:.0f} ms", d * 1000.f)
+                   : fmt::format("{:.2f} s", d);
+}
+
+auto
+to_mix_string(float const m) -> std::string
+{
+    return fmt::format("{:.0f}%", m * 100.f);
+}
+
+auto
+to_impulse_response_string(int const n) -> std::string
+{
+    auto const files = impulse_responses();
+    return n > 0 && static_cast<std::size_t>(n) <= files.size()
+                   ? files[static_cast<std::size_t>(n - 1)].stem().string()
+                   : std::string("Synthetic");
+}
+
+} // namespace
+
+auto
+make_module(runtime::internal_fx_module_factory_args const& args)
+        -> runtime::fx::module
+{
+    using namespace std::string_literals;
+
+    runtime::parameter_factory params_factory{args.params};
+
+    return runtime::fx::module{
+            .fx_instance_id = internal_id(),
+            .name = box("Convolution"s),
+            .bus_type = args.bus_type,
+            .parameters = box(runtime::fx::module_parameters{
+                    {to_underlying(parameter_key::decay),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Decay"s),
+                             .default_value = 1.5f,
+                             .min = 0.1f,
+                             .max = static_cast<float>(max_decay.count()),
+                             .value_to_string = &to_decay_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_log,
+                             .from_normalized = &runtime::parameter::
+                                                        from_normalized_log})},
+                    {to_underlying(parameter_key::mix),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Mix"s),
+                             .default_value = 0.3f,
+                             .min = 0.f,
+                             .max = 1.f,
+                             .value_to_string = &to_mix_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})},
+                    {to_underlying(parameter_key::impulse_response),
+                     params_factory.make_parameter(runtime::int_parameter{
+                             .name = box("Impulse Response"s),
+                             .default_value = 0,
+                             .min = 0,
+                             .max = static_cast<int>(
+                                     impulse_responses().size()),
+                             .value_to_string =
+                                     &to_impulse_response_string})}}),
+            .streams = {}};
+}
+
+} // namespace piejam::fx_modules::convolution
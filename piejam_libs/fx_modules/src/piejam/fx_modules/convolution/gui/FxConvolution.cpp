@@ -0,0 +1,20 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/convolution/gui/FxConvolution.h>
+
+#include <piejam/fx_modules/convolution/convolution_internal_id.h>
+
+namespace piejam::fx_modules::convolution::gui
+{
+
+using namespace piejam::gui::model;
+
+auto
+FxConvolution::type() const noexcept -> FxModuleType
+{
+    return {.id = internal_id()};
+}
+
+} // namespace piejam::fx_modules::convolution::gui
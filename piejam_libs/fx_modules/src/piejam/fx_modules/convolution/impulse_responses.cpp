@@ -0,0 +1,164 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/convolution/impulse_responses.h>
+
+#include <piejam/audio/dsp/resampler.h>
+
+#include <fmt/format.h>
+
+#include <spdlog/spdlog.h>
+
+#include <sndfile.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string_view>
+
+namespace piejam::fx_modules::convolution
+{
+
+namespace
+{
+
+// written once by scan_impulse_responses, on init
+std::vector<std::filesystem::path> s_impulse_responses;
+
+auto
+is_impulse_response_file(std::filesystem::directory_entry const& entry)
+        -> bool
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_extensions{
+            ".wav"sv,
+            ".flac"sv,
+            ".aif"sv,
+            ".aiff"sv};
+
+    std::error_code ec;
+    return entry.is_regular_file(ec) &&
+           std::ranges::find(
+                   s_extensions,
+                   entry.path().extension().string()) != s_extensions.end();
+}
+
+auto
+resample(
+        std::vector<float> const& in,
+        double const ratio,
+        std::size_t const max_size) -> std::vector<float>
+{
+    audio::dsp::resampler rs(ratio);
+
+    // flush the filter, so the end of the response isn't cut off
+    std::vector<float> padded(in);
+    padded.resize(in.size() + rs.latency());
+
+    std::vector<float> out(rs.max_output_size(padded.size()));
+    out.resize(rs.process(padded, out));
+    out.resize(std::min(
+            {out.size(),
+             static_cast<std::size_t>(
+                     std::lround(static_cast<double>(in.size()) * ratio)),
+             max_size}));
+
+    return out;
+}
+
+} // namespace
+
+void
+scan_impulse_responses(std::filesystem::path const& dir)
+{
+    s_impulse_responses.clear();
+
+    std::error_code ec;
+    for (auto const& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        if (is_impulse_response_file(entry))
+        {
+            s_impulse_responses.push_back(entry.path());
+        }
+    }
+
+    std::ranges::sort(s_impulse_responses);
+
+    spdlog::info(
+            "found {} impulse responses in {}",
+            s_impulse_responses.size(),
+            dir.string());
+}
+
+auto
+impulse_responses() noexcept -> std::span<std::filesystem::path const>
+{
+    return s_impulse_responses;
+}
+
+auto
+read_impulse_response(
+        std::filesystem::path const& file,
+        std::size_t const num_channels,
+        audio::sample_rate const sample_rate,
+        std::size_t const max_size) -> std::vector<std::vector<float>>
+{
+    SndfileHandle sndfile(file.string());
+    if (!sndfile || sndfile.channels() <= 0 || sndfile.samplerate() <= 0)
+    {
+        throw std::runtime_error(fmt::format(
+                "could not read impulse response {}",
+                file.string()));
+    }
+
+    auto const file_channels = static_cast<std::size_t>(sndfile.channels());
+    double const ratio =
+            static_cast<double>(sample_rate.value()) /
+            static_cast<double>(sndfile.samplerate());
+
+    // no need to read what is cut off after resampling anyway
+    auto const num_frames = std::min(
+            static_cast<std::size_t>(std::max(sndfile.frames(), sf_count_t{})),
+            static_cast<std::size_t>(
+                    std::ceil(static_cast<double>(max_size) / ratio)) +
+                    1);
+
+    std::vector<float> interleaved(num_frames * file_channels);
+    auto const read = static_cast<std::size_t>(sndfile.readf(
+            interleaved.data(),
+            static_cast<sf_count_t>(num_frames)));
+    if (read == 0)
+    {
+        throw std::runtime_error(fmt::format(
+                "impulse response {} is empty",
+                file.string()));
+    }
+
+    std::vector<std::vector<float>> result(num_channels);
+    for (std::size_t ch = 0; ch < num_channels; ++ch)
+    {
+        std::size_t const file_ch = std::min(ch, file_channels - 1);
+
+        std::vector<float> ir(read);
+        for (std::size_t i = 0; i < read; ++i)
+        {
+            ir[i] = interleaved[i * file_channels + file_ch];
+        }
+
+        if (static_cast<unsigned>(sndfile.samplerate()) != sample_rate.value())
+        {
+            result[ch] = resample(ir, ratio, max_size);
+        }
+        else
+        {
+            ir.resize(std::min(ir.size(), max_size));
+            result[ch] = std::move(ir);
+        }
+    }
+
+    return result;
+}
+
+} // namespace piejam::fx_modules::convolution
@@ -0,0 +1,417 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/delay/delay_component.h>
+
+#include <piejam/audio/dsp/delay_line.h>
+#include <piejam/audio/dsp/smoother.h>
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/delay_line_pool.h>
+#include <piejam/audio/engine/event_converter_processor.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_endpoint.h>
+#include <piejam/audio/engine/graph_generic_algorithms.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/single_event_input_processor.h>
+#include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/sample_rate.h>
+#include <piejam/audio/slice_algorithms.h>
+#include <piejam/fx_modules/delay/delay_module.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_component_factory.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/hof/match.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace piejam::fx_modules::delay
+{
+
+namespace
+{
+
+using audio::dsp::delay_line;
+
+// Changes of the delay time are ramped over this time. The pitch bends
+// while ramping, as with a tape delay, instead of clicking.
+constexpr std::chrono::milliseconds time_smoothing{50};
+
+// The repeats are considered silent below -90 dB.
+constexpr float silence_level = 3.16e-5f;
+
+struct event_value
+{
+    float delay{};
+    float feedback{};
+    float mix{};
+};
+
+auto
+make_params_converter_processor(audio::sample_rate const sample_rate)
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_input_names{
+            "time"sv,
+            "sync"sv,
+            "tempo"sv,
+            "feedback"sv,
+            "mix"sv};
+    static constexpr std::array s_output_names{"params"sv};
+    return audio::engine::make_event_converter_processor(
+            [sample_rate](
+                    float const time,
+                    int const sync_value,
+                    float const tempo,
+                    float const feedback,
+                    float const mix) {
+                float const beats = sync_beats(static_cast<sync>(sync_value));
+                float const seconds =
+                        beats > 0.f ? std::min(
+                                              beats * 60.f / tempo,
+                                              std::chrono::duration<float>(
+                                                      max_time)
+                                                      .count())
+                                    : time / 1000.f;
+                return event_value{
+                        .delay = seconds * sample_rate.as_float(),
+                        .feedback = feedback,
+                        .mix = mix};
+            },
+            s_input_names,
+            s_output_names,
+            "delay_params");
+}
+
+class processor final
+    : public audio::engine::named_processor
+    , public audio::engine::single_event_input_processor<processor, event_value>
+{
+public:
+    processor(
+            std::vector<audio::engine::delay_line_buffer> buffers,
+            audio::sample_rate const sample_rate,
+            std::string_view const name)
+        : named_processor(name)
+        , m_buffers(std::move(buffers))
+        , m_smoothing_steps(sample_rate.to_samples(time_smoothing))
+    {
+        std::ranges::transform(
+                m_buffers,
+                std::back_inserter(m_lines),
+                [](auto const& buffer) { return delay_line{buffer.frames()}; });
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "delay";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_lines.size();
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_lines.size();
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{audio::engine::event_port{
+                std::in_place_type<event_value>,
+                "params"}};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return m_silence_tail;
+    }
+
+    void process(audio::engine::process_context const& ctx) override
+    {
+        verify_process_context(*this, ctx);
+
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
+
+        process_sliced(ctx);
+    }
+
+    void process_buffer(audio::engine::process_context const& ctx)
+    {
+        process_slice(ctx, 0, ctx.buffer_size);
+    }
+
+    void process_slice(
+            audio::engine::process_context const& ctx,
+            std::size_t const offset,
+            std::size_t const count)
+    {
+        for (std::size_t pos = 0; pos < count; pos += delay_line::chunk_size)
+        {
+            process_chunk(
+                    ctx,
+                    offset + pos,
+                    std::min(delay_line::chunk_size, count - pos));
+        }
+    }
+
+    void process_event(
+            audio::engine::process_context const& /*ctx*/,
+            audio::engine::event<event_value> const& ev)
+    {
+        m_feedback = ev.value().feedback;
+        m_mix = ev.value().mix;
+
+        float const delay = std::clamp(
+                ev.value().delay,
+                static_cast<float>(delay_line::chunk_size + 2),
+                m_lines.front().max_delay());
+
+        // start at the first delay, instead of ramping up from zero
+        if (m_delay.current() == 0.f)
+        {
+            m_delay = audio::dsp::smoother<float>{delay};
+        }
+        else
+        {
+            m_delay.set(delay, m_smoothing_steps);
+        }
+
+        std::size_t const repeats =
+                m_feedback > 0.f ? static_cast<std::size_t>(std::ceil(
+                                           std::log(silence_level) /
+                                           std::log(m_feedback)))
+                                 : 0;
+        m_silence_tail = static_cast<std::size_t>(delay) * (repeats + 1) +
+                         m_smoothing_steps;
+    }
+
+private:
+    void process_chunk(
+            audio::engine::process_context const& ctx,
+            std::size_t const offset,
+            std::size_t const count)
+    {
+        auto const delays = std::span{m_delays}.first(count);
+        std::ranges::generate(delays, [gen = m_delay.generator()]() mutable {
+            return *gen++;
+        });
+
+        auto const wet = std::span{m_wet}.first(count);
+
+        float const dry_gain = 1.f - m_mix;
+        float const wet_gain = m_mix;
+
+        for (std::size_t ch = 0; ch < m_lines.size(); ++ch)
+        {
+            auto& line = m_lines[ch];
+            line.read(delays, wet);
+
+            auto const out = ctx.outputs[ch].subspan(offset, count);
+
+            auto const process_sample = [&](std::size_t const i,
+                                             float const x) {
+                line.push(x + m_feedback * wet[i]);
+                out[i] = dry_gain * x + wet_gain * wet[i];
+            };
+
+            visit(boost::hof::match(
+                          [&](float const c) {
+                              for (std::size_t i = 0; i < count; ++i)
+                              {
+                                  process_sample(i, c);
+                              }
+                          },
+                          [&](audio::slice<float>::span_t const& in) {
+                              for (std::size_t i = 0; i < count; ++i)
+                              {
+                                  process_sample(i, in[i]);
+                              }
+                          }),
+                  subslice(ctx.inputs[ch].get(), offset, count));
+        }
+    }
+
+    std::vector<audio::engine::delay_line_buffer> m_buffers;
+    std::vector<delay_line> m_lines;
+
+    std::size_t m_smoothing_steps;
+    audio::dsp::smoother<float> m_delay;
+    float m_feedback{};
+    float m_mix{};
+    std::size_t m_silence_tail{};
+
+    std::array<float, delay_line::chunk_size> m_delays{};
+    std::array<float, delay_line::chunk_size> m_wet{};
+};
+
+template <std::size_t... Channel>
+class component final : public audio::engine::component
+{
+    static constexpr std::size_t num_channels = sizeof...(Channel);
+
+public:
+    component(
+            runtime::internal_fx_component_factory_args const& args,
+            std::vector<std::shared_ptr<audio::engine::processor>>
+                    param_input_procs,
+            std::vector<audio::engine::delay_line_buffer> buffers)
+        : m_param_input_procs(std::move(param_input_procs))
+        , m_params_proc(make_params_converter_processor(args.sample_rate))
+        , m_delay_proc(std::make_unique<processor>(
+                  std::move(buffers),
+                  args.sample_rate,
+                  args.name))
+    {
+        std::ranges::transform(
+                m_param_input_procs,
+                std::back_inserter(m_event_inputs),
+                [](auto const& proc) {
+                    return audio::engine::graph_endpoint{
+                            .proc = *proc,
+                            .port = 0};
+                });
+    }
+
+    auto inputs() const -> endpoints override
+    {
+        return m_inputs;
+    }
+
+    auto outputs() const -> endpoints override
+    {
+        return m_outputs;
+    }
+
+    auto event_inputs() const -> endpoints override
+    {
+        return m_event_inputs;
+    }
+
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    void connect(audio::engine::graph& g) const override
+    {
+        using namespace audio::engine::endpoint_ports;
+
+        for (std::size_t port = 0; port < m_param_input_procs.size(); ++port)
+        {
+            g.event.insert(
+                    audio::engine::src_event_endpoint(
+                            *m_param_input_procs[port],
+                            0),
+                    audio::engine::dst_event_endpoint(*m_params_proc, port));
+        }
+
+        audio::engine::connect_event(
+                g,
+                *m_params_proc,
+                from<0>,
+                *m_delay_proc,
+                to<0>);
+    }
+
+private:
+    std::vector<std::shared_ptr<audio::engine::processor>> m_param_input_procs;
+    std::unique_ptr<audio::engine::processor> m_params_proc;
+    std::unique_ptr<audio::engine::processor> m_delay_proc;
+    std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_delay_proc,
+                    .port = Channel}...};
+    std::array<audio::engine::graph_endpoint, num_channels> m_outputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_delay_proc,
+                    .port = Channel}...};
+    std::vector<audio::engine::graph_endpoint> m_event_inputs;
+};
+
+auto
+make_param_input_proc(
+        runtime::internal_fx_component_factory_args const& args,
+        parameter_key const key,
+        std::string_view const name)
+{
+    return runtime::processors::find_or_make_parameter_processor(
+            args.param_procs,
+            args.fx_mod.parameters->at(to_underlying(key)),
+            name);
+}
+
+template <std::size_t... Channel>
+auto
+make_component(
+        runtime::internal_fx_component_factory_args const& args,
+        std::index_sequence<Channel...>)
+        -> std::unique_ptr<audio::engine::component>
+{
+    // room for the longest delay and the interpolation taps
+    std::size_t const frames = args.sample_rate.to_samples(max_time) +
+                               delay_line::chunk_size + 4;
+
+    std::vector<audio::engine::delay_line_buffer> buffers;
+    for (std::size_t ch = 0; ch < sizeof...(Channel); ++ch)
+    {
+        auto buffer = args.delay_lines.allocate(frames);
+        if (!buffer)
+        {
+            spdlog::error(
+                    "delay: out of delay line memory, {} frames requested",
+                    frames);
+            return nullptr;
+        }
+
+        buffers.push_back(std::move(buffer));
+    }
+
+    return std::make_unique<component<Channel...>>(
+            args,
+            std::vector{
+                    make_param_input_proc(args, parameter_key::time, "time"),
+                    make_param_input_proc(args, parameter_key::sync, "sync"),
+                    make_param_input_proc(args, parameter_key::tempo, "tempo"),
+                    make_param_input_proc(
+                            args,
+                            parameter_key::feedback,
+                            "feedback"),
+                    make_param_input_proc(args, parameter_key::mix, "mix")},
+            std::move(buffers));
+}
+
+} // namespace
+
+auto
+make_component(runtime::internal_fx_component_factory_args const& args)
+        -> std::unique_ptr<audio::engine::component>
+{
+    switch (args.fx_mod.bus_type)
+    {
+        case audio::bus_type::mono:
+            return make_component(args, std::make_index_sequence<1>{});
+
+        case audio::bus_type::stereo:
+            return make_component(args, std::make_index_sequence<2>{});
+    }
+}
+
+} // namespace piejam::fx_modules::delay
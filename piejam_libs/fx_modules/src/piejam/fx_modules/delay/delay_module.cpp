@@ -0,0 +1,145 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/delay/delay_module.h>
+
+#include <piejam/fx_modules/delay/delay_internal_id.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/parameter/float_descriptor.h>
+#include <piejam/runtime/parameter/float_normalize.h>
+#include <piejam/runtime/parameter/int_descriptor.h>
+#include <piejam/runtime/parameter_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <fmt/format.h>
+
+#include <boost/container/flat_map.hpp>
+
+namespace piejam::fx_modules::delay
+{
+
+namespace
+{
+
+auto
+to_time_string(float const ms) -> std::string
+{
+    return ms < 1000.f ? fmt::format("{:.0f} ms", ms)
+                       : fmt::format("{:.2f} s", ms / 1000.f);
+}
+
+auto
+to_sync_string(int const n) -> std::string
+{
+    switch (n)
+    {
+        case to_underlying(sync::whole):
+            return "1/1";
+        case to_underlying(sync::half):
+            return "1/2";
+        case to_underlying(sync::quarter):
+            return "1/4";
+        case to_underlying(sync::quarter_dotted):
+            return "1/4.";
+        case to_underlying(sync::quarter_triplet):
+            return "1/4T";
+        case to_underlying(sync::eighth):
+            return "1/8";
+        case to_underlying(sync::eighth_dotted):
+            return "1/8.";
+        case to_underlying(sync::eighth_triplet):
+            return "1/8T";
+        case to_underlying(sync::sixteenth):
+            return "1/16";
+
+        default:
+            return "Off";
+    }
+}
+
+auto
+to_tempo_string(float const bpm) -> std::string
+{
+    return fmt::format("{:.1f} BPM", bpm);
+}
+
+auto
+to_percent_string(float const x) -> std::string
+{
+    return fmt::format("{:.0f}%", x * 100.f);
+}
+
+} // namespace
+
+auto
+make_module(runtime::internal_fx_module_factory_args const& args)
+        -> runtime::fx::module
+{
+    using namespace std::string_literals;
+
+    runtime::parameter_factory params_factory{args.params};
+
+    return runtime::fx::module{
+            .fx_instance_id = internal_id(),
+            .name = box("Delay"s),
+            .bus_type = args.bus_type,
+            .parameters = box(runtime::fx::module_parameters{
+                    {to_underlying(parameter_key::time),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Time"s),
+                             .default_value = 375.f,
+                             .min = static_cast<float>(min_time.count()),
+                             .max = static_cast<float>(max_time.count()),
+                             .value_to_string = &to_time_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_log,
+                             .from_normalized = &runtime::parameter::
+                                                        from_normalized_log})},
+                    {to_underlying(parameter_key::sync),
+                     params_factory.make_parameter(runtime::int_parameter{
+                             .name = box("Sync"s),
+                             .default_value = to_underlying(sync::off),
+                             .min = to_underlying(sync::off),
+                             .max = to_underlying(sync::sixteenth),
+                             .value_to_string = &to_sync_string})},
+                    {to_underlying(parameter_key::tempo),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Tempo"s),
+                             .default_value = 120.f,
+                             .min = 40.f,
+                             .max = 240.f,
+                             .value_to_string = &to_tempo_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})},
+                    {to_underlying(parameter_key::feedback),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Feedback"s),
+                             .default_value = 0.4f,
+                             .min = 0.f,
+                             .max = 0.95f,
+                             .value_to_string = &to_percent_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})},
+                    {to_underlying(parameter_key::mix),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Mix"s),
+                             .default_value = 0.3f,
+                             .min = 0.f,
+                             .max = 1.f,
+                             .value_to_string = &to_percent_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})}}),
+            .streams = {}};
+}
+
+} // namespace piejam::fx_modules::delay
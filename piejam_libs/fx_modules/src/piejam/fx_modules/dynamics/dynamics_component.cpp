@@ -0,0 +1,495 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/dynamics/dynamics_component.h>
+
+#include <piejam/audio/dsp/dynamics.h>
+#include <piejam/audio/dsp/envelope_follower.h>
+#include <piejam/audio/engine/component.h>
+#include <piejam/audio/engine/event_converter_processor.h>
+#include <piejam/audio/engine/graph.h>
+#include <piejam/audio/engine/graph_endpoint.h>
+#include <piejam/audio/engine/graph_generic_algorithms.h>
+#include <piejam/audio/engine/named_processor.h>
+#include <piejam/audio/engine/single_event_input_processor.h>
+#include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/sample_rate.h>
+#include <piejam/audio/slice_algorithms.h>
+#include <piejam/fx_modules/dynamics/dynamics_module.h>
+#include <piejam/math.h>
+#include <piejam/runtime/components/stream.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/internal_fx_component_factory.h>
+#include <piejam/runtime/parameter_processor_factory.h>
+#include <piejam/runtime/processors/stream_processor_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <boost/assert.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/hof/match.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace piejam::fx_modules::dynamics
+{
+
+namespace
+{
+
+// The gain is computed for chunks of this size, small enough to keep the
+// scratch buffers on the processor, big enough for the simd gain computer.
+constexpr std::size_t chunk_size = 64;
+
+struct event_value
+{
+    float log_threshold{};
+    float slope{};
+    float attack{};
+    float release{};
+    float makeup{1.f};
+};
+
+auto
+log_threshold(float const threshold_dB) -> float
+{
+    return std::log(math::from_dB(threshold_dB));
+}
+
+auto
+time_coefficient(audio::sample_rate const sample_rate, float const ms)
+        -> float
+{
+    return audio::dsp::one_pole_coefficient(
+            sample_rate.as_float() * ms / 1000.f);
+}
+
+auto
+make_compressor_params_converter_processor(audio::sample_rate const sample_rate)
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_input_names{
+            "threshold"sv,
+            "ratio"sv,
+            "attack"sv,
+            "release"sv,
+            "makeup"sv};
+    static constexpr std::array s_output_names{"params"sv};
+    return audio::engine::make_event_converter_processor(
+            [sample_rate](
+                    float const threshold,
+                    float const ratio,
+                    float const attack,
+                    float const release,
+                    float const makeup) {
+                return event_value{
+                        .log_threshold = log_threshold(threshold),
+                        .slope = 1.f - 1.f / ratio,
+                        .attack = time_coefficient(sample_rate, attack),
+                        .release = time_coefficient(sample_rate, release),
+                        .makeup = math::from_dB(makeup)};
+            },
+            s_input_names,
+            s_output_names,
+            "compressor_params");
+}
+
+// Infinite ratio and an immediate attack. Together with the lookahead,
+// the gain is down before a peak arrives, nothing passes the threshold.
+auto
+make_limiter_params_converter_processor(audio::sample_rate const sample_rate)
+{
+    using namespace std::string_view_literals;
+    static constexpr std::array s_input_names{"threshold"sv, "release"sv};
+    static constexpr std::array s_output_names{"params"sv};
+    return audio::engine::make_event_converter_processor(
+            [sample_rate](float const threshold, float const release) {
+                return event_value{
+                        .log_threshold = log_threshold(threshold),
+                        .slope = 1.f,
+                        .attack = 0.f,
+                        .release = time_coefficient(sample_rate, release),
+                        .makeup = 1.f};
+            },
+            s_input_names,
+            s_output_names,
+            "limiter_params");
+}
+
+// Stereo linked, the gain is computed from the loudest channel and applied
+// to all of them. The last output carries the gain reduction (1 - gain),
+// for metering. Silence means no reduction, so it doesn't matter that it
+// goes silent along with the processor.
+class processor final
+    : public audio::engine::named_processor
+    , public audio::engine::single_event_input_processor<processor, event_value>
+{
+public:
+    processor(
+            std::size_t const num_channels,
+            std::size_t const lookahead,
+            std::string_view const name)
+        : named_processor(name)
+        , m_num_channels(num_channels)
+        , m_lookahead(lookahead)
+        , m_detector(lookahead + 1)
+        , m_delay(num_channels * lookahead)
+        , m_input(num_channels * chunk_size)
+    {
+        BOOST_ASSERT(lookahead > 0);
+    }
+
+    auto type_name() const noexcept -> std::string_view override
+    {
+        return "dynamics";
+    }
+
+    auto num_inputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels;
+    }
+
+    auto num_outputs() const noexcept -> std::size_t override
+    {
+        return m_num_channels + 1;
+    }
+
+    auto event_inputs() const noexcept -> event_ports override
+    {
+        static std::array s_ports{audio::engine::event_port{
+                std::in_place_type<event_value>,
+                "params"}};
+        return s_ports;
+    }
+
+    auto event_outputs() const noexcept -> event_ports override
+    {
+        return {};
+    }
+
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return m_lookahead;
+    }
+
+    auto latency() const noexcept -> std::size_t override
+    {
+        return m_lookahead;
+    }
+
+    void process(audio::engine::process_context const& ctx) override
+    {
+        verify_process_context(*this, ctx);
+
+        std::ranges::copy(ctx.outputs, ctx.results.begin());
+
+        process_sliced(ctx);
+    }
+
+    void process_buffer(audio::engine::process_context const& ctx)
+    {
+        process_slice(ctx, 0, ctx.buffer_size);
+    }
+
+    void process_slice(
+            audio::engine::process_context const& ctx,
+            std::size_t const offset,
+            std::size_t const count)
+    {
+        for (std::size_t pos = 0; pos < count; pos += chunk_size)
+        {
+            process_chunk(
+                    ctx,
+                    offset + pos,
+                    std::min(chunk_size, count - pos));
+        }
+    }
+
+    void process_event(
+            audio::engine::process_context const& /*ctx*/,
+            audio::engine::event<event_value> const& ev)
+    {
+        m_params = ev.value();
+        m_ballistics.set_coefficients(m_params.attack, m_params.release);
+    }
+
+private:
+    void process_chunk(
+            audio::engine::process_context const& ctx,
+            std::size_t const offset,
+            std::size_t const count)
+    {
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            visit(boost::hof::match(
+                          [this, ch, count](float const c) {
+                              std::fill_n(input(ch).begin(), count, c);
+                          },
+                          [this, ch](audio::slice<float>::span_t const& in) {
+                              std::ranges::copy(in, input(ch).begin());
+                          }),
+                  subslice(ctx.inputs[ch].get(), offset, count));
+        }
+
+        auto const level = std::span{m_level}.first(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float peak{};
+            for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+            {
+                peak = std::max(peak, std::abs(input(ch)[i]));
+            }
+
+            level[i] = m_detector(peak);
+        }
+
+        auto const gain = std::span{m_gain}.first(count);
+        audio::dsp::simd::compute_gain<float>(
+                level,
+                m_params.log_threshold,
+                m_params.slope,
+                gain);
+        m_ballistics.process(gain);
+
+        std::ranges::transform(
+                gain,
+                ctx.outputs[m_num_channels].subspan(offset, count).begin(),
+                [](float const g) { return 1.f - g; });
+
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            auto const delay = std::span{m_delay}.subspan(
+                    ch * m_lookahead,
+                    m_lookahead);
+            auto const out = ctx.outputs[ch].subspan(offset, count);
+
+            std::size_t delay_pos = m_delay_pos;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = delay[delay_pos] * gain[i] * m_params.makeup;
+                delay[delay_pos] = input(ch)[i];
+
+                if (++delay_pos == m_lookahead)
+                {
+                    delay_pos = 0;
+                }
+            }
+        }
+
+        m_delay_pos = (m_delay_pos + count) % m_lookahead;
+    }
+
+    auto input(std::size_t const ch) noexcept -> std::span<float>
+    {
+        return std::span{m_input}.subspan(ch * chunk_size, chunk_size);
+    }
+
+    std::size_t m_num_channels;
+    std::size_t m_lookahead;
+
+    event_value m_params;
+    audio::dsp::peak_envelope_follower<float> m_detector;
+    audio::dsp::gain_ballistics<float> m_ballistics;
+
+    // one ring per channel, sharing the position
+    std::vector<float> m_delay;
+    std::size_t m_delay_pos{};
+
+    std::vector<float> m_input;
+    std::array<float, chunk_size> m_level{};
+    std::array<float, chunk_size> m_gain{};
+};
+
+template <std::size_t... Channel>
+class component final : public audio::engine::component
+{
+    static constexpr std::size_t num_channels = sizeof...(Channel);
+
+public:
+    component(
+            runtime::internal_fx_component_factory_args const& args,
+            std::vector<std::shared_ptr<audio::engine::processor>>
+                    param_input_procs,
+            std::unique_ptr<audio::engine::processor> params_proc)
+        : m_param_input_procs(std::move(param_input_procs))
+        , m_params_proc(std::move(params_proc))
+        , m_dynamics_proc(std::make_unique<processor>(
+                  num_channels,
+                  args.sample_rate.to_samples(lookahead),
+                  args.name))
+        , m_gain_reduction_stream(runtime::components::make_stream(
+                  args.fx_mod.streams->at(
+                          to_underlying(stream_key::gain_reduction)),
+                  args.stream_procs,
+                  1,
+                  args.sample_rate.to_samples(std::chrono::milliseconds(120)),
+                  "gain_reduction"))
+    {
+        std::ranges::transform(
+                m_param_input_procs,
+                std::back_inserter(m_event_inputs),
+                [](auto const& proc) {
+                    return audio::engine::graph_endpoint{
+                            .proc = *proc,
+                            .port = 0};
+                });
+    }
+
+    auto inputs() const -> endpoints override
+    {
+        return m_inputs;
+    }
+
+    auto outputs() const -> endpoints override
+    {
+        return m_outputs;
+    }
+
+    auto event_inputs() const -> endpoints override
+    {
+        return m_event_inputs;
+    }
+
+    auto event_outputs() const -> endpoints override
+    {
+        return {};
+    }
+
+    void connect(audio::engine::graph& g) const override
+    {
+        using namespace audio::engine::endpoint_ports;
+
+        m_gain_reduction_stream->connect(g);
+
+        for (std::size_t port = 0; port < m_param_input_procs.size(); ++port)
+        {
+            g.event.insert(
+                    audio::engine::src_event_endpoint(
+                            *m_param_input_procs[port],
+                            0),
+                    audio::engine::dst_event_endpoint(*m_params_proc, port));
+        }
+
+        audio::engine::connect_event(
+                g,
+                *m_params_proc,
+                from<0>,
+                *m_dynamics_proc,
+                to<0>);
+
+        audio::engine::connect(
+                g,
+                *m_dynamics_proc,
+                from<num_channels>,
+                *m_gain_reduction_stream,
+                to<0>);
+    }
+
+private:
+    std::vector<std::shared_ptr<audio::engine::processor>> m_param_input_procs;
+    std::unique_ptr<audio::engine::processor> m_params_proc;
+    std::unique_ptr<audio::engine::processor> m_dynamics_proc;
+    std::unique_ptr<audio::engine::component> m_gain_reduction_stream;
+    std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_dynamics_proc,
+                    .port = Channel}...};
+    std::array<audio::engine::graph_endpoint, num_channels> m_outputs{
+            audio::engine::graph_endpoint{
+                    .proc = *m_dynamics_proc,
+                    .port = Channel}...};
+    std::vector<audio::engine::graph_endpoint> m_event_inputs;
+};
+
+template <std::size_t... Channel>
+auto
+make_component(
+        runtime::internal_fx_component_factory_args const& args,
+        std::vector<std::shared_ptr<audio::engine::processor>>
+                param_input_procs,
+        std::unique_ptr<audio::engine::processor> params_proc,
+        std::index_sequence<Channel...>)
+        -> std::unique_ptr<audio::engine::component>
+{
+    return std::make_unique<component<Channel...>>(
+            args,
+            std::move(param_input_procs),
+            std::move(params_proc));
+}
+
+auto
+make_component(
+        runtime::internal_fx_component_factory_args const& args,
+        std::vector<std::shared_ptr<audio::engine::processor>>
+                param_input_procs,
+        std::unique_ptr<audio::engine::processor> params_proc)
+        -> std::unique_ptr<audio::engine::component>
+{
+    switch (args.fx_mod.bus_type)
+    {
+        case audio::bus_type::mono:
+            return make_component(
+                    args,
+                    std::move(param_input_procs),
+                    std::move(params_proc),
+                    std::make_index_sequence<1>{});
+
+        case audio::bus_type::stereo:
+            return make_component(
+                    args,
+                    std::move(param_input_procs),
+                    std::move(params_proc),
+                    std::make_index_sequence<2>{});
+    }
+}
+
+template <class Key>
+auto
+make_param_input_proc(
+        runtime::internal_fx_component_factory_args const& args,
+        Key const key,
+        std::string_view const name)
+{
+    return runtime::processors::find_or_make_parameter_processor(
+            args.param_procs,
+            args.fx_mod.parameters->at(to_underlying(key)),
+            name);
+}
+
+} // namespace
+
+auto
+make_compressor_component(
+        runtime::internal_fx_component_factory_args const& args)
+        -> std::unique_ptr<audio::engine::component>
+{
+    using key = compressor_parameter_key;
+
+    return make_component(
+            args,
+            {make_param_input_proc(args, key::threshold, "threshold"),
+             make_param_input_proc(args, key::ratio, "ratio"),
+             make_param_input_proc(args, key::attack, "attack"),
+             make_param_input_proc(args, key::release, "release"),
+             make_param_input_proc(args, key::makeup, "makeup")},
+            make_compressor_params_converter_processor(args.sample_rate));
+}
+
+auto
+make_limiter_component(runtime::internal_fx_component_factory_args const& args)
+        -> std::unique_ptr<audio::engine::component>
+{
+    using key = limiter_parameter_key;
+
+    return make_component(
+            args,
+            {make_param_input_proc(args, key::threshold, "threshold"),
+             make_param_input_proc(args, key::release, "release")},
+            make_limiter_params_converter_processor(args.sample_rate));
+}
+
+} // namespace piejam::fx_modules::dynamics
@@ -0,0 +1,53 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/dynamics/dynamics_internal_id.h>
+
+#include <piejam/fx_modules/dynamics/dynamics_component.h>
+#include <piejam/fx_modules/dynamics/dynamics_module.h>
+#include <piejam/fx_modules/dynamics/gui/FxDynamics.h>
+#include <piejam/fx_modules/module_registration.h>
+
+namespace piejam::fx_modules::dynamics
+{
+
+auto
+compressor_internal_id() -> runtime::fx::internal_id
+{
+    using namespace std::string_literals;
+
+    static auto const id = register_module(module_registration{
+            .available_for_mono = true,
+            .persistence_name = "compressor"s,
+            .fx_module_factory = &make_compressor_module,
+            .fx_component_factory = &make_compressor_component,
+            .fx_browser_entry_name = "Compressor",
+            .fx_browser_entry_description =
+                    "Reduce the dynamic range of an audio signal.",
+            .fx_module_content_factory =
+                    &piejam::gui::model::makeFxModule<gui::FxCompressor>,
+            .viewSource = "/PieJam.FxModules/DynamicsView.qml"});
+    return id;
+}
+
+auto
+limiter_internal_id() -> runtime::fx::internal_id
+{
+    using namespace std::string_literals;
+
+    static auto const id = register_module(module_registration{
+            .available_for_mono = true,
+            .persistence_name = "limiter"s,
+            .fx_module_factory = &make_limiter_module,
+            .fx_component_factory = &make_limiter_component,
+            .fx_browser_entry_name = "Limiter",
+            .fx_browser_entry_description =
+                    "Keep the peaks of an audio signal below a threshold.",
+            .fx_module_content_factory =
+                    &piejam::gui::model::makeFxModule<gui::FxLimiter>,
+            .viewSource = "/PieJam.FxModules/DynamicsView.qml"});
+    return id;
+}
+
+} // namespace piejam::fx_modules::dynamics
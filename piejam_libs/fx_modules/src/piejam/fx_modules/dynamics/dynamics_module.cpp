@@ -0,0 +1,173 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/dynamics/dynamics_module.h>
+
+#include <piejam/fx_modules/dynamics/dynamics_internal_id.h>
+
+#include <piejam/entity_map.h>
+#include <piejam/runtime/fx/module.h>
+#include <piejam/runtime/parameter/float_descriptor.h>
+#include <piejam/runtime/parameter/float_normalize.h>
+#include <piejam/runtime/parameter_factory.h>
+#include <piejam/to_underlying.h>
+
+#include <fmt/format.h>
+
+#include <boost/container/flat_map.hpp>
+
+namespace piejam::fx_modules::dynamics
+{
+
+namespace
+{
+
+auto
+to_dB_string(float const dB) -> std::string
+{
+    return fmt::format("{:.1f} dB", dB);
+}
+
+auto
+to_ratio_string(float const r) -> std::string
+{
+    return fmt::format("{:.1f}:1", r);
+}
+
+auto
+to_time_string(float const ms) -> std::string
+{
+    return ms < 10.f ? fmt::format("{:.1f} ms", ms)
+                     : fmt::format("{:.0f} ms", ms);
+}
+
+auto
+make_threshold_parameter(
+        runtime::parameter_factory<> const& params_factory,
+        float const default_value,
+        float const min) -> runtime::float_parameter_id
+{
+    using namespace std::string_literals;
+
+    return params_factory.make_parameter(runtime::float_parameter{
+            .name = box("Threshold"s),
+            .default_value = default_value,
+            .min = min,
+            .max = 0.f,
+            .value_to_string = &to_dB_string,
+            .to_normalized = &runtime::parameter::to_normalized_linear,
+            .from_normalized = &runtime::parameter::from_normalized_linear});
+}
+
+auto
+make_time_parameter(
+        runtime::parameter_factory<> const& params_factory,
+        std::string name,
+        float const default_value,
+        float const min,
+        float const max) -> runtime::float_parameter_id
+{
+    return params_factory.make_parameter(runtime::float_parameter{
+            .name = box(std::move(name)),
+            .default_value = default_value,
+            .min = min,
+            .max = max,
+            .value_to_string = &to_time_string,
+            .to_normalized = &runtime::parameter::to_normalized_log,
+            .from_normalized = &runtime::parameter::from_normalized_log});
+}
+
+auto
+make_gain_reduction_streams(
+        runtime::internal_fx_module_factory_args const& args)
+{
+    return box(runtime::fx::module_streams{
+            {to_underlying(stream_key::gain_reduction),
+             make_stream(args.streams, 1)},
+    });
+}
+
+} // namespace
+
+auto
+make_compressor_module(runtime::internal_fx_module_factory_args const& args)
+        -> runtime::fx::module
+{
+    using namespace std::string_literals;
+
+    runtime::parameter_factory params_factory{args.params};
+
+    return runtime::fx::module{
+            .fx_instance_id = compressor_internal_id(),
+            .name = box("Compressor"s),
+            .bus_type = args.bus_type,
+            .parameters = box(runtime::fx::module_parameters{
+                    {to_underlying(compressor_parameter_key::threshold),
+                     make_threshold_parameter(params_factory, -18.f, -60.f)},
+                    {to_underlying(compressor_parameter_key::ratio),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Ratio"s),
+                             .default_value = 4.f,
+                             .min = 1.f,
+                             .max = 20.f,
+                             .value_to_string = &to_ratio_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_log,
+                             .from_normalized = &runtime::parameter::
+                                                        from_normalized_log})},
+                    {to_underlying(compressor_parameter_key::attack),
+                     make_time_parameter(
+                             params_factory,
+                             "Attack"s,
+                             10.f,
+                             0.1f,
+                             100.f)},
+                    {to_underlying(compressor_parameter_key::release),
+                     make_time_parameter(
+                             params_factory,
+                             "Release"s,
+                             100.f,
+                             10.f,
+                             2000.f)},
+                    {to_underlying(compressor_parameter_key::makeup),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Makeup"s),
+                             .default_value = 0.f,
+                             .min = 0.f,
+                             .max = 24.f,
+                             .value_to_string = &to_dB_string,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})}}),
+            .streams = make_gain_reduction_streams(args)};
+}
+
+auto
+make_limiter_module(runtime::internal_fx_module_factory_args const& args)
+        -> runtime::fx::module
+{
+    using namespace std::string_literals;
+
+    runtime::parameter_factory params_factory{args.params};
+
+    return runtime::fx::module{
+            .fx_instance_id = limiter_internal_id(),
+            .name = box("Limiter"s),
+            .bus_type = args.bus_type,
+            .parameters = box(runtime::fx::module_parameters{
+                    {to_underlying(limiter_parameter_key::threshold),
+                     make_threshold_parameter(params_factory, -1.f, -24.f)},
+                    {to_underlying(limiter_parameter_key::release),
+                     make_time_parameter(
+                             params_factory,
+                             "Release"s,
+                             50.f,
+                             1.f,
+                             1000.f)}}),
+            .streams = make_gain_reduction_streams(args)};
+}
+
+} // namespace piejam::fx_modules::dynamics
@@ -0,0 +1,77 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/fx_modules/dynamics/gui/FxDynamics.h>
+
+#include <piejam/fx_modules/dynamics/dynamics_internal_id.h>
+#include <piejam/fx_modules/dynamics/dynamics_module.h>
+
+#include <piejam/gui/model/AudioStreamProvider.h>
+#include <piejam/gui/model/FxStream.h>
+#include <piejam/math.h>
+#include <piejam/to_underlying.h>
+
+#include <boost/container/flat_map.hpp>
+
+#include <algorithm>
+
+namespace piejam::fx_modules::dynamics::gui
+{
+
+using namespace piejam::gui::model;
+
+struct FxDynamics::Impl
+{
+    std::unique_ptr<FxStream> gainReductionStream;
+};
+
+FxDynamics::FxDynamics(
+        runtime::store_dispatch store_dispatch,
+        runtime::subscriber& state_change_subscriber,
+        runtime::fx::module_id const fx_mod_id)
+    : FxGenericModule{store_dispatch, state_change_subscriber, fx_mod_id}
+    , m_impl{make_pimpl<Impl>()}
+{
+    makeStream(
+            to_underlying(stream_key::gain_reduction),
+            m_impl->gainReductionStream,
+            streams());
+
+    QObject::connect(
+            m_impl->gainReductionStream.get(),
+            &AudioStreamProvider::captured,
+            this,
+            [this](AudioStream captured) {
+                auto const samples = captured.samples();
+                if (samples.empty())
+                {
+                    return;
+                }
+
+                // the stream carries 1 - gain, show the strongest reduction
+                float const reduction = std::ranges::max(samples);
+                setGainReduction(
+                        reduction > 0.f ? math::to_dB(1.f - reduction) : 0.f);
+            });
+}
+
+void
+FxDynamics::clear()
+{
+    setGainReduction(0.f);
+}
+
+auto
+FxCompressor::type() const noexcept -> FxModuleType
+{
+    return {.id = compressor_internal_id()};
+}
+
+auto
+FxLimiter::type() const noexcept -> FxModuleType
+{
+    return {.id = limiter_internal_id()};
+}
+
+} // namespace piejam::fx_modules::dynamics::gui
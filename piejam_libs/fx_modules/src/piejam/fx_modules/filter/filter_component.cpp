@@ -32,6 +32,7 @@
 #include <boost/hof/match.hpp>
 #include <boost/mp11/map.hpp>
 
+#include <chrono>
 #include <cmath>
 
 namespace piejam::fx_modules::filter
@@ -58,6 +59,10 @@ using br_tag = make_integral_constant<type::br>;
 
 namespace biqflt = audio::dsp::biquad_filter;
 
+// Even with high resonance, the ringing of the filter has decayed far below
+// audibility after that time.
+constexpr std::chrono::milliseconds filter_silence_tail{500};
+
 using tag_make_coefficients_map = boost::mp11::mp_list<
         std::pair<
                 lp2_tag,
@@ -166,8 +171,9 @@ class processor final
     , public audio::engine::single_event_input_processor<processor, event_value>
 {
 public:
-    processor(std::string_view const name)
+    processor(std::size_t const silence_tail, std::string_view const name)
         : named_processor(name)
+        , m_silence_tail(silence_tail)
     {
     }
 
@@ -199,6 +205,11 @@ public:
         return {};
     }
 
+    auto silence_tail() const noexcept -> std::size_t override
+    {
+        return m_silence_tail;
+    }
+
     void process(audio::engine::process_context const& ctx) override
     {
         verify_process_context(*this, ctx);
@@ -279,6 +290,7 @@ public:
     }
 
 private:
+    std::size_t m_silence_tail;
     type m_type{type::bypass};
     audio::dsp::biquad<float> m_biquad_first;
     audio::dsp::biquad<float> m_biquad_second;
@@ -351,6 +363,11 @@ public:
                                   to_underlying(parameter_key::resonance)),
                           "res"))
         , m_coeffs_proc(make_coefficent_converter_processor(args.sample_rate))
+        , m_filter_procs{
+                  ((void)Channel,
+                   std::make_unique<processor>(
+                           args.sample_rate.to_samples(filter_silence_tail),
+                           filter_channel_name<num_channels>(Channel)))...}
         , m_in_out_stream(make_in_out_stream(
                   args.fx_mod.bus_type,
                   args.fx_mod.streams->at(to_underlying(
@@ -450,10 +467,7 @@ private:
                     ((void)Channel,
                      audio::engine::make_identity_processor())...};
     std::array<std::unique_ptr<audio::engine::processor>, num_channels>
-            m_filter_procs{
-                    ((void)Channel,
-                     std::make_unique<processor>(
-                             filter_channel_name<num_channels>(Channel)))...};
+            m_filter_procs;
     std::shared_ptr<audio::engine::component> m_in_out_stream;
     std::array<audio::engine::graph_endpoint, num_channels> m_inputs{
             audio::engine::graph_endpoint{
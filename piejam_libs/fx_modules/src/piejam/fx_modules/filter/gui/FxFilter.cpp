@@ -39,6 +39,8 @@ struct FxFilter::Impl
     SpectrumGenerator spectrumInGenerator{sample_rate};
     SpectrumGenerator spectrumOutGenerator{sample_rate};
 
+    std::vector<float> middle;
+
     SpectrumSlot spectrumIn;
     SpectrumSlot spectrumOut;
 
@@ -114,12 +116,16 @@ FxFilter::FxFilter(
 
                     m_impl->spectrumIn.update(
                             m_impl->spectrumInGenerator.process(
-                                    toMiddle(captured.channels_subview(0, 2)
-                                                     .channels_cast<2>())));
+                                    mixToMiddle(
+                                            captured.channels_subview(0, 2)
+                                                    .channels_cast<2>(),
+                                            m_impl->middle)));
                     m_impl->spectrumOut.update(
                             m_impl->spectrumOutGenerator.process(
-                                    toMiddle(captured.channels_subview(2, 2)
-                                                     .channels_cast<2>())));
+                                    mixToMiddle(
+                                            captured.channels_subview(2, 2)
+                                                    .channels_cast<2>(),
+                                            m_impl->middle)));
                 });
     }
 }
@@ -2,8 +2,15 @@
 // SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <piejam/fx_modules/convolution/convolution_internal_id.h>
+#include <piejam/fx_modules/convolution/gui/FxConvolution.h>
+#include <piejam/fx_modules/convolution/impulse_responses.h>
+#include <piejam/fx_modules/delay/delay_internal_id.h>
+#include <piejam/fx_modules/delay/gui/FxDelay.h>
 #include <piejam/fx_modules/dual_pan/dual_pan_internal_id.h>
 #include <piejam/fx_modules/dual_pan/gui/FxDualPan.h>
+#include <piejam/fx_modules/dynamics/dynamics_internal_id.h>
+#include <piejam/fx_modules/dynamics/gui/FxDynamics.h>
 #include <piejam/fx_modules/filter/filter_internal_id.h>
 #include <piejam/fx_modules/filter/gui/FxFilter.h>
 #include <piejam/fx_modules/scope/gui/FxScope.h>
@@ -25,7 +32,11 @@ initResources()
 {
     Q_INIT_RESOURCE(piejam_fx_modules_resources);
 
+    qRegisterMetaType<piejam::fx_modules::convolution::gui::FxConvolution*>();
+    qRegisterMetaType<piejam::fx_modules::delay::gui::FxDelay*>();
     qRegisterMetaType<piejam::fx_modules::dual_pan::gui::FxDualPan*>();
+    qRegisterMetaType<piejam::fx_modules::dynamics::gui::FxCompressor*>();
+    qRegisterMetaType<piejam::fx_modules::dynamics::gui::FxLimiter*>();
     qRegisterMetaType<piejam::fx_modules::filter::gui::FxFilter*>();
     qRegisterMetaType<piejam::fx_modules::scope::gui::FxScope*>();
     qRegisterMetaType<piejam::fx_modules::spectrum::gui::FxSpectrum*>();
@@ -44,13 +55,19 @@ namespace piejam::fx_modules
 {
 
 void
-init()
+init(std::filesystem::path const& impulse_responses_dir)
 {
     static std::once_flag s_init;
-    std::call_once(s_init, []() {
+    std::call_once(s_init, [&impulse_responses_dir]() {
         initResources();
 
+        convolution::scan_impulse_responses(impulse_responses_dir);
+
+        convolution::internal_id();
+        delay::internal_id();
         dual_pan::internal_id();
+        dynamics::compressor_internal_id();
+        dynamics::limiter_internal_id();
         filter::internal_id();
         scope::internal_id();
         spectrum::internal_id();
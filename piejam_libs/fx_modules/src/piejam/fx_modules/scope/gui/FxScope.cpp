@@ -72,6 +72,7 @@ struct FxScope::Impl
     std::unique_ptr<EnumParameter> mode;
     std::unique_ptr<EnumParameter> triggerSlope;
     std::unique_ptr<FloatParameter> triggerLevel;
+    std::unique_ptr<FloatParameter> triggerHysteresis;
     std::unique_ptr<FloatParameter> holdTime;
     std::unique_ptr<IntParameter> waveformResolution;
     std::unique_ptr<IntParameter> scopeResolution;
@@ -156,6 +157,10 @@ FxScope::FxScope(
             m_impl->triggerLevel,
             parameters.at(to_underlying(parameter_key::trigger_level)));
 
+    makeParameter(
+            m_impl->triggerHysteresis,
+            parameters.at(to_underlying(parameter_key::trigger_hysteresis)));
+
     makeParameter(
             m_impl->holdTime,
             parameters.at(to_underlying(parameter_key::hold_time)));
@@ -226,7 +231,8 @@ FxScope::FxScope(
                                 m_impl->triggerSlopeEnum(),
                                 m_impl->triggerLevel->valueF(),
                                 captured.num_frames(),
-                                m_impl->holdTimeInFrames());
+                                m_impl->holdTimeInFrames(),
+                                m_impl->triggerHysteresis->valueF());
 
                         if (scope.size() == 1)
                         {
@@ -265,9 +271,10 @@ FxScope::FxScope(
                                          .cached()},
                                 m_viewSize,
                                 m_impl->triggerSlopeEnum(),
-                                m_impl->triggerLevel->value(),
+                                m_impl->triggerLevel->valueF(),
                                 captured.num_frames(),
-                                m_impl->holdTimeInFrames());
+                                m_impl->holdTimeInFrames(),
+                                m_impl->triggerHysteresis->valueF());
 
                         if (scopeSamples.size() == 2)
                         {
@@ -359,6 +366,12 @@ FxScope::triggerLevel() const noexcept -> FloatParameter*
     return m_impl->triggerLevel.get();
 }
 
+auto
+FxScope::triggerHysteresis() const noexcept -> FloatParameter*
+{
+    return m_impl->triggerHysteresis.get();
+}
+
 auto
 FxScope::holdTime() const noexcept -> FloatParameter*
 {
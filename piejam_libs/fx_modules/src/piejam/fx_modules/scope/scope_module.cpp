@@ -292,6 +292,17 @@ make_module(runtime::internal_fx_module_factory_args const& args)
                      params_factory.make_parameter(runtime::bool_parameter{
                              .name = box("Freeze"s),
                              .default_value = false})},
+                    {to_underlying(parameter_key::trigger_hysteresis),
+                     params_factory.make_parameter(runtime::float_parameter{
+                             .name = box("Hysteresis"s),
+                             .default_value = 0.f,
+                             .min = 0.f,
+                             .max = .5f,
+                             .to_normalized =
+                                     &runtime::parameter::to_normalized_linear,
+                             .from_normalized =
+                                     &runtime::parameter::
+                                             from_normalized_linear})},
             }),
             .streams = box(runtime::fx::module_streams{
                     {to_underlying(stream_key::input),
@@ -34,6 +34,8 @@ struct FxTuner::Impl
 
     std::unique_ptr<FxStream> stream{};
 
+    std::vector<float> middle;
+
     void updateSampleRate(audio::sample_rate sr)
     {
         if (sr.valid() && sample_rate != sr)
@@ -62,8 +64,10 @@ FxTuner::FxTuner(
                         m_impl->busType == BusType::Mono
                                 ? m_impl->pitchGenerator.process(
                                           captured.samples())
-                                : m_impl->pitchGenerator.process(toMiddle(
-                                          captured.channels_cast<2>()));
+                                : m_impl->pitchGenerator.process(
+                                          mixToMiddle(
+                                                  captured.channels_cast<2>(),
+                                                  m_impl->middle));
 
                 if (detectedFrequency != m_detectedFrequency)
                 {
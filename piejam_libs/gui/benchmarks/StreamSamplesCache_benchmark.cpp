@@ -0,0 +1,31 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/gui/model/StreamSamplesCache.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+constexpr auto period_size = 1024;
+constexpr auto view_size = 2 * 1024;
+
+static void
+BM_StreamSamplesCache_process(benchmark::State& state)
+{
+    std::vector<float> samples(period_size, 0.5f);
+    piejam::gui::model::StreamSamplesCache sut(
+            view_size,
+            static_cast<int>(state.range(0)));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        sut.process(samples);
+        benchmark::DoNotOptimize(sut.cached().data());
+    }
+}
+
+// stride as configured by the scope, resolution * 2 + 1
+BENCHMARK(BM_StreamSamplesCache_process)->DenseRange(1, 17, 4);
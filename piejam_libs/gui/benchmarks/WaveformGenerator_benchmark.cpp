@@ -0,0 +1,102 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/gui/model/WaveformGenerator.h>
+
+#include <piejam/audio/dsp/gain.h>
+#include <piejam/audio/dsp/minmax.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace
+{
+
+constexpr auto period_size = 1024;
+
+auto
+make_random_samples(std::size_t size)
+{
+    std::srand(std::time(nullptr));
+
+    std::vector<float> samples(size);
+    for (float& s : samples)
+    {
+        s = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * 2.f -
+            1.f;
+    }
+
+    return samples;
+}
+
+} // namespace
+
+static void
+BM_minmax(benchmark::State& state)
+{
+    auto const samples = make_random_samples(state.range(0));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+                piejam::audio::dsp::minmax(std::span<float const>{samples}));
+    }
+}
+
+BENCHMARK(BM_minmax)->RangeMultiplier(8)->Range(8, 4096);
+
+static void
+BM_simd_minmax(benchmark::State& state)
+{
+    auto const samples = make_random_samples(state.range(0));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(piejam::audio::dsp::simd::minmax(
+                std::span<float const>{samples}));
+    }
+}
+
+BENCHMARK(BM_simd_minmax)->RangeMultiplier(8)->Range(8, 4096);
+
+static void
+BM_simd_apply_gain(benchmark::State& state)
+{
+    auto const samples = make_random_samples(period_size);
+    std::vector<float> out(period_size);
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        piejam::audio::dsp::simd::apply_gain(
+                std::span<float const>{samples},
+                0.5f,
+                std::span{out});
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(BM_simd_apply_gain);
+
+static void
+BM_WaveformGenerator_process(benchmark::State& state)
+{
+    auto const samples = make_random_samples(period_size);
+    piejam::gui::model::WaveformGenerator sut(
+            static_cast<int>(state.range(0)));
+    benchmark::ClobberMemory();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sut.process(samples));
+    }
+}
+
+// samplesPerPixel as configured by the scope, 2^(resolution * 3)
+BENCHMARK(BM_WaveformGenerator_process)->RangeMultiplier(8)->Range(1, 4096);
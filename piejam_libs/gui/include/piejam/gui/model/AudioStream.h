@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <piejam/audio/dsp/gain.h>
 #include <piejam/audio/multichannel_view.h>
 
-#include <boost/range/adaptor/transformed.hpp>
+#include <span>
+#include <vector>
 
 namespace piejam::gui::model
 {
@@ -37,20 +39,18 @@ toRight(StereoAudioStream stream)
     return stream.channels()[1];
 }
 
+//! Sum of both channels, written into buffer, which is resized to fit.
 inline auto
-toMiddle(StereoAudioStream stream)
+mixToMiddle(StereoAudioStream stream, std::vector<float>& buffer)
+        -> std::span<float const>
 {
-    return stream.frames() | boost::adaptors::transformed([](auto frame) {
-               return frame[0] + frame[1];
-           });
-}
-
-inline auto
-toSide(StereoAudioStream stream)
-{
-    return stream.frames() | boost::adaptors::transformed([](auto frame) {
-               return frame[0] - frame[1];
-           });
+    buffer.resize(stream.num_frames());
+    audio::dsp::simd::sum_gain(
+            toLeft(stream),
+            toRight(stream),
+            1.f,
+            std::span{buffer});
+    return buffer;
 }
 
 } // namespace piejam::gui::model
@@ -22,6 +22,7 @@ class FxChainModule : public Subscribable<SubscribableModel>
 
     M_PIEJAM_GUI_PROPERTY(QString, name, setName)
     M_PIEJAM_GUI_PROPERTY(bool, focused, setFocused)
+    M_PIEJAM_GUI_PROPERTY(bool, failed, setFailed)
 
 public:
     FxChainModule(
@@ -20,7 +20,16 @@ class Info final : public Subscribable<SubscribableModel>
 
     M_PIEJAM_GUI_PROPERTY(double, audioLoad, setAudioLoad)
     M_PIEJAM_GUI_PROPERTY(unsigned, xruns, setXruns)
+    M_PIEJAM_GUI_PROPERTY(unsigned, rtAllocations, setRtAllocations)
+    M_PIEJAM_GUI_PROPERTY(
+            unsigned,
+            failedAggregateInputs,
+            setFailedAggregateInputs)
     M_PIEJAM_GUI_PROPERTY(QList<float>, cpuLoad, setCpuLoad)
+    M_PIEJAM_GUI_PROPERTY(QList<float>, workerBusy, setWorkerBusy)
+    M_PIEJAM_GUI_PROPERTY(QList<float>, workerSteal, setWorkerSteal)
+    M_PIEJAM_GUI_PROPERTY(QList<float>, workerIdle, setWorkerIdle)
+    M_PIEJAM_GUI_PROPERTY(QList<float>, workerCpu, setWorkerCpu)
     M_PIEJAM_GUI_PROPERTY(int, cpuTemp, setCpuTemp)
     M_PIEJAM_GUI_PROPERTY(bool, recording, setRecording)
     M_PIEJAM_GUI_PROPERTY(bool, midiLearn, setMidiLearn)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <piejam/algorithm/shift_push_back.h>
+#include <piejam/audio/dsp/pitch_yin_fft.h>
 #include <piejam/audio/sample_rate.h>
 
 #include <vector>
@@ -15,7 +16,8 @@ namespace piejam::gui::model
 class PitchGenerator
 {
 public:
-    explicit PitchGenerator(audio::sample_rate);
+    //! A new pitch is estimated every hopSize captured samples.
+    explicit PitchGenerator(audio::sample_rate, std::size_t hopSize = 4096);
 
     template <class Samples>
     auto process(Samples const& samples) -> float
@@ -29,6 +31,8 @@ private:
     auto process() -> float;
 
     std::vector<float> m_signal;
+    audio::dsp::pitch_yin_fft m_pitch_yin;
+    std::size_t m_hop_size;
     std::size_t m_captured_samples{};
     float m_last_frequency{};
     audio::sample_rate m_sample_rate;
@@ -17,6 +17,9 @@ class ScopeGenerator
 public:
     using Streams = boost::container::static_vector<std::span<float const>, 2>;
 
+    //! After a trigger, the search is suspended for holdTimeInFrames. With a
+    //! triggerHysteresis > 0, the signal has to pass the trigger level from
+    //! at least that far away, so noise around the level doesn't trigger.
     auto
     process(std::size_t triggerStream,
             Streams,
@@ -24,7 +27,8 @@ public:
             TriggerSlope,
             float triggerLevel,
             std::size_t capturedFrames,
-            std::size_t holdTimeInFrames) -> Streams;
+            std::size_t holdTimeInFrames,
+            float triggerHysteresis) -> Streams;
 
     void clear()
     {
@@ -10,12 +10,12 @@
 #include <piejam/gui/model/FloatParameter.h>
 #include <piejam/gui/model/Types.h>
 
-#include <piejam/functional/operators.h>
+#include <piejam/audio/dsp/gain.h>
 #include <piejam/switch_cast.h>
 
-#include <boost/range/adaptor/transformed.hpp>
-
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace piejam::gui::model
 {
@@ -23,23 +23,22 @@ namespace piejam::gui::model
 template <class Derived>
 struct StreamProcessor
 {
-    template <class Samples>
-    auto processSamples(Samples&& samples)
+    void processSamples(std::span<float const> samples)
     {
         auto const g = static_cast<float>(gain->value());
         switch (switch_cast(g))
         {
             case switch_cast(1.f):
-                static_cast<Derived&>(*this).process(
-                        std::forward<Samples>(samples));
+                static_cast<Derived&>(*this).process(samples);
                 break;
 
             default:
-                static_cast<Derived&>(*this).process(boost::adaptors::transform(
-                        boost::make_iterator_range(
-                                std::begin(samples),
-                                std::end(samples)),
-                        multiplies(g)));
+                audio::dsp::simd::apply_gain(
+                        samples,
+                        g,
+                        std::span{prepareScratch(samples.size())});
+                static_cast<Derived&>(*this).process(
+                        std::span<float const>{m_scratch});
                 break;
         }
     }
@@ -62,11 +61,23 @@ struct StreamProcessor
                 break;
 
             case StereoChannel::Middle:
-                processSamples(toMiddle(stream));
+                audio::dsp::simd::sum_gain(
+                        toLeft(stream),
+                        toRight(stream),
+                        static_cast<float>(gain->value()),
+                        std::span{prepareScratch(stream.num_frames())});
+                static_cast<Derived&>(*this).process(
+                        std::span<float const>{m_scratch});
                 break;
 
             case StereoChannel::Side:
-                processSamples(toSide(stream));
+                audio::dsp::simd::difference_gain(
+                        toLeft(stream),
+                        toRight(stream),
+                        static_cast<float>(gain->value()),
+                        std::span{prepareScratch(stream.num_frames())});
+                static_cast<Derived&>(*this).process(
+                        std::span<float const>{m_scratch});
                 break;
         }
     }
@@ -74,6 +85,16 @@ struct StreamProcessor
     std::unique_ptr<BoolParameter> active;
     std::unique_ptr<EnumParameter> channel;
     std::unique_ptr<FloatParameter> gain;
+
+private:
+    auto prepareScratch(std::size_t size) -> std::vector<float>&
+    {
+        m_scratch.resize(size);
+        return m_scratch;
+    }
+
+    // gained and mixed down samples, reused to avoid allocations per update
+    std::vector<float> m_scratch;
 };
 
 } // namespace piejam::gui::model
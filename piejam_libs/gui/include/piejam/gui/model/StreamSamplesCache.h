@@ -5,10 +5,9 @@
 #pragma once
 
 #include <piejam/algorithm/shift_push_back.h>
+#include <piejam/range/strided_span.h>
 
-#include <boost/range/adaptor/strided.hpp>
-
-#include <ranges>
+#include <algorithm>
 #include <span>
 #include <vector>
 
@@ -30,22 +29,23 @@ public:
         return m_cached;
     }
 
-    template <class Samples>
-    void process(Samples samples)
+    void process(std::span<float const> samples)
     {
-        auto const streamFramesSubRange = boost::make_iterator_range(
-                std::next(
-                        std::begin(samples),
-                        m_restFrames == 0 ? 0 : m_stride - m_restFrames),
-                std::end(samples));
+        auto const streamFramesSubRange = samples.subspan(std::min(
+                samples.size(),
+                static_cast<std::size_t>(
+                        m_restFrames == 0 ? 0 : m_stride - m_restFrames)));
 
         algorithm::shift_push_back(
                 m_cached,
-                boost::adaptors::stride(streamFramesSubRange, m_stride));
+                range::strided_span<float const>{
+                        streamFramesSubRange.data(),
+                        (streamFramesSubRange.size() + m_stride - 1) /
+                                m_stride,
+                        m_stride});
 
         m_restFrames =
-                static_cast<int>(std::ranges::size(streamFramesSubRange)) %
-                m_stride;
+                static_cast<int>(streamFramesSubRange.size()) % m_stride;
     }
 
 private:
@@ -7,8 +7,12 @@
 #include <piejam/gui/model/Waveform.h>
 #include <piejam/gui/model/fwd.h>
 
+#include <piejam/audio/dsp/minmax.h>
 #include <piejam/math.h>
 
+#include <algorithm>
+#include <span>
+
 namespace piejam::gui::model
 {
 
@@ -20,19 +24,24 @@ public:
     {
     }
 
-    template <class Samples>
-    auto process(Samples const& samples) -> Waveform
+    auto process(std::span<float const> samples) -> Waveform
     {
         Waveform result;
 
         constexpr auto clip = [](float x) { return math::clamp(x, -1.f, 1.f); };
 
-        for (auto const sample : samples)
+        while (!samples.empty())
         {
-            m_accY0 = std::min(m_accY0, sample);
-            m_accY1 = std::max(m_accY1, sample);
+            auto const bucket = samples.first(std::min(
+                    samples.size(),
+                    static_cast<std::size_t>(
+                            m_samplesPerPixel - m_accNumSamples)));
+
+            auto const [min, max] = audio::dsp::simd::minmax(bucket);
+            m_accY0 = std::min(m_accY0, min);
+            m_accY1 = std::max(m_accY1, max);
 
-            ++m_accNumSamples;
+            m_accNumSamples += static_cast<int>(bucket.size());
 
             if (m_accNumSamples >= m_samplesPerPixel)
             {
@@ -40,6 +49,8 @@ public:
 
                 reset();
             }
+
+            samples = samples.subspan(bucket.size());
         }
 
         return result;
@@ -12,6 +12,8 @@ Item {
     property alias diskUsage: diskSpaceIndicator.usage
     property real audioLoad: 0
     property int xruns: 0
+    property int rtAllocations: 0
+    property int failedAggregateInputs: 0
     property var cpuLoad: ({})
     property int cpuTemp: 0
 
@@ -31,6 +33,27 @@ Item {
             anchors.left: parent.left
         }
 
+        Label {
+            id: failedAggregateInputsLabel
+
+            height: 16
+
+            anchors.right: audioLoadLabel.left
+            anchors.top: parent.top
+
+            // additional capture devices, which couldn't be opened, their
+            // channels are silent, details are in the log
+            visible: root.failedAggregateInputs !== 0
+
+            padding: 2
+            leftPadding: 4
+            text: "IN"
+            font.bold: true
+            textFormat: Text.PlainText
+
+            color: "#ff0000"
+        }
+
         Label {
             id: audioLoadLabel
 
@@ -45,6 +68,9 @@ Item {
             horizontalAlignment: Text.AlignRight
             textFormat: Text.PlainText
             text: (root.audioLoad * 100).toFixed(1)
+
+            // allocations on the audio threads, details are in the log
+            color: root.rtAllocations === 0 ? Material.foreground : "#ff8000"
         }
 
         Label {
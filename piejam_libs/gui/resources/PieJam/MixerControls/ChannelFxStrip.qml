@@ -81,6 +81,9 @@ SubscribableItem {
                                 text: model.item.name
                                 verticalAlignment: Label.AlignVCenter
 
+                                // couldn't be created by the audio engine
+                                color: model.item.failed ? Material.color(Material.Red) : Material.foreground
+
                                 elide: Text.ElideRight
 
                                 MouseArea {
@@ -88,6 +88,8 @@ SubscribableItem {
                 diskUsage: root.model.diskUsage
                 audioLoad: root.model.audioLoad
                 xruns: root.model.xruns
+                rtAllocations: root.model.rtAllocations
+                failedAggregateInputs: root.model.failedAggregateInputs
                 cpuLoad: root.model.cpuLoad
                 cpuTemp: root.model.cpuTemp
             }
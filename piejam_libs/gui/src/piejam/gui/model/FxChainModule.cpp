@@ -44,6 +44,10 @@ FxChainModule::onSubscribe()
             [this](auto const focused_fx_mod_id) {
                 setFocused(focused_fx_mod_id == m_impl->fx_mod_id);
             });
+
+    observe(runtime::selectors::make_fx_module_failed_selector(
+                    m_impl->fx_mod_id),
+            [this](bool const failed) { setFailed(failed); });
 }
 
 void
@@ -29,9 +29,37 @@ Info::onSubscribe()
         setXruns(static_cast<unsigned>(xruns));
     });
 
+    observe(runtime::selectors::select_rt_allocations,
+            [this](std::size_t const rt_allocations) {
+                setRtAllocations(static_cast<unsigned>(rt_allocations));
+            });
+
+    observe(runtime::selectors::select_num_failed_aggregate_inputs,
+            [this](std::size_t const num_failed) {
+                setFailedAggregateInputs(static_cast<unsigned>(num_failed));
+            });
+
     observe(runtime::selectors::select_cpu_load,
             [this](float const cpu_load) { setAudioLoad(cpu_load); });
 
+    observe(runtime::selectors::select_worker_loads,
+            [this](boxed_vector<audio::engine::worker_load> const& loads) {
+                auto const to_list = [&loads](auto const member) {
+                    QList<float> result;
+                    result.reserve(static_cast<int>(loads->size()));
+                    for (auto const& load : *loads)
+                    {
+                        result.push_back(load.*member);
+                    }
+                    return result;
+                };
+
+                setWorkerBusy(to_list(&audio::engine::worker_load::busy));
+                setWorkerSteal(to_list(&audio::engine::worker_load::steal));
+                setWorkerIdle(to_list(&audio::engine::worker_load::idle));
+                setWorkerCpu(to_list(&audio::engine::worker_load::cpu));
+            });
+
     observe(runtime::selectors::select_midi_learning,
             [this](bool const midi_learning) { setMidiLearn(midi_learning); });
 
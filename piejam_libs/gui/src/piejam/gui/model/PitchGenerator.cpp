@@ -4,9 +4,10 @@
 
 #include <piejam/gui/model/PitchGenerator.h>
 
-#include <piejam/audio/dsp/pitch_yin.h>
 #include <piejam/audio/dsp/rms.h>
 
+#include <boost/assert.hpp>
+
 namespace piejam::gui::model
 {
 
@@ -14,20 +15,25 @@ namespace
 {
 
 inline constexpr std::size_t windowSize{8192};
-inline constexpr std::size_t captureSize{4096};
+inline constexpr std::size_t preDecimation{4};
 
 } // namespace
 
-PitchGenerator::PitchGenerator(audio::sample_rate sample_rate)
+PitchGenerator::PitchGenerator(
+        audio::sample_rate sample_rate,
+        std::size_t hopSize)
     : m_signal(windowSize)
+    , m_pitch_yin(windowSize, preDecimation)
+    , m_hop_size{hopSize}
     , m_sample_rate{sample_rate}
 {
+    BOOST_ASSERT(m_hop_size > 0);
 }
 
 auto
 PitchGenerator::process() -> float
 {
-    if (m_captured_samples >= captureSize)
+    if (m_captured_samples >= m_hop_size)
     {
         if (audio::dsp::simd::rms<float>(m_signal) < 0.001) // -60 dB
         {
@@ -35,11 +41,10 @@ PitchGenerator::process() -> float
         }
         else
         {
-            m_last_frequency =
-                    audio::dsp::pitch_yin<float>(m_signal, m_sample_rate);
+            m_last_frequency = m_pitch_yin(m_signal, m_sample_rate);
         }
 
-        m_captured_samples %= captureSize;
+        m_captured_samples %= m_hop_size;
     }
 
     return m_last_frequency;
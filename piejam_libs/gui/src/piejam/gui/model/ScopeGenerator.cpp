@@ -4,7 +4,8 @@
 
 #include <piejam/gui/model/ScopeGenerator.h>
 
-#include <piejam/functional/edge_detect.h>
+#include <piejam/audio/dsp/find_edge.h>
+#include <piejam/npos.h>
 
 #include <boost/assert.hpp>
 #include <boost/container/static_vector.hpp>
@@ -22,38 +23,28 @@ findTrigger(
         std::span<float const> samples,
         std::size_t const windowSize,
         TriggerSlope const trigger,
-        float triggerLevel)
+        float triggerLevel,
+        float triggerHysteresis) -> std::size_t
 {
     if (samples.empty())
     {
-        return samples.end();
+        return npos;
     }
 
     BOOST_ASSERT(samples.size() >= windowSize);
 
-    auto itFirst = samples.begin();
-    auto itLast = std::next(
-            samples.begin(),
-            static_cast<std::ranges::range_difference_t<ScopeSlot::Samples>>(
-                    samples.size() - windowSize));
-
-    auto itFound =
-            trigger == TriggerSlope::RisingEdge
-                    ? std::adjacent_find(
-                              itFirst,
-                              itLast,
-                              std::bind_front(rising_edge, triggerLevel))
-                    : std::adjacent_find(
-                              itFirst,
-                              itLast,
-                              std::bind_front(falling_edge, triggerLevel));
-
-    if (itFound == itLast)
-    {
-        return samples.end();
-    }
-
-    return itFound;
+    // the trigger position must be followed by a full window
+    auto const searchRange = samples.first(samples.size() - windowSize);
+
+    return trigger == TriggerSlope::RisingEdge
+                   ? audio::dsp::simd::find_rising_edge(
+                             searchRange,
+                             triggerLevel,
+                             triggerHysteresis)
+                   : audio::dsp::simd::find_falling_edge(
+                             searchRange,
+                             triggerLevel,
+                             triggerHysteresis);
 }
 
 } // namespace
@@ -66,7 +57,8 @@ ScopeGenerator::process(
         TriggerSlope triggerSlope,
         float triggerLevel,
         std::size_t capturedFrames,
-        std::size_t holdTimeInFrames) -> Streams
+        std::size_t holdTimeInFrames,
+        float triggerHysteresis) -> Streams
 {
     BOOST_ASSERT(
             streams.empty() || streams.size() == 1 ||
@@ -80,14 +72,14 @@ ScopeGenerator::process(
     {
         case State::WaitingForTrigger:
         {
-            auto it = findTrigger(
+            auto offset = findTrigger(
                     triggerStreamSamples,
                     windowSize,
                     triggerSlope,
-                    triggerLevel);
-            if (it != triggerStreamSamples.end())
+                    triggerLevel,
+                    triggerHysteresis);
+            if (offset != npos)
             {
-                auto offset = std::distance(triggerStreamSamples.begin(), it);
                 std::ranges::transform(
                         streams,
                         std::back_inserter(result),
@@ -21,5 +21,6 @@ using instance_id = entity_id<instance_id_tag>;
 
 class instance_manager;
 class processor_factory;
+class scan_cache;
 
 } // namespace piejam::ladspa
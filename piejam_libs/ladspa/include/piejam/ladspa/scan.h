@@ -13,7 +13,10 @@ namespace piejam::ladspa
 {
 
 auto scan_file(std::filesystem::path const&) -> std::vector<plugin_descriptor>;
-auto
-scan_directory(std::filesystem::path const&) -> std::vector<plugin_descriptor>;
+
+//! Only files which aren't in the cache, or changed since, are opened. The
+//! cache is updated to the current content of the directory.
+auto scan_directory(std::filesystem::path const&, scan_cache&)
+        -> std::vector<plugin_descriptor>;
 
 } // namespace piejam::ladspa
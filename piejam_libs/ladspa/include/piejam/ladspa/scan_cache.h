@@ -0,0 +1,68 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/ladspa/plugin_descriptor.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace piejam::ladspa
+{
+
+//! Identifies the version of a plugin file, without opening it.
+struct file_stamp
+{
+    std::uint64_t size{};
+    std::uint64_t mtime_ns{};
+    std::uint64_t inode{};
+
+    auto operator==(file_stamp const&) const noexcept -> bool = default;
+};
+
+[[nodiscard]]
+auto file_stamp_of(std::filesystem::path const&) -> std::optional<file_stamp>;
+
+//! Scan results per plugin file. A file is only rescanned, if its stamp
+//! changed. Files which failed to scan are cached with no descriptors, so
+//! they aren't opened again until they change.
+class scan_cache
+{
+public:
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_entries.size();
+    }
+
+    [[nodiscard]]
+    auto lookup(std::filesystem::path const&, file_stamp const&) const
+            -> std::vector<plugin_descriptor> const*;
+
+    void insert(
+            std::filesystem::path const&,
+            file_stamp const&,
+            std::vector<plugin_descriptor>);
+
+    //! Reads a cache written by save. A missing or invalid file results in
+    //! an empty cache.
+    static auto load(std::filesystem::path const&) -> scan_cache;
+
+    auto save(std::filesystem::path const&) const -> bool;
+
+private:
+    struct entry
+    {
+        file_stamp stamp;
+        std::vector<plugin_descriptor> plugins;
+    };
+
+    std::map<std::filesystem::path, entry> m_entries;
+};
+
+} // namespace piejam::ladspa
@@ -394,7 +394,7 @@ private:
     std::size_t m_offset{};
     float m_data{};
 
-    std::aligned_storage_t<32> m_iterators;
+    std::aligned_storage_t<48> m_iterators;
 
     using initialize_t = void (*)(
             control_input&,
@@ -496,6 +496,11 @@ public:
         return m_event_outputs;
     }
 
+    auto may_forward_inputs() const noexcept -> bool override
+    {
+        return false;
+    }
+
     void process(audio::engine::process_context const& ctx) override
     {
         audio::engine::verify_process_context(*this, ctx);
@@ -5,6 +5,7 @@
 #include <piejam/ladspa/scan.h>
 
 #include <piejam/ladspa/plugin_descriptor.h>
+#include <piejam/ladspa/scan_cache.h>
 
 #include <piejam/system/dll.h>
 
@@ -20,6 +21,34 @@
 namespace piejam::ladspa
 {
 
+namespace
+{
+
+auto
+is_plugin_file(std::filesystem::directory_entry const& entry) -> bool
+{
+    return entry.is_regular_file() &&
+           entry.path().extension().string() == ".so";
+}
+
+auto
+try_scan_file(std::filesystem::path const& file)
+        -> std::vector<plugin_descriptor>
+{
+    try
+    {
+        return scan_file(file);
+    }
+    catch (std::system_error const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("LADSPA fx plugin scan: {}", message);
+        return {};
+    }
+}
+
+} // namespace
+
 auto
 scan_file(std::filesystem::path const& file) -> std::vector<plugin_descriptor>
 {
@@ -75,7 +104,7 @@ scan_file(std::filesystem::path const& file) -> std::vector<plugin_descriptor>
 }
 
 auto
-scan_directory(std::filesystem::path const& dir)
+scan_directory(std::filesystem::path const& dir, scan_cache& cache)
         -> std::vector<plugin_descriptor>
 {
     BOOST_ASSERT(std::filesystem::exists(dir));
@@ -83,23 +112,45 @@ scan_directory(std::filesystem::path const& dir)
 
     std::vector<plugin_descriptor> result;
 
+    // entries of removed files are dropped
+    scan_cache updated;
+    std::size_t num_scanned{};
+
     for (auto const& entry : std::filesystem::directory_iterator(dir))
     {
-        if (entry.is_regular_file() &&
-            entry.path().extension().string() == ".so")
+        if (!is_plugin_file(entry))
         {
-            try
-            {
-                boost::push_back(result, scan_file(entry.path()));
-            }
-            catch (std::system_error const& err)
-            {
-                auto const* const message = err.what();
-                spdlog::error("LADSPA fx plugin scan: {}", message);
-            }
+            continue;
+        }
+
+        auto const stamp = file_stamp_of(entry.path());
+        if (!stamp)
+        {
+            continue;
+        }
+
+        std::vector<plugin_descriptor> plugins;
+        if (auto const* const cached = cache.lookup(entry.path(), *stamp))
+        {
+            plugins = *cached;
+        }
+        else
+        {
+            plugins = try_scan_file(entry.path());
+            ++num_scanned;
         }
+
+        boost::push_back(result, plugins);
+        updated.insert(entry.path(), *stamp, std::move(plugins));
     }
 
+    spdlog::info(
+            "LADSPA fx plugin scan: {} files, {} rescanned",
+            updated.size(),
+            num_scanned);
+
+    cache = std::move(updated);
+
     return result;
 }
 
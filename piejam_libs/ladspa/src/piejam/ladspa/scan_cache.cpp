@@ -0,0 +1,284 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/ladspa/scan_cache.h>
+
+#include <piejam/system/mapped_file.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <system_error>
+
+#include <sys/stat.h>
+
+namespace piejam::ladspa
+{
+
+namespace
+{
+
+constexpr char file_magic[4]{'P', 'J', 'L', 'C'};
+constexpr std::uint32_t file_version = 1;
+
+class writer
+{
+public:
+    explicit writer(std::ofstream& out)
+        : m_out(out)
+    {
+    }
+
+    void u64(std::uint64_t const value)
+    {
+        m_out.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+
+    void str(std::string const& s)
+    {
+        u64(s.size());
+        m_out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+private:
+    std::ofstream& m_out;
+};
+
+// Reads from the mapped file, every read is bounds checked. Once a read
+// fails, all subsequent ones fail as well.
+class reader
+{
+public:
+    explicit reader(std::span<std::byte const> data)
+        : m_data(data)
+    {
+    }
+
+    [[nodiscard]]
+    auto ok() const noexcept -> bool
+    {
+        return m_ok;
+    }
+
+    auto bytes(void* dst, std::size_t const size) -> bool
+    {
+        if (!m_ok || size > m_data.size())
+        {
+            m_ok = false;
+            return false;
+        }
+
+        std::memcpy(dst, m_data.data(), size);
+        m_data = m_data.subspan(size);
+        return true;
+    }
+
+    auto u64() -> std::uint64_t
+    {
+        std::uint64_t value{};
+        bytes(&value, sizeof(value));
+        return value;
+    }
+
+    auto str() -> std::string
+    {
+        std::uint64_t const size = u64();
+        if (!m_ok || size > m_data.size())
+        {
+            m_ok = false;
+            return {};
+        }
+
+        std::string result(
+                reinterpret_cast<char const*>(m_data.data()),
+                static_cast<std::size_t>(size));
+        m_data = m_data.subspan(static_cast<std::size_t>(size));
+        return result;
+    }
+
+private:
+    std::span<std::byte const> m_data;
+    bool m_ok{true};
+};
+
+} // namespace
+
+auto
+file_stamp_of(std::filesystem::path const& file) -> std::optional<file_stamp>
+{
+    struct stat st{};
+    if (::stat(file.c_str(), &st) < 0)
+    {
+        return std::nullopt;
+    }
+
+    return file_stamp{
+            .size = static_cast<std::uint64_t>(st.st_size),
+            .mtime_ns = static_cast<std::uint64_t>(st.st_mtim.tv_sec) *
+                                1'000'000'000u +
+                        static_cast<std::uint64_t>(st.st_mtim.tv_nsec),
+            .inode = static_cast<std::uint64_t>(st.st_ino)};
+}
+
+auto
+scan_cache::lookup(
+        std::filesystem::path const& file,
+        file_stamp const& stamp) const -> std::vector<plugin_descriptor> const*
+{
+    auto const it = m_entries.find(file);
+    return it != m_entries.end() && it->second.stamp == stamp
+                   ? &it->second.plugins
+                   : nullptr;
+}
+
+void
+scan_cache::insert(
+        std::filesystem::path const& file,
+        file_stamp const& stamp,
+        std::vector<plugin_descriptor> plugins)
+{
+    m_entries.insert_or_assign(
+            file,
+            entry{.stamp = stamp, .plugins = std::move(plugins)});
+}
+
+auto
+scan_cache::load(std::filesystem::path const& file) -> scan_cache
+{
+    if (!std::filesystem::exists(file))
+    {
+        return {};
+    }
+
+    system::mapped_file mapped;
+    try
+    {
+        mapped = system::mapped_file(file);
+    }
+    catch (std::system_error const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("could not map LADSPA scan cache: {}", message);
+        return {};
+    }
+
+    reader in(mapped.data());
+
+    char magic[4]{};
+    in.bytes(magic, sizeof(magic));
+    std::uint64_t const version = in.u64();
+    if (!in.ok() || std::memcmp(magic, file_magic, sizeof(magic)) != 0 ||
+        version != file_version)
+    {
+        spdlog::warn("ignoring LADSPA scan cache: {}", file.string());
+        return {};
+    }
+
+    scan_cache result;
+
+    std::uint64_t const num_entries = in.u64();
+    for (std::uint64_t i = 0; i < num_entries && in.ok(); ++i)
+    {
+        std::filesystem::path const plugin_file = in.str();
+
+        file_stamp stamp;
+        stamp.size = in.u64();
+        stamp.mtime_ns = in.u64();
+        stamp.inode = in.u64();
+
+        std::vector<plugin_descriptor> plugins;
+        std::uint64_t const num_plugins = in.u64();
+        for (std::uint64_t p = 0; p < num_plugins && in.ok(); ++p)
+        {
+            plugin_descriptor pd;
+            pd.id = in.u64();
+            pd.file = plugin_file;
+            pd.index = in.u64();
+            pd.label = in.str();
+            pd.name = in.str();
+            pd.author = in.str();
+            pd.copyright = in.str();
+            pd.num_inputs = in.u64();
+            pd.num_outputs = in.u64();
+            plugins.push_back(std::move(pd));
+        }
+
+        result.insert(plugin_file, stamp, std::move(plugins));
+    }
+
+    if (!in.ok())
+    {
+        spdlog::warn("ignoring truncated LADSPA scan cache: {}", file.string());
+        return {};
+    }
+
+    return result;
+}
+
+auto
+scan_cache::save(std::filesystem::path const& file) const -> bool
+{
+    // written aside and renamed, a reader never sees a partial file
+    auto const tmp_file = std::filesystem::path{file}.concat(".tmp");
+
+    std::error_code ec;
+    std::filesystem::create_directories(file.parent_path(), ec);
+
+    {
+        std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            spdlog::error(
+                    "could not open LADSPA scan cache: {}",
+                    tmp_file.string());
+            return false;
+        }
+
+        out.write(file_magic, sizeof(file_magic));
+
+        writer w(out);
+        w.u64(file_version);
+        w.u64(m_entries.size());
+
+        for (auto const& [plugin_file, e] : m_entries)
+        {
+            w.str(plugin_file.string());
+            w.u64(e.stamp.size);
+            w.u64(e.stamp.mtime_ns);
+            w.u64(e.stamp.inode);
+
+            w.u64(e.plugins.size());
+            for (plugin_descriptor const& pd : e.plugins)
+            {
+                w.u64(pd.id);
+                w.u64(pd.index);
+                w.str(pd.label);
+                w.str(pd.name);
+                w.str(pd.author);
+                w.str(pd.copyright);
+                w.u64(pd.num_inputs);
+                w.u64(pd.num_outputs);
+            }
+        }
+
+        if (!out.good())
+        {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmp_file, file, ec);
+    if (ec)
+    {
+        spdlog::error("could not write LADSPA scan cache: {}", ec.message());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace piejam::ladspa
@@ -0,0 +1,220 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/ladspa/scan_cache.h>
+
+#include <piejam/ladspa/plugin_descriptor.h>
+#include <piejam/ladspa/scan.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace piejam::ladspa::test
+{
+
+namespace
+{
+
+auto
+make_plugin(std::filesystem::path const& file, plugin_id_t id)
+        -> plugin_descriptor
+{
+    return plugin_descriptor{
+            .id = id,
+            .file = file,
+            .index = 1,
+            .label = "label",
+            .name = "name",
+            .author = "author",
+            .copyright = "copyright",
+            .num_inputs = 2,
+            .num_outputs = 3};
+}
+
+void
+write_file(std::filesystem::path const& file, std::string_view content)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+struct scan_cache_test : ::testing::Test
+{
+    scan_cache_test()
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(plugin_dir);
+    }
+
+    ~scan_cache_test() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path const dir{
+            std::filesystem::temp_directory_path() / "scan_cache_test"};
+    std::filesystem::path const plugin_dir{dir / "plugins"};
+    std::filesystem::path const cache_file{dir / "ladspa.cache"};
+};
+
+} // namespace
+
+TEST_F(scan_cache_test, round_trip)
+{
+    auto const plugin_file = plugin_dir / "a.so";
+    file_stamp const stamp{.size = 1, .mtime_ns = 2, .inode = 3};
+
+    scan_cache sut;
+    sut.insert(
+            plugin_file,
+            stamp,
+            {make_plugin(plugin_file, 5), make_plugin(plugin_file, 7)});
+    sut.insert(plugin_dir / "failed.so", stamp, {});
+    ASSERT_TRUE(sut.save(cache_file));
+
+    auto const loaded = scan_cache::load(cache_file);
+    ASSERT_EQ(2u, loaded.size());
+
+    auto const* const plugins = loaded.lookup(plugin_file, stamp);
+    ASSERT_NE(nullptr, plugins);
+    ASSERT_EQ(2u, plugins->size());
+
+    auto const& pd = plugins->back();
+    EXPECT_EQ(7u, pd.id);
+    EXPECT_EQ(plugin_file, pd.file);
+    EXPECT_EQ(1u, pd.index);
+    EXPECT_EQ("label", pd.label);
+    EXPECT_EQ("name", pd.name);
+    EXPECT_EQ("author", pd.author);
+    EXPECT_EQ("copyright", pd.copyright);
+    EXPECT_EQ(2u, pd.num_inputs);
+    EXPECT_EQ(3u, pd.num_outputs);
+
+    auto const* const failed = loaded.lookup(plugin_dir / "failed.so", stamp);
+    ASSERT_NE(nullptr, failed);
+    EXPECT_TRUE(failed->empty());
+}
+
+TEST_F(scan_cache_test, lookup_with_changed_stamp_misses)
+{
+    auto const plugin_file = plugin_dir / "a.so";
+
+    scan_cache sut;
+    sut.insert(
+            plugin_file,
+            file_stamp{.size = 1, .mtime_ns = 2, .inode = 3},
+            {make_plugin(plugin_file, 5)});
+
+    EXPECT_EQ(
+            nullptr,
+            sut.lookup(
+                    plugin_file,
+                    file_stamp{.size = 1, .mtime_ns = 4, .inode = 3}));
+    EXPECT_EQ(
+            nullptr,
+            sut.lookup(
+                    plugin_dir / "b.so",
+                    file_stamp{.size = 1, .mtime_ns = 2, .inode = 3}));
+}
+
+TEST_F(scan_cache_test, load_missing_file_is_empty)
+{
+    EXPECT_EQ(0u, scan_cache::load(cache_file).size());
+}
+
+TEST_F(scan_cache_test, load_corrupt_file_is_empty)
+{
+    write_file(cache_file, "this is not a LADSPA scan cache");
+
+    EXPECT_EQ(0u, scan_cache::load(cache_file).size());
+}
+
+TEST_F(scan_cache_test, load_truncated_file_is_empty)
+{
+    auto const plugin_file = plugin_dir / "a.so";
+
+    scan_cache sut;
+    sut.insert(
+            plugin_file,
+            file_stamp{.size = 1, .mtime_ns = 2, .inode = 3},
+            {make_plugin(plugin_file, 5)});
+    ASSERT_TRUE(sut.save(cache_file));
+
+    std::filesystem::resize_file(
+            cache_file,
+            std::filesystem::file_size(cache_file) - 1);
+
+    EXPECT_EQ(0u, scan_cache::load(cache_file).size());
+}
+
+TEST_F(scan_cache_test, scan_directory_uses_cached_entry)
+{
+    // not a loadable library, it can only come from the cache
+    auto const plugin_file = plugin_dir / "a.so";
+    write_file(plugin_file, "a");
+
+    auto const stamp = file_stamp_of(plugin_file);
+    ASSERT_TRUE(stamp.has_value());
+
+    scan_cache cache;
+    cache.insert(plugin_file, *stamp, {make_plugin(plugin_file, 5)});
+
+    auto const plugins = scan_directory(plugin_dir, cache);
+    ASSERT_EQ(1u, plugins.size());
+    EXPECT_EQ(5u, plugins.front().id);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(scan_cache_test, scan_directory_rescans_stale_entry)
+{
+    auto const plugin_file = plugin_dir / "a.so";
+    write_file(plugin_file, "a");
+
+    auto const stamp = file_stamp_of(plugin_file);
+    ASSERT_TRUE(stamp.has_value());
+
+    scan_cache cache;
+    cache.insert(plugin_file, *stamp, {make_plugin(plugin_file, 5)});
+
+    write_file(plugin_file, "changed");
+
+    // the rescan fails, the file isn't a loadable library
+    EXPECT_TRUE(scan_directory(plugin_dir, cache).empty());
+
+    auto const new_stamp = file_stamp_of(plugin_file);
+    ASSERT_TRUE(new_stamp.has_value());
+    auto const* const cached = cache.lookup(plugin_file, *new_stamp);
+    ASSERT_NE(nullptr, cached);
+    EXPECT_TRUE(cached->empty());
+}
+
+TEST_F(scan_cache_test, scan_directory_drops_removed_plugin)
+{
+    auto const plugin_file = plugin_dir / "a.so";
+    write_file(plugin_file, "a");
+    auto const removed_file = plugin_dir / "removed.so";
+    write_file(removed_file, "removed");
+
+    auto const stamp = file_stamp_of(plugin_file);
+    auto const removed_stamp = file_stamp_of(removed_file);
+    ASSERT_TRUE(stamp.has_value());
+    ASSERT_TRUE(removed_stamp.has_value());
+
+    scan_cache cache;
+    cache.insert(plugin_file, *stamp, {make_plugin(plugin_file, 5)});
+    cache.insert(removed_file, *removed_stamp, {make_plugin(removed_file, 7)});
+
+    std::filesystem::remove(removed_file);
+
+    auto const plugins = scan_directory(plugin_dir, cache);
+    ASSERT_EQ(1u, plugins.size());
+    EXPECT_EQ(5u, plugins.front().id);
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ(nullptr, cache.lookup(removed_file, *removed_stamp));
+}
+
+} // namespace piejam::ladspa::test
@@ -6,6 +6,8 @@
 
 #include <piejam/midi/fwd.h>
 
+#include <piejam/system/monotonic_raw_clock.h>
+
 namespace piejam::midi
 {
 
@@ -14,7 +16,10 @@ class event_handler
 public:
     virtual ~event_handler() = default;
 
-    virtual void process(external_event const&) = 0;
+    //! received is the time the event was read from the sequencer
+    virtual void process(
+            external_event const&,
+            system::monotonic_raw_clock::time_point received) = 0;
 };
 
 } // namespace piejam::midi
@@ -14,7 +14,8 @@ class input_event_handler
 public:
     virtual ~input_event_handler() = default;
 
-    //! RT-safe
+    //! Passes the events received since the last call. RT-safe, the
+    //! sequencer is read on a separate thread.
     virtual void process(event_handler&) = 0;
 };
 
@@ -144,6 +144,13 @@ midi_io::midi_io()
     }
 }
 
+auto
+midi_io::wait_for_input(std::chrono::milliseconds const timeout) -> bool
+{
+    auto const poll_result = m_seq.poll_read(timeout);
+    return poll_result && poll_result.value();
+}
+
 void
 midi_io::process_input(event_handler& handler)
 {
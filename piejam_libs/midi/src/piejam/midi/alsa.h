@@ -6,6 +6,7 @@
 
 #include <piejam/system/device.h>
 
+#include <chrono>
 #include <string>
 #include <variant>
 #include <vector>
@@ -46,6 +47,10 @@ public:
         return m_in_port;
     }
 
+    //! Returns true, if input is available before the timeout expires.
+    [[nodiscard]]
+    auto wait_for_input(std::chrono::milliseconds timeout) -> bool;
+
     void process_input(event_handler&);
 
 private:
@@ -13,13 +13,18 @@
 
 #include <piejam/algorithm/contains.h>
 #include <piejam/entity_id_hash.h>
+#include <piejam/system/monotonic_raw_clock.h>
+#include <piejam/thread/configuration.h>
+#include <piejam/thread/spsc_queue.h>
 
 #include <fmt/format.h>
+#include <spdlog/spdlog.h>
 
 #include <boost/assert.hpp>
 #include <boost/container/flat_map.hpp>
 
 #include <algorithm>
+#include <thread>
 #include <unordered_map>
 
 namespace piejam::midi
@@ -32,13 +37,26 @@ using alsa_midi_devices_t = boost::container::flat_map<
         std::pair<alsa::midi_client_id_t, alsa::midi_port_t>,
         device_id_t>;
 
-struct alsa_event_handler final : alsa::event_handler
+struct received_cc_event
 {
-    alsa_event_handler(
-            midi::event_handler& ev_handler,
-            alsa_midi_devices_t const& devices)
-        : m_ev_handler(ev_handler)
-        , m_devices(devices)
+    alsa::midi_client_id_t client_id{};
+    alsa::midi_port_t port{};
+    std::size_t channel{};
+    std::size_t cc_id{};
+    std::size_t value{};
+    system::monotonic_raw_clock::time_point received;
+};
+
+using received_events_queue = thread::spsc_queue<received_cc_event>;
+
+// Runs on the reader thread, all events of one read share the timestamp.
+struct queueing_event_handler final : alsa::event_handler
+{
+    queueing_event_handler(
+            received_events_queue& queue,
+            system::monotonic_raw_clock::time_point received)
+        : m_queue(queue)
+        , m_received(received)
     {
     }
 
@@ -49,28 +67,36 @@ struct alsa_event_handler final : alsa::event_handler
             std::size_t const cc_id,
             std::size_t const value) override
     {
-        if (auto it = m_devices.find(std::pair{client_id, port});
-            it != m_devices.end())
+        if (!m_queue.push(
+                    {.client_id = client_id,
+                     .port = port,
+                     .channel = channel,
+                     .cc_id = cc_id,
+                     .value = value,
+                     .received = m_received}))
         {
-            m_ev_handler.process(midi::external_event{
-                    .device_id = it->second,
-                    .event = midi::channel_cc_event{
-                            .channel = channel,
-                            .data = cc_event{.cc = cc_id, .value = value}}});
+            ++m_dropped;
         }
     }
 
+    [[nodiscard]]
+    auto dropped() const noexcept -> std::size_t
+    {
+        return m_dropped;
+    }
+
 private:
-    midi::event_handler& m_ev_handler;
-    alsa_midi_devices_t const& m_devices;
+    received_events_queue& m_queue;
+    system::monotonic_raw_clock::time_point m_received;
+    std::size_t m_dropped{};
 };
 
 struct alsa_input_event_handler final : input_event_handler
 {
     alsa_input_event_handler(
-            alsa::midi_io& mio,
+            received_events_queue& received_events,
             std::unordered_map<device_id_t, alsa::midi_device> const& devices)
-        : m_midi_io(mio)
+        : m_received_events(received_events)
     {
         m_devices.reserve(devices.size());
 
@@ -86,12 +112,25 @@ struct alsa_input_event_handler final : input_event_handler
 
     void process(event_handler& ev_handler) override
     {
-        alsa_event_handler alsa_ev_handler(ev_handler, m_devices);
-        m_midi_io.process_input(alsa_ev_handler);
+        m_received_events.consume([&](received_cc_event const& ev) {
+            if (auto it = m_devices.find(std::pair{ev.client_id, ev.port});
+                it != m_devices.end())
+            {
+                ev_handler.process(
+                        midi::external_event{
+                                .device_id = it->second,
+                                .event = midi::channel_cc_event{
+                                        .channel = ev.channel,
+                                        .data = cc_event{
+                                                .cc = ev.cc_id,
+                                                .value = ev.value}}},
+                        ev.received);
+            }
+        });
     }
 
 private:
-    alsa::midi_io& m_midi_io;
+    received_events_queue& m_received_events;
     alsa_midi_devices_t m_devices;
 };
 
@@ -161,6 +200,8 @@ private:
                 op);
     }
 
+    void read_input(std::stop_token const&);
+
     alsa::midi_io m_midi_io;
     alsa::midi_devices m_alsa_midi_devices{
             m_midi_io.client_id(),
@@ -169,8 +210,47 @@ private:
     using alsa_input_devices_t =
             std::unordered_map<device_id_t, alsa::midi_device>;
     alsa_input_devices_t m_alsa_input_devices;
+
+    static constexpr std::size_t received_events_capacity{1024};
+    received_events_queue m_received_events{received_events_capacity};
+
+    // last member, the reader must be stopped before anything it uses
+    std::jthread m_reader{
+            [this](std::stop_token stop_token) { read_input(stop_token); }};
 };
 
+void
+alsa_device_manager::read_input(std::stop_token const& stop_token)
+{
+    thread::configuration{
+            .affinity = {},
+            .realtime_priority = {},
+            .name = "midi_in"}
+            .apply();
+
+    // the timeout only bounds the time to notice a stop request
+    constexpr std::chrono::milliseconds poll_timeout{100};
+
+    while (!stop_token.stop_requested())
+    {
+        if (!m_midi_io.wait_for_input(poll_timeout))
+        {
+            continue;
+        }
+
+        queueing_event_handler handler(
+                m_received_events,
+                system::monotonic_raw_clock::now());
+        m_midi_io.process_input(handler);
+
+        if (handler.dropped() > 0)
+        {
+            auto const dropped = handler.dropped();
+            spdlog::warn("midi_in: dropped {} events, queue full", dropped);
+        }
+    }
+}
+
 auto
 alsa_device_manager::activate_input_device(device_id_t const device_id) -> bool
 {
@@ -218,7 +298,7 @@ alsa_device_manager::make_input_event_handler()
         -> std::unique_ptr<input_event_handler>
 {
     return std::make_unique<alsa_input_event_handler>(
-            m_midi_io,
+            m_received_events,
             m_alsa_input_devices);
 }
 
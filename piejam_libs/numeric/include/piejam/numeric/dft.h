@@ -15,8 +15,11 @@ class dft
 {
 public:
     explicit dft(std::size_t size);
+    dft(dft&&) noexcept;
     ~dft();
 
+    auto operator=(dft&&) noexcept -> dft&;
+
     [[nodiscard]]
     auto size() const noexcept -> std::size_t;
     [[nodiscard]]
@@ -31,4 +34,29 @@ private:
     std::unique_ptr<impl> m_impl;
 };
 
+//! Inverse of dft, complex half-spectrum to real. Like FFTW, the result is
+//! not normalized, i.e. scaled by size().
+class idft
+{
+public:
+    explicit idft(std::size_t size);
+    idft(idft&&) noexcept;
+    ~idft();
+
+    auto operator=(idft&&) noexcept -> idft&;
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t;
+    [[nodiscard]]
+    auto input_buffer() const noexcept -> std::span<std::complex<float>>;
+    [[nodiscard]]
+    auto input_size() const noexcept -> std::size_t;
+
+    auto process() -> std::span<float const>;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+};
+
 } // namespace piejam::numeric
@@ -42,19 +42,19 @@ struct fftwf_plan_deleter
     }
 };
 
+static_assert(sizeof(std::complex<float>) == sizeof(fftwf_complex));
+
+template <class T>
+using fftwf_vector = std::vector<T, fftwf_allocator<T>>;
+using fftwf_real_vector = fftwf_vector<float>;
+using fftwf_complex_vector = fftwf_vector<std::complex<float>>;
+using fftwf_plan_unique_ptr =
+        std::unique_ptr<std::remove_pointer_t<fftwf_plan>, fftwf_plan_deleter>;
+
 } // namespace
 
 struct dft::impl
 {
-    static_assert(sizeof(std::complex<float>) == sizeof(fftwf_complex));
-
-    template <class T>
-    using fftwf_vector = std::vector<T, fftwf_allocator<T>>;
-    using fftwf_real_vector = fftwf_vector<float>;
-    using fftwf_complex_vector = fftwf_vector<std::complex<float>>;
-    using fftwf_plan_unique_ptr = std::
-            unique_ptr<std::remove_pointer_t<fftwf_plan>, fftwf_plan_deleter>;
-
     std::size_t input_size{};
     std::size_t output_size{input_size / 2 + 1};
 
@@ -72,8 +72,13 @@ dft::dft(std::size_t const size)
 {
 }
 
+dft::dft(dft&&) noexcept = default;
+
 dft::~dft() = default;
 
+auto
+dft::operator=(dft&&) noexcept -> dft& = default;
+
 auto
 dft::size() const noexcept -> std::size_t
 {
@@ -99,4 +104,57 @@ dft::process() -> std::span<std::complex<float> const>
     return m_impl->out_buffer;
 }
 
+struct idft::impl
+{
+    std::size_t output_size{};
+    std::size_t input_size{output_size / 2 + 1};
+
+    fftwf_complex_vector in_buffer{fftwf_complex_vector(input_size)};
+    fftwf_real_vector out_buffer{fftwf_real_vector(output_size)};
+    fftwf_plan_unique_ptr plan{fftwf_plan_dft_c2r_1d(
+            output_size,
+            reinterpret_cast<fftwf_complex*>(in_buffer.data()),
+            out_buffer.data(),
+            FFTW_MEASURE)};
+};
+
+idft::idft(std::size_t const size)
+    : m_impl(std::make_unique<impl>(size))
+{
+}
+
+idft::idft(idft&&) noexcept = default;
+
+idft::~idft() = default;
+
+auto
+idft::operator=(idft&&) noexcept -> idft& = default;
+
+auto
+idft::size() const noexcept -> std::size_t
+{
+    return m_impl->output_size;
+}
+
+auto
+idft::input_buffer() const noexcept -> std::span<std::complex<float>>
+{
+    return m_impl->in_buffer;
+}
+
+auto
+idft::input_size() const noexcept -> std::size_t
+{
+    return m_impl->input_size;
+}
+
+auto
+idft::process() -> std::span<float const>
+{
+    // c2r transforms destroy their input, which is fine, since the input is
+    // rewritten before every process call anyway.
+    fftwf_execute(m_impl->plan.get());
+    return m_impl->out_buffer;
+}
+
 } // namespace piejam::numeric
@@ -0,0 +1,178 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/persistence/binary_session.h>
+
+#include <piejam/runtime/parameter/assignment.h>
+#include <piejam/runtime/persistence/fx_internal_id.h>
+#include <piejam/runtime/persistence/session.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+using namespace piejam::runtime;
+using namespace piejam::runtime::persistence;
+
+constexpr auto num_fx_per_channel = 4;
+constexpr auto num_parameters_per_fx = 16;
+
+auto
+benchmark_internal_fx() -> fx::internal_id
+{
+    static fx::internal_id const s_id = [] {
+        auto id = fx::internal_id::generate();
+        register_internal_fx(id, "session_benchmark_fx");
+        return id;
+    }();
+    return s_id;
+}
+
+auto
+make_fx_preset() -> fx_preset
+{
+    fx_preset preset;
+    for (unsigned key = 0; key < num_parameters_per_fx; ++key)
+    {
+        preset.push_back({.key = key, .value = static_cast<float>(key)});
+    }
+    return preset;
+}
+
+auto
+make_mixer_channel(std::size_t const index) -> session::mixer_channel
+{
+    session::mixer_channel mc{
+            .name = "channel " + std::to_string(index),
+            .color = material_color::blue,
+            .bus_type = piejam::audio::bus_type::stereo,
+            .parameter = {.volume = 1.f, .pan = 0.f, .mute = false},
+            .midi = {},
+            .fx_chain = {},
+            .in = {.type = session::mixer_io_type::device, .index = index},
+            .out = {.type = session::mixer_io_type::default_, .index = 0},
+            .aux_sends = {}};
+
+    for (auto i = 0; i < num_fx_per_channel; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            mc.fx_chain.emplace_back(session::internal_fx{
+                    .type = benchmark_internal_fx(),
+                    .preset = make_fx_preset(),
+                    .midi = {}});
+        }
+        else
+        {
+            mc.fx_chain.emplace_back(session::ladspa_plugin{
+                    .id = 1000u + static_cast<unsigned>(i),
+                    .name = "ladspa plugin",
+                    .preset = make_fx_preset(),
+                    .midi = {}});
+        }
+    }
+
+    return mc;
+}
+
+auto
+make_session(std::size_t const num_channels) -> session
+{
+    session ses;
+    ses.main_mixer_channel = make_mixer_channel(0);
+    for (std::size_t i = 1; i <= num_channels; ++i)
+    {
+        ses.mixer_channels.push_back(make_mixer_channel(i));
+    }
+    return ses;
+}
+
+auto
+write_file(session const& ses, bool const binary) -> std::filesystem::path
+{
+    auto const file = std::filesystem::temp_directory_path() /
+                      (binary ? "session_benchmark.pjsb"
+                              : "session_benchmark.pjs");
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (binary)
+    {
+        save_binary_session(out, ses);
+    }
+    else
+    {
+        save_session(out, ses);
+    }
+    return file;
+}
+
+} // namespace
+
+static void
+BM_session_save_json(benchmark::State& state)
+{
+    auto const ses = make_session(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        save_session(out, ses);
+        benchmark::DoNotOptimize(out.str().data());
+    }
+}
+
+BENCHMARK(BM_session_save_json)->Arg(64);
+
+static void
+BM_session_save_binary(benchmark::State& state)
+{
+    auto const ses = make_session(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        save_binary_session(out, ses);
+        benchmark::DoNotOptimize(out.str().data());
+    }
+}
+
+BENCHMARK(BM_session_save_binary)->Arg(64);
+
+static void
+BM_session_load_json(benchmark::State& state)
+{
+    auto const file = write_file(
+            make_session(static_cast<std::size_t>(state.range(0))),
+            false);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(load_session(file));
+    }
+
+    std::filesystem::remove(file);
+}
+
+BENCHMARK(BM_session_load_json)->Arg(64);
+
+static void
+BM_session_load_binary(benchmark::State& state)
+{
+    auto const file = write_file(
+            make_session(static_cast<std::size_t>(state.range(0))),
+            true);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(load_session(file));
+    }
+
+    std::filesystem::remove(file);
+}
+
+BENCHMARK(BM_session_load_binary)->Arg(64);
@@ -0,0 +1,22 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/actions/persistence_action.h>
+#include <piejam/runtime/fwd.h>
+#include <piejam/runtime/ui/action.h>
+#include <piejam/runtime/ui/cloneable_action.h>
+
+namespace piejam::runtime::actions
+{
+
+//! Journals the changes to the session since the previous autosave.
+struct autosave_session final
+    : ui::cloneable_action<autosave_session, action>
+    , visitable_persistence_action<autosave_session>
+{
+};
+
+} // namespace piejam::runtime::actions
@@ -76,6 +76,7 @@ struct save_app_config;
 struct apply_app_config;
 struct load_session;
 struct save_session;
+struct autosave_session;
 struct apply_session;
 
 struct start_recording;
@@ -15,7 +15,8 @@ struct persistence_action_visitor
               load_app_config,
               save_app_config,
               load_session,
-              save_session>
+              save_session,
+              autosave_session>
 {
 };
 
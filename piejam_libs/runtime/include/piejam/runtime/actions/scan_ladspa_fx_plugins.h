@@ -11,6 +11,10 @@
 namespace piejam::runtime::actions
 {
 
-auto scan_ladspa_fx_plugins(std::filesystem::path const& dir) -> thunk_action;
+//! The scan results are cached in cache_file, only changed plugin files
+//! are rescanned.
+auto scan_ladspa_fx_plugins(
+        std::filesystem::path const& dir,
+        std::filesystem::path const& cache_file) -> thunk_action;
 
 } // namespace piejam::runtime::actions
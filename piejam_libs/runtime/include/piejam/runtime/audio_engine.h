@@ -6,8 +6,10 @@
 
 #include <piejam/runtime/audio_stream.h>
 #include <piejam/runtime/fwd.h>
+#include <piejam/runtime/fx/fwd.h>
 #include <piejam/runtime/fx/ladspa_processor_factory.h>
 
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/audio/fwd.h>
 #include <piejam/audio/pair.h>
 #include <piejam/audio/pcm_buffer_converter.h>
@@ -16,9 +18,11 @@
 #include <piejam/pimpl.h>
 #include <piejam/thread/fwd.h>
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace piejam::runtime
 {
@@ -47,11 +51,18 @@ public:
     [[nodiscard]]
     auto get_stream(audio_stream_id) const -> audio_stream_buffer;
 
-    [[nodiscard]]
-    auto
-    rebuild(state const&,
+    //! Doesn't wait for the audio thread to pick up the new graph.
+    //! on_active is called from a housekeeping thread, once it is running.
+    void rebuild(
+            state const&,
             fx::simple_ladspa_processor_factory const&,
-            std::unique_ptr<midi::input_event_handler>) -> bool;
+            std::unique_ptr<midi::input_event_handler>,
+            std::function<void()> on_active = {});
+
+    //! Fx modules, whose components couldn't be created by the last
+    //! rebuild, e.g. when the delay line memory is exhausted.
+    [[nodiscard]]
+    auto failed_fx_modules() const -> std::vector<fx::module_id> const&;
 
     void init_process(
             std::span<audio::pcm_input_buffer_converter const>,
@@ -59,6 +70,10 @@ public:
 
     void process(std::size_t buffer_size) noexcept;
 
+    //! Index 0 is the audio thread, the others are the worker threads.
+    [[nodiscard]]
+    auto worker_stats() const -> std::vector<audio::engine::worker_stats>;
+
 private:
     struct impl;
     pimpl<impl> const m_impl;
@@ -4,16 +4,19 @@
 
 #pragma once
 
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/audio/fwd.h>
 #include <piejam/ladspa/fwd.h>
 #include <piejam/runtime/actions/fwd.h>
+#include <piejam/runtime/audio_thread_topology.h>
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/ladspa_processor_factory.h>
-#include <piejam/thread/configuration.h>
 #include <piejam/thread/fwd.h>
 
 #include <boost/container/flat_set.hpp>
 
+#include <chrono>
+#include <filesystem>
 #include <memory>
 #include <span>
 #include <vector>
@@ -25,11 +28,11 @@ class audio_engine_middleware final
 {
 public:
     audio_engine_middleware(
-            thread::configuration const& audio_thread_config,
-            std::span<thread::configuration const> wt_configs,
+            audio_thread_topology auto_thread_topology,
             audio::sound_card_manager&,
             ladspa::processor_factory&,
-            std::unique_ptr<midi_input_controller>);
+            std::unique_ptr<midi_input_controller>,
+            std::filesystem::path xrun_report_dir);
     audio_engine_middleware(audio_engine_middleware&&) noexcept = default;
     ~audio_engine_middleware();
 
@@ -49,19 +52,36 @@ private:
 
     void close_sound_card();
     void open_sound_card(state const&);
-    void start_engine(state const&);
+    void start_engine(middleware_functors const&);
 
-    void rebuild(state const&);
+    void rebuild(middleware_functors const&);
 
-    thread::configuration m_audio_thread_config;
+    void set_thread_topology(audio_thread_topology const&);
+
+    auto wait_for_probes(middleware_functors const&) -> bool;
+
+    void write_xrun_report(std::size_t xruns);
+    auto update_worker_loads() -> std::vector<audio::engine::worker_load>;
+
+    audio_thread_topology m_auto_thread_topology;
+    audio_thread_topology m_thread_topology;
     std::vector<thread::worker> m_workers;
 
     audio::sound_card_manager& m_sound_card_manager;
     ladspa::processor_factory& m_ladspa_processor_factory;
     std::unique_ptr<midi_input_controller> m_midi_controller;
+    std::filesystem::path m_xrun_report_dir;
 
     std::unique_ptr<audio_engine> m_engine;
+    std::size_t m_graph_generation{};
     std::unique_ptr<audio::io_process> m_io_process;
+
+    // Sound card probes finish in the background. Until then, actions are
+    // deferred in order, instead of blocking on the hw_params of a card.
+    std::vector<std::unique_ptr<action>> m_deferred_actions;
+
+    std::vector<audio::engine::worker_stats> m_worker_stats;
+    std::chrono::steady_clock::time_point m_worker_stats_time;
 };
 
 } // namespace piejam::runtime
@@ -0,0 +1,58 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/thread/configuration.h>
+
+#include <span>
+#include <vector>
+
+namespace piejam::runtime
+{
+
+struct audio_thread_config
+{
+    std::vector<int> affinity;
+    int realtime_priority{96};
+
+    auto operator==(audio_thread_config const&) const -> bool = default;
+};
+
+//! Audio threads as configured in the app config. In automatic mode, the
+//! thread configs are ignored and the topology is derived from the system.
+struct audio_threads_config
+{
+    bool automatic{true};
+    audio_thread_config audio_main;
+    std::vector<audio_thread_config> workers;
+
+    auto operator==(audio_threads_config const&) const -> bool = default;
+};
+
+//! The audio main thread, executing the io process, and the worker threads
+//! the dag executor spreads its tasks over.
+struct audio_thread_topology
+{
+    thread::configuration audio_main;
+    std::vector<thread::configuration> workers;
+
+    auto operator==(audio_thread_topology const&) const -> bool = default;
+};
+
+//! Puts the audio main thread and one worker on each of the available cpus.
+//! If there are isolated cpus, only these are used. Otherwise, the ui cpu is
+//! avoided and cpu 0, where the system is serviced, comes last.
+[[nodiscard]]
+auto auto_audio_thread_topology(
+        std::span<int const> online_cpus,
+        std::span<int const> isolated_cpus,
+        int ui_cpu,
+        int realtime_priority) -> audio_thread_topology;
+
+[[nodiscard]]
+auto make_audio_thread_topology(audio_threads_config const&)
+        -> audio_thread_topology;
+
+} // namespace piejam::runtime
@@ -23,6 +23,7 @@ make_fx(fx::module const&,
         fx::simple_ladspa_processor_factory const&,
         parameter_processor_factory&,
         processors::stream_processor_factory&,
+        audio::engine::delay_line_pool&,
         audio::sample_rate,
         std::string_view name = {})
         -> std::unique_ptr<audio::engine::component>;
@@ -23,6 +23,7 @@ struct internal_fx_component_factory_args
     audio::sample_rate sample_rate;
     parameter_processor_factory& param_procs;
     processors::stream_processor_factory& stream_procs;
+    audio::engine::delay_line_pool& delay_lines;
     std::string_view name;
 };
 
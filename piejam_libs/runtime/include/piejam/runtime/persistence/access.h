@@ -6,6 +6,7 @@
 
 #include <piejam/runtime/fwd.h>
 #include <piejam/runtime/fx/fwd.h>
+#include <piejam/runtime/persistence/fwd.h>
 
 #include <filesystem>
 #include <string>
@@ -19,6 +20,10 @@ void save_app_config(
         std::vector<std::string> const& enabled_midi_input_devices,
         state const&);
 
-void save_session(std::filesystem::path const&, state const&);
+//! The persistent part of the state.
+[[nodiscard]]
+auto export_session(state const&) -> session;
+
+auto save_session(std::filesystem::path const&, state const&) -> bool;
 
 } // namespace piejam::runtime::persistence
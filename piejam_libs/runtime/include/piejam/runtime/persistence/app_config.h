@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <piejam/runtime/audio_thread_topology.h>
+
 #include <piejam/audio/period_count.h>
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
@@ -17,12 +19,13 @@
 namespace piejam::runtime::persistence
 {
 
-inline constexpr unsigned current_app_config_version = 0;
+inline constexpr unsigned current_app_config_version = 2;
 
 struct app_config
 {
     std::string input_sound_card;
     std::string output_sound_card;
+    std::vector<std::string> aggregate_input_sound_cards;
     audio::sample_rate sample_rate{};
     audio::period_size period_size{};
     audio::period_count period_count{};
@@ -30,6 +33,8 @@ struct app_config
     std::vector<std::string> enabled_midi_input_devices;
 
     std::size_t rec_session{};
+
+    audio_threads_config audio_threads;
 };
 
 auto load_app_config(std::istream&) -> app_config;
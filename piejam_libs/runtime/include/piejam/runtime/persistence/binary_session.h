@@ -0,0 +1,69 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/persistence/session.h>
+
+#include <piejam/system/mapped_file.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace piejam::runtime::persistence
+{
+
+inline constexpr unsigned current_binary_session_version = 1;
+
+//! Sessions are saved in the binary format, if the file has this extension.
+inline constexpr std::string_view binary_session_extension{".pjsb"};
+
+//! Binary alternative to the JSON session format. The fx chains, which
+//! make up the bulk of a session, are stored in sections of their own.
+void save_binary_session(std::ostream&, session const&);
+
+//! Sections of the binary format. The session section contains everything
+//! but the fx chains of the mixer channels. Decoding throws
+//! std::runtime_error on invalid data.
+[[nodiscard]]
+auto encode_session_section(session const&) -> std::vector<std::byte>;
+[[nodiscard]]
+auto encode_fx_chain_section(session::fx_chain_t const&)
+        -> std::vector<std::byte>;
+[[nodiscard]]
+auto decode_session_section(std::span<std::byte const>) -> session;
+[[nodiscard]]
+auto decode_fx_chain_section(std::span<std::byte const>)
+        -> session::fx_chain_t;
+
+//! Checks the magic only, without validating the file.
+[[nodiscard]]
+auto is_binary_session(std::filesystem::path const&) -> bool;
+
+//! A binary session file, mapped into memory. The section table is
+//! validated on opening, throws std::runtime_error if it's invalid. The
+//! sections are decoded by load.
+class binary_session_file
+{
+public:
+    explicit binary_session_file(std::filesystem::path const&);
+
+    [[nodiscard]]
+    auto load() const -> session;
+
+private:
+    system::mapped_file m_file;
+    std::span<std::byte const> m_session;
+    //! Including the main mixer channel, which comes first.
+    std::vector<std::span<std::byte const>> m_fx_chains;
+};
+
+//! Detects the format of the file.
+auto load_session(std::filesystem::path const&) -> session;
+
+} // namespace piejam::runtime::persistence
@@ -10,4 +10,6 @@ namespace piejam::runtime::persistence
 struct app_config;
 struct session;
 
+class session_journal;
+
 } // namespace piejam::runtime::persistence
@@ -8,6 +8,8 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <string>
+
 namespace piejam::runtime::fx
 {
 
@@ -21,4 +23,13 @@ namespace piejam::runtime::persistence
 
 void register_internal_fx(fx::internal_id, std::string name);
 
+//! Persistent name of a registered internal fx.
+[[nodiscard]]
+auto internal_fx_name(fx::internal_id) -> std::string const&;
+
+//! Registered internal fx by its persistent name, a default constructed id
+//! if there is none.
+[[nodiscard]]
+auto find_internal_fx(std::string const& name) -> fx::internal_id;
+
 } // namespace piejam::runtime::persistence
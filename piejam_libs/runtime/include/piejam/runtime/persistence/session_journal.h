@@ -0,0 +1,126 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/runtime/persistence/session.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace piejam::runtime::persistence
+{
+
+//! Autosave of the session in between explicit saves. Each append writes
+//! the sections of the binary session format, which changed since the
+//! previous append, as checksummed records to an append-only journal.
+//! Once the journal grows beyond the compaction threshold, it is folded
+//! into a snapshot. Writing, syncing and compacting is done on a
+//! background thread.
+class session_journal
+{
+public:
+    static constexpr std::size_t default_compaction_threshold = 1 << 20;
+
+    explicit session_journal(
+            std::filesystem::path dir,
+            std::size_t compaction_threshold = default_compaction_threshold);
+    session_journal(session_journal const&) = delete;
+    session_journal(session_journal&&) = delete;
+
+    ~session_journal();
+
+    auto operator=(session_journal const&) -> session_journal& = delete;
+    auto operator=(session_journal&&) -> session_journal& = delete;
+
+    //! The snapshot with the journal replayed on top of it. A torn record
+    //! at the end of the journal is dropped. Subsequent appends continue
+    //! the recovered journal.
+    [[nodiscard]]
+    auto recover() -> std::optional<session>;
+
+    //! Returns the number of records, i.e. changed sections, appended.
+    auto append(session const&) -> std::size_t;
+
+    //! Discards the autosave, e.g. after the session was saved explicitly.
+    void clear();
+
+    //! Blocks until all appends are written and synced.
+    void flush();
+
+private:
+    enum class record_type : std::uint32_t
+    {
+        session,
+        fx_chain,
+    };
+
+    //! The session section replaces the session and resizes the fx chains
+    //! to index, the number of mixer channels. The fx chain section
+    //! replaces the fx chain of the mixer channel at index.
+    struct record
+    {
+        record_type type;
+        std::uint32_t index;
+        std::vector<std::byte> payload;
+    };
+
+    struct sections
+    {
+        std::vector<std::byte> session;
+        std::vector<std::vector<std::byte>> fx_chains;
+    };
+
+    [[nodiscard]]
+    static auto apply(
+            sections&,
+            record_type,
+            std::uint32_t index,
+            std::span<std::byte const> payload) -> bool;
+
+    [[nodiscard]]
+    static auto encode(session const&) -> sections;
+
+    //! Throws std::runtime_error, if the sections are invalid.
+    [[nodiscard]]
+    static auto decode(sections const&) -> session;
+
+    void post(std::function<void()>);
+
+    // executed on the background thread
+    void write(std::vector<record> const&);
+    void open_journal(bool with_image);
+    void close_journal() noexcept;
+    void compact();
+    void reset();
+
+    std::filesystem::path m_dir;
+    std::size_t m_compaction_threshold;
+
+    // state of the last append
+    sections m_sections;
+
+    // state of the journal, accessed from the background thread only
+    sections m_image;
+    int m_fd{-1};
+    std::size_t m_journal_size{};
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_cv;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_busy{};
+
+    std::jthread m_thread;
+};
+
+} // namespace piejam::runtime::persistence
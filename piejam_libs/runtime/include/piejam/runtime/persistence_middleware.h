@@ -6,17 +6,28 @@
 
 #include <piejam/runtime/fwd.h>
 
+#include <piejam/pimpl.h>
+
+#include <filesystem>
+
 namespace piejam::runtime
 {
 
 class persistence_middleware
 {
 public:
+    //! The session is autosaved to a journal in autosave_dir, which is
+    //! recovered on the first load of a session.
+    explicit persistence_middleware(std::filesystem::path autosave_dir);
+
     void operator()(middleware_functors const&, action const&);
 
 private:
     template <class Action>
     void process_persistence_action(middleware_functors const&, Action const&);
+
+    struct impl;
+    pimpl<impl> m_impl;
 };
 
 } // namespace piejam::runtime
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <piejam/audio/engine/fwd.h>
+#include <piejam/audio/fwd.h>
 #include <piejam/midi/fwd.h>
 
 #include <memory>
@@ -12,7 +13,9 @@
 namespace piejam::runtime::processors
 {
 
-auto make_midi_input_processor(std::unique_ptr<midi::input_event_handler>)
+auto make_midi_input_processor(
+        std::unique_ptr<midi::input_event_handler>,
+        audio::sample_rate)
         -> std::unique_ptr<audio::engine::processor>;
 
 } // namespace piejam::runtime::processors
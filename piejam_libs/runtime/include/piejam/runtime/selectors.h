@@ -13,6 +13,7 @@
 #include <piejam/runtime/parameters.h>
 #include <piejam/runtime/string_id.h>
 
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/audio/period_count.h>
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
@@ -166,6 +167,7 @@ auto make_fx_module_name_selector(fx::module_id) -> selector<boxed_string>;
 auto make_fx_module_bus_type_selector(fx::module_id)
         -> selector<audio::bus_type>;
 auto make_fx_module_bypass_selector(fx::module_id) -> selector<bool>;
+auto make_fx_module_failed_selector(fx::module_id) -> selector<bool>;
 auto make_fx_module_parameters_selector(fx::module_id)
         -> selector<box<fx::module_parameters>>;
 auto make_fx_module_can_move_up_selector(mixer::channel_id) -> selector<bool>;
@@ -200,7 +202,12 @@ extern selector<fx::registry> const select_fx_registry;
 extern selector<bool> const select_recording;
 
 extern selector<std::size_t> const select_xruns;
+extern selector<std::size_t> const select_rt_allocations;
+//! Additional capture devices, which couldn't be opened.
+extern selector<std::size_t> const select_num_failed_aggregate_inputs;
 extern selector<float> const select_cpu_load;
+extern selector<boxed_vector<audio::engine::worker_load>> const
+        select_worker_loads;
 
 extern selector<root_view_mode> const select_root_view_mode;
 extern selector<mixer::channel_id> const select_fx_browser_fx_chain;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <piejam/runtime/audio_stream.h>
+#include <piejam/runtime/audio_thread_topology.h>
 #include <piejam/runtime/channel_index_pair.h>
 #include <piejam/runtime/external_audio.h>
 #include <piejam/runtime/fx/ladspa_instances.h>
@@ -26,6 +27,8 @@
 #include <piejam/runtime/selected_sound_card.h>
 #include <piejam/runtime/string_id.h>
 
+#include <piejam/audio/aggregate_input_stats.h>
+#include <piejam/audio/engine/worker_telemetry.h>
 #include <piejam/audio/period_count.h>
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
@@ -54,8 +57,15 @@ struct state
     strings_t strings;
 
     audio::io_sound_cards io_sound_cards;
+    //! Capabilities of all sound cards, parallel to io_sound_cards. Filled in
+    //! once the cards are probed.
+    io_pair<boxed_vector<audio::sound_card_hw_params>> io_sound_card_hw_params;
     io_pair<selected_sound_card> selected_io_sound_card;
 
+    //! Additional capture devices, their channels follow the channels of the
+    //! selected input sound card.
+    boxed_vector<selected_sound_card> aggregate_input_sound_cards;
+
     audio::sample_rate sample_rate{};
     audio::period_size period_size{};
     audio::period_count period_count{};
@@ -74,6 +84,9 @@ struct state
     fx::ladspa_instances fx_ladspa_instances;
     fx::unavailable_ladspa_plugins fx_unavailable_ladspa_plugins;
 
+    //! Fx modules without audio components, reported by the audio engine.
+    boxed_vector<fx::module_id> failed_fx_modules;
+
     mixer::state mixer_state{};
 
     box<midi_assignments_map> midi_assignments;
@@ -83,8 +96,17 @@ struct state
     std::size_t rec_session{};
     std::size_t rec_take{};
 
+    audio_threads_config audio_threads;
+
     std::size_t xruns{};
     float cpu_load{};
+    std::size_t rt_allocations{};
+    boxed_vector<audio::engine::worker_load> worker_loads;
+    boxed_vector<audio::aggregate_input_stats> aggregate_input_stats;
+
+    //! Rebuilds of the audio graph are asynchronous, this is the last one
+    //! which became active.
+    std::size_t active_graph_generation{};
 
     struct
     {
@@ -119,6 +141,9 @@ auto period_counts(
         -> audio::period_counts_t;
 auto period_counts_from_state(state const&) -> audio::period_counts_t;
 
+//! Channels of the selected input sound card and the aggregate inputs.
+auto num_input_channels(state const&) -> std::size_t;
+
 auto add_external_audio_device(
         state&,
         std::string const& name,
@@ -0,0 +1,184 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/system/mapped_file.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace piejam::runtime
+{
+
+//! Min/max of all samples of one channel within one bucket, quantized to
+//! 16 bit. The quantization rounds outwards, so peaks are never hidden.
+struct waveform_overview_peak
+{
+    std::int16_t min{};
+    std::int16_t max{};
+
+    auto operator==(waveform_overview_peak const&) const noexcept
+            -> bool = default;
+};
+
+//! Incrementally builds a min/max pyramid over an interleaved sample stream.
+//! Every level folds the buckets of the previous one, so each sample is
+//! visited only once, regardless of the number of levels.
+class waveform_overview_builder
+{
+public:
+    static constexpr std::size_t default_bucket_sizes[]{64, 512, 4096};
+
+    explicit waveform_overview_builder(
+            std::size_t num_channels,
+            std::span<std::size_t const> bucket_sizes = default_bucket_sizes);
+
+    void process(std::span<float const> interleaved);
+
+    //! Emits the partially filled trailing buckets.
+    void flush();
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_num_channels;
+    }
+
+    [[nodiscard]]
+    auto num_frames() const noexcept -> std::uint64_t
+    {
+        return m_num_frames;
+    }
+
+    [[nodiscard]]
+    auto num_levels() const noexcept -> std::size_t
+    {
+        return m_levels.size();
+    }
+
+    [[nodiscard]]
+    auto samples_per_bucket(std::size_t level) const noexcept -> std::size_t
+    {
+        return m_levels[level].samples_per_bucket;
+    }
+
+    //! Peaks of a level, bucket-major with interleaved channels.
+    [[nodiscard]]
+    auto peaks(std::size_t level) const noexcept
+            -> std::span<waveform_overview_peak const>
+    {
+        return m_levels[level].peaks;
+    }
+
+private:
+    struct level
+    {
+        std::size_t samples_per_bucket{};
+        std::size_t fold_factor{};
+        std::size_t acc_count{};
+        std::vector<waveform_overview_peak> acc;
+        std::vector<waveform_overview_peak> peaks;
+    };
+
+    void emit_first_level();
+    void emit(std::size_t level_index);
+    void push_peaks(
+            std::size_t level_index,
+            std::span<waveform_overview_peak const> frame_peaks);
+
+    std::size_t m_num_channels;
+    std::uint64_t m_num_frames{};
+
+    std::size_t m_acc_count{};
+    std::vector<float> m_acc_min;
+    std::vector<float> m_acc_max;
+    std::vector<waveform_overview_peak> m_frame_peaks;
+
+    std::vector<level> m_levels;
+};
+
+//! Writes the pyramid as a sidecar file, meant to be mapped into memory by
+//! waveform_overview_file. Returns false on failure.
+[[nodiscard]]
+auto write_waveform_overview(
+        std::filesystem::path const& file,
+        waveform_overview_builder const&,
+        unsigned sample_rate) -> bool;
+
+//! Sidecar file location for a recorded take.
+[[nodiscard]]
+auto waveform_overview_path(std::filesystem::path const& audio_file)
+        -> std::filesystem::path;
+
+//! Read-only, memory-mapped view of a waveform overview sidecar file.
+class waveform_overview_file
+{
+public:
+    explicit waveform_overview_file(std::filesystem::path const& file);
+
+    explicit operator bool() const noexcept
+    {
+        return !m_levels.empty();
+    }
+
+    [[nodiscard]]
+    auto sample_rate() const noexcept -> unsigned
+    {
+        return m_sample_rate;
+    }
+
+    [[nodiscard]]
+    auto num_channels() const noexcept -> std::size_t
+    {
+        return m_num_channels;
+    }
+
+    [[nodiscard]]
+    auto num_frames() const noexcept -> std::uint64_t
+    {
+        return m_num_frames;
+    }
+
+    [[nodiscard]]
+    auto num_levels() const noexcept -> std::size_t
+    {
+        return m_levels.size();
+    }
+
+    [[nodiscard]]
+    auto samples_per_bucket(std::size_t level) const noexcept -> std::size_t
+    {
+        return m_levels[level].samples_per_bucket;
+    }
+
+    [[nodiscard]]
+    auto peaks(std::size_t level) const noexcept
+            -> std::span<waveform_overview_peak const>
+    {
+        return m_levels[level].peaks;
+    }
+
+    //! Coarsest level whose buckets don't exceed samples_per_pixel.
+    [[nodiscard]]
+    auto select_level(std::size_t samples_per_pixel) const noexcept
+            -> std::size_t;
+
+private:
+    struct level
+    {
+        std::size_t samples_per_bucket{};
+        std::span<waveform_overview_peak const> peaks;
+    };
+
+    system::mapped_file m_file;
+    unsigned m_sample_rate{};
+    std::size_t m_num_channels{};
+    std::uint64_t m_num_frames{};
+    std::vector<level> m_levels;
+};
+
+} // namespace piejam::runtime
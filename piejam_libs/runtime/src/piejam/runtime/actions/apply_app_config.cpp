@@ -13,6 +13,7 @@ void
 apply_app_config::reduce(state& st) const
 {
     st.rec_session = conf.rec_session;
+    st.audio_threads = conf.audio_threads;
 }
 
 } // namespace piejam::runtime::actions
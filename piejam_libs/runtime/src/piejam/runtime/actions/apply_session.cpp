@@ -209,7 +209,7 @@ apply_session::reduce(state& st) const
     apply_external_audio_device_configs<io_direction::input>(
             st,
             session->external_audio_input_devices,
-            st.selected_io_sound_card.in.hw_params->num_channels);
+            num_input_channels(st));
 
     apply_external_audio_device_configs<io_direction::output>(
             st,
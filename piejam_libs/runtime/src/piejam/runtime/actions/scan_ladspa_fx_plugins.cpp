@@ -5,6 +5,7 @@
 #include <piejam/runtime/actions/scan_ladspa_fx_plugins.h>
 
 #include <piejam/ladspa/scan.h>
+#include <piejam/ladspa/scan_cache.h>
 #include <piejam/runtime/actions/finalize_ladspa_fx_plugin_scan.h>
 #include <piejam/runtime/actions/reload_missing_plugins.h>
 #include <piejam/runtime/state.h>
@@ -16,14 +17,20 @@ namespace piejam::runtime::actions
 {
 
 auto
-scan_ladspa_fx_plugins(std::filesystem::path const& dir) -> thunk_action
+scan_ladspa_fx_plugins(
+        std::filesystem::path const& dir,
+        std::filesystem::path const& cache_file) -> thunk_action
 {
-    return [dir](auto&&, auto&& dispatch) {
+    return [dir, cache_file](auto&&, auto&& dispatch) {
         std::thread([=]() {
+            auto cache = ladspa::scan_cache::load(cache_file);
+
             actions::finalize_ladspa_fx_plugin_scan action;
-            action.plugins = ladspa::scan_directory(dir);
+            action.plugins = ladspa::scan_directory(dir, cache);
             dispatch(action);
 
+            cache.save(cache_file);
+
             dispatch(runtime::actions::reload_missing_plugins());
         }).detach();
     };
@@ -28,6 +28,7 @@
 #include <piejam/audio/engine/component.h>
 #include <piejam/audio/engine/dag.h>
 #include <piejam/audio/engine/dag_executor.h>
+#include <piejam/audio/engine/delay_line_pool.h>
 #include <piejam/audio/engine/graph.h>
 #include <piejam/audio/engine/graph_algorithms.h>
 #include <piejam/audio/engine/graph_generic_algorithms.h>
@@ -44,6 +45,7 @@
 #include <piejam/range/indices.h>
 #include <piejam/range/iota.h>
 #include <piejam/thread/configuration.h>
+#include <piejam/thread/name.h>
 #include <piejam/thread/worker.h>
 
 #include <fmt/format.h>
@@ -52,9 +54,14 @@
 #include <boost/range/algorithm_ext/erase.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <stop_token>
+#include <thread>
 
 namespace piejam::runtime
 {
@@ -201,8 +208,10 @@ make_fx_chain_components(
         parameters_map const& params,
         parameter_processor_factory& param_procs,
         processors::stream_processor_factory& stream_procs,
+        audio::engine::delay_line_pool& delay_lines,
         fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
-        audio::sample_rate const sample_rate)
+        audio::sample_rate const sample_rate,
+        std::vector<fx::module_id>& failed_fx_modules)
 {
     auto get_fx_param_name =
             [&params](parameter_id param_id) -> std::string_view {
@@ -232,11 +241,17 @@ make_fx_chain_components(
                     ladspa_fx_proc_factory,
                     param_procs,
                     stream_procs,
+                    delay_lines,
                     sample_rate);
             if (comp)
             {
                 comps.insert(fx_mod_id, std::move(comp));
             }
+            else if (!std::holds_alternative<fx::unavailable_ladspa_id>(
+                             fx_mod.fx_instance_id))
+            {
+                failed_fx_modules.push_back(fx_mod_id);
+            }
         }
     }
 }
@@ -244,6 +259,7 @@ make_fx_chain_components(
 auto
 make_midi_processors(
         std::unique_ptr<midi::input_event_handler> midi_in,
+        audio::sample_rate const sample_rate,
         bool const midi_learning,
         processor_map& procs)
 {
@@ -251,7 +267,9 @@ make_midi_processors(
     {
         procs.insert(
                 engine_processors::midi_input,
-                processors::make_midi_input_processor(std::move(midi_in)));
+                processors::make_midi_input_processor(
+                        std::move(midi_in),
+                        sample_rate));
 
         if (midi_learning)
         {
@@ -649,6 +667,25 @@ make_io_processors(std::size_t const num_channels)
             [](std::size_t const i) { return Processor(std::to_string(i)); });
 }
 
+// Everything a dag executor refers to. Kept alive by the process, until the
+// executor is reclaimed.
+struct graph_resources
+{
+    audio::engine::graph graph;
+
+    std::vector<processor_ptr> output_clip_procs;
+    std::vector<processor_ptr> mixer_procs;
+    value_io_processor_ptr<midi::external_event> midi_learn_output_proc;
+
+    processor_map procs;
+    component_map comps;
+};
+
+constexpr std::chrono::milliseconds reclaim_interval{20};
+
+// Memory shared by the delay lines of all fx, 16 MiB.
+constexpr std::size_t delay_line_pool_blocks = 1024;
+
 } // namespace
 
 struct audio_engine::impl
@@ -659,34 +696,57 @@ struct audio_engine::impl
          std::size_t num_device_output_channels)
         : sample_rate(sr)
         , worker_threads(workers)
+        , worker_telemetry(workers.size() + 1)
         , input_procs(make_io_processors<audio::engine::input_processor>(
                   num_device_input_channels))
         , output_procs(make_io_processors<audio::engine::output_processor>(
                   num_device_output_channels))
-        , output_clip_procs(
-                  std::vector<processor_ptr>(num_device_output_channels))
+        , current(std::make_shared<graph_resources>())
+        , reclaimer([this](std::stop_token stoken) { reclaim(stoken); })
+    {
+        current->output_clip_procs.resize(num_device_output_channels);
+    }
+
+    void reclaim(std::stop_token const& stoken)
     {
+        this_thread::set_name("audio_reclaim");
+
+        std::mutex mutex;
+        std::condition_variable_any cv;
+        std::unique_lock lock(mutex);
+
+        while (!stoken.stop_requested())
+        {
+            cv.wait_for(lock, stoken, reclaim_interval, []() {
+                return false;
+            });
+
+            process.reclaim();
+        }
     }
 
     audio::sample_rate sample_rate;
 
+    // declared before anything holding components, to outlive their
+    // delay line buffers
+    audio::engine::delay_line_pool delay_lines{delay_line_pool_blocks};
+
     audio::engine::process process;
     std::span<thread::worker> worker_threads;
+    audio::engine::worker_telemetry worker_telemetry;
 
     std::vector<audio::engine::input_processor> input_procs;
     std::vector<audio::engine::output_processor> output_procs;
 
-    std::vector<processor_ptr> output_clip_procs;
-    std::vector<processor_ptr> mixer_procs;
-    value_io_processor_ptr<midi::external_event> midi_learn_output_proc;
-
-    processor_map procs;
-    component_map comps;
-
     parameter_processor_factory param_procs;
     processors::stream_processor_factory stream_procs;
 
-    audio::engine::graph graph;
+    std::shared_ptr<graph_resources> current;
+
+    std::vector<fx::module_id> failed_fx_modules;
+
+    // declared last, to be stopped first
+    std::jthread reclaimer;
 };
 
 audio_engine::audio_engine(
@@ -747,9 +807,9 @@ audio_engine::get_learned_midi() const -> std::optional<midi::external_event>
 {
     std::optional<midi::external_event> result;
 
-    if (m_impl->midi_learn_output_proc)
+    if (m_impl->current->midi_learn_output_proc)
     {
-        m_impl->midi_learn_output_proc->consume(
+        m_impl->current->midi_learn_output_proc->consume(
                 [&result](midi::external_event const& ev) { result = ev; });
     }
 
@@ -767,17 +827,21 @@ audio_engine::get_stream(audio_stream_id const id) const -> audio_stream_buffer
     return audio_stream_buffer{};
 }
 
-bool
+void
 audio_engine::rebuild(
         state const& st,
         fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
-        std::unique_ptr<midi::input_event_handler> midi_in)
+        std::unique_ptr<midi::input_event_handler> midi_in,
+        std::function<void()> on_active)
 {
+    graph_resources& prev = *m_impl->current;
+
     component_map comps;
+    m_impl->failed_fx_modules.clear();
 
     make_mixer_components(
             comps,
-            m_impl->comps,
+            prev.comps,
             m_impl->sample_rate,
             st.strings,
             st.mixer_state.channels,
@@ -785,32 +849,38 @@ audio_engine::rebuild(
             m_impl->stream_procs);
     make_fx_chain_components(
             comps,
-            m_impl->comps,
+            prev.comps,
             st.fx_modules,
             st.params,
             m_impl->param_procs,
             m_impl->stream_procs,
+            m_impl->delay_lines,
             ladspa_fx_proc_factory,
-            m_impl->sample_rate);
+            m_impl->sample_rate,
+            m_impl->failed_fx_modules);
     auto const solo_groups = runtime::solo_groups(st.mixer_state.channels);
     make_solo_group_components(comps, solo_groups, m_impl->param_procs);
 
     processor_map procs;
 
     bool const midi_learn = static_cast<bool>(st.midi_learning);
-    make_midi_processors(std::move(midi_in), midi_learn, procs);
+    make_midi_processors(
+            std::move(midi_in),
+            m_impl->sample_rate,
+            midi_learn,
+            procs);
     make_midi_assignment_processors(
             st.midi_assignments,
             st.params,
             procs,
-            m_impl->procs);
+            prev.procs);
     auto midi_learn_output_proc =
             midi_learn ? std::make_unique<audio::engine::value_io_processor<
                                  midi::external_event>>("midi_learned")
                        : nullptr;
 
     std::vector<processor_ptr> output_clip_procs(
-            m_impl->output_clip_procs.size());
+            prev.output_clip_procs.size());
 
     auto new_graph = make_graph(
             comps,
@@ -836,19 +906,25 @@ audio_engine::rebuild(
         return desc ? std::optional{desc->value.get()} : std::nullopt;
     });
 
-    if (!m_impl->process.swap_executor(
-                audio::engine::graph_to_dag(final_graph)
-                        .make_runnable(m_impl->worker_threads)))
-    {
-        return false;
-    }
-
-    m_impl->graph = std::move(final_graph);
-    m_impl->output_clip_procs = std::move(output_clip_procs);
-    m_impl->mixer_procs = std::move(mixers);
-    m_impl->midi_learn_output_proc = std::move(midi_learn_output_proc);
-    m_impl->procs = std::move(procs);
-    m_impl->comps = std::move(comps);
+    auto executor = audio::engine::graph_to_dag(final_graph)
+                            .make_runnable(
+                                    m_impl->worker_threads,
+                                    audio::engine::dag::
+                                            default_event_memory_size,
+                                    &m_impl->worker_telemetry);
+
+    m_impl->current = std::make_shared<graph_resources>(
+            std::move(final_graph),
+            std::move(output_clip_procs),
+            std::move(mixers),
+            std::move(midi_learn_output_proc),
+            std::move(procs),
+            std::move(comps));
+
+    m_impl->process.swap_executor(
+            std::move(executor),
+            m_impl->current,
+            std::move(on_active));
 
     m_impl->param_procs.clear_expired();
     m_impl->stream_procs.clear_expired();
@@ -860,10 +936,15 @@ audio_engine::rebuild(
 
     {
         std::ofstream os("final_graph.dot");
-        audio::engine::export_graph_as_dot(m_impl->graph, os) << std::endl;
+        audio::engine::export_graph_as_dot(m_impl->current->graph, os)
+                << std::endl;
     }
+}
 
-    return true;
+auto
+audio_engine::failed_fx_modules() const -> std::vector<fx::module_id> const&
+{
+    return m_impl->failed_fx_modules;
 }
 
 void
@@ -890,4 +971,10 @@ audio_engine::process(std::size_t const buffer_size) noexcept
     m_impl->process(buffer_size);
 }
 
+auto
+audio_engine::worker_stats() const -> std::vector<audio::engine::worker_stats>
+{
+    return m_impl->worker_telemetry.stats();
+}
+
 } // namespace piejam::runtime
@@ -18,6 +18,7 @@
 #include <piejam/runtime/actions/mixer_actions.h>
 #include <piejam/runtime/actions/move_fx_module.h>
 #include <piejam/runtime/actions/recording.h>
+#include <piejam/runtime/actions/refresh_sound_cards.h>
 #include <piejam/runtime/actions/select_period_count.h>
 #include <piejam/runtime/actions/select_period_size.h>
 #include <piejam/runtime/actions/select_sample_rate.h>
@@ -28,14 +29,17 @@
 #include <piejam/runtime/midi_input_controller.h>
 #include <piejam/runtime/state.h>
 
+#include <piejam/algorithm/contains.h>
 #include <piejam/algorithm/find_or_get_first.h>
 #include <piejam/algorithm/for_each_visit.h>
 #include <piejam/algorithm/index_of.h>
 #include <piejam/algorithm/transform_to_vector.h>
+#include <piejam/audio/alloc_debug.h>
 #include <piejam/audio/engine/processor.h>
 #include <piejam/audio/io_process.h>
 #include <piejam/audio/io_process_config.h>
 #include <piejam/audio/multichannel_buffer.h>
+#include <piejam/audio/period_timing.h>
 #include <piejam/audio/sound_card_descriptor.h>
 #include <piejam/audio/sound_card_hw_params.h>
 #include <piejam/audio/sound_card_manager.h>
@@ -50,12 +54,19 @@
 #include <piejam/thread/worker.h>
 #include <piejam/tuple_element_compare.h>
 
+#include <fmt/format.h>
+
 #include <spdlog/spdlog.h>
 
 #include <boost/assert.hpp>
 #include <boost/mp11/tuple.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <utility>
+
 namespace piejam::runtime
 {
 
@@ -69,6 +80,7 @@ struct update_devices final
 
     selected_sound_card input;
     selected_sound_card output;
+    boxed_vector<selected_sound_card> aggregate_inputs;
 
     audio::sample_rate sample_rate{};
     audio::period_size period_size{};
@@ -79,6 +91,7 @@ struct update_devices final
         st.io_sound_cards = io_sound_cards;
         st.selected_io_sound_card.in = input;
         st.selected_io_sound_card.out = output;
+        st.aggregate_input_sound_cards = aggregate_inputs;
         st.sample_rate = sample_rate;
         st.period_size = period_size;
         st.period_count = period_count;
@@ -96,7 +109,7 @@ struct update_devices final
         };
 
         update_channels(
-                input.hw_params->num_channels,
+                num_input_channels(st),
                 *st.external_audio_state.inputs);
 
         update_channels(
@@ -109,29 +122,121 @@ struct update_info final : ui::cloneable_action<update_info, reducible_action>
 {
     std::size_t xruns{};
     float cpu_load{};
+    std::size_t rt_allocations{};
+    std::vector<audio::engine::worker_load> worker_loads;
+    std::vector<audio::aggregate_input_stats> aggregate_input_stats;
+    std::vector<fx::module_id> failed_fx_modules;
 
     void reduce(state& st) const override
     {
         st.xruns = xruns;
         st.cpu_load = cpu_load;
+        st.rt_allocations = rt_allocations;
+        st.worker_loads = worker_loads;
+        st.aggregate_input_stats = aggregate_input_stats;
+
+        if (*st.failed_fx_modules != failed_fx_modules)
+        {
+            st.failed_fx_modules = failed_fx_modules;
+        }
     }
 };
 
+// Dispatched from the housekeeping thread of the process, once a rebuilt
+// graph is running.
+struct update_active_graph final
+    : ui::cloneable_action<update_active_graph, reducible_action>
+{
+    std::size_t generation{};
+
+    void reduce(state& st) const override
+    {
+        st.active_graph_generation =
+                std::max(st.active_graph_generation, generation);
+    }
+};
+
+// The probed capabilities of all sound cards, parallel to the descriptors.
+struct update_sound_card_hw_params final
+    : ui::cloneable_action<update_sound_card_hw_params, reducible_action>
+{
+    piejam::audio::io_sound_cards io_sound_cards;
+    io_pair<boxed_vector<audio::sound_card_hw_params>> hw_params;
+
+    void reduce(state& st) const override
+    {
+        // the cards might have changed since the capabilities were gathered
+        if (st.io_sound_cards == io_sound_cards)
+        {
+            st.io_sound_card_hw_params = hw_params;
+        }
+    }
+};
+
+// Dispatched once the sound cards are probed, to process the deferred
+// actions.
+struct sound_cards_probed final
+    : ui::cloneable_action<sound_cards_probed, action>
+{
+};
+
+// Only the most recent xrun reports are kept, so an xrun storm can't fill
+// up the disk.
+constexpr std::size_t max_xrun_reports{32};
+
+void
+remove_old_xrun_reports(std::filesystem::path const& dir)
+{
+    std::error_code ec;
+    std::vector<std::filesystem::directory_entry> reports;
+    for (auto const& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        auto const name = entry.path().filename().string();
+        if (entry.is_regular_file(ec) && name.starts_with("xrun_") &&
+            entry.path().extension() == ".pjpt")
+        {
+            reports.push_back(entry);
+        }
+    }
+
+    if (reports.size() <= max_xrun_reports)
+    {
+        return;
+    }
+
+    auto const last_write_time = [&ec](auto const& entry) {
+        return entry.last_write_time(ec);
+    };
+
+    std::ranges::sort(reports, std::less<>{}, last_write_time);
+
+    std::for_each(
+            reports.begin(),
+            std::prev(reports.end(), max_xrun_reports),
+            [&ec](auto const& entry) {
+                std::filesystem::remove(entry.path(), ec);
+            });
+}
+
 } // namespace
 
 audio_engine_middleware::audio_engine_middleware(
-        thread::configuration const& audio_thread_config,
-        std::span<thread::configuration const> const wt_configs,
+        audio_thread_topology auto_thread_topology,
         audio::sound_card_manager& sound_card_manager,
         ladspa::processor_factory& ladspa_processor_factory,
-        std::unique_ptr<midi_input_controller> midi_controller)
-    : m_audio_thread_config(audio_thread_config)
-    , m_workers(wt_configs.begin(), wt_configs.end())
+        std::unique_ptr<midi_input_controller> midi_controller,
+        std::filesystem::path xrun_report_dir)
+    : m_auto_thread_topology(std::move(auto_thread_topology))
+    , m_thread_topology(m_auto_thread_topology)
+    , m_workers(
+              m_thread_topology.workers.begin(),
+              m_thread_topology.workers.end())
     , m_sound_card_manager(sound_card_manager)
     , m_ladspa_processor_factory(ladspa_processor_factory)
     , m_midi_controller(
               midi_controller ? std::move(midi_controller)
                               : make_dummy_midi_input_controller())
+    , m_xrun_report_dir(std::move(xrun_report_dir))
     , m_io_process(audio::make_dummy_io_process())
 {
 }
@@ -147,6 +252,78 @@ audio_engine_middleware::process_device_action(
     mw_fs.next(a);
 }
 
+static auto
+aggregate_input_indices(state const& st) -> std::vector<std::size_t>
+{
+    return algorithm::transform_to_vector(
+            *st.aggregate_input_sound_cards,
+            &selected_sound_card::index);
+}
+
+// Aggregate inputs are resampled to the clock of the selected sound cards,
+// they run at the nearest sample rate and period size they support.
+static auto
+aggregate_input_hw_params(
+        audio::sound_card_manager& device_manager,
+        audio::sound_card_descriptor const& device,
+        audio::sample_rate const sample_rate,
+        audio::period_size const period_size) -> audio::sound_card_hw_params
+{
+    auto hw_params = device_manager.hw_params(device, nullptr, nullptr);
+    if (hw_params.sample_rates.empty())
+    {
+        return {};
+    }
+
+    auto const device_sample_rate =
+            *algorithm::find_or_get_first(hw_params.sample_rates, sample_rate);
+    hw_params = device_manager.hw_params(device, &device_sample_rate, nullptr);
+    if (hw_params.period_sizes.empty())
+    {
+        return {};
+    }
+
+    auto const device_period_size =
+            *algorithm::find_or_get_first(hw_params.period_sizes, period_size);
+    return device_manager.hw_params(
+            device,
+            &device_sample_rate,
+            &device_period_size);
+}
+
+static auto
+make_update_sound_card_hw_params_action(
+        audio::sound_card_manager& device_manager,
+        audio::io_sound_cards const& devices) -> update_sound_card_hw_params
+{
+    auto all_hw_params = [&](auto const& descriptors) {
+        return boxed_vector<audio::sound_card_hw_params>(
+                algorithm::transform_to_vector(
+                        descriptors,
+                        [&](audio::sound_card_descriptor const& d) {
+                            try
+                            {
+                                return device_manager
+                                        .hw_params(d, nullptr, nullptr);
+                            }
+                            catch (std::exception const& err)
+                            {
+                                spdlog::warn(
+                                        "could not probe sound card {}: {}",
+                                        d.name,
+                                        err.what());
+                                return audio::sound_card_hw_params{};
+                            }
+                        }));
+    };
+
+    update_sound_card_hw_params next_action;
+    next_action.io_sound_cards = devices;
+    next_action.hw_params.in = all_hw_params(devices.in.get());
+    next_action.hw_params.out = all_hw_params(devices.out.get());
+    return next_action;
+}
+
 static auto
 make_update_devices_action(
         audio::sound_card_manager& device_manager,
@@ -154,6 +331,7 @@ make_update_devices_action(
         audio::io_sound_cards const& current_devices,
         std::size_t const input_index,
         std::size_t const output_index,
+        std::vector<std::size_t> const& aggregate_indices,
         audio::sample_rate const sample_rate,
         audio::period_size const period_size,
         audio::period_count const period_count) -> update_devices
@@ -245,6 +423,47 @@ make_update_devices_action(
             &period_counts,
             period_count);
 
+    if (next_action.period_size.valid())
+    {
+        auto aggregate_inputs = next_action.aggregate_inputs.lock();
+        for (std::size_t const index : aggregate_indices)
+        {
+            if (index == npos)
+            {
+                continue;
+            }
+
+            auto const found_index = algorithm::index_of(
+                    new_devices.in.get(),
+                    current_devices.in.get()[index]);
+
+            if (found_index == npos || found_index == next_action.input.index ||
+                algorithm::contains(
+                        *aggregate_inputs,
+                        found_index,
+                        &selected_sound_card::index))
+            {
+                continue;
+            }
+
+            auto hw_params = aggregate_input_hw_params(
+                    device_manager,
+                    new_devices.in.get()[found_index],
+                    next_action.sample_rate,
+                    next_action.period_size);
+            if (hw_params.period_counts.empty())
+            {
+                auto const& name = new_devices.in.get()[found_index].name;
+                spdlog::warn("aggregate input {} is not usable", name);
+                continue;
+            }
+
+            aggregate_inputs->push_back(selected_sound_card{
+                    .index = found_index,
+                    .hw_params = box(std::move(hw_params))});
+        }
+    }
+
     return next_action;
 }
 
@@ -254,6 +473,11 @@ audio_engine_middleware::process_device_action(
         middleware_functors const& mw_fs,
         actions::apply_app_config const& a)
 {
+    set_thread_topology(
+            a.conf.audio_threads.automatic
+                    ? m_auto_thread_topology
+                    : make_audio_thread_topology(a.conf.audio_threads));
+
     state const& current_state = mw_fs.get_state();
 
     mw_fs.next(make_update_devices_action(
@@ -268,6 +492,14 @@ audio_engine_middleware::process_device_action(
                     current_state.io_sound_cards.out.get(),
                     a.conf.output_sound_card,
                     &audio::sound_card_descriptor::name),
+            algorithm::transform_to_vector(
+                    a.conf.aggregate_input_sound_cards,
+                    [&](std::string const& name) {
+                        return algorithm::index_of(
+                                current_state.io_sound_cards.in.get(),
+                                name,
+                                &audio::sound_card_descriptor::name);
+                    }),
             a.conf.sample_rate,
             a.conf.period_size,
             a.conf.period_count));
@@ -279,19 +511,33 @@ template <>
 void
 audio_engine_middleware::process_device_action(
         middleware_functors const& mw_fs,
-        actions::refresh_sound_cards const&)
+        actions::refresh_sound_cards const& a)
 {
+    auto const io_descriptors = m_sound_card_manager.io_descriptors();
+
+    // newly found cards are being probed
+    if (!wait_for_probes(mw_fs))
+    {
+        m_deferred_actions.push_back(a.clone());
+        return;
+    }
+
     state const& current_state = mw_fs.get_state();
 
     mw_fs.next(make_update_devices_action(
             m_sound_card_manager,
-            m_sound_card_manager.io_descriptors(),
+            io_descriptors,
             current_state.io_sound_cards,
             current_state.selected_io_sound_card.in.index,
             current_state.selected_io_sound_card.out.index,
+            aggregate_input_indices(current_state),
             current_state.sample_rate,
             current_state.period_size,
             current_state.period_count));
+
+    mw_fs.next(make_update_sound_card_hw_params_action(
+            m_sound_card_manager,
+            io_descriptors));
 }
 
 template <>
@@ -312,6 +558,7 @@ audio_engine_middleware::process_device_action(
             action.io_dir == io_direction::output
                     ? action.index
                     : current_state.selected_io_sound_card.out.index,
+            aggregate_input_indices(current_state),
             current_state.sample_rate,
             current_state.period_size,
             current_state.period_count));
@@ -334,6 +581,7 @@ audio_engine_middleware::process_device_action(
                 current_state.io_sound_cards,
                 current_state.selected_io_sound_card.in.index,
                 current_state.selected_io_sound_card.out.index,
+                aggregate_input_indices(current_state),
                 srs[action.index],
                 current_state.period_size,
                 current_state.period_count));
@@ -357,6 +605,7 @@ audio_engine_middleware::process_device_action(
                 current_state.io_sound_cards,
                 current_state.selected_io_sound_card.in.index,
                 current_state.selected_io_sound_card.out.index,
+                aggregate_input_indices(current_state),
                 current_state.sample_rate,
                 pss[action.index],
                 current_state.period_count));
@@ -380,6 +629,7 @@ audio_engine_middleware::process_device_action(
                 current_state.io_sound_cards,
                 current_state.selected_io_sound_card.in.index,
                 current_state.selected_io_sound_card.out.index,
+                aggregate_input_indices(current_state),
                 current_state.sample_rate,
                 current_state.period_size,
                 pcs[action.index]));
@@ -415,7 +665,7 @@ audio_engine_middleware::process_engine_action(
         Action const& a)
 {
     mw_fs.next(a);
-    rebuild(mw_fs.get_state());
+    rebuild(mw_fs);
 }
 
 template <class Parameter>
@@ -499,7 +749,7 @@ audio_engine_middleware::process_engine_action(
         actions::stop_recording const& a)
 {
     mw_fs.next(a);
-    rebuild(mw_fs.get_state());
+    rebuild(mw_fs);
 }
 
 template <>
@@ -512,6 +762,23 @@ audio_engine_middleware::process_engine_action(
         update_info next_action;
         next_action.xruns = m_io_process->xruns();
         next_action.cpu_load = m_io_process->cpu_load();
+        next_action.rt_allocations = audio::rt_allocation_count();
+        next_action.worker_loads = update_worker_loads();
+        next_action.aggregate_input_stats = m_io_process->aggregate_inputs();
+        if (m_engine)
+        {
+            next_action.failed_fx_modules = m_engine->failed_fx_modules();
+        }
+
+        if (next_action.xruns != mw_fs.get_state().xruns)
+        {
+            write_xrun_report(next_action.xruns);
+        }
+
+        if (next_action.rt_allocations != mw_fs.get_state().rt_allocations)
+        {
+            audio::log_rt_allocation_samples();
+        }
 
         mw_fs.next(next_action);
     }
@@ -537,7 +804,7 @@ audio_engine_middleware::process_engine_action(
 
             mw_fs.next(actions::stop_midi_learning{});
 
-            rebuild(mw_fs.get_state());
+            rebuild(mw_fs);
         }
     }
 }
@@ -552,6 +819,32 @@ audio_engine_middleware::close_sound_card()
     m_engine.reset();
 }
 
+// Picks the same parameters as aggregate_input_hw_params.
+static auto
+aggregate_input_config(
+        audio::sound_card_descriptor const& device,
+        audio::sound_card_hw_params const& hw_params,
+        state const& st) -> audio::aggregate_input_config
+{
+    return audio::aggregate_input_config{
+            .device = device,
+            .config =
+                    audio::sound_card_config{
+                            hw_params.interleaved,
+                            hw_params.format,
+                            hw_params.num_channels},
+            .buffer_config = audio::sound_card_buffer_config{
+                    *algorithm::find_or_get_first(
+                            hw_params.sample_rates,
+                            st.sample_rate),
+                    *algorithm::find_or_get_first(
+                            hw_params.period_sizes,
+                            st.period_size),
+                    *algorithm::find_or_get_first(
+                            hw_params.period_counts,
+                            st.period_count)}};
+}
+
 void
 audio_engine_middleware::open_sound_card(state const& st)
 {
@@ -585,7 +878,16 @@ audio_engine_middleware::open_sound_card(state const& st)
                         audio::sound_card_buffer_config{
                                 st.sample_rate,
                                 st.period_size,
-                                st.period_count}});
+                                st.period_count},
+                        algorithm::transform_to_vector(
+                                *st.aggregate_input_sound_cards,
+                                [&st](selected_sound_card const& aggregate) {
+                                    return aggregate_input_config(
+                                            st.io_sound_cards.in
+                                                    .get()[aggregate.index],
+                                            *aggregate.hw_params,
+                                            st);
+                                })});
         m_io_process.swap(io_process);
     }
     catch (std::exception const& err)
@@ -596,8 +898,10 @@ audio_engine_middleware::open_sound_card(state const& st)
 }
 
 void
-audio_engine_middleware::start_engine(state const& st)
+audio_engine_middleware::start_engine(middleware_functors const& mw_fs)
 {
+    state const& st = mw_fs.get_state();
+
     BOOST_ASSERT(m_io_process);
 
     if (m_io_process->is_open())
@@ -605,11 +909,11 @@ audio_engine_middleware::start_engine(state const& st)
         m_engine = std::make_unique<audio_engine>(
                 m_workers,
                 st.sample_rate,
-                st.selected_io_sound_card.in.hw_params->num_channels,
+                num_input_channels(st),
                 st.selected_io_sound_card.out.hw_params->num_channels);
 
         m_io_process->start(
-                m_audio_thread_config,
+                m_thread_topology.audio_main,
                 [engine = m_engine.get()](auto const& in, auto const& out) {
                     engine->init_process(in, out);
                 },
@@ -617,27 +921,53 @@ audio_engine_middleware::start_engine(state const& st)
                     engine->process(buffer_size);
                 });
 
-        rebuild(st);
+        rebuild(mw_fs);
     }
 }
 
 void
-audio_engine_middleware::rebuild(state const& st)
+audio_engine_middleware::rebuild(middleware_functors const& mw_fs)
 {
+    state const& st = mw_fs.get_state();
+
     if (!m_engine || !m_io_process->is_running())
     {
         return;
     }
 
-    if (!m_engine->rebuild(
-                st,
-                [this, sr = st.sample_rate](ladspa::instance_id id) {
-                    return m_ladspa_processor_factory.make_processor(id, sr);
-                },
-                m_midi_controller->make_input_event_handler()))
+    m_engine->rebuild(
+            st,
+            [this, sr = st.sample_rate](ladspa::instance_id id) {
+                return m_ladspa_processor_factory.make_processor(id, sr);
+            },
+            m_midi_controller->make_input_event_handler(),
+            [dispatch = mw_fs.dispatch_f(),
+             generation = ++m_graph_generation]() {
+                update_active_graph action;
+                action.generation = generation;
+                dispatch(action);
+            });
+}
+
+void
+audio_engine_middleware::set_thread_topology(
+        audio_thread_topology const& topology)
+{
+    // Device actions are processed with the sound card closed, no executor
+    // is referencing the workers.
+    BOOST_ASSERT(!m_engine);
+
+    if (topology == m_thread_topology)
     {
-        spdlog::error("Rebuilding audio engine graph failed.");
+        return;
     }
+
+    m_workers = std::vector<thread::worker>(
+            topology.workers.begin(),
+            topology.workers.end());
+    m_thread_topology = topology;
+
+    spdlog::info("audio threads: main + {} workers", m_workers.size());
 }
 
 void
@@ -645,8 +975,26 @@ audio_engine_middleware::operator()(
         middleware_functors const& mw_fs,
         action const& action)
 {
-    if (auto a = dynamic_cast<actions::audio_io_process_action const*>(&action))
+    if (dynamic_cast<sound_cards_probed const*>(&action))
+    {
+        auto deferred_actions = std::exchange(m_deferred_actions, {});
+        for (auto const& deferred_action : deferred_actions)
+        {
+            // defers again, if new probes were started in between
+            (*this)(mw_fs, *deferred_action);
+        }
+    }
+    else if (
+            auto a = dynamic_cast<actions::audio_io_process_action const*>(
+                    &action))
     {
+        // device actions stay in order behind the already deferred ones
+        if (!m_deferred_actions.empty() || !wait_for_probes(mw_fs))
+        {
+            m_deferred_actions.push_back(action.clone());
+            return;
+        }
+
         auto const& st = mw_fs.get_state();
 
         if (st.recording)
@@ -663,7 +1011,7 @@ audio_engine_middleware::operator()(
         a->visit(v);
 
         open_sound_card(st);
-        start_engine(st);
+        start_engine(mw_fs);
     }
     else if (
             auto a = dynamic_cast<actions::audio_engine_action const*>(&action))
@@ -679,4 +1027,66 @@ audio_engine_middleware::operator()(
     }
 }
 
+auto
+audio_engine_middleware::wait_for_probes(middleware_functors const& mw_fs)
+        -> bool
+{
+    return m_sound_card_manager.wait_for_probes(
+            [dispatch = mw_fs.dispatch_f()]() {
+                dispatch(sound_cards_probed{});
+            });
+}
+
+void
+audio_engine_middleware::write_xrun_report(std::size_t const xruns)
+{
+    auto const timings = m_io_process->take_xrun_period_timings();
+    if (timings.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_xrun_report_dir, ec);
+
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+    auto const file =
+            m_xrun_report_dir /
+            fmt::format("xrun_{}_{}.pjpt", seconds.count(), xruns);
+
+    if (audio::write_period_timings(file, timings))
+    {
+        spdlog::warn("xrun, period timings written to {}", file.string());
+        remove_old_xrun_reports(m_xrun_report_dir);
+    }
+}
+
+auto
+audio_engine_middleware::update_worker_loads()
+        -> std::vector<audio::engine::worker_load>
+{
+    if (!m_engine)
+    {
+        m_worker_stats.clear();
+        return {};
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    auto stats = m_engine->worker_stats();
+
+    // without a previous snapshot, there is no interval to relate to
+    auto loads = m_worker_stats.empty()
+                         ? std::vector<audio::engine::worker_load>(stats.size())
+                         : audio::engine::worker_loads(
+                                   m_worker_stats,
+                                   stats,
+                                   now - m_worker_stats_time);
+
+    m_worker_stats = std::move(stats);
+    m_worker_stats_time = now;
+
+    return loads;
+}
+
 } // namespace piejam::runtime
@@ -0,0 +1,96 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/audio_thread_topology.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace piejam::runtime
+{
+
+namespace
+{
+
+auto
+audio_worker_name(std::size_t const index) -> std::string
+{
+    return fmt::format("audio_worker_{}", index);
+}
+
+} // namespace
+
+auto
+auto_audio_thread_topology(
+        std::span<int const> const online_cpus,
+        std::span<int const> const isolated_cpus,
+        int const ui_cpu,
+        int const realtime_priority) -> audio_thread_topology
+{
+    std::vector<int> cpus;
+
+    std::ranges::copy_if(isolated_cpus, std::back_inserter(cpus), [&](int cpu) {
+        return cpu != ui_cpu && std::ranges::count(online_cpus, cpu);
+    });
+
+    if (cpus.empty())
+    {
+        std::ranges::copy_if(
+                online_cpus,
+                std::back_inserter(cpus),
+                [ui_cpu](int cpu) { return cpu != ui_cpu && cpu != 0; });
+
+        if (std::ranges::count(online_cpus, 0) && ui_cpu != 0)
+        {
+            cpus.push_back(0);
+        }
+    }
+
+    audio_thread_topology result;
+    result.audio_main = {
+            .affinity = {},
+            .realtime_priority = realtime_priority,
+            .name = "audio_main"};
+
+    if (cpus.empty())
+    {
+        return result;
+    }
+
+    result.audio_main.affinity = {cpus.front()};
+
+    for (std::size_t i = 1; i < cpus.size(); ++i)
+    {
+        result.workers.push_back(
+                {.affinity = {cpus[i]},
+                 .realtime_priority = realtime_priority,
+                 .name = audio_worker_name(i - 1)});
+    }
+
+    return result;
+}
+
+auto
+make_audio_thread_topology(audio_threads_config const& conf)
+        -> audio_thread_topology
+{
+    audio_thread_topology result;
+    result.audio_main = {
+            .affinity = conf.audio_main.affinity,
+            .realtime_priority = conf.audio_main.realtime_priority,
+            .name = "audio_main"};
+
+    for (std::size_t i = 0; i < conf.workers.size(); ++i)
+    {
+        result.workers.push_back(
+                {.affinity = conf.workers[i].affinity,
+                 .realtime_priority = conf.workers[i].realtime_priority,
+                 .name = audio_worker_name(i)});
+    }
+
+    return result;
+}
+
+} // namespace piejam::runtime
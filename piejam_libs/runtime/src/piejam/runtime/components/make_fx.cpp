@@ -31,6 +31,7 @@ make_internal_fx(
         audio::sample_rate const sample_rate,
         parameter_processor_factory& param_procs,
         processors::stream_processor_factory& stream_procs,
+        audio::engine::delay_line_pool& delay_lines,
         std::string_view const name)
         -> std::unique_ptr<audio::engine::component>
 {
@@ -39,6 +40,7 @@ make_internal_fx(
             .sample_rate = sample_rate,
             .param_procs = param_procs,
             .stream_procs = stream_procs,
+            .delay_lines = delay_lines,
             .name = name,
     });
 }
@@ -51,6 +53,7 @@ make_fx(fx::module const& fx_mod,
         fx::simple_ladspa_processor_factory const& ladspa_fx_proc_factory,
         parameter_processor_factory& param_procs,
         processors::stream_processor_factory& stream_procs,
+        audio::engine::delay_line_pool& delay_lines,
         audio::sample_rate const sample_rate,
         std::string_view const name)
         -> std::unique_ptr<audio::engine::component>
@@ -65,6 +68,7 @@ make_fx(fx::module const& fx_mod,
                                 sample_rate,
                                 param_procs,
                                 stream_procs,
+                                delay_lines,
                                 name);
                     },
                     [&](ladspa::instance_id id)
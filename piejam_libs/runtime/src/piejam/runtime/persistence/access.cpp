@@ -8,6 +8,7 @@
 #include <piejam/algorithm/transform_to_vector.h>
 #include <piejam/runtime/fx/unavailable_ladspa.h>
 #include <piejam/runtime/persistence/app_config.h>
+#include <piejam/runtime/persistence/binary_session.h>
 #include <piejam/runtime/persistence/session.h>
 #include <piejam/runtime/state.h>
 
@@ -50,6 +51,19 @@ save_app_config(
                                   .get()[state.selected_io_sound_card.out.index]
                                   .name
                         : std::string();
+
+        // the cards might have changed since the aggregate was selected
+        auto const& input_sound_cards = state.io_sound_cards.in.get();
+        for (selected_sound_card const& aggregate :
+             *state.aggregate_input_sound_cards)
+        {
+            if (aggregate.index < input_sound_cards.size())
+            {
+                conf.aggregate_input_sound_cards.push_back(
+                        input_sound_cards[aggregate.index].name);
+            }
+        }
+
         conf.sample_rate = state.sample_rate;
         conf.period_size = state.period_size;
         conf.period_count = state.period_count;
@@ -58,6 +72,8 @@ save_app_config(
 
         conf.rec_session = state.rec_session + 1;
 
+        conf.audio_threads = state.audio_threads;
+
         persistence::save_app_config(out, conf);
     }
     catch (std::exception const& err)
@@ -347,42 +363,61 @@ export_mixer_channels(state const& st, mixer::channel_ids_t const& channel_ids)
 
 } // namespace
 
-void
-save_session(std::filesystem::path const& file, state const& st)
+auto
+export_session(state const& st) -> session
+{
+    session ses;
+
+    ses.external_audio_input_devices = export_external_audio_device_configs(
+            st.external_audio_state.devices,
+            st.external_audio_state.inputs.get(),
+            st.strings);
+
+    ses.external_audio_output_devices = export_external_audio_device_configs(
+            st.external_audio_state.devices,
+            st.external_audio_state.outputs.get(),
+            st.strings);
+
+    ses.mixer_channels = export_mixer_channels(st, *st.mixer_state.inputs);
+    ses.main_mixer_channel = export_mixer_channel(
+            st,
+            st.mixer_state.main,
+            st.mixer_state.channels[st.mixer_state.main]);
+
+    return ses;
+}
+
+auto
+save_session(std::filesystem::path const& file, state const& st) -> bool
 {
     try
     {
-        std::ofstream out(file);
+        bool const binary = file.extension() == binary_session_extension;
+
+        std::ofstream out(
+                file,
+                binary ? std::ios::out | std::ios::binary : std::ios::out);
         if (!out.is_open())
         {
             throw std::runtime_error("could not open session file");
         }
 
-        session ses;
-
-        ses.external_audio_input_devices = export_external_audio_device_configs(
-                st.external_audio_state.devices,
-                st.external_audio_state.inputs.get(),
-                st.strings);
-
-        ses.external_audio_output_devices =
-                export_external_audio_device_configs(
-                        st.external_audio_state.devices,
-                        st.external_audio_state.outputs.get(),
-                        st.strings);
-
-        ses.mixer_channels = export_mixer_channels(st, *st.mixer_state.inputs);
-        ses.main_mixer_channel = export_mixer_channel(
-                st,
-                st.mixer_state.main,
-                st.mixer_state.channels[st.mixer_state.main]);
+        if (binary)
+        {
+            save_binary_session(out, export_session(st));
+        }
+        else
+        {
+            save_session(out, export_session(st));
+        }
 
-        save_session(out, ses);
+        return out.good();
     }
     catch (std::exception const& err)
     {
         auto const* const message = err.what();
         spdlog::error("save_session: {}", message);
+        return false;
     }
 }
 
@@ -31,6 +31,22 @@ M_PIEJAM_PERSISTENCE_DEFINE_STRONG_TYPE_SERIALIER(
 
 } // namespace piejam::audio
 
+namespace piejam::runtime
+{
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+        audio_thread_config,
+        affinity,
+        realtime_priority);
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+        audio_threads_config,
+        automatic,
+        audio_main,
+        workers);
+
+} // namespace piejam::runtime
+
 namespace piejam::runtime::persistence
 {
 
@@ -47,11 +63,13 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
         app_config,
         input_sound_card,
         output_sound_card,
+        aggregate_input_sound_cards,
         sample_rate,
         period_size,
         period_count,
         enabled_midi_input_devices,
-        rec_session);
+        rec_session,
+        audio_threads);
 
 using upgrade_function = void (*)(nlohmann::json&);
 using upgrade_functions_array =
@@ -60,6 +78,23 @@ using upgrade_functions_array =
 template <size_t Version>
 static void upgrade(nlohmann::json&);
 
+template <>
+void
+upgrade<0>(nlohmann::json& conf)
+{
+    conf[s_key_app_config]["audio_threads"] = audio_threads_config{};
+    conf[s_key_version] = 1;
+}
+
+template <>
+void
+upgrade<1>(nlohmann::json& conf)
+{
+    conf[s_key_app_config]["aggregate_input_sound_cards"] =
+            std::vector<std::string>{};
+    conf[s_key_version] = 2;
+}
+
 template <size_t... I>
 static auto
 make_upgrade_functions_array(std::index_sequence<I...>)
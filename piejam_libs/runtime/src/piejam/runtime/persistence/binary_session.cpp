@@ -0,0 +1,652 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/persistence/binary_session.h>
+
+#include <piejam/runtime/parameter/assignment.h>
+#include <piejam/runtime/persistence/fx_internal_id.h>
+
+#include <boost/assert.hpp>
+#include <boost/hof/match.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace piejam::runtime::persistence
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little);
+
+constexpr char file_magic[4]{'P', 'J', 'S', 'B'};
+
+struct file_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t num_mixer_channels;
+    std::uint32_t reserved;
+    std::uint64_t session_offset;
+    std::uint64_t session_size;
+};
+
+struct file_section
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+static_assert(sizeof(file_header) == 32);
+static_assert(sizeof(file_section) == 16);
+
+enum class fx_plugin_kind : std::uint8_t
+{
+    internal = 1,
+    ladspa = 2,
+};
+
+[[noreturn]]
+void
+throw_invalid()
+{
+    throw std::runtime_error("invalid binary session");
+}
+
+class writer
+{
+public:
+    [[nodiscard]]
+    auto release() && noexcept -> std::vector<std::byte>
+    {
+        return std::move(m_data);
+    }
+
+    void bytes(void const* src, std::size_t const size)
+    {
+        auto const* const first = static_cast<std::byte const*>(src);
+        m_data.insert(m_data.end(), first, first + size);
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    void value(T const v)
+    {
+        bytes(&v, sizeof(v));
+    }
+
+    template <class E>
+        requires std::is_enum_v<E>
+    void value(E const e)
+    {
+        value(static_cast<std::uint32_t>(e));
+    }
+
+    void value(bool const b)
+    {
+        value(static_cast<std::uint8_t>(b));
+    }
+
+    void value(std::string const& s)
+    {
+        value(static_cast<std::uint64_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+
+private:
+    std::vector<std::byte> m_data;
+};
+
+class reader
+{
+public:
+    explicit reader(std::span<std::byte const> data)
+        : m_data(data)
+    {
+    }
+
+    [[nodiscard]]
+    auto at_end() const noexcept -> bool
+    {
+        return m_data.empty();
+    }
+
+    void bytes(void* dst, std::size_t const size)
+    {
+        if (size > m_data.size())
+        {
+            throw_invalid();
+        }
+
+        std::memcpy(dst, m_data.data(), size);
+        m_data = m_data.subspan(size);
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    auto value() -> T
+    {
+        T v;
+        bytes(&v, sizeof(v));
+        return v;
+    }
+
+    template <class E>
+        requires std::is_enum_v<E>
+    auto value(E const last) -> E
+    {
+        auto const v = value<std::uint32_t>();
+        if (v > static_cast<std::uint32_t>(last))
+        {
+            throw_invalid();
+        }
+
+        return static_cast<E>(v);
+    }
+
+    auto boolean() -> bool
+    {
+        return value<std::uint8_t>() != 0;
+    }
+
+    auto string() -> std::string
+    {
+        auto const size = value<std::uint64_t>();
+        if (size > m_data.size())
+        {
+            throw_invalid();
+        }
+
+        std::string result(
+                reinterpret_cast<char const*>(m_data.data()),
+                static_cast<std::size_t>(size));
+        m_data = m_data.subspan(static_cast<std::size_t>(size));
+        return result;
+    }
+
+    //! Element count of a sequence, each element takes at least one byte.
+    auto count() -> std::size_t
+    {
+        auto const n = value<std::uint64_t>();
+        if (n > m_data.size())
+        {
+            throw_invalid();
+        }
+
+        return static_cast<std::size_t>(n);
+    }
+
+private:
+    std::span<std::byte const> m_data;
+};
+
+void
+write(writer& out, midi_assignment const& m)
+{
+    out.value(static_cast<std::uint64_t>(m.channel));
+    out.value(m.control_type);
+    out.value(static_cast<std::uint64_t>(m.control_id));
+}
+
+void
+read(reader& in, midi_assignment& m)
+{
+    m.channel = in.value<std::uint64_t>();
+    m.control_type = in.value(midi_assignment::type::cc);
+    m.control_id = in.value<std::uint64_t>();
+}
+
+void
+write(writer& out, std::optional<midi_assignment> const& m)
+{
+    out.value(m.has_value());
+    if (m)
+    {
+        write(out, *m);
+    }
+}
+
+void
+read(reader& in, std::optional<midi_assignment>& m)
+{
+    if (in.boolean())
+    {
+        read(in, m.emplace());
+    }
+    else
+    {
+        m.reset();
+    }
+}
+
+void
+write(writer& out, fx::parameter_value_assignment const& a)
+{
+    out.value(a.key);
+    out.value(static_cast<std::uint8_t>(a.value.index()));
+    std::visit([&out](auto const v) { out.value(v); }, a.value);
+}
+
+template <std::size_t I = 0>
+void
+read_parameter_value(
+        reader& in,
+        std::size_t const index,
+        parameter_value& result)
+{
+    if constexpr (I < std::variant_size_v<parameter_value>)
+    {
+        if (index == I)
+        {
+            using value_t = std::variant_alternative_t<I, parameter_value>;
+            if constexpr (std::is_same_v<value_t, bool>)
+            {
+                result = in.boolean();
+            }
+            else
+            {
+                result = in.value<value_t>();
+            }
+        }
+        else
+        {
+            read_parameter_value<I + 1>(in, index, result);
+        }
+    }
+    else
+    {
+        throw_invalid();
+    }
+}
+
+void
+read(reader& in, fx::parameter_value_assignment& a)
+{
+    a.key = in.value<parameter::key>();
+    read_parameter_value(in, in.value<std::uint8_t>(), a.value);
+}
+
+void
+write(writer& out, fx::parameter_midi_assignment const& a)
+{
+    out.value(a.key);
+    write(out, a.value);
+}
+
+void
+read(reader& in, fx::parameter_midi_assignment& a)
+{
+    a.key = in.value<parameter::key>();
+    read(in, a.value);
+}
+
+template <class T>
+void
+write(writer& out, std::vector<T> const& v)
+{
+    out.value(static_cast<std::uint64_t>(v.size()));
+    for (T const& x : v)
+    {
+        write(out, x);
+    }
+}
+
+template <class T>
+void
+read(reader& in, std::vector<T>& v)
+{
+    v.resize(in.count());
+    for (T& x : v)
+    {
+        read(in, x);
+    }
+}
+
+void
+write(writer& out, session::fx_plugin const& fx_plug)
+{
+    std::visit(
+            boost::hof::match(
+                    [&out](session::internal_fx const& fx) {
+                        out.value(fx_plugin_kind::internal);
+                        out.value(internal_fx_name(fx.type));
+                        write(out, fx.preset);
+                        write(out, fx.midi);
+                    },
+                    [&out](session::ladspa_plugin const& ladspa_plug) {
+                        out.value(fx_plugin_kind::ladspa);
+                        out.value(static_cast<std::uint64_t>(ladspa_plug.id));
+                        out.value(ladspa_plug.name);
+                        write(out, ladspa_plug.preset);
+                        write(out, ladspa_plug.midi);
+                    },
+                    [](std::monostate) { BOOST_ASSERT(false); }),
+            fx_plug.as_variant());
+}
+
+void
+read(reader& in, session::fx_plugin& fx_plug)
+{
+    switch (in.value(fx_plugin_kind::ladspa))
+    {
+        case fx_plugin_kind::internal:
+        {
+            session::internal_fx fx;
+            fx.type = find_internal_fx(in.string());
+            read(in, fx.preset);
+            read(in, fx.midi);
+            fx_plug = std::move(fx);
+            break;
+        }
+
+        case fx_plugin_kind::ladspa:
+        {
+            session::ladspa_plugin ladspa_plug;
+            ladspa_plug.id = in.value<std::uint64_t>();
+            ladspa_plug.name = in.string();
+            read(in, ladspa_plug.preset);
+            read(in, ladspa_plug.midi);
+            fx_plug = std::move(ladspa_plug);
+            break;
+        }
+
+        default:
+            throw std::runtime_error("unknown fx_plugin_id");
+    }
+}
+
+void
+write(writer& out, session::external_audio_device_config const& conf)
+{
+    out.value(conf.name);
+    out.value(conf.bus_type);
+    out.value(static_cast<std::uint64_t>(conf.channels.left));
+    out.value(static_cast<std::uint64_t>(conf.channels.right));
+}
+
+void
+read(reader& in, session::external_audio_device_config& conf)
+{
+    conf.name = in.string();
+    conf.bus_type = in.value(audio::bus_type::stereo);
+    conf.channels.left = in.value<std::uint64_t>();
+    conf.channels.right = in.value<std::uint64_t>();
+}
+
+void
+write(writer& out, session::mixer_io const& io)
+{
+    out.value(io.type);
+    out.value(static_cast<std::uint64_t>(io.index));
+}
+
+void
+read(reader& in, session::mixer_io& io)
+{
+    io.type = in.value(session::mixer_io_type::channel);
+    io.index = in.value<std::uint64_t>();
+}
+
+void
+write(writer& out, session::mixer_aux_send const& aux)
+{
+    write(out, aux.route);
+    out.value(aux.enabled);
+    out.value(aux.volume);
+}
+
+void
+read(reader& in, session::mixer_aux_send& aux)
+{
+    read(in, aux.route);
+    aux.enabled = in.boolean();
+    aux.volume = in.value<float>();
+}
+
+// Without the fx chain, which goes into a section of its own.
+void
+write(writer& out, session::mixer_channel const& mc)
+{
+    out.value(mc.name);
+    out.value(mc.color);
+    out.value(mc.bus_type);
+    out.value(mc.parameter.volume);
+    out.value(mc.parameter.pan);
+    out.value(mc.parameter.mute);
+    write(out, mc.midi.volume);
+    write(out, mc.midi.pan);
+    write(out, mc.midi.mute);
+    write(out, mc.in);
+    write(out, mc.out);
+    write(out, mc.aux_sends);
+}
+
+void
+read(reader& in, session::mixer_channel& mc)
+{
+    mc.name = in.string();
+    mc.color = in.value(material_color::blue_grey);
+    mc.bus_type = in.value(audio::bus_type::stereo);
+    mc.parameter.volume = in.value<float>();
+    mc.parameter.pan = in.value<float>();
+    mc.parameter.mute = in.boolean();
+    read(in, mc.midi.volume);
+    read(in, mc.midi.pan);
+    read(in, mc.midi.mute);
+    read(in, mc.in);
+    read(in, mc.out);
+    read(in, mc.aux_sends);
+}
+
+} // namespace
+
+auto
+encode_session_section(session const& ses) -> std::vector<std::byte>
+{
+    writer out;
+    write(out, ses.external_audio_input_devices);
+    write(out, ses.external_audio_output_devices);
+    out.value(static_cast<std::uint64_t>(ses.mixer_channels.size() + 1));
+    write(out, ses.main_mixer_channel);
+    for (session::mixer_channel const& mc : ses.mixer_channels)
+    {
+        write(out, mc);
+    }
+    return std::move(out).release();
+}
+
+auto
+encode_fx_chain_section(session::fx_chain_t const& fx_chain)
+        -> std::vector<std::byte>
+{
+    writer out;
+    write(out, fx_chain);
+    return std::move(out).release();
+}
+
+auto
+decode_session_section(std::span<std::byte const> const data) -> session
+{
+    session result;
+
+    reader in(data);
+    read(in, result.external_audio_input_devices);
+    read(in, result.external_audio_output_devices);
+
+    auto const num_mixer_channels = in.count();
+    if (num_mixer_channels == 0)
+    {
+        throw_invalid();
+    }
+
+    read(in, result.main_mixer_channel);
+    result.mixer_channels.resize(num_mixer_channels - 1);
+    for (session::mixer_channel& mc : result.mixer_channels)
+    {
+        read(in, mc);
+    }
+
+    return result;
+}
+
+auto
+decode_fx_chain_section(std::span<std::byte const> const data)
+        -> session::fx_chain_t
+{
+    session::fx_chain_t result;
+
+    reader in(data);
+    read(in, result);
+
+    return result;
+}
+
+void
+save_binary_session(std::ostream& out, session const& ses)
+{
+    std::size_t const num_mixer_channels = ses.mixer_channels.size() + 1;
+
+    auto const session_section = encode_session_section(ses);
+
+    std::vector<std::vector<std::byte>> fx_chain_sections;
+    fx_chain_sections.reserve(num_mixer_channels);
+    fx_chain_sections.push_back(
+            encode_fx_chain_section(ses.main_mixer_channel.fx_chain));
+    for (session::mixer_channel const& mc : ses.mixer_channels)
+    {
+        fx_chain_sections.push_back(encode_fx_chain_section(mc.fx_chain));
+    }
+
+    file_header header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = current_binary_session_version;
+    header.num_mixer_channels =
+            static_cast<std::uint32_t>(num_mixer_channels);
+    header.session_offset =
+            sizeof(file_header) + num_mixer_channels * sizeof(file_section);
+    header.session_size = session_section.size();
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    std::uint64_t offset = header.session_offset + header.session_size;
+    for (auto const& fx_chain_section : fx_chain_sections)
+    {
+        file_section const section{
+                .offset = offset,
+                .size = fx_chain_section.size()};
+        out.write(reinterpret_cast<char const*>(&section), sizeof(section));
+        offset += section.size;
+    }
+
+    auto const write_section = [&out](std::vector<std::byte> const& data) {
+        out.write(
+                reinterpret_cast<char const*>(data.data()),
+                static_cast<std::streamsize>(data.size()));
+    };
+
+    write_section(session_section);
+    for (auto const& fx_chain_section : fx_chain_sections)
+    {
+        write_section(fx_chain_section);
+    }
+}
+
+auto
+is_binary_session(std::filesystem::path const& file) -> bool
+{
+    std::ifstream in(file, std::ios::binary);
+    char magic[sizeof(file_magic)]{};
+    return in.read(magic, sizeof(magic)) &&
+           std::memcmp(magic, file_magic, sizeof(magic)) == 0;
+}
+
+binary_session_file::binary_session_file(std::filesystem::path const& file)
+    : m_file(file)
+{
+    auto const data = m_file.data();
+
+    auto const section =
+            [&data](std::uint64_t const offset,
+                    std::uint64_t const size) -> std::span<std::byte const> {
+        if (offset > data.size() || size > data.size() - offset)
+        {
+            throw_invalid();
+        }
+
+        return data.subspan(
+                static_cast<std::size_t>(offset),
+                static_cast<std::size_t>(size));
+    };
+
+    file_header header;
+    reader(section(0, sizeof(header))).bytes(&header, sizeof(header));
+
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0)
+    {
+        throw_invalid();
+    }
+
+    if (header.version > current_binary_session_version)
+    {
+        throw std::runtime_error("session version is too new");
+    }
+
+    reader table(section(
+            sizeof(file_header),
+            std::uint64_t{header.num_mixer_channels} * sizeof(file_section)));
+
+    m_session = section(header.session_offset, header.session_size);
+
+    m_fx_chains.reserve(header.num_mixer_channels);
+    for (std::uint32_t i = 0; i < header.num_mixer_channels; ++i)
+    {
+        file_section s;
+        table.bytes(&s, sizeof(s));
+        m_fx_chains.push_back(section(s.offset, s.size));
+    }
+}
+
+auto
+binary_session_file::load() const -> session
+{
+    session result = decode_session_section(m_session);
+
+    if (result.mixer_channels.size() + 1 != m_fx_chains.size())
+    {
+        throw_invalid();
+    }
+
+    result.main_mixer_channel.fx_chain =
+            decode_fx_chain_section(m_fx_chains[0]);
+    for (std::size_t i = 0; i < result.mixer_channels.size(); ++i)
+    {
+        result.mixer_channels[i].fx_chain =
+                decode_fx_chain_section(m_fx_chains[i + 1]);
+    }
+
+    return result;
+}
+
+auto
+load_session(std::filesystem::path const& file) -> session
+{
+    if (is_binary_session(file))
+    {
+        return binary_session_file(file).load();
+    }
+
+    std::ifstream in(file);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("could not open session file");
+    }
+
+    return load_session(in);
+}
+
+} // namespace piejam::runtime::persistence
@@ -32,10 +32,7 @@ namespace piejam::runtime::fx
 void
 to_json(nlohmann::json& j, internal_id const& id)
 {
-    auto it = internal_fx_names().left.find(id);
-    BOOST_ASSERT(it != internal_fx_names().left.end());
-
-    j = it->second;
+    j = persistence::internal_fx_name(id);
 }
 
 void
@@ -44,10 +41,10 @@ from_json(nlohmann::json const& j, internal_id& id)
     std::string name;
     j.get_to<std::string>(name);
 
-    auto it = internal_fx_names().right.find(name);
-    if (it != internal_fx_names().right.end())
+    if (auto const found = persistence::find_internal_fx(name);
+        found != internal_id{})
     {
-        id = it->second;
+        id = found;
     }
 }
 
@@ -65,4 +62,21 @@ register_internal_fx(fx::internal_id id, std::string name)
                          .second);
 }
 
+auto
+internal_fx_name(fx::internal_id const id) -> std::string const&
+{
+    auto it = internal_fx_names().left.find(id);
+    BOOST_ASSERT(it != internal_fx_names().left.end());
+
+    return it->second;
+}
+
+auto
+find_internal_fx(std::string const& name) -> fx::internal_id
+{
+    auto it = internal_fx_names().right.find(name);
+    return it != internal_fx_names().right.end() ? it->second
+                                                 : fx::internal_id{};
+}
+
 } // namespace piejam::runtime::persistence
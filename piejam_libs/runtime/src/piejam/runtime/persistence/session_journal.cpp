@@ -0,0 +1,597 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/persistence/session_journal.h>
+
+#include <piejam/runtime/persistence/binary_session.h>
+
+#include <piejam/system/mapped_file.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace piejam::runtime::persistence
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little);
+
+constexpr char journal_magic[4]{'P', 'J', 'S', 'J'};
+constexpr std::uint32_t journal_version = 1;
+
+struct journal_header
+{
+    char magic[4];
+    std::uint32_t version;
+};
+
+struct record_header
+{
+    std::uint32_t type;
+    std::uint32_t index;
+    std::uint64_t size;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(journal_header) == 8);
+static_assert(sizeof(record_header) == 24);
+
+auto
+snapshot_file(std::filesystem::path const& dir) -> std::filesystem::path
+{
+    return dir / "snapshot.pjsb";
+}
+
+auto
+journal_file(std::filesystem::path const& dir) -> std::filesystem::path
+{
+    return dir / "journal";
+}
+
+// FNV-1a over the header fields and the payload
+auto
+checksum(record_header const& h, std::span<std::byte const> const payload)
+        -> std::uint64_t
+{
+    std::uint64_t hash = 0xcbf2'9ce4'8422'2325u;
+
+    auto const add = [&hash](std::span<std::byte const> const bytes) {
+        for (std::byte const b : bytes)
+        {
+            hash ^= std::to_integer<std::uint64_t>(b);
+            hash *= 0x100'0000'01b3u;
+        }
+    };
+
+    add(std::as_bytes(std::span{&h.type, 1}));
+    add(std::as_bytes(std::span{&h.index, 1}));
+    add(std::as_bytes(std::span{&h.size, 1}));
+    add(payload);
+
+    return hash;
+}
+
+void
+append_record(
+        std::vector<std::byte>& out,
+        std::uint32_t const type,
+        std::uint32_t const index,
+        std::span<std::byte const> const payload)
+{
+    record_header h{
+            .type = type,
+            .index = index,
+            .size = payload.size(),
+            .checksum = 0};
+    h.checksum = checksum(h, payload);
+
+    auto const* const first = reinterpret_cast<std::byte const*>(&h);
+    out.insert(out.end(), first, first + sizeof(h));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+[[noreturn]]
+void
+throw_errno()
+{
+    throw std::system_error(errno, std::generic_category());
+}
+
+void
+write_all(int const fd, std::span<std::byte const> data)
+{
+    while (!data.empty())
+    {
+        auto const written = ::write(fd, data.data(), data.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw_errno();
+        }
+
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+}
+
+void
+sync_path(std::filesystem::path const& path)
+{
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw_errno();
+    }
+
+    int const result = ::fsync(fd);
+    ::close(fd);
+    if (result < 0)
+    {
+        throw_errno();
+    }
+}
+
+} // namespace
+
+session_journal::session_journal(
+        std::filesystem::path dir,
+        std::size_t const compaction_threshold)
+    : m_dir(std::move(dir))
+    , m_compaction_threshold(compaction_threshold)
+    , m_thread([this](std::stop_token const stoken) {
+        std::unique_lock lock(m_mutex);
+        while (m_cv.wait(lock, stoken, [this] { return !m_tasks.empty(); }))
+        {
+            auto task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_busy = true;
+
+            lock.unlock();
+            task();
+            lock.lock();
+
+            m_busy = false;
+            m_cv.notify_all();
+        }
+    })
+{
+}
+
+session_journal::~session_journal()
+{
+    flush();
+    close_journal();
+}
+
+auto
+session_journal::apply(
+        sections& image,
+        record_type const type,
+        std::uint32_t const index,
+        std::span<std::byte const> const payload) -> bool
+{
+    switch (type)
+    {
+        case record_type::session:
+            image.session.assign(payload.begin(), payload.end());
+            image.fx_chains.resize(index);
+            return true;
+
+        case record_type::fx_chain:
+            if (index >= image.fx_chains.size())
+            {
+                return false;
+            }
+
+            image.fx_chains[index].assign(payload.begin(), payload.end());
+            return true;
+    }
+
+    return false;
+}
+
+auto
+session_journal::encode(session const& ses) -> sections
+{
+    sections result;
+
+    result.session = encode_session_section(ses);
+    result.fx_chains.reserve(ses.mixer_channels.size() + 1);
+    result.fx_chains.push_back(
+            encode_fx_chain_section(ses.main_mixer_channel.fx_chain));
+    for (session::mixer_channel const& mc : ses.mixer_channels)
+    {
+        result.fx_chains.push_back(encode_fx_chain_section(mc.fx_chain));
+    }
+
+    return result;
+}
+
+auto
+session_journal::decode(sections const& image) -> session
+{
+    session result = decode_session_section(image.session);
+    if (result.mixer_channels.size() + 1 != image.fx_chains.size())
+    {
+        throw std::runtime_error("mixer channel count mismatch");
+    }
+
+    result.main_mixer_channel.fx_chain =
+            decode_fx_chain_section(image.fx_chains.front());
+    for (std::size_t i = 0; i < result.mixer_channels.size(); ++i)
+    {
+        result.mixer_channels[i].fx_chain =
+                decode_fx_chain_section(image.fx_chains[i + 1]);
+    }
+
+    return result;
+}
+
+auto
+session_journal::recover() -> std::optional<session>
+{
+    // the background thread is idle from here on, until the next post
+    flush();
+
+    close_journal();
+    m_image = {};
+    m_sections = {};
+
+    auto const snapshot = snapshot_file(m_dir);
+    auto const journal = journal_file(m_dir);
+
+    try
+    {
+        if (std::filesystem::exists(snapshot))
+        {
+            m_image = encode(binary_session_file(snapshot).load());
+        }
+    }
+    catch (std::exception const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("session_journal: invalid snapshot: {}", message);
+        m_image = {};
+    }
+
+    std::size_t journal_end{};
+
+    try
+    {
+        if (std::filesystem::exists(journal))
+        {
+            system::mapped_file const mapped(journal);
+            auto data = mapped.data();
+
+            journal_header header{};
+            if (data.size() >= sizeof(header))
+            {
+                std::memcpy(&header, data.data(), sizeof(header));
+            }
+
+            bool const valid_header =
+                    std::memcmp(
+                            header.magic,
+                            journal_magic,
+                            sizeof(header.magic)) == 0 &&
+                    header.version == journal_version;
+            if (valid_header)
+            {
+                data = data.subspan(sizeof(header));
+                journal_end = sizeof(header);
+
+                // replay up to the first torn or corrupted record
+                record_header rh{};
+                while (data.size() >= sizeof(rh))
+                {
+                    std::memcpy(&rh, data.data(), sizeof(rh));
+                    if (rh.size > data.size() - sizeof(rh))
+                    {
+                        break;
+                    }
+
+                    auto const payload = data.subspan(
+                            sizeof(rh),
+                            static_cast<std::size_t>(rh.size));
+                    if (rh.checksum != checksum(rh, payload) ||
+                        !apply(m_image,
+                               static_cast<record_type>(rh.type),
+                               rh.index,
+                               payload))
+                    {
+                        break;
+                    }
+
+                    data = data.subspan(sizeof(rh) + payload.size());
+                    journal_end += sizeof(rh) + payload.size();
+                }
+            }
+        }
+    }
+    catch (std::system_error const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("session_journal: could not read journal: {}", message);
+    }
+
+    if (m_image.session.empty())
+    {
+        m_image = {};
+        return std::nullopt;
+    }
+
+    try
+    {
+        session result = decode(m_image);
+
+        if (journal_end > 0)
+        {
+            // continue the journal, without the torn tail
+            m_fd = ::open(journal.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+            if (m_fd < 0 ||
+                ::ftruncate(m_fd, static_cast<off_t>(journal_end)) < 0)
+            {
+                close_journal();
+            }
+            else
+            {
+                m_journal_size = journal_end;
+            }
+        }
+
+        m_sections = m_image;
+        return result;
+    }
+    catch (std::exception const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("session_journal: could not recover: {}", message);
+        m_image = {};
+        return std::nullopt;
+    }
+}
+
+auto
+session_journal::append(session const& ses) -> std::size_t
+{
+    std::vector<record> records;
+
+    std::size_t const num_mixer_channels = ses.mixer_channels.size() + 1;
+
+    auto session_section = encode_session_section(ses);
+    if (m_sections.fx_chains.size() != num_mixer_channels ||
+        m_sections.session != session_section)
+    {
+        m_sections.session = session_section;
+        records.push_back(
+                {.type = record_type::session,
+                 .index = static_cast<std::uint32_t>(num_mixer_channels),
+                 .payload = std::move(session_section)});
+    }
+
+    // new mixer channels start out empty, which never equals an encoded fx
+    // chain, so they are always written
+    m_sections.fx_chains.resize(num_mixer_channels);
+
+    for (std::size_t i = 0; i < num_mixer_channels; ++i)
+    {
+        auto fx_chain_section = encode_fx_chain_section(
+                i == 0 ? ses.main_mixer_channel.fx_chain
+                       : ses.mixer_channels[i - 1].fx_chain);
+        if (m_sections.fx_chains[i] != fx_chain_section)
+        {
+            m_sections.fx_chains[i] = fx_chain_section;
+            records.push_back(
+                    {.type = record_type::fx_chain,
+                     .index = static_cast<std::uint32_t>(i),
+                     .payload = std::move(fx_chain_section)});
+        }
+    }
+
+    std::size_t const num_records = records.size();
+    if (num_records > 0)
+    {
+        post([this, records = std::move(records)]() { write(records); });
+    }
+
+    return num_records;
+}
+
+void
+session_journal::clear()
+{
+    m_sections = {};
+    post([this]() { reset(); });
+}
+
+void
+session_journal::flush()
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_tasks.empty() && !m_busy; });
+}
+
+void
+session_journal::post(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_cv.notify_all();
+}
+
+void
+session_journal::write(std::vector<record> const& records)
+{
+    for (record const& r : records)
+    {
+        BOOST_VERIFY(apply(m_image, r.type, r.index, r.payload));
+    }
+
+    try
+    {
+        if (m_fd < 0)
+        {
+            // a new journal starts with the whole image
+            open_journal(true);
+        }
+        else
+        {
+            std::vector<std::byte> buffer;
+            for (record const& r : records)
+            {
+                append_record(
+                        buffer,
+                        static_cast<std::uint32_t>(r.type),
+                        r.index,
+                        r.payload);
+            }
+
+            write_all(m_fd, buffer);
+            if (::fsync(m_fd) < 0)
+            {
+                throw_errno();
+            }
+
+            m_journal_size += buffer.size();
+        }
+
+        if (m_journal_size > m_compaction_threshold)
+        {
+            compact();
+        }
+    }
+    catch (std::exception const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("session_journal: {}", message);
+
+        // start over with a new journal on the next write
+        close_journal();
+    }
+}
+
+void
+session_journal::open_journal(bool const with_image)
+{
+    close_journal();
+
+    std::filesystem::create_directories(m_dir);
+
+    auto const journal = journal_file(m_dir);
+    m_fd = ::open(
+            journal.c_str(),
+            O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC,
+            0644);
+    if (m_fd < 0)
+    {
+        throw_errno();
+    }
+
+    journal_header header{};
+    std::memcpy(header.magic, journal_magic, sizeof(header.magic));
+    header.version = journal_version;
+
+    std::vector<std::byte> buffer(sizeof(header));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    if (with_image)
+    {
+        append_record(
+                buffer,
+                static_cast<std::uint32_t>(record_type::session),
+                static_cast<std::uint32_t>(m_image.fx_chains.size()),
+                m_image.session);
+
+        for (std::size_t i = 0; i < m_image.fx_chains.size(); ++i)
+        {
+            append_record(
+                    buffer,
+                    static_cast<std::uint32_t>(record_type::fx_chain),
+                    static_cast<std::uint32_t>(i),
+                    m_image.fx_chains[i]);
+        }
+    }
+
+    write_all(m_fd, buffer);
+    if (::fsync(m_fd) < 0)
+    {
+        throw_errno();
+    }
+
+    sync_path(m_dir);
+
+    m_journal_size = buffer.size();
+}
+
+void
+session_journal::close_journal() noexcept
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    m_journal_size = 0;
+}
+
+void
+session_journal::compact()
+{
+    session const ses = decode(m_image);
+
+    auto const snapshot = snapshot_file(m_dir);
+    auto const tmp_file = std::filesystem::path{snapshot}.concat(".tmp");
+
+    {
+        std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+        save_binary_session(out, ses);
+        out.close();
+        if (!out)
+        {
+            throw std::runtime_error("could not write snapshot");
+        }
+    }
+
+    sync_path(tmp_file);
+    std::filesystem::rename(tmp_file, snapshot);
+    sync_path(m_dir);
+
+    // Should we crash before the journal is truncated, it is replayed on
+    // top of the new snapshot. That's harmless, the records replace whole
+    // sections and the last record of each section is already part of the
+    // snapshot.
+    open_journal(false);
+}
+
+void
+session_journal::reset()
+{
+    close_journal();
+    m_image = {};
+
+    std::error_code ec;
+    std::filesystem::remove(journal_file(m_dir), ec);
+    std::filesystem::remove(snapshot_file(m_dir), ec);
+}
+
+} // namespace piejam::runtime::persistence
@@ -6,23 +6,127 @@
 
 #include <piejam/runtime/actions/apply_app_config.h>
 #include <piejam/runtime/actions/apply_session.h>
+#include <piejam/runtime/actions/audio_engine_sync.h>
+#include <piejam/runtime/actions/autosave_session.h>
 #include <piejam/runtime/actions/load_app_config.h>
 #include <piejam/runtime/actions/load_session.h>
 #include <piejam/runtime/actions/save_app_config.h>
 #include <piejam/runtime/actions/save_session.h>
+#include <piejam/runtime/actions/set_parameter_value.h>
 #include <piejam/runtime/middleware_functors.h>
 #include <piejam/runtime/persistence/access.h>
+#include <piejam/runtime/persistence/binary_session.h>
 #include <piejam/runtime/persistence/session.h>
+#include <piejam/runtime/persistence/session_journal.h>
+#include <piejam/runtime/state.h>
+
+#include <piejam/algorithm/transform_to_vector.h>
 
 #include <spdlog/spdlog.h>
 
 #include <boost/assert.hpp>
 
 #include <fstream>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace piejam::runtime
 {
 
+namespace
+{
+
+// entity_data_map entries are changed in place, so their values are kept.
+template <class Id, class Data>
+auto
+entries(entity_data_map<Id, Data> const& m) -> std::vector<std::pair<Id, Data>>
+{
+    return algorithm::transform_to_vector(m, [](auto const& entry) {
+        return std::pair{entry.first, *entry.second};
+    });
+}
+
+// The state members a session is exported from. Boxed members are copied
+// on write, comparing them compares their identities.
+struct session_members
+{
+    explicit session_members(state const& st)
+        : strings(entries(st.strings))
+        , mixer_channels(st.mixer_state.channels)
+        , mixer_inputs(st.mixer_state.inputs)
+        , mixer_colors(entries(st.gui_state.mixer_colors))
+        , external_audio_devices(st.external_audio_state.devices)
+        , external_audio_inputs(st.external_audio_state.inputs)
+        , external_audio_outputs(st.external_audio_state.outputs)
+        , fx_modules(st.fx_modules)
+        , fx_unavailable_ladspa_plugins(st.fx_unavailable_ladspa_plugins)
+        , midi_assignments(st.midi_assignments)
+    {
+    }
+
+    auto operator==(session_members const&) const -> bool = default;
+
+    std::vector<std::pair<string_id, box<std::string>>> strings;
+    mixer::channels_t mixer_channels;
+    box<mixer::channel_ids_t> mixer_inputs;
+    std::vector<std::pair<mixer::channel_id, material_color>> mixer_colors;
+    external_audio::devices_t external_audio_devices;
+    box<external_audio::device_ids_t> external_audio_inputs;
+    box<external_audio::device_ids_t> external_audio_outputs;
+    fx::modules_t fx_modules;
+    fx::unavailable_ladspa_plugins fx_unavailable_ladspa_plugins;
+    box<midi_assignments_map> midi_assignments;
+};
+
+// Parameter values are set in place, their changes are only visible
+// through the actions.
+auto
+changes_parameter_values(action const& a) -> bool
+{
+    if (auto const* const sync =
+                dynamic_cast<actions::audio_engine_sync_update const*>(&a))
+    {
+        return std::apply(
+                [](auto const&... values) { return (!values.empty() || ...); },
+                sync->values);
+    }
+
+    return dynamic_cast<actions::set_parameter_value<bool_parameter> const*>(
+                   &a) ||
+           dynamic_cast<actions::set_parameter_value<float_parameter> const*>(
+                   &a) ||
+           dynamic_cast<actions::set_parameter_value<int_parameter> const*>(
+                   &a);
+}
+
+} // namespace
+
+struct persistence_middleware::impl
+{
+    explicit impl(std::filesystem::path autosave_dir)
+        : journal(std::move(autosave_dir))
+    {
+    }
+
+    persistence::session_journal journal;
+
+    // A crashed session is recovered on the first load, nothing is
+    // autosaved before that, so it isn't overwritten.
+    bool recovery_pending{true};
+
+    // session members at the last autosave
+    std::optional<session_members> autosaved_members;
+    bool parameter_values_changed{};
+};
+
+persistence_middleware::persistence_middleware(
+        std::filesystem::path autosave_dir)
+    : m_impl(make_pimpl<impl>(std::move(autosave_dir)))
+{
+}
+
 void
 persistence_middleware::operator()(
         middleware_functors const& mw_fs,
@@ -39,6 +143,11 @@ persistence_middleware::operator()(
     }
     else
     {
+        if (changes_parameter_values(a))
+        {
+            m_impl->parameter_values_changed = true;
+        }
+
         mw_fs.next(a);
     }
 }
@@ -100,21 +209,30 @@ persistence_middleware::process_persistence_action(
         middleware_functors const& mw_fs,
         actions::load_session const& a)
 {
-    if (!std::filesystem::exists(a.file))
-    {
-        return;
-    }
-
     try
     {
-        std::ifstream in(a.file);
-        if (!in.is_open())
+        actions::apply_session action;
+
+        std::optional<persistence::session> recovered;
+        if (std::exchange(m_impl->recovery_pending, false))
         {
-            throw std::runtime_error("could not open session file");
+            recovered = m_impl->journal.recover();
+        }
+
+        if (recovered)
+        {
+            spdlog::info("load_session: recovered autosaved session");
+            action.session = std::move(*recovered);
+        }
+        else if (std::filesystem::exists(a.file))
+        {
+            action.session = persistence::load_session(a.file);
+        }
+        else
+        {
+            return;
         }
 
-        actions::apply_session action;
-        action.session = persistence::load_session(in);
         mw_fs.dispatch(action);
     }
     catch (std::exception const& err)
@@ -130,7 +248,32 @@ persistence_middleware::process_persistence_action(
         middleware_functors const& mw_fs,
         actions::save_session const& a)
 {
-    persistence::save_session(a.file, mw_fs.get_state());
+    if (persistence::save_session(a.file, mw_fs.get_state()))
+    {
+        m_impl->journal.clear();
+    }
+}
+
+template <>
+void
+persistence_middleware::process_persistence_action(
+        middleware_functors const& mw_fs,
+        actions::autosave_session const&)
+{
+    if (m_impl->recovery_pending)
+    {
+        return;
+    }
+
+    state const& st = mw_fs.get_state();
+    session_members members(st);
+    if (m_impl->autosaved_members != members ||
+        m_impl->parameter_values_changed)
+    {
+        m_impl->autosaved_members = std::move(members);
+        m_impl->parameter_values_changed = false;
+        m_impl->journal.append(persistence::export_session(st));
+    }
 }
 
 } // namespace piejam::runtime
@@ -6,9 +6,11 @@
 
 #include <piejam/audio/engine/named_processor.h>
 #include <piejam/audio/engine/verify_process_context.h>
+#include <piejam/audio/sample_rate.h>
 #include <piejam/midi/event.h>
 #include <piejam/midi/event_handler.h>
 #include <piejam/midi/input_event_handler.h>
+#include <piejam/system/monotonic_raw_clock.h>
 
 namespace piejam::runtime::processors
 {
@@ -22,24 +24,56 @@ using external_midi_event_buffer =
 class midi_input_processor final : public audio::engine::named_processor
 {
 public:
+    // The events of the last period are placed at the offsets they were
+    // received at, relative to the start of this process call. This delays
+    // them by one period, but keeps their timing.
     struct event_handler final : midi::event_handler
     {
-        event_handler(external_midi_event_buffer& event_out_buffer)
+        event_handler(
+                external_midi_event_buffer& event_out_buffer,
+                audio::sample_rate const sample_rate,
+                std::size_t const buffer_size)
             : m_event_out_buffer(event_out_buffer)
+            , m_sample_rate(sample_rate)
+            , m_buffer_size(buffer_size)
         {
         }
 
-        void process(midi::external_event const& ev) override
+        void process(
+                midi::external_event const& ev,
+                system::monotonic_raw_clock::time_point const received) override
         {
-            m_event_out_buffer.insert(0, ev);
+            m_event_out_buffer.insert(offset(received), ev);
         }
 
     private:
+        auto offset(system::monotonic_raw_clock::time_point const received)
+                const noexcept -> std::size_t
+        {
+            if (received >= m_now)
+            {
+                return m_buffer_size - 1;
+            }
+
+            std::size_t const frames_ago =
+                    m_sample_rate.to_samples(m_now - received);
+
+            return frames_ago < m_buffer_size ? m_buffer_size - 1 - frames_ago
+                                              : 0;
+        }
+
         external_midi_event_buffer& m_event_out_buffer;
+        audio::sample_rate m_sample_rate;
+        std::size_t m_buffer_size;
+        system::monotonic_raw_clock::time_point m_now{
+                system::monotonic_raw_clock::now()};
     };
 
-    midi_input_processor(std::unique_ptr<midi::input_event_handler> midi_in)
+    midi_input_processor(
+            std::unique_ptr<midi::input_event_handler> midi_in,
+            audio::sample_rate const sample_rate)
         : m_midi_in(std::move(midi_in))
+        , m_sample_rate(sample_rate)
     {
         BOOST_ASSERT(m_midi_in);
     }
@@ -78,21 +112,28 @@ public:
         audio::engine::verify_process_context(*this, ctx);
 
         event_handler ev_handler(
-                ctx.event_outputs.get<midi::external_event>(0));
+                ctx.event_outputs.get<midi::external_event>(0),
+                m_sample_rate,
+                ctx.buffer_size);
         m_midi_in->process(ev_handler);
     }
 
 private:
     std::unique_ptr<midi::input_event_handler> m_midi_in;
+    audio::sample_rate m_sample_rate;
 };
 
 } // namespace
 
 auto
-make_midi_input_processor(std::unique_ptr<midi::input_event_handler> midi_in)
+make_midi_input_processor(
+        std::unique_ptr<midi::input_event_handler> midi_in,
+        audio::sample_rate const sample_rate)
         -> std::unique_ptr<audio::engine::processor>
 {
-    return std::make_unique<midi_input_processor>(std::move(midi_in));
+    return std::make_unique<midi_input_processor>(
+            std::move(midi_in),
+            sample_rate);
 }
 
 } // namespace piejam::runtime::processors
@@ -11,6 +11,7 @@
 #include <piejam/runtime/state.h>
 #include <piejam/runtime/ui/action.h>
 #include <piejam/runtime/ui/update_state_action.h>
+#include <piejam/runtime/waveform_overview.h>
 
 #include <piejam/audio/multichannel_buffer.h>
 #include <piejam/numeric/mipp_iterator.h>
@@ -33,8 +34,15 @@ namespace piejam::runtime
 
 struct recorder_middleware::impl
 {
+    struct open_stream
+    {
+        SndfileHandle sndfile;
+        std::filesystem::path filename;
+        waveform_overview_builder overview;
+    };
+
     using open_streams_t =
-            boost::container::flat_map<audio_stream_id, SndfileHandle>;
+            boost::container::flat_map<audio_stream_id, open_stream>;
 
     std::filesystem::path recordings_dir;
     open_streams_t open_streams{};
@@ -129,7 +137,11 @@ recorder_middleware::process_recorder_action(
             {
                 open_streams.emplace(
                         mixer_channel.out_stream,
-                        std::move(sndfile));
+                        impl::open_stream{
+                                .sndfile = std::move(sndfile),
+                                .filename = std::move(filename),
+                                .overview = waveform_overview_builder{
+                                        num_channels}});
             }
             else
             {
@@ -163,7 +175,24 @@ recorder_middleware::process_recorder_action(
         middleware_functors const& mw_fs,
         actions::stop_recording const&)
 {
-    BOOST_ASSERT(mw_fs.get_state().recording);
+    auto const& st = mw_fs.get_state();
+
+    BOOST_ASSERT(st.recording);
+
+    for (auto& stream : m_impl->open_streams | std::views::values)
+    {
+        stream.overview.flush();
+
+        if (!write_waveform_overview(
+                    waveform_overview_path(stream.filename),
+                    stream.overview,
+                    static_cast<unsigned>(st.sample_rate.as_int())))
+        {
+            spdlog::warn(
+                    "Could not write waveform overview for {}",
+                    stream.filename.string());
+        }
+    }
 
     m_impl->open_streams.clear();
 
@@ -213,12 +242,14 @@ recorder_middleware::process_recorder_action(
                 write_data = interleaved;
             }
 
+            it->second.overview.process(write_data);
+
             auto const written =
-                    it->second.writef(write_data.data(), num_frames);
+                    it->second.sndfile.writef(write_data.data(), num_frames);
             if (static_cast<std::size_t>(written) < num_frames)
             {
                 auto const frames_not_written = num_frames - written;
-                auto const* const message = it->second.strError();
+                auto const* const message = it->second.sndfile.strError();
                 spdlog::warn(
                         "Could not write {} frames: {}",
                         frames_not_written,
@@ -18,6 +18,8 @@
 #include <boost/hof/match.hpp>
 #include <boost/hof/unpack.hpp>
 
+#include <algorithm>
+
 namespace piejam::runtime::selectors
 {
 
@@ -163,7 +165,7 @@ make_num_device_channels_selector(io_direction const io_dir)
     {
         case io_direction::input:
             return selector<std::size_t>([](state const& st) -> std::size_t {
-                return st.selected_io_sound_card.in.hw_params->num_channels;
+                return num_input_channels(st);
             });
 
         case io_direction::output:
@@ -743,6 +745,15 @@ make_fx_module_bypass_selector(fx::module_id const fx_mod_id) -> selector<bool>
     return make_fx_module_member_selector<&fx::module::bypassed>(fx_mod_id);
 }
 
+auto
+make_fx_module_failed_selector(fx::module_id const fx_mod_id) -> selector<bool>
+{
+    return [fx_mod_id](state const& st) {
+        return std::ranges::find(*st.failed_fx_modules, fx_mod_id) !=
+               st.failed_fx_modules->end();
+    };
+}
+
 auto
 make_fx_module_parameters_selector(fx::module_id const fx_mod_id)
         -> selector<box<fx::module_parameters>>
@@ -1036,6 +1047,20 @@ selector<float> const select_cpu_load([](state const& st) {
     return st.cpu_load;
 });
 
+selector<std::size_t> const select_rt_allocations([](state const& st) {
+    return st.rt_allocations;
+});
+
+selector<std::size_t> const
+        select_num_failed_aggregate_inputs([](state const& st) {
+            return static_cast<std::size_t>(std::ranges::count_if(
+                    *st.aggregate_input_stats,
+                    &audio::aggregate_input_stats::failed));
+        });
+
+selector<boxed_vector<audio::engine::worker_load>> const
+        select_worker_loads([](state const& st) { return st.worker_loads; });
+
 selector<root_view_mode> const select_root_view_mode([](state const& st) {
     return st.gui_state.root_view_mode_;
 });
@@ -161,6 +161,19 @@ period_counts_from_state(state const& state) -> audio::period_counts_t
             state.selected_io_sound_card.out.hw_params);
 }
 
+auto
+num_input_channels(state const& state) -> std::size_t
+{
+    std::size_t result =
+            state.selected_io_sound_card.in.hw_params->num_channels;
+    for (selected_sound_card const& aggregate :
+         *state.aggregate_input_sound_cards)
+    {
+        result += aggregate.hw_params->num_channels;
+    }
+    return result;
+}
+
 static auto
 make_internal_fx_module(fx::modules_t& fx_modules, fx::module&& fx_mod)
 {
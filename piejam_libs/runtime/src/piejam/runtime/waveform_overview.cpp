@@ -0,0 +1,357 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/waveform_overview.h>
+
+#include <piejam/math.h>
+
+#include <spdlog/spdlog.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace piejam::runtime
+{
+
+namespace
+{
+
+// The peaks are mapped directly into memory, the file is always written in
+// the native byte order of the target platform.
+static_assert(std::endian::native == std::endian::little);
+
+constexpr char file_magic[4]{'P', 'J', 'W', 'O'};
+constexpr std::uint32_t file_version = 1;
+
+struct file_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t sample_rate;
+    std::uint32_t num_channels;
+    std::uint64_t num_frames;
+    std::uint32_t num_levels;
+    std::uint32_t reserved;
+};
+
+struct file_level_header
+{
+    std::uint64_t samples_per_bucket;
+    std::uint64_t num_buckets;
+    std::uint64_t offset;
+};
+
+static_assert(sizeof(file_header) == 32);
+static_assert(sizeof(file_level_header) == 24);
+static_assert(sizeof(waveform_overview_peak) == 4);
+
+constexpr float peak_scale = std::numeric_limits<std::int16_t>::max();
+
+auto
+quantize(float const min, float const max) -> waveform_overview_peak
+{
+    return {
+            .min = static_cast<std::int16_t>(
+                    std::floor(math::clamp(min, -1.f, 1.f) * peak_scale)),
+            .max = static_cast<std::int16_t>(
+                    std::ceil(math::clamp(max, -1.f, 1.f) * peak_scale))};
+}
+
+auto
+merge(waveform_overview_peak const& l, waveform_overview_peak const& r)
+        -> waveform_overview_peak
+{
+    return {.min = std::min(l.min, r.min), .max = std::max(l.max, r.max)};
+}
+
+} // namespace
+
+waveform_overview_builder::waveform_overview_builder(
+        std::size_t const num_channels,
+        std::span<std::size_t const> const bucket_sizes)
+    : m_num_channels{num_channels}
+    , m_acc_min(num_channels, std::numeric_limits<float>::max())
+    , m_acc_max(num_channels, std::numeric_limits<float>::lowest())
+    , m_frame_peaks(num_channels)
+{
+    BOOST_ASSERT(num_channels > 0);
+    BOOST_ASSERT(!bucket_sizes.empty());
+    BOOST_ASSERT(bucket_sizes.front() > 0);
+
+    std::size_t prev_bucket_size = 1;
+    for (std::size_t const bucket_size : bucket_sizes)
+    {
+        BOOST_ASSERT(bucket_size > prev_bucket_size);
+        BOOST_ASSERT(bucket_size % prev_bucket_size == 0);
+
+        m_levels.push_back(
+                {.samples_per_bucket = bucket_size,
+                 .fold_factor = bucket_size / prev_bucket_size,
+                 .acc_count = 0,
+                 .acc = std::vector<waveform_overview_peak>(num_channels),
+                 .peaks = {}});
+
+        prev_bucket_size = bucket_size;
+    }
+}
+
+void
+waveform_overview_builder::process(std::span<float const> const interleaved)
+{
+    BOOST_ASSERT(interleaved.size() % m_num_channels == 0);
+
+    std::size_t const bucket_size = m_levels.front().samples_per_bucket;
+
+    for (auto it = interleaved.begin(); it != interleaved.end();
+         it += m_num_channels)
+    {
+        for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+        {
+            m_acc_min[ch] = std::min(m_acc_min[ch], it[ch]);
+            m_acc_max[ch] = std::max(m_acc_max[ch], it[ch]);
+        }
+
+        if (++m_acc_count == bucket_size)
+        {
+            emit_first_level();
+        }
+    }
+
+    m_num_frames += interleaved.size() / m_num_channels;
+}
+
+void
+waveform_overview_builder::flush()
+{
+    if (m_acc_count > 0)
+    {
+        emit_first_level();
+    }
+
+    for (std::size_t level_index = 1; level_index < m_levels.size();
+         ++level_index)
+    {
+        if (m_levels[level_index].acc_count > 0)
+        {
+            emit(level_index);
+        }
+    }
+}
+
+void
+waveform_overview_builder::emit_first_level()
+{
+    for (std::size_t ch = 0; ch < m_num_channels; ++ch)
+    {
+        m_frame_peaks[ch] = quantize(m_acc_min[ch], m_acc_max[ch]);
+    }
+
+    std::ranges::fill(m_acc_min, std::numeric_limits<float>::max());
+    std::ranges::fill(m_acc_max, std::numeric_limits<float>::lowest());
+    m_acc_count = 0;
+
+    push_peaks(0, m_frame_peaks);
+}
+
+void
+waveform_overview_builder::emit(std::size_t const level_index)
+{
+    auto& lvl = m_levels[level_index];
+    lvl.acc_count = 0;
+
+    push_peaks(level_index, lvl.acc);
+}
+
+void
+waveform_overview_builder::push_peaks(
+        std::size_t const level_index,
+        std::span<waveform_overview_peak const> const frame_peaks)
+{
+    auto& lvl = m_levels[level_index];
+    lvl.peaks.insert(lvl.peaks.end(), frame_peaks.begin(), frame_peaks.end());
+
+    if (level_index + 1 == m_levels.size())
+    {
+        return;
+    }
+
+    auto& next = m_levels[level_index + 1];
+    if (next.acc_count == 0)
+    {
+        std::ranges::copy(frame_peaks, next.acc.begin());
+    }
+    else
+    {
+        std::ranges::transform(
+                next.acc,
+                frame_peaks,
+                next.acc.begin(),
+                merge);
+    }
+
+    if (++next.acc_count == next.fold_factor)
+    {
+        emit(level_index + 1);
+    }
+}
+
+auto
+write_waveform_overview(
+        std::filesystem::path const& file,
+        waveform_overview_builder const& builder,
+        unsigned const sample_rate) -> bool
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        spdlog::error(
+                "could not open waveform overview file: {}",
+                file.string());
+        return false;
+    }
+
+    file_header header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.sample_rate = sample_rate;
+    header.num_channels = static_cast<std::uint32_t>(builder.num_channels());
+    header.num_frames = builder.num_frames();
+    header.num_levels = static_cast<std::uint32_t>(builder.num_levels());
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    std::uint64_t offset =
+            sizeof(file_header) +
+            builder.num_levels() * sizeof(file_level_header);
+    for (std::size_t level = 0; level < builder.num_levels(); ++level)
+    {
+        auto const peaks = builder.peaks(level);
+
+        file_level_header const level_header{
+                .samples_per_bucket = builder.samples_per_bucket(level),
+                .num_buckets = peaks.size() / builder.num_channels(),
+                .offset = offset};
+
+        out.write(
+                reinterpret_cast<char const*>(&level_header),
+                sizeof(level_header));
+
+        offset += peaks.size_bytes();
+    }
+
+    for (std::size_t level = 0; level < builder.num_levels(); ++level)
+    {
+        auto const peaks = builder.peaks(level);
+        out.write(
+                reinterpret_cast<char const*>(peaks.data()),
+                static_cast<std::streamsize>(peaks.size_bytes()));
+    }
+
+    return out.good();
+}
+
+auto
+waveform_overview_path(std::filesystem::path const& audio_file)
+        -> std::filesystem::path
+{
+    return std::filesystem::path{audio_file}.concat(".peaks");
+}
+
+waveform_overview_file::waveform_overview_file(
+        std::filesystem::path const& file)
+{
+    try
+    {
+        m_file = system::mapped_file(file);
+    }
+    catch (std::system_error const& err)
+    {
+        auto const* const message = err.what();
+        spdlog::error("could not map waveform overview file: {}", message);
+        return;
+    }
+
+    auto const data = m_file.data();
+
+    if (data.size() < sizeof(file_header))
+    {
+        return;
+    }
+
+    file_header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+        header.version != file_version || header.num_channels == 0 ||
+        data.size() < sizeof(file_header) +
+                              header.num_levels * sizeof(file_level_header))
+    {
+        spdlog::error("invalid waveform overview file: {}", file.string());
+        return;
+    }
+
+    std::vector<level> levels;
+    levels.reserve(header.num_levels);
+
+    for (std::size_t i = 0; i < header.num_levels; ++i)
+    {
+        file_level_header level_header;
+        std::memcpy(
+                &level_header,
+                data.data() + sizeof(file_header) +
+                        i * sizeof(file_level_header),
+                sizeof(level_header));
+
+        std::uint64_t const num_peaks =
+                level_header.num_buckets * header.num_channels;
+        if (level_header.offset % alignof(waveform_overview_peak) != 0 ||
+            level_header.offset > data.size() ||
+            num_peaks > (data.size() - level_header.offset) /
+                                sizeof(waveform_overview_peak))
+        {
+            spdlog::error(
+                    "invalid waveform overview file: {}",
+                    file.string());
+            return;
+        }
+
+        levels.push_back(
+                {.samples_per_bucket = level_header.samples_per_bucket,
+                 .peaks = std::span{
+                         reinterpret_cast<waveform_overview_peak const*>(
+                                 data.data() + level_header.offset),
+                         num_peaks}});
+    }
+
+    m_sample_rate = header.sample_rate;
+    m_num_channels = header.num_channels;
+    m_num_frames = header.num_frames;
+    m_levels = std::move(levels);
+}
+
+auto
+waveform_overview_file::select_level(
+        std::size_t const samples_per_pixel) const noexcept -> std::size_t
+{
+    BOOST_ASSERT(!m_levels.empty());
+
+    std::size_t result = 0;
+    for (std::size_t level = 1; level < m_levels.size(); ++level)
+    {
+        if (m_levels[level].samples_per_bucket <= samples_per_pixel)
+        {
+            result = level;
+        }
+    }
+
+    return result;
+}
+
+} // namespace piejam::runtime
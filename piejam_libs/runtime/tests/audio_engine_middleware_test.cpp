@@ -12,6 +12,7 @@
 #include <piejam/audio/period_size.h>
 #include <piejam/audio/sample_rate.h>
 #include <piejam/runtime/actions/initiate_sound_card_selection.h>
+#include <piejam/runtime/actions/refresh_sound_cards.h>
 #include <piejam/runtime/actions/select_period_size.h>
 #include <piejam/runtime/actions/select_sample_rate.h>
 #include <piejam/runtime/audio_engine_middleware.h>
@@ -27,16 +28,22 @@ namespace piejam::runtime::test
 
 struct audio_engine_middleware_test : ::testing::Test
 {
+    audio_engine_middleware_test()
+    {
+        EXPECT_CALL(audio_device_manager, wait_for_probes(testing::_))
+                .WillRepeatedly(testing::Return(true));
+    }
+
     testing::StrictMock<middleware_functors_mock> mf_mock;
     testing::StrictMock<sound_card_manager_mock> audio_device_manager;
     testing::StrictMock<ladspa_processor_factory_mock> ladspa_processor_factory;
 
     audio_engine_middleware sut{
-            {},
             {},
             audio_device_manager,
             ladspa_processor_factory,
-            nullptr};
+            nullptr,
+            {}};
 };
 
 TEST_F(audio_engine_middleware_test,
@@ -144,6 +151,117 @@ TEST_F(audio_engine_middleware_test, select_period_size_will_change_period_size)
     EXPECT_EQ(audio::period_size(128u), st.period_size);
 }
 
+TEST_F(audio_engine_middleware_test,
+       device_actions_are_deferred_until_sound_cards_are_probed)
+{
+    using namespace testing;
+
+    audio::sound_card_hw_params const default_hw_params{
+            .sample_rates =
+                    {audio::sample_rate(44100u), audio::sample_rate(48000u)},
+            .period_sizes = {},
+            .period_counts = {}};
+
+    state st;
+    st.io_sound_cards = audio::io_sound_cards{
+            box(std::vector{
+                    audio::sound_card_descriptor{.name = "foo", .path = {}}}),
+            box(std::vector{
+                    audio::sound_card_descriptor{.name = "foo", .path = {}}}),
+    };
+    st.selected_io_sound_card.in.index = 0;
+    st.selected_io_sound_card.in.hw_params = default_hw_params;
+    st.selected_io_sound_card.out.index = 0;
+    st.selected_io_sound_card.out.hw_params = default_hw_params;
+    EXPECT_CALL(mf_mock, get_state()).WillRepeatedly(ReturnRef(st));
+    EXPECT_CALL(mf_mock, next(_)).WillRepeatedly([&st](auto const& a) {
+        dynamic_cast<reducible_action const&>(a).reduce(st);
+    });
+    EXPECT_CALL(audio_device_manager, hw_params(_, _, _))
+            .WillRepeatedly(Return(default_hw_params));
+
+    std::function<void()> on_probed;
+    EXPECT_CALL(audio_device_manager, wait_for_probes(_))
+            .WillOnce(DoAll(SaveArg<0>(&on_probed), Return(false)))
+            .RetiresOnSaturation();
+
+    auto const mw_fs = make_middleware_functors(mf_mock);
+    EXPECT_CALL(mf_mock, dispatch(_)).WillOnce([&](action const& a) {
+        sut(mw_fs, a);
+    });
+
+    actions::select_sample_rate action;
+    action.index = 1;
+    sut(mw_fs, action);
+
+    EXPECT_EQ(audio::sample_rate(), st.sample_rate);
+    ASSERT_TRUE(on_probed);
+
+    on_probed();
+
+    EXPECT_EQ(audio::sample_rate(48000u), st.sample_rate);
+}
+
+TEST_F(audio_engine_middleware_test,
+       non_device_actions_are_not_deferred_behind_device_actions)
+{
+    using namespace testing;
+
+    state st;
+    EXPECT_CALL(mf_mock, get_state()).WillRepeatedly(ReturnRef(st));
+
+    EXPECT_CALL(audio_device_manager, wait_for_probes(_))
+            .WillOnce(Return(false))
+            .RetiresOnSaturation();
+
+    actions::select_sample_rate device_action;
+    device_action.index = 1;
+    sut(make_middleware_functors(mf_mock), device_action);
+
+    struct non_device_action final
+        : ui::cloneable_action<non_device_action, action>
+    {
+    } action;
+    EXPECT_CALL(mf_mock, next(Ref(action)));
+    sut(make_middleware_functors(mf_mock), action);
+}
+
+TEST_F(audio_engine_middleware_test,
+       refresh_sound_cards_stores_the_probed_hw_params)
+{
+    using namespace testing;
+
+    audio::sound_card_hw_params const hw_params{
+            .sample_rates = {audio::sample_rate(48000u)},
+            .period_sizes = {audio::period_size(128u)},
+            .period_counts = {audio::period_count(2u)}};
+
+    audio::io_sound_cards const io_sound_cards{
+            box(std::vector{
+                    audio::sound_card_descriptor{.name = "foo", .path = {}},
+                    audio::sound_card_descriptor{.name = "bar", .path = {}}}),
+            box(std::vector{
+                    audio::sound_card_descriptor{.name = "foo", .path = {}}}),
+    };
+
+    state st;
+    EXPECT_CALL(mf_mock, get_state()).WillRepeatedly(ReturnRef(st));
+    EXPECT_CALL(mf_mock, next(_)).WillRepeatedly([&st](auto const& a) {
+        dynamic_cast<reducible_action const&>(a).reduce(st);
+    });
+    EXPECT_CALL(audio_device_manager, io_descriptors())
+            .WillOnce(Return(io_sound_cards));
+    EXPECT_CALL(audio_device_manager, hw_params(_, nullptr, nullptr))
+            .WillRepeatedly(Return(hw_params));
+
+    sut(make_middleware_functors(mf_mock), actions::refresh_sound_cards{});
+
+    EXPECT_EQ(io_sound_cards, st.io_sound_cards);
+    ASSERT_EQ(2u, st.io_sound_card_hw_params.in->size());
+    ASSERT_EQ(1u, st.io_sound_card_hw_params.out->size());
+    EXPECT_EQ(hw_params, st.io_sound_card_hw_params.in.get()[1]);
+}
+
 TEST_F(audio_engine_middleware_test,
        initiate_device_selection_is_converted_to_select_device_and_passed_to_next)
 {
@@ -14,7 +14,6 @@
 #include <cmath>
 #include <filesystem>
 #include <fstream>
-#include <future>
 #include <vector>
 
 namespace piejam::runtime::test
@@ -90,17 +89,11 @@ struct audio_engine_render_test : public ::testing::Test
         }
     }
 
+    // the new graph is picked up with the next rendered buffer
     void rebuild(state const& st)
     {
-        auto engine_swap = std::async(std::launch::async, [&]() {
-            return sut.rebuild(st, {}, nullptr);
-        });
-
-        do
-        {
-            render_buffer();
-        } while (engine_swap.wait_for(std::chrono::milliseconds{1}) !=
-                 std::future_status::ready);
+        sut.rebuild(st, {}, nullptr);
+        render_buffer();
     }
 
     void dump_output(std::filesystem::path const& file)
@@ -0,0 +1,105 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/audio_thread_topology.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::runtime::test
+{
+
+namespace
+{
+
+auto
+affinities(audio_thread_topology const& topology) -> std::vector<int>
+{
+    std::vector<int> result;
+    result.insert(
+            result.end(),
+            topology.audio_main.affinity.begin(),
+            topology.audio_main.affinity.end());
+    for (auto const& worker : topology.workers)
+    {
+        result.insert(
+                result.end(),
+                worker.affinity.begin(),
+                worker.affinity.end());
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(auto_audio_thread_topology, four_cores_avoid_ui_and_use_cpu_0_last)
+{
+    std::vector const online{0, 1, 2, 3};
+
+    auto const sut = auto_audio_thread_topology(online, {}, 1, 96);
+
+    EXPECT_EQ((std::vector{2, 3, 0}), affinities(sut));
+    ASSERT_EQ(2u, sut.workers.size());
+    EXPECT_EQ(96, sut.audio_main.realtime_priority);
+    EXPECT_EQ("audio_main", sut.audio_main.name);
+    EXPECT_EQ("audio_worker_1", sut.workers[1].name);
+}
+
+TEST(auto_audio_thread_topology, two_cores_have_no_workers)
+{
+    std::vector const online{0, 1};
+
+    auto const sut = auto_audio_thread_topology(online, {}, 1, 96);
+
+    EXPECT_EQ((std::vector{0}), affinities(sut));
+    EXPECT_TRUE(sut.workers.empty());
+}
+
+TEST(auto_audio_thread_topology, eight_cores_scale_the_workers)
+{
+    std::vector const online{0, 1, 2, 3, 4, 5, 6, 7};
+
+    auto const sut = auto_audio_thread_topology(online, {}, 1, 96);
+
+    EXPECT_EQ((std::vector{2, 3, 4, 5, 6, 7, 0}), affinities(sut));
+    EXPECT_EQ(6u, sut.workers.size());
+}
+
+TEST(auto_audio_thread_topology, isolated_cpus_are_used_exclusively)
+{
+    std::vector const online{0, 1, 2, 3};
+    std::vector const isolated{1, 2, 3};
+
+    auto const sut = auto_audio_thread_topology(online, isolated, 1, 96);
+
+    EXPECT_EQ((std::vector{2, 3}), affinities(sut));
+}
+
+TEST(auto_audio_thread_topology, single_core_is_not_pinned)
+{
+    std::vector const online{0};
+
+    auto const sut = auto_audio_thread_topology(online, {}, 0, 96);
+
+    EXPECT_TRUE(sut.audio_main.affinity.empty());
+    EXPECT_TRUE(sut.workers.empty());
+}
+
+TEST(make_audio_thread_topology, takes_configured_threads)
+{
+    audio_threads_config conf;
+    conf.automatic = false;
+    conf.audio_main = {.affinity = {3}, .realtime_priority = 90};
+    conf.workers = {{.affinity = {1, 2}, .realtime_priority = 80}};
+
+    auto const sut = make_audio_thread_topology(conf);
+
+    EXPECT_EQ((std::vector{3}), sut.audio_main.affinity);
+    EXPECT_EQ(90, sut.audio_main.realtime_priority);
+    ASSERT_EQ(1u, sut.workers.size());
+    EXPECT_EQ((std::vector{1, 2}), sut.workers[0].affinity);
+    EXPECT_EQ(80, sut.workers[0].realtime_priority);
+    EXPECT_EQ("audio_worker_0", sut.workers[0].name);
+}
+
+} // namespace piejam::runtime::test
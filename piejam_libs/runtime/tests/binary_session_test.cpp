@@ -0,0 +1,183 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/persistence/binary_session.h>
+
+#include <piejam/runtime/parameter/assignment.h>
+#include <piejam/runtime/persistence/fx_internal_id.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace piejam::runtime::persistence::test
+{
+
+namespace
+{
+
+auto
+test_internal_fx() -> fx::internal_id
+{
+    static fx::internal_id const s_id = [] {
+        auto id = fx::internal_id::generate();
+        register_internal_fx(id, "binary_session_test_fx");
+        return id;
+    }();
+    return s_id;
+}
+
+auto
+make_mixer_channel(std::string name) -> session::mixer_channel
+{
+    return session::mixer_channel{
+            .name = std::move(name),
+            .color = material_color::teal,
+            .bus_type = audio::bus_type::stereo,
+            .parameter = {.volume = 0.5f, .pan = -0.25f, .mute = true},
+            .midi = {.volume =
+                             midi_assignment{
+                                     .channel = 1,
+                                     .control_type = midi_assignment::type::cc,
+                                     .control_id = 7},
+                     .pan = std::nullopt,
+                     .mute = std::nullopt},
+            .fx_chain = {},
+            .in = {.type = session::mixer_io_type::device, .index = 2},
+            .out = {.type = session::mixer_io_type::default_, .index = 0},
+            .aux_sends = {
+                    {.route = {.type = session::mixer_io_type::channel,
+                               .index = 1},
+                     .enabled = true,
+                     .volume = 0.75f}}};
+}
+
+auto
+make_session() -> session
+{
+    session ses;
+    ses.external_audio_input_devices = {
+            {.name = "in",
+             .bus_type = audio::bus_type::mono,
+             .channels = {3, 3}}};
+    ses.external_audio_output_devices = {
+            {.name = "out",
+             .bus_type = audio::bus_type::stereo,
+             .channels = {0, 1}}};
+
+    ses.main_mixer_channel = make_mixer_channel("main");
+    ses.mixer_channels = {make_mixer_channel("a"), make_mixer_channel("b")};
+
+    ses.mixer_channels[1].fx_chain = {
+            session::internal_fx{
+                    .type = test_internal_fx(),
+                    .preset = {{.key = 0, .value = 0.5f},
+                               {.key = 1, .value = 3},
+                               {.key = 2, .value = true}},
+                    .midi = {{.key = 0,
+                              .value = {.channel = 2,
+                                        .control_type =
+                                                midi_assignment::type::cc,
+                                        .control_id = 11}}}},
+            session::ladspa_plugin{
+                    .id = 1234,
+                    .name = "ladspa",
+                    .preset = {{.key = 5, .value = -1.f}},
+                    .midi = {}}};
+
+    return ses;
+}
+
+auto
+save(session const& ses, std::string const& name) -> std::filesystem::path
+{
+    auto const file = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    save_binary_session(out, ses);
+    return file;
+}
+
+void
+expect_eq(session::mixer_channel const& l, session::mixer_channel const& r)
+{
+    EXPECT_EQ(l.name, r.name);
+    EXPECT_EQ(l.color, r.color);
+    EXPECT_EQ(l.bus_type, r.bus_type);
+    EXPECT_EQ(l.parameter.volume, r.parameter.volume);
+    EXPECT_EQ(l.parameter.pan, r.parameter.pan);
+    EXPECT_EQ(l.parameter.mute, r.parameter.mute);
+    EXPECT_EQ(l.midi.volume, r.midi.volume);
+    EXPECT_EQ(l.midi.pan, r.midi.pan);
+    EXPECT_EQ(l.midi.mute, r.midi.mute);
+    EXPECT_EQ(l.in.type, r.in.type);
+    EXPECT_EQ(l.in.index, r.in.index);
+    EXPECT_EQ(l.out.type, r.out.type);
+    EXPECT_EQ(l.out.index, r.out.index);
+    ASSERT_EQ(l.aux_sends.size(), r.aux_sends.size());
+    for (std::size_t i = 0; i < l.aux_sends.size(); ++i)
+    {
+        EXPECT_EQ(l.aux_sends[i].route.type, r.aux_sends[i].route.type);
+        EXPECT_EQ(l.aux_sends[i].route.index, r.aux_sends[i].route.index);
+        EXPECT_EQ(l.aux_sends[i].enabled, r.aux_sends[i].enabled);
+        EXPECT_EQ(l.aux_sends[i].volume, r.aux_sends[i].volume);
+    }
+}
+
+} // namespace
+
+TEST(binary_session, save_and_load)
+{
+    auto const ses = make_session();
+    auto const file = save(ses, "binary_session_test_1.pjsb");
+
+    ASSERT_TRUE(is_binary_session(file));
+    auto const loaded = load_session(file);
+
+    ASSERT_EQ(1u, loaded.external_audio_input_devices.size());
+    EXPECT_EQ("in", loaded.external_audio_input_devices[0].name);
+    EXPECT_EQ(
+            audio::bus_type::mono,
+            loaded.external_audio_input_devices[0].bus_type);
+    EXPECT_EQ(3u, loaded.external_audio_input_devices[0].channels.left);
+    ASSERT_EQ(1u, loaded.external_audio_output_devices.size());
+    EXPECT_EQ(1u, loaded.external_audio_output_devices[0].channels.right);
+
+    expect_eq(ses.main_mixer_channel, loaded.main_mixer_channel);
+    ASSERT_EQ(2u, loaded.mixer_channels.size());
+    expect_eq(ses.mixer_channels[0], loaded.mixer_channels[0]);
+    expect_eq(ses.mixer_channels[1], loaded.mixer_channels[1]);
+
+    auto const& fx_chain = loaded.mixer_channels[1].fx_chain;
+    ASSERT_EQ(2u, fx_chain.size());
+
+    auto const* internal = std::get_if<session::internal_fx>(&fx_chain[0]);
+    ASSERT_NE(nullptr, internal);
+    EXPECT_EQ(test_internal_fx(), internal->type);
+    auto const& ses_internal =
+            std::get<session::internal_fx>(ses.mixer_channels[1].fx_chain[0]);
+    EXPECT_EQ(ses_internal.preset, internal->preset);
+    EXPECT_EQ(ses_internal.midi, internal->midi);
+
+    auto const* ladspa = std::get_if<session::ladspa_plugin>(&fx_chain[1]);
+    ASSERT_NE(nullptr, ladspa);
+    EXPECT_EQ(1234u, ladspa->id);
+    EXPECT_EQ("ladspa", ladspa->name);
+    ASSERT_EQ(1u, ladspa->preset.size());
+    EXPECT_EQ(parameter_value{-1.f}, ladspa->preset[0].value);
+
+    std::filesystem::remove(file);
+}
+
+TEST(binary_session, truncated_file_is_rejected)
+{
+    auto const file = save(make_session(), "binary_session_test_3.pjsb");
+    std::filesystem::resize_file(file, std::filesystem::file_size(file) - 1);
+
+    EXPECT_THROW(binary_session_file{file}, std::runtime_error);
+
+    std::filesystem::remove(file);
+}
+
+} // namespace piejam::runtime::persistence::test
@@ -9,6 +9,7 @@
 #include <piejam/audio/engine/event_output_buffers.h>
 #include <piejam/audio/engine/process_context.h>
 #include <piejam/audio/engine/processor.h>
+#include <piejam/audio/sample_rate.h>
 #include <piejam/audio/slice.h>
 #include <piejam/midi/event.h>
 #include <piejam/midi/event_handler.h>
@@ -32,7 +33,9 @@ struct midi_input_processor_test : testing::Test
         auto mock = std::make_unique<
                 testing::StrictMock<midi_input_event_handler_mock>>();
         in_ev_handler = mock.get();
-        proc = make_midi_input_processor(std::move(mock));
+        proc = make_midi_input_processor(
+                std::move(mock),
+                audio::sample_rate{48000});
 
         ev_out_bufs.set_event_memory(&ev_buf_mem.memory_resource());
 
@@ -73,7 +76,7 @@ TEST_F(midi_input_processor_test, with_event)
 
     using testing::_;
     EXPECT_CALL(*in_ev_handler, process(_)).WillOnce([&ev](auto& handler) {
-        handler.process(ev);
+        handler.process(ev, {});
     });
     proc->process(ctx);
 
@@ -99,8 +102,8 @@ TEST_F(midi_input_processor_test, with_multiple_event)
 
     using testing::_;
     EXPECT_CALL(*in_ev_handler, process(_)).WillOnce([&](auto& handler) {
-        handler.process(ev1);
-        handler.process(ev2);
+        handler.process(ev1, {});
+        handler.process(ev2, {});
     });
     proc->process(ctx);
 
@@ -115,4 +118,30 @@ TEST_F(midi_input_processor_test, with_multiple_event)
     EXPECT_EQ(ev2, evr2.value());
 }
 
+TEST_F(midi_input_processor_test, events_are_placed_at_their_receive_time)
+{
+    midi::external_event ev{
+            .device_id = midi::device_id_t::generate(),
+            .event = midi::channel_cc_event{
+                    .channel = 1,
+                    .data = midi::cc_event{.cc = 5, .value = 23}}};
+
+    using namespace std::chrono_literals;
+    auto const now = system::monotonic_raw_clock::now();
+
+    using testing::_;
+    EXPECT_CALL(*in_ev_handler, process(_)).WillOnce([&](auto& handler) {
+        // older than a period
+        handler.process(ev, now - 1s);
+        // received after the process call started
+        handler.process(ev, now + 1s);
+    });
+    proc->process(ctx);
+
+    auto const& ev_buf = ev_out_bufs.get<midi::external_event>(0);
+    ASSERT_EQ(2u, ev_buf.size());
+    EXPECT_EQ(0u, ev_buf.begin()->offset());
+    EXPECT_EQ(ctx.buffer_size - 1, std::next(ev_buf.begin())->offset());
+}
+
 } // namespace piejam::runtime::processors::test
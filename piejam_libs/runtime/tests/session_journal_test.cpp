@@ -0,0 +1,177 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/persistence/session_journal.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace piejam::runtime::persistence::test
+{
+
+namespace
+{
+
+auto
+make_mixer_channel(std::string name) -> session::mixer_channel
+{
+    session::mixer_channel mc;
+    mc.name = std::move(name);
+    mc.color = material_color::pink;
+    mc.bus_type = audio::bus_type::stereo;
+    mc.in = {.type = session::mixer_io_type::default_, .index = 0};
+    mc.out = {.type = session::mixer_io_type::default_, .index = 0};
+    return mc;
+}
+
+auto
+make_ladspa_plugin(std::string name) -> session::ladspa_plugin
+{
+    return session::ladspa_plugin{
+            .id = 42,
+            .name = std::move(name),
+            .preset = {{.key = 0, .value = 0.5f}},
+            .midi = {}};
+}
+
+auto
+make_session() -> session
+{
+    session ses;
+    ses.main_mixer_channel = make_mixer_channel("main");
+    ses.mixer_channels = {make_mixer_channel("a"), make_mixer_channel("b")};
+    ses.mixer_channels[0].fx_chain = {make_ladspa_plugin("delay")};
+    return ses;
+}
+
+auto
+fx_name(session::fx_plugin const& fx_plug) -> std::string const&
+{
+    return std::get<session::ladspa_plugin>(fx_plug).name;
+}
+
+struct session_journal_test : ::testing::Test
+{
+    session_journal_test()
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    ~session_journal_test() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path const dir{
+            std::filesystem::temp_directory_path() / "session_journal_test"};
+};
+
+} // namespace
+
+TEST_F(session_journal_test, nothing_to_recover_without_journal)
+{
+    session_journal sut(dir);
+    EXPECT_FALSE(sut.recover().has_value());
+}
+
+TEST_F(session_journal_test, recover_appended_session)
+{
+    {
+        session_journal sut(dir);
+        ASSERT_FALSE(sut.recover().has_value());
+        EXPECT_EQ(4u, sut.append(make_session()));
+    }
+
+    session_journal sut(dir);
+    auto const recovered = sut.recover();
+    ASSERT_TRUE(recovered.has_value());
+    EXPECT_EQ("main", recovered->main_mixer_channel.name);
+    ASSERT_EQ(2u, recovered->mixer_channels.size());
+    EXPECT_EQ("b", recovered->mixer_channels[1].name);
+    ASSERT_EQ(1u, recovered->mixer_channels[0].fx_chain.size());
+    EXPECT_EQ("delay", fx_name(recovered->mixer_channels[0].fx_chain[0]));
+}
+
+TEST_F(session_journal_test, only_changed_sections_are_appended)
+{
+    session_journal sut(dir);
+    ASSERT_FALSE(sut.recover().has_value());
+
+    auto ses = make_session();
+    EXPECT_EQ(4u, sut.append(ses));
+    EXPECT_EQ(0u, sut.append(ses));
+
+    ses.mixer_channels[1].fx_chain.push_back(make_ladspa_plugin("reverb"));
+    EXPECT_EQ(1u, sut.append(ses));
+
+    ses.mixer_channels[0].name = "renamed";
+    EXPECT_EQ(1u, sut.append(ses));
+
+    // the session section and the fx chain of the new channel
+    ses.mixer_channels.push_back(make_mixer_channel("c"));
+    EXPECT_EQ(2u, sut.append(ses));
+}
+
+TEST_F(session_journal_test, torn_record_is_dropped)
+{
+    {
+        session_journal sut(dir);
+        ASSERT_FALSE(sut.recover().has_value());
+
+        auto ses = make_session();
+        sut.append(ses);
+
+        ses.mixer_channels[0].fx_chain.push_back(make_ladspa_plugin("reverb"));
+        EXPECT_EQ(1u, sut.append(ses));
+    }
+
+    auto const journal = dir / "journal";
+    std::filesystem::resize_file(
+            journal,
+            std::filesystem::file_size(journal) - 1);
+
+    session_journal sut(dir);
+    auto const recovered = sut.recover();
+    ASSERT_TRUE(recovered.has_value());
+    EXPECT_EQ(1u, recovered->mixer_channels[0].fx_chain.size());
+}
+
+TEST_F(session_journal_test, compaction_writes_snapshot)
+{
+    {
+        session_journal sut(dir, 0);
+        ASSERT_FALSE(sut.recover().has_value());
+
+        auto ses = make_session();
+        sut.append(ses);
+
+        ses.mixer_channels[1].name = "compacted";
+        sut.append(ses);
+        sut.flush();
+
+        EXPECT_TRUE(std::filesystem::exists(dir / "snapshot.pjsb"));
+    }
+
+    session_journal sut(dir);
+    auto const recovered = sut.recover();
+    ASSERT_TRUE(recovered.has_value());
+    EXPECT_EQ("compacted", recovered->mixer_channels[1].name);
+    EXPECT_EQ(1u, recovered->mixer_channels[0].fx_chain.size());
+}
+
+TEST_F(session_journal_test, clear_discards_autosave)
+{
+    {
+        session_journal sut(dir);
+        ASSERT_FALSE(sut.recover().has_value());
+        sut.append(make_session());
+        sut.clear();
+    }
+
+    session_journal sut(dir);
+    EXPECT_FALSE(sut.recover().has_value());
+}
+
+} // namespace piejam::runtime::persistence::test
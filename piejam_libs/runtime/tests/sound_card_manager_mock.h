@@ -15,6 +15,7 @@ namespace piejam::runtime::test
 struct sound_card_manager_mock : public audio::sound_card_manager
 {
     MOCK_METHOD(audio::io_sound_cards, io_descriptors, ());
+    MOCK_METHOD(bool, wait_for_probes, (std::function<void()>));
     MOCK_METHOD(
             audio::sound_card_hw_params,
             hw_params,
@@ -68,4 +68,21 @@ TEST_F(state_with_one_mixer_input,
     EXPECT_TRUE(sut.params.get_map<bool_parameter>().empty());
 }
 
+TEST(num_input_channels, aggregate_inputs_follow_the_input_sound_card)
+{
+    audio::sound_card_hw_params stereo;
+    stereo.num_channels = 2;
+    audio::sound_card_hw_params eight_channels;
+    eight_channels.num_channels = 8;
+
+    state sut;
+    sut.selected_io_sound_card.in.hw_params = stereo;
+    EXPECT_EQ(2u, num_input_channels(sut));
+
+    emplace_back(
+            sut.aggregate_input_sound_cards,
+            selected_sound_card{.index = 1, .hw_params = box(eight_channels)});
+    EXPECT_EQ(10u, num_input_channels(sut));
+}
+
 } // namespace piejam::runtime::test
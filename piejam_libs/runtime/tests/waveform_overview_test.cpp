@@ -0,0 +1,131 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/runtime/waveform_overview.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace piejam::runtime::test
+{
+
+TEST(waveform_overview_builder, mono_levels_are_folded_from_previous_level)
+{
+    std::array<std::size_t, 2> const bucket_sizes{2, 4};
+    waveform_overview_builder sut(1, bucket_sizes);
+
+    std::array const samples{0.5f, -0.5f, 1.f, 0.f, -1.f, 0.25f, 0.f, 0.f};
+    sut.process(samples);
+
+    ASSERT_EQ(2u, sut.num_levels());
+    EXPECT_EQ(8u, sut.num_frames());
+
+    auto const level0 = sut.peaks(0);
+    ASSERT_EQ(4u, level0.size());
+    EXPECT_EQ((waveform_overview_peak{-16384, 16384}), level0[0]);
+    EXPECT_EQ((waveform_overview_peak{0, 32767}), level0[1]);
+    EXPECT_EQ((waveform_overview_peak{-32767, 8192}), level0[2]);
+    EXPECT_EQ((waveform_overview_peak{0, 0}), level0[3]);
+
+    auto const level1 = sut.peaks(1);
+    ASSERT_EQ(2u, level1.size());
+    EXPECT_EQ((waveform_overview_peak{-16384, 32767}), level1[0]);
+    EXPECT_EQ((waveform_overview_peak{-32767, 8192}), level1[1]);
+}
+
+TEST(waveform_overview_builder, stereo_channels_are_kept_apart)
+{
+    std::array<std::size_t, 1> const bucket_sizes{2};
+    waveform_overview_builder sut(2, bucket_sizes);
+
+    std::array const samples{1.f, 0.f, -1.f, 0.f};
+    sut.process(samples);
+
+    auto const level0 = sut.peaks(0);
+    ASSERT_EQ(2u, level0.size());
+    EXPECT_EQ((waveform_overview_peak{-32767, 32767}), level0[0]);
+    EXPECT_EQ((waveform_overview_peak{0, 0}), level0[1]);
+}
+
+TEST(waveform_overview_builder, flush_emits_partial_buckets_on_all_levels)
+{
+    std::array<std::size_t, 2> const bucket_sizes{2, 4};
+    waveform_overview_builder sut(1, bucket_sizes);
+
+    std::array const samples{0.f, 0.f, 0.5f};
+    sut.process(samples);
+
+    EXPECT_EQ(1u, sut.peaks(0).size());
+    EXPECT_TRUE(sut.peaks(1).empty());
+
+    sut.flush();
+
+    EXPECT_EQ(2u, sut.peaks(0).size());
+    ASSERT_EQ(1u, sut.peaks(1).size());
+    EXPECT_EQ((waveform_overview_peak{0, 16384}), sut.peaks(1)[0]);
+}
+
+TEST(waveform_overview_file, read_back_written_overview)
+{
+    std::array<std::size_t, 2> const bucket_sizes{2, 4};
+    waveform_overview_builder builder(2, bucket_sizes);
+
+    std::vector<float> samples(20, 0.f);
+    samples[5] = 1.f;
+    samples[12] = -1.f;
+    builder.process(samples);
+    builder.flush();
+
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_waveform_overview_test.wav.peaks";
+    ASSERT_TRUE(write_waveform_overview(file, builder, 48000));
+
+    {
+        waveform_overview_file sut(file);
+        ASSERT_TRUE(sut);
+        EXPECT_EQ(48000u, sut.sample_rate());
+        EXPECT_EQ(2u, sut.num_channels());
+        EXPECT_EQ(10u, sut.num_frames());
+        ASSERT_EQ(2u, sut.num_levels());
+
+        for (std::size_t level = 0; level < sut.num_levels(); ++level)
+        {
+            EXPECT_EQ(
+                    builder.samples_per_bucket(level),
+                    sut.samples_per_bucket(level));
+            EXPECT_TRUE(std::ranges::equal(
+                    builder.peaks(level),
+                    sut.peaks(level)));
+        }
+
+        EXPECT_EQ(0u, sut.select_level(1));
+        EXPECT_EQ(0u, sut.select_level(3));
+        EXPECT_EQ(1u, sut.select_level(4));
+        EXPECT_EQ(1u, sut.select_level(4096));
+    }
+
+    std::filesystem::remove(file);
+}
+
+TEST(waveform_overview_file, invalid_file_is_rejected)
+{
+    auto const file = std::filesystem::temp_directory_path() /
+                      "piejam_waveform_overview_invalid_test.wav.peaks";
+    {
+        std::ofstream out(file, std::ios::binary);
+        out << "not a waveform overview file";
+    }
+
+    waveform_overview_file sut(file);
+    EXPECT_FALSE(sut);
+
+    std::filesystem::remove(file);
+}
+
+} // namespace piejam::runtime::test
@@ -0,0 +1,25 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace piejam::system
+{
+
+//! Parses the cpu list format of the kernel, e.g. "0-2,4". Malformed
+//! entries are skipped.
+[[nodiscard]]
+auto parse_cpu_list(std::string_view) -> std::vector<int>;
+
+[[nodiscard]]
+auto online_cpus() -> std::vector<int>;
+
+//! CPUs excluded from the scheduler by the isolcpus boot parameter.
+[[nodiscard]]
+auto isolated_cpus() -> std::vector<int>;
+
+} // namespace piejam::system
@@ -6,6 +6,7 @@
 
 #include <boost/outcome/std_result.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <span>
 #include <system_error>
@@ -47,6 +48,11 @@ public:
     auto read(std::span<std::byte> buffer) noexcept
             -> outcome::std_result<std::size_t>;
 
+    //! Waits until the device is readable. Returns false on timeout.
+    [[nodiscard]]
+    auto poll_read(std::chrono::milliseconds timeout) noexcept
+            -> outcome::std_result<bool>;
+
     [[nodiscard]]
     auto set_nonblock(bool set = true) -> std::error_code;
 
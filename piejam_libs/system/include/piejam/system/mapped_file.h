@@ -0,0 +1,46 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace piejam::system
+{
+
+//! Read-only memory mapping of a whole file.
+class mapped_file
+{
+public:
+    mapped_file() noexcept = default;
+    explicit mapped_file(std::filesystem::path const& pathname);
+    mapped_file(mapped_file const&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+
+    ~mapped_file();
+
+    auto operator=(mapped_file const&) -> mapped_file& = delete;
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+    explicit operator bool() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    [[nodiscard]]
+    auto data() const noexcept -> std::span<std::byte const>
+    {
+        return {m_data, m_size};
+    }
+
+private:
+    void unmap() noexcept;
+
+    std::byte const* m_data{};
+    std::size_t m_size{};
+};
+
+} // namespace piejam::system
@@ -0,0 +1,36 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <chrono>
+
+#include <time.h>
+
+namespace piejam::system
+{
+
+//! CLOCK_MONOTONIC_RAW, the clock the ALSA PCM timestamps are taken from.
+//! Not subject to NTP adjustments, and served from the vDSO, so it's
+//! safe to be read from the realtime threads.
+struct monotonic_raw_clock
+{
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<monotonic_raw_clock>;
+
+    static constexpr bool is_steady = true;
+
+    static auto now() noexcept -> time_point
+    {
+        timespec ts{};
+        ::clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return time_point{
+                std::chrono::seconds{ts.tv_sec} +
+                std::chrono::nanoseconds{ts.tv_nsec}};
+    }
+};
+
+} // namespace piejam::system
@@ -0,0 +1,111 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/system/cpu_topology.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace piejam::system
+{
+
+namespace
+{
+
+auto
+parse_int(std::string_view const s, int& value) -> bool
+{
+    auto const* const last = s.data() + s.size();
+    auto const [ptr, ec] = std::from_chars(s.data(), last, value);
+    return ec == std::errc{} && ptr == last && value >= 0;
+}
+
+auto
+read_cpu_list(char const* const file) -> std::vector<int>
+{
+    std::ifstream in(file);
+    std::string line;
+    std::getline(in, line);
+    return parse_cpu_list(line);
+}
+
+} // namespace
+
+auto
+parse_cpu_list(std::string_view list) -> std::vector<int>
+{
+    std::vector<int> result;
+
+    while (!list.empty())
+    {
+        auto const comma = list.find(',');
+        auto entry = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{}
+                                               : list.substr(comma + 1);
+
+        while (!entry.empty() &&
+               (entry.back() == '\n' || entry.back() == ' '))
+        {
+            entry.remove_suffix(1);
+        }
+
+        auto const dash = entry.find('-');
+        int first{};
+        int last{};
+        if (dash == std::string_view::npos)
+        {
+            if (!parse_int(entry, first))
+            {
+                continue;
+            }
+
+            last = first;
+        }
+        else if (
+                !parse_int(entry.substr(0, dash), first) ||
+                !parse_int(entry.substr(dash + 1), last) || last < first)
+        {
+            continue;
+        }
+
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            result.push_back(cpu);
+        }
+    }
+
+    std::ranges::sort(result);
+    auto const [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+
+    return result;
+}
+
+auto
+online_cpus() -> std::vector<int>
+{
+    auto cpus = read_cpu_list("/sys/devices/system/cpu/online");
+    if (cpus.empty())
+    {
+        for (int cpu = 0;
+             cpu < static_cast<int>(std::thread::hardware_concurrency());
+             ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+auto
+isolated_cpus() -> std::vector<int>
+{
+    return read_cpu_list("/sys/devices/system/cpu/isolated");
+}
+
+} // namespace piejam::system
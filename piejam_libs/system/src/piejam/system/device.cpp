@@ -8,6 +8,7 @@
 #include <boost/core/ignore_unused.hpp>
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
@@ -104,6 +105,21 @@ device::read(std::span<std::byte> const buffer) noexcept
     return static_cast<std::size_t>(res);
 }
 
+auto
+device::poll_read(std::chrono::milliseconds const timeout) noexcept
+        -> outcome::std_result<bool>
+{
+    pollfd pfd{.fd = m_fd, .events = POLLIN, .revents = 0};
+
+    auto const res = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (res < 0)
+    {
+        return std::error_code(errno, std::generic_category());
+    }
+
+    return res > 0 && (pfd.revents & POLLIN);
+}
+
 auto
 device::set_nonblock(bool const set) -> std::error_code
 {
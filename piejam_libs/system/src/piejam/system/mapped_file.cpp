@@ -0,0 +1,93 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/system/mapped_file.h>
+
+#include <boost/assert.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <system_error>
+#include <utility>
+
+namespace piejam::system
+{
+
+mapped_file::mapped_file(std::filesystem::path const& pathname)
+{
+    int const fd = ::open(pathname.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) < 0)
+    {
+        int const err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category());
+    }
+
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        return;
+    }
+
+    void* const addr = ::mmap(
+            nullptr,
+            static_cast<std::size_t>(st.st_size),
+            PROT_READ,
+            MAP_PRIVATE,
+            fd,
+            0);
+    int const err = errno;
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+
+    if (addr == MAP_FAILED)
+    {
+        throw std::system_error(err, std::generic_category());
+    }
+
+    m_data = static_cast<std::byte const*>(addr);
+    m_size = static_cast<std::size_t>(st.st_size);
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+mapped_file::~mapped_file()
+{
+    unmap();
+}
+
+auto
+mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file&
+{
+    unmap();
+
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    return *this;
+}
+
+void
+mapped_file::unmap() noexcept
+{
+    if (m_data)
+    {
+        BOOST_VERIFY(!::munmap(const_cast<std::byte*>(m_data), m_size));
+    }
+}
+
+} // namespace piejam::system
@@ -0,0 +1,35 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/system/cpu_topology.h>
+
+#include <gtest/gtest.h>
+
+namespace piejam::system::test
+{
+
+TEST(parse_cpu_list, empty)
+{
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("\n").empty());
+}
+
+TEST(parse_cpu_list, single_and_ranges)
+{
+    EXPECT_EQ((std::vector{0}), parse_cpu_list("0\n"));
+    EXPECT_EQ((std::vector{0, 1, 2, 3}), parse_cpu_list("0-3"));
+    EXPECT_EQ((std::vector{1, 2, 4, 6, 7}), parse_cpu_list("1-2,4,6-7\n"));
+}
+
+TEST(parse_cpu_list, sorted_and_unique)
+{
+    EXPECT_EQ((std::vector{1, 2, 3}), parse_cpu_list("3,1-2,2"));
+}
+
+TEST(parse_cpu_list, malformed_entries_are_skipped)
+{
+    EXPECT_EQ((std::vector{2}), parse_cpu_list("x,2,3-1,-4"));
+}
+
+} // namespace piejam::system::test
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <span>
+
 namespace piejam::this_thread
 {
 
 void set_affinity(int cpu);
+void set_affinity(std::span<int const> cpus);
 
 } // namespace piejam::this_thread
@@ -6,17 +6,21 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace piejam::thread
 {
 
 struct configuration
 {
-    std::optional<int> affinity;
+    //! CPUs the thread may run on, empty to not restrict it.
+    std::vector<int> affinity;
     std::optional<int> realtime_priority;
     std::optional<std::string> name;
 
     void apply() const;
+
+    auto operator==(configuration const&) const -> bool = default;
 };
 
 } // namespace piejam::thread
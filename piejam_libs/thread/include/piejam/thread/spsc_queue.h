@@ -0,0 +1,175 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <piejam/thread/cache_line_size.h>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace piejam::thread
+{
+
+//! Bounded single-producer-single-consumer, lock-free FIFO queue. Elements
+//! can be transferred one by one or in blocks.
+template <class T>
+class spsc_queue
+{
+    static_assert(std::atomic_size_t::is_always_lock_free);
+    static_assert(std::is_nothrow_copy_assignable_v<T>);
+
+public:
+    //! capacity is rounded up to the next power of two
+    explicit spsc_queue(std::size_t const capacity)
+        : m_buffer(std::bit_ceil(capacity))
+        , m_mask(m_buffer.size() - 1)
+    {
+        BOOST_ASSERT(capacity > 0);
+    }
+
+    [[nodiscard]]
+    auto capacity() const noexcept -> std::size_t
+    {
+        return m_buffer.size();
+    }
+
+    //! Number of elements, which can be popped. Only exact on the consumer
+    //! side, the producer might push more in the meantime.
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    {
+        return m_write.load(std::memory_order_acquire) -
+               m_read.load(std::memory_order_relaxed);
+    }
+
+    //! Returns false, if the queue is full.
+    auto push(T const& v) noexcept -> bool
+    {
+        std::size_t const write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read_cache == m_buffer.size())
+        {
+            m_read_cache = m_read.load(std::memory_order_acquire);
+            if (write - m_read_cache == m_buffer.size())
+            {
+                return false;
+            }
+        }
+
+        m_buffer[write & m_mask] = v;
+        m_write.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Returns false, if the queue is empty.
+    auto pop(T& r) noexcept -> bool
+    {
+        std::size_t const read = m_read.load(std::memory_order_relaxed);
+        if (read == m_write_cache)
+        {
+            m_write_cache = m_write.load(std::memory_order_acquire);
+            if (read == m_write_cache)
+            {
+                return false;
+            }
+        }
+
+        r = m_buffer[read & m_mask];
+        m_read.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Pushes either all of the elements or, if they don't fit, none.
+    auto push(std::span<T const> const elements) noexcept -> bool
+    {
+        std::size_t const write = m_write.load(std::memory_order_relaxed);
+        if (m_buffer.size() - (write - m_read_cache) < elements.size())
+        {
+            m_read_cache = m_read.load(std::memory_order_acquire);
+            if (m_buffer.size() - (write - m_read_cache) < elements.size())
+            {
+                return false;
+            }
+        }
+
+        std::size_t const offset = write & m_mask;
+        std::size_t const first =
+                std::min(elements.size(), m_buffer.size() - offset);
+        std::ranges::copy(
+                elements.first(first),
+                std::next(m_buffer.begin(), static_cast<long>(offset)));
+        std::ranges::copy(elements.subspan(first), m_buffer.begin());
+
+        m_write.store(write + elements.size(), std::memory_order_release);
+        return true;
+    }
+
+    //! Pops either as many elements as fit into the target or, if there
+    //! aren't enough, none.
+    auto pop(std::span<T> const target) noexcept -> bool
+    {
+        std::size_t const read = m_read.load(std::memory_order_relaxed);
+        if (m_write_cache - read < target.size())
+        {
+            m_write_cache = m_write.load(std::memory_order_acquire);
+            if (m_write_cache - read < target.size())
+            {
+                return false;
+            }
+        }
+
+        std::size_t const offset = read & m_mask;
+        std::size_t const first =
+                std::min(target.size(), m_buffer.size() - offset);
+        std::copy_n(
+                std::next(m_buffer.begin(), static_cast<long>(offset)),
+                first,
+                target.begin());
+        std::copy_n(
+                m_buffer.begin(),
+                target.size() - first,
+                std::next(target.begin(), static_cast<long>(first)));
+
+        m_read.store(read + target.size(), std::memory_order_release);
+        return true;
+    }
+
+    //! Pops all currently available elements.
+    template <std::invocable<T const&> F>
+    void consume(F&& f) noexcept(
+            noexcept(std::invoke(std::forward<F>(f), std::declval<T>())))
+    {
+        std::size_t read = m_read.load(std::memory_order_relaxed);
+        m_write_cache = m_write.load(std::memory_order_acquire);
+
+        for (; read != m_write_cache; ++read)
+        {
+            std::invoke(f, m_buffer[read & m_mask]);
+        }
+
+        m_read.store(read, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> m_buffer;
+    std::size_t m_mask;
+
+    // consumer side
+    alignas(cache_line_size) std::atomic_size_t m_read{};
+    std::size_t m_write_cache{};
+
+    // producer side
+    alignas(cache_line_size) std::atomic_size_t m_write{};
+    std::size_t m_read_cache{};
+};
+
+} // namespace piejam::thread
@@ -14,9 +14,19 @@ namespace piejam::this_thread
 
 void
 set_affinity(int const cpu)
+{
+    set_affinity(std::span{&cpu, 1});
+}
+
+void
+set_affinity(std::span<int const> const cpus)
 {
     cpu_set_t cpuset{};
-    CPU_SET(cpu, &cpuset);
+    for (int const cpu : cpus)
+    {
+        CPU_SET(cpu, &cpuset);
+    }
+
     int const status =
             pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
     if (status)
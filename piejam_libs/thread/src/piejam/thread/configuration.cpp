@@ -14,9 +14,9 @@ namespace piejam::thread
 void
 configuration::apply() const
 {
-    if (affinity)
+    if (!affinity.empty())
     {
-        this_thread::set_affinity(*affinity);
+        this_thread::set_affinity(affinity);
     }
 
     if (realtime_priority)
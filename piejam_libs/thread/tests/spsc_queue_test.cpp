@@ -0,0 +1,191 @@
+// PieJam - An audio mixer for Raspberry Pi.
+// SPDX-FileCopyrightText: 2020-2024  Dimitrij Kotrev
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <piejam/thread/spsc_queue.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace piejam::thread::test
+{
+
+TEST(spsc_queue, capacity_is_rounded_up_to_power_of_two)
+{
+    spsc_queue<int> sut(5);
+    EXPECT_EQ(8u, sut.capacity());
+}
+
+TEST(spsc_queue, pop_from_empty)
+{
+    spsc_queue<int> sut(4);
+    int r{};
+    EXPECT_FALSE(sut.pop(r));
+}
+
+TEST(spsc_queue, push_pop_in_fifo_order)
+{
+    spsc_queue<int> sut(4);
+    EXPECT_TRUE(sut.push(1));
+    EXPECT_TRUE(sut.push(2));
+
+    int r{};
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_EQ(1, r);
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_EQ(2, r);
+    EXPECT_FALSE(sut.pop(r));
+}
+
+TEST(spsc_queue, push_into_full)
+{
+    spsc_queue<int> sut(2);
+    EXPECT_TRUE(sut.push(1));
+    EXPECT_TRUE(sut.push(2));
+    EXPECT_FALSE(sut.push(3));
+
+    int r{};
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_TRUE(sut.push(3));
+}
+
+TEST(spsc_queue, consume_all)
+{
+    spsc_queue<int> sut(4);
+    sut.push(1);
+    sut.push(2);
+    sut.push(3);
+
+    std::vector<int> consumed;
+    sut.consume([&](int x) { consumed.push_back(x); });
+
+    EXPECT_EQ((std::vector{1, 2, 3}), consumed);
+
+    int r{};
+    EXPECT_FALSE(sut.pop(r));
+}
+
+TEST(spsc_queue, concurrent_push_pop_keeps_order)
+{
+    constexpr int num_values = 100000;
+    spsc_queue<int> sut(16);
+
+    std::jthread producer([&sut]() {
+        for (int i = 0; i < num_values;)
+        {
+            if (sut.push(i))
+            {
+                ++i;
+            }
+        }
+    });
+
+    int expected{};
+    while (expected < num_values)
+    {
+        int r{};
+        if (sut.pop(r))
+        {
+            ASSERT_EQ(expected, r);
+            ++expected;
+        }
+    }
+}
+
+TEST(spsc_queue, pop_block_from_empty)
+{
+    spsc_queue<int> sut(4);
+    std::array<int, 1> r{};
+    EXPECT_FALSE(sut.pop(r));
+    EXPECT_EQ(0u, sut.size());
+}
+
+TEST(spsc_queue, push_pop_blocks_in_fifo_order)
+{
+    spsc_queue<int> sut(8);
+    EXPECT_TRUE(sut.push(std::array{1, 2, 3}));
+    EXPECT_TRUE(sut.push(std::array{4}));
+    EXPECT_EQ(4u, sut.size());
+
+    std::array<int, 3> r{};
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_EQ((std::array{1, 2, 3}), r);
+    EXPECT_EQ(1u, sut.size());
+}
+
+TEST(spsc_queue, pop_block_larger_than_available_pops_nothing)
+{
+    spsc_queue<int> sut(8);
+    EXPECT_TRUE(sut.push(std::array{1, 2}));
+
+    std::array<int, 3> r{};
+    EXPECT_FALSE(sut.pop(r));
+    EXPECT_EQ(2u, sut.size());
+}
+
+TEST(spsc_queue, push_block_larger_than_free_pushes_nothing)
+{
+    spsc_queue<int> sut(4);
+    EXPECT_TRUE(sut.push(std::array{1, 2, 3}));
+    EXPECT_FALSE(sut.push(std::array{4, 5}));
+    EXPECT_EQ(3u, sut.size());
+
+    std::array<int, 2> r{};
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_TRUE(sut.push(std::array{4, 5}));
+}
+
+TEST(spsc_queue, push_pop_blocks_wrap_around)
+{
+    spsc_queue<int> sut(4);
+    std::array<int, 3> r{};
+
+    EXPECT_TRUE(sut.push(std::array{1, 2, 3}));
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_TRUE(sut.push(std::array{4, 5, 6}));
+    ASSERT_TRUE(sut.pop(r));
+    EXPECT_EQ((std::array{4, 5, 6}), r);
+}
+
+TEST(spsc_queue, concurrent_push_pop_blocks_keeps_order)
+{
+    constexpr int num_blocks = 10000;
+    constexpr int block_size = 7;
+    spsc_queue<int> sut(32);
+
+    std::jthread producer([&sut]() {
+        std::array<int, block_size> block{};
+        for (int b = 0; b < num_blocks;)
+        {
+            for (int i = 0; i < block_size; ++i)
+            {
+                block[i] = b * block_size + i;
+            }
+
+            if (sut.push(block))
+            {
+                ++b;
+            }
+        }
+    });
+
+    // different block size, so the blocks are split on the consumer side
+    std::array<int, 5> r{};
+    int expected{};
+    while (expected + 5 <= num_blocks * block_size)
+    {
+        if (sut.pop(r))
+        {
+            for (int x : r)
+            {
+                ASSERT_EQ(expected, x);
+                ++expected;
+            }
+        }
+    }
+}
+
+} // namespace piejam::thread::test